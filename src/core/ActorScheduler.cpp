@@ -0,0 +1,143 @@
+#include "ActorScheduler.hpp"
+#include <algorithm>
+
+ActorScheduler::ActorId ActorScheduler::add(int speed, std::uint32_t tag,
+                                            Tick firstDelay) {
+  ActorId id;
+  if (!freeSlots.empty()) {
+    id = freeSlots.back();
+    freeSlots.pop_back();
+  } else {
+    id = static_cast<ActorId>(actors.size());
+    actors.push_back({});
+  }
+
+  Actor &a = actors[id];
+  a.speed = std::max(1, speed);
+  a.energy = 0;
+  a.tag = tag;
+  a.gen++;
+  a.alive = true;
+  liveCount++;
+
+  schedule(id, firstDelay);
+  return id;
+}
+
+void ActorScheduler::remove(ActorId id) {
+  if (!contains(id))
+    return;
+  actors[id].alive = false;
+  actors[id].gen++; // Su entrada en la cola queda obsoleta
+  freeSlots.push_back(id);
+  liveCount--;
+  compactIfNeeded();
+}
+
+bool ActorScheduler::contains(ActorId id) const {
+  return id < actors.size() && actors[id].alive;
+}
+
+void ActorScheduler::setSpeed(ActorId id, int speed) {
+  if (contains(id))
+    actors[id].speed = std::max(1, speed);
+}
+
+int ActorScheduler::speedOf(ActorId id) const {
+  return contains(id) ? actors[id].speed : 0;
+}
+
+void ActorScheduler::setTag(ActorId id, std::uint32_t tag) {
+  if (contains(id))
+    actors[id].tag = tag;
+}
+
+std::uint32_t ActorScheduler::tagOf(ActorId id) const {
+  return contains(id) ? actors[id].tag : 0;
+}
+
+void ActorScheduler::schedule(ActorId id, Tick delay) {
+  Actor &a = actors[id];
+  if (delay < 0) {
+    // Ticks hasta reunir la energía de una acción (redondeo hacia arriba)
+    const int need = ACTION_COST - a.energy;
+    delay = std::max<Tick>(1, (need + a.speed - 1) / a.speed);
+    a.energy = static_cast<int>(a.energy + delay * a.speed - ACTION_COST);
+  }
+  heap.push_back({clock + delay, nextSeq++, id, a.gen});
+  std::push_heap(heap.begin(), heap.end(), Later{});
+}
+
+bool ActorScheduler::valid(const Entry &e) const {
+  return e.id < actors.size() && actors[e.id].alive &&
+         actors[e.id].gen == e.gen;
+}
+
+void ActorScheduler::dropStale() {
+  while (!heap.empty() && !valid(heap.front())) {
+    std::pop_heap(heap.begin(), heap.end(), Later{});
+    heap.pop_back();
+  }
+}
+
+void ActorScheduler::compactIfNeeded() {
+  // Las bajas dejan entradas muertas en la cola: si superan a las vivas,
+  // reconstruimos (O(n)) para que la cola no crezca sin límite.
+  if (heap.size() < 64 || heap.size() < 2 * liveCount)
+    return;
+  heap.erase(std::remove_if(heap.begin(), heap.end(),
+                            [this](const Entry &e) { return !valid(e); }),
+             heap.end());
+  std::make_heap(heap.begin(), heap.end(), Later{});
+}
+
+ActorScheduler::ActorId ActorScheduler::peek() {
+  dropStale();
+  return heap.empty() ? INVALID_ACTOR : heap.front().id;
+}
+
+ActorScheduler::Tick ActorScheduler::peekTime() {
+  dropStale();
+  return heap.empty() ? clock : heap.front().time;
+}
+
+ActorScheduler::ActorId ActorScheduler::pop() {
+  dropStale();
+  if (heap.empty())
+    return INVALID_ACTOR;
+
+  std::pop_heap(heap.begin(), heap.end(), Later{});
+  const Entry e = heap.back();
+  heap.pop_back();
+  clock = std::max(clock, e.time);
+  schedule(e.id, -1);
+  return e.id;
+}
+
+void ActorScheduler::advanceTo(Tick t) {
+  if (t > clock)
+    clock = t;
+}
+
+void ActorScheduler::clear() {
+  actors.clear();
+  freeSlots.clear();
+  heap.clear();
+  liveCount = 0;
+  nextSeq = 0;
+  clock = 0;
+}
+
+void ActorScheduler::saveState(StateWriter &out) const {
+  out.vec(actors);
+  out.vec(freeSlots);
+  out.vec(heap);
+  out.pod(liveCount);
+  out.pod(nextSeq);
+  out.pod(clock);
+}
+
+bool ActorScheduler::loadState(StateReader &in) {
+  return in.vec(actors) && in.vec(freeSlots) && in.vec(heap) &&
+         in.pod(liveCount) && in.pod(nextSeq) && in.pod(clock);
+}
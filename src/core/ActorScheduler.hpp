@@ -0,0 +1,102 @@
+#ifndef ACTOR_SCHEDULER_HPP
+#define ACTOR_SCHEDULER_HPP
+
+#include "StateBuffer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Planificador de turnos por energía (Energy-based scheduler)
+// Cada actor (jugador, enemigo, boss...) tiene una velocidad. Por cada tick
+// del reloj acumula 'speed' puntos de energía y actúa al llegar a
+// ACTION_COST. En vez de recorrer a todos los actores cada tick, guardamos en
+// una cola de prioridad el instante de su próxima acción:
+// - Sacar el siguiente actor cuesta O(log n).
+// - A velocidad normal (100) se actúa cada TICKS_PER_ACTION ticks; a 200 el
+//   doble de veces, a 50 la mitad. El sobrante de energía se conserva, así
+//   que velocidades no divisibles (ej: 75) mantienen su ritmo exacto.
+// - Los empates se resuelven por orden de programación: el orden de turnos
+//   es determinista y se puede testear.
+class ActorScheduler {
+public:
+  using ActorId = std::uint32_t;
+  using Tick = std::int64_t;
+
+  static constexpr ActorId INVALID_ACTOR = 0xFFFFFFFFu;
+  static constexpr int NORMAL_SPEED = 100;
+  static constexpr int ACTION_COST = 100 * NORMAL_SPEED;
+  static constexpr Tick TICKS_PER_ACTION = ACTION_COST / NORMAL_SPEED;
+
+  // Añade un actor. 'tag' es un dato libre del usuario (ej: índice de
+  // enemigo). Si firstDelay < 0, su primera acción llega tras una acción
+  // completa a su velocidad; si no, exactamente firstDelay ticks después.
+  ActorId add(int speed, std::uint32_t tag = 0, Tick firstDelay = -1);
+  void remove(ActorId id);
+  bool contains(ActorId id) const;
+
+  // La nueva velocidad se aplica a partir de su próxima acción.
+  void setSpeed(ActorId id, int speed);
+  int speedOf(ActorId id) const;
+
+  void setTag(ActorId id, std::uint32_t tag);
+  std::uint32_t tagOf(ActorId id) const;
+
+  // Siguiente actor en actuar (sin sacarlo). INVALID_ACTOR si no hay.
+  ActorId peek();
+  Tick peekTime();
+
+  // Saca al siguiente actor, avanza el reloj a su instante y lo vuelve a
+  // programar tras una acción. INVALID_ACTOR si no hay actores.
+  ActorId pop();
+
+  // Relojes en tiempo real: adelanta el reloj sin que nadie actúe
+  // (nunca hacia atrás).
+  void advanceTo(Tick t);
+
+  Tick now() const { return clock; }
+  std::size_t size() const { return liveCount; }
+  bool empty() const { return liveCount == 0; }
+  void clear();
+
+  // Foto de la cola (ver SimSnapshot): actores, entradas y reloj tal cual,
+  // así que el orden de turnos tras cargarla es el mismo
+  void saveState(StateWriter &out) const;
+  bool loadState(StateReader &in);
+
+private:
+  struct Actor {
+    int speed = NORMAL_SPEED;
+    int energy = 0; // Sobrante de la última espera
+    std::uint32_t tag = 0;
+    std::uint32_t gen = 0; // Invalida entradas viejas de la cola
+    bool alive = false;
+  };
+
+  struct Entry {
+    Tick time;
+    std::uint64_t seq;
+    ActorId id;
+    std::uint32_t gen;
+  };
+  struct Later {
+    bool operator()(const Entry &a, const Entry &b) const {
+      if (a.time != b.time)
+        return a.time > b.time;
+      return a.seq > b.seq;
+    }
+  };
+
+  void schedule(ActorId id, Tick delay); // delay < 0: según energía
+  void dropStale();                      // Limpia la cima inválida
+  void compactIfNeeded();                // Rehace la cola si hay mucha basura
+  bool valid(const Entry &e) const;
+
+  std::vector<Actor> actors;
+  std::vector<ActorId> freeSlots;
+  std::vector<Entry> heap; // Montículo (std::push_heap/pop_heap con Later)
+  std::size_t liveCount = 0;
+  std::uint64_t nextSeq = 0;
+  Tick clock = 0;
+};
+
+#endif
@@ -0,0 +1,323 @@
+#include "AutoPlayer.hpp"
+#include "FixedTimestep.hpp"
+#include "GameUtils.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+const int DIRS[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+int sign(int v) { return (v > 0) - (v < 0); }
+
+bool enemyAt(const GameSim &sim, int x, int y) {
+  for (const Enemy &e : sim.getEnemies())
+    if (e.getX() == x && e.getY() == y)
+      return true;
+  return false;
+}
+
+// Casillas libres (sin muro ni enemigo) entre dos puntos de la misma fila o
+// columna, sin contar los extremos
+bool clearLine(const GameSim &sim, int x0, int y0, int x1, int y1) {
+  const int dx = sign(x1 - x0), dy = sign(y1 - y0);
+  for (int x = x0 + dx, y = y0 + dy; x != x1 || y != y1; x += dx, y += dy)
+    if (!sim.getMap().isWalkable(x, y) || enemyAt(sim, x, y))
+      return false;
+  return true;
+}
+} // namespace
+
+TickInput AutoPlayer::next(const GameSim &sim) {
+  if (sim.getState() != GameState::Playing)
+    return TickInput{};
+  if (wait > 0) {
+    --wait;
+    return TickInput{}; // Entre acciones no pulsa nada
+  }
+  wait = ACTION_TICKS - 1;
+  return decide(sim);
+}
+
+TickInput AutoPlayer::decide(const GameSim &sim) {
+  const int px = sim.getPlayerX(), py = sim.getPlayerY();
+  if (sim.getCurrentLevel() != level) {
+    level = sim.getCurrentLevel();
+    const auto exitTile = sim.getMap().findExitTile();
+    exitX = exitTile.first;
+    exitY = exitTile.second;
+    exploreX = exploreY = -1;
+    stillActions = unstickActions = 0;
+    lastX = lastY = -1;
+  }
+
+  // ¿Quiso andar y sigue en la misma casilla?
+  const bool wantedToMove =
+      current != Goal::Fight && current != Goal::Boss && lastX >= 0;
+  stillActions = (wantedToMove && px == lastX && py == lastY) ? stillActions + 1
+                                                              : 0;
+  lastX = px;
+  lastY = py;
+
+  TickInput in; // Modo paso a paso: una acción, una casilla
+  if (unstickActions > 0) {
+    --unstickActions;
+    face(unstickX, unstickY, in);
+    return in;
+  }
+  if (stillActions >= STUCK_ACTIONS) {
+    // Atascado (un enemigo que no se aparta, un camino que no existe...):
+    // unos pasos al azar y vuelta a empezar
+    const int d = rng.range(0, 3);
+    unstickX = DIRS[d][0];
+    unstickY = DIRS[d][1];
+    unstickActions = 3;
+    stillActions = 0;
+    exploreX = exploreY = -1;
+    current = Goal::Unstick;
+    face(unstickX, unstickY, in);
+    return in;
+  }
+
+  if (sim.getBoss().active) {
+    current = Goal::Boss;
+    fightBoss(sim, in);
+    return in;
+  }
+  if (attackAdjacent(sim, in) || shootInLine(sim, in)) {
+    current = Goal::Fight;
+    return in;
+  }
+
+  // Encima de un objeto: recogerlo (la llave se recoge sola)
+  for (const ItemSpawn &it : sim.getItems())
+    if (it.tile.x == px && it.tile.y == py &&
+        it.type != ItemType::LlaveMaestra)
+      in.interact = true;
+
+  int tx = px, ty = py;
+  if (pickTarget(sim, tx, ty))
+    stepToward(sim, tx, ty, in);
+  return in;
+}
+
+void AutoPlayer::face(int dx, int dy, TickInput &in) {
+  // En paso a paso, pedir una dirección gira al jugador y, si la casilla
+  // está libre, además avanza
+  in.stepX = static_cast<std::int8_t>(dx);
+  in.stepY = static_cast<std::int8_t>(dy);
+  in.movePressed = true;
+  faceX = dx;
+  faceY = dy;
+}
+
+void AutoPlayer::meleeAttack(const GameSim &sim, TickInput &in) {
+  const float cd = sim.getSwordTier() > 0 ? CD_SWORD : CD_HANDS;
+  if (sim.getSwordTier() > 0)
+    in.attackSword = true;
+  else
+    in.attackHands = true;
+  meleeReadyTick =
+      sim.getTick() + static_cast<std::uint64_t>(cd * FixedTimestep::TICK_HZ);
+}
+
+bool AutoPlayer::attackAdjacent(const GameSim &sim, TickInput &in) {
+  const int px = sim.getPlayerX(), py = sim.getPlayerY();
+  if (adjacentEnemies(sim, px, py) == 0)
+    return false;
+
+  // Con el arma recargando, un paso atrás: el enemigo tiene que volver a
+  // acercarse antes de poder golpear
+  if (sim.getTick() < meleeReadyTick) {
+    retreat(sim, in);
+    return true;
+  }
+
+  // Primero el que ya tiene delante: no hace falta girarse
+  if (!enemyAt(sim, px + faceX, py + faceY)) {
+    for (const auto &d : DIRS) {
+      if (enemyAt(sim, px + d[0], py + d[1])) {
+        // La casilla está ocupada: el paso solo gira, y el golpe del mismo
+        // tick ya sale en esa dirección
+        face(d[0], d[1], in);
+        break;
+      }
+    }
+  }
+  meleeAttack(sim, in);
+  return true;
+}
+
+int AutoPlayer::adjacentEnemies(const GameSim &sim, int x, int y) const {
+  int n = 0;
+  for (const auto &d : DIRS)
+    n += enemyAt(sim, x + d[0], y + d[1]) ? 1 : 0;
+  return n;
+}
+
+void AutoPlayer::retreat(const GameSim &sim, TickInput &in) {
+  const int px = sim.getPlayerX(), py = sim.getPlayerY();
+  int best = adjacentEnemies(sim, px, py);
+  int bx = 0, by = 0;
+  for (const auto &d : DIRS) {
+    const int x = px + d[0], y = py + d[1];
+    if (!sim.getMap().isWalkable(x, y) || enemyAt(sim, x, y))
+      continue;
+    const int n = adjacentEnemies(sim, x, y);
+    if (n < best) {
+      best = n;
+      bx = d[0];
+      by = d[1];
+    }
+  }
+  if (bx != 0 || by != 0)
+    face(bx, by, in);
+}
+
+bool AutoPlayer::shootInLine(const GameSim &sim, TickInput &in) {
+  if (sim.getPlasmaTier() <= 0)
+    return false;
+  const int px = sim.getPlayerX(), py = sim.getPlayerY();
+  const int range = static_cast<int>(PLASMA_RANGE_TILES);
+  for (const Enemy &e : sim.getEnemies()) {
+    const int dx = e.getX() - px, dy = e.getY() - py;
+    if ((dx != 0 && dy != 0) || std::abs(dx) + std::abs(dy) > range)
+      continue;
+    if (!sim.getMap().isVisible(e.getX(), e.getY()) ||
+        !clearLine(sim, px, py, e.getX(), e.getY()))
+      continue;
+    if (faceX == sign(dx) && faceY == sign(dy))
+      in.attackPlasma = true;
+    else
+      face(sign(dx), sign(dy), in); // Girarse (o acercarse un paso)
+    return true;
+  }
+  return false;
+}
+
+void AutoPlayer::fightBoss(const GameSim &sim, TickInput &in) {
+  const Boss &b = sim.getBoss();
+  const int px = sim.getPlayerX(), py = sim.getPlayerY();
+  const int dx = b.x - px, dy = b.y - py;
+  const int adx = std::abs(dx), ady = std::abs(dy);
+
+  // De lejos, a tiro y alineado con su cuerpo (3x3): plasma
+  const int range = static_cast<int>(PLASMA_RANGE_TILES);
+  if (sim.getPlasmaTier() > 0 && (adx <= 1 || ady <= 1) && adx + ady > 2 &&
+      std::max(adx, ady) - 1 <= range) {
+    const int fx = adx <= 1 ? 0 : sign(dx);
+    const int fy = adx <= 1 ? sign(dy) : 0;
+    if (faceX == fx && faceY == fy)
+      in.attackPlasma = true;
+    else
+      face(fx, fy, in);
+    return;
+  }
+
+  // Cuerpo a cuerpo: la casilla de delante tiene que tocar su cuerpo
+  if (adx <= 2 && ady <= 2) {
+    const int fx = adx >= ady ? sign(dx) : 0;
+    const int fy = adx >= ady ? 0 : sign(dy);
+    if (std::abs(px + fx - b.x) <= 1 && std::abs(py + fy - b.y) <= 1) {
+      if (faceX != fx || faceY != fy)
+        face(fx, fy, in);
+      meleeAttack(sim, in);
+      return;
+    }
+  }
+  stepToward(sim, b.x, b.y, in);
+}
+
+bool AutoPlayer::pickTarget(const GameSim &sim, int &tx, int &ty) {
+  const Map &map = sim.getMap();
+  const NavGraph &nav = map.nav();
+  const int px = sim.getPlayerX(), py = sim.getPlayerY();
+
+  // 1. Un objeto a la vista y a poca distancia
+  int bestD = ITEM_DETOUR + 1;
+  for (const ItemSpawn &it : sim.getItems()) {
+    if (it.type == ItemType::LlaveMaestra ||
+        !map.isDiscovered(it.tile.x, it.tile.y))
+      continue;
+    if (std::abs(it.tile.x - px) + std::abs(it.tile.y - py) >= bestD)
+      continue;
+    const int d = nav.distance(px, py, it.tile.x, it.tile.y);
+    if (d > 0 && d < bestD) {
+      bestD = d;
+      tx = it.tile.x;
+      ty = it.tile.y;
+    }
+  }
+  if (bestD <= ITEM_DETOUR) {
+    current = Goal::Item;
+    return true;
+  }
+
+  // 2. La llave, si ya la ha visto; con ella, la salida
+  const ItemSpawn *key = nullptr;
+  for (const ItemSpawn &it : sim.getItems())
+    if (it.type == ItemType::LlaveMaestra)
+      key = &it;
+  if (!sim.hasKeycard() && key && map.isDiscovered(key->tile.x, key->tile.y)) {
+    tx = key->tile.x;
+    ty = key->tile.y;
+    current = Goal::Key;
+    return true;
+  }
+  if (sim.hasKeycard() && map.isDiscovered(exitX, exitY)) {
+    tx = exitX;
+    ty = exitY;
+    current = Goal::Exit;
+    return true;
+  }
+
+  // 3. Explorar: la sala sin descubrir más cercana
+  if (exploreX < 0 || map.isDiscovered(exploreX, exploreY)) {
+    exploreX = exploreY = -1;
+    int best = INT_MAX;
+    for (const Room &r : map.rooms()) {
+      const int cx = r.x + r.w / 2, cy = r.y + r.h / 2;
+      const int d = std::abs(cx - px) + std::abs(cy - py);
+      if (map.isWalkable(cx, cy) && !map.isDiscovered(cx, cy) && d < best) {
+        best = d;
+        exploreX = cx;
+        exploreY = cy;
+      }
+    }
+  }
+  if (exploreX >= 0) {
+    tx = exploreX;
+    ty = exploreY;
+    current = Goal::Explore;
+    return true;
+  }
+
+  // 4. Todo visto y aún sin llave o sin salida a la vista: ir a por ellas
+  if (!sim.hasKeycard() && key) {
+    tx = key->tile.x;
+    ty = key->tile.y;
+    current = Goal::Key;
+    return true;
+  }
+  tx = exitX;
+  ty = exitY;
+  current = Goal::Exit;
+  return true;
+}
+
+void AutoPlayer::stepToward(const GameSim &sim, int tx, int ty,
+                            TickInput &in) {
+  const int px = sim.getPlayerX(), py = sim.getPlayerY();
+  if (px == tx && py == ty)
+    return;
+  const auto step = sim.getMap().nav().nextStep(px, py, tx, ty);
+  int dx = step.first - px, dy = step.second - py;
+  if (dx == 0 && dy == 0) {
+    // Sin camino en el grafo: en línea recta por el eje más largo
+    if (std::abs(tx - px) >= std::abs(ty - py))
+      dx = sign(tx - px);
+    else
+      dy = sign(ty - py);
+  }
+  face(dx, dy, in);
+}
@@ -0,0 +1,71 @@
+#ifndef AUTO_PLAYER_HPP
+#define AUTO_PLAYER_HPP
+
+#include "GameSim.hpp"
+#include "RngStream.hpp"
+#include "TickInput.hpp"
+#include <cstdint>
+
+// Jugador automático
+// Juega una partida de GameSim con las mismas consultas que usa el HUD
+// (mapa, niebla, enemigos, objetos, boss) y devuelve un TickInput por tick,
+// igual que el teclado. Explora las salas que aún no ha visto, recoge lo que
+// encuentra por el camino, pelea con el arma que tenga (puños, espada,
+// plasma; golpea y se aparta mientras recarga), coge la llave y va a la
+// salida; en el nivel 4 se enfrenta al
+// boss. No es un buen jugador: es una carga de trabajo realista y repetible
+// para tests de resistencia, equilibrado y benchmarks sin ventana.
+//
+// Clave de diseño: decide a ritmo humano. Solo piensa cada ACTION_TICKS
+// ticks (unas 10 acciones por segundo, en modo paso a paso) y entre medias
+// no pulsa nada, así que una partida del bot dura lo que la de una persona
+// y las métricas de tiempo (ticks por nivel, tiempo hasta la llave) son
+// comparables. Lo aleatorio (desatascarse) sale de su propio RngStream: la
+// misma semilla da la misma partida.
+class AutoPlayer {
+public:
+  static constexpr int ACTION_TICKS = 6;
+  static constexpr int ITEM_DETOUR = 8;   // Desvío máximo (pasos) por un objeto
+  static constexpr int STUCK_ACTIONS = 25; // Sin moverse: paso al azar
+
+  // Lo que está haciendo (para informes y depuración)
+  enum class Goal { Explore, Item, Key, Exit, Fight, Boss, Unstick };
+
+  explicit AutoPlayer(std::uint64_t seed = 1) : rng(seed, RngStream::Bot) {}
+
+  // Entrada para el siguiente tick de 'sim'
+  TickInput next(const GameSim &sim);
+
+  Goal goal() const { return current; }
+
+private:
+  TickInput decide(const GameSim &sim);
+  bool attackAdjacent(const GameSim &sim, TickInput &in);
+  bool shootInLine(const GameSim &sim, TickInput &in);
+  void fightBoss(const GameSim &sim, TickInput &in);
+  bool pickTarget(const GameSim &sim, int &tx, int &ty);
+  void stepToward(const GameSim &sim, int tx, int ty, TickInput &in);
+  void face(int dx, int dy, TickInput &in);
+  void meleeAttack(const GameSim &sim, TickInput &in);
+  int adjacentEnemies(const GameSim &sim, int x, int y) const;
+  void retreat(const GameSim &sim, TickInput &in);
+
+  RngStream rng;
+  int wait = 0;         // Ticks hasta la siguiente decisión
+  int faceX = 0, faceY = 1; // Última dirección pedida (la mirada del jugador)
+  Goal current = Goal::Explore;
+  std::uint64_t meleeReadyTick = 0; // Cuándo vuelve a estar lista el arma
+
+  // Memoria por nivel
+  int level = 0;
+  int exitX = 0, exitY = 0;
+  int exploreX = -1, exploreY = -1; // Sala elegida para explorar
+
+  // Atascos
+  int lastX = -1, lastY = -1;
+  int stillActions = 0;
+  int unstickActions = 0;
+  int unstickX = 0, unstickY = 0;
+};
+
+#endif
@@ -0,0 +1,362 @@
+#include "BossPlanner.hpp"
+#include "BulletPatterns.hpp"
+#include "SweptCollision.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+constexpr float PI_F = 3.14159265358979323846f;
+constexpr float DEG2RAD_F = PI_F / 180.0f;
+constexpr float RANGE_TILES = 30.0f;  // ~1000 px de alcance de bala
+constexpr float BULLET_TILES = 0.15f; // Radio de bala en casillas
+constexpr float STEP_DISCOUNT = 0.85f;
+constexpr float ATTACK_WEIGHT = 2.0f;
+constexpr float RANGE_WEIGHT = 0.25f;
+constexpr int DODGE_RADIUS = 2; // Casillas de esquiva alrededor de la predicción
+constexpr int MOVES[5][2] = {{0, 0}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+double nowMs() {
+  using namespace std::chrono;
+  return duration<double, std::milli>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
+float angleDiff(float a, float b) {
+  float d = std::fmod(std::fabs(a - b), 2.0f * PI_F);
+  return d > PI_F ? 2.0f * PI_F - d : d;
+}
+
+// Carriles de un ataque: ángulos fijos (anillos, espirales), desvíos sobre
+// la puntería (abanicos) y si lleva explosión retardada
+struct AttackLanes {
+  std::vector<float> fixed;
+  std::vector<float> aimed;
+  bool burst = false;
+};
+
+std::vector<AttackLanes> lanesFor(int phase) {
+  std::vector<AttackLanes> out;
+  for (const BulletAttack &attack : BulletPatternEngine::bossAttacks(phase)) {
+    if ((int)out.size() == BossPlanner::MAX_ATTACKS)
+      break;
+    AttackLanes l;
+    for (const BulletPattern &p : attack) {
+      switch (p.kind) {
+      case BulletPattern::Ring:
+      case BulletPattern::Spiral:
+        for (int v = 0; v < p.volleys; ++v)
+          for (int k = 0; k < p.bullets; ++k)
+            l.fixed.push_back(p.spin * DEG2RAD_F * v + 2.0f * PI_F * k / p.bullets);
+        break;
+      case BulletPattern::AimedFan:
+        for (int k = 0; k < p.bullets; ++k)
+          l.aimed.push_back(p.bullets > 1
+                                ? (-0.5f * p.spread + p.spread * k / (p.bullets - 1)) *
+                                      DEG2RAD_F
+                                : 0.0f);
+        break;
+      case BulletPattern::DelayedBurst:
+        l.burst = true;
+        break;
+      }
+    }
+    // Normalizados a [-pi, pi) y ordenados: búsqueda binaria por casilla
+    for (float &f : l.fixed)
+      f = std::remainder(f, 2.0f * PI_F);
+    std::sort(l.fixed.begin(), l.fixed.end());
+    out.push_back(std::move(l));
+  }
+  return out;
+}
+
+// ¿Algún carril fijo (ordenado) a menos de 'half' del ángulo 'ang'?
+bool nearFixedLane(const std::vector<float> &lanes, float ang, float half) {
+  if (lanes.empty())
+    return false;
+  const auto it = std::lower_bound(lanes.begin(), lanes.end(), ang);
+  // Vecinos a ambos lados (con la vuelta de -pi a pi)
+  const float after = it == lanes.end() ? lanes.front() : *it;
+  const float before = it == lanes.begin() ? lanes.back() : *(it - 1);
+  return angleDiff(after, ang) < half || angleDiff(before, ang) < half;
+}
+
+struct Search {
+  const BossPlanner::Arena &a;
+  std::vector<AttackLanes> attacks;
+  int preferred = 4; // Distancia (Chebyshev) que le gusta mantener
+
+  // Predicción del jugador k pasos del boss más adelante
+  std::array<int, 2 * (BossPlanner::MAX_DEPTH + 1)> predicted{};
+
+  // Memo (casilla, paso) -> puntuación y mejor ataque
+  std::vector<float> memoScore;
+  std::vector<signed char> memoAttack;
+  std::vector<std::uint8_t> memoDone;
+
+  std::array<float, BossPlanner::MAX_DEPTH + 1> discount{}; // STEP_DISCOUNT^k
+
+  std::size_t maxNodes = 0;
+  bool exhausted = false;
+  std::size_t nodes = 0;
+
+  explicit Search(const BossPlanner::Arena &arena) : a(arena) {
+    attacks = lanesFor(a.phase);
+    discount[0] = 1.0f;
+    for (int k = 1; k <= BossPlanner::MAX_DEPTH; ++k)
+      discount[k] = discount[k - 1] * STEP_DISCOUNT;
+    preferred = a.phase <= 2 ? 5 : (a.phase == 3 ? 3 : 1);
+
+    // El jugador sigue en la dirección de su último paso hasta chocar
+    int x = a.playerX, y = a.playerY;
+    for (int k = 0; k <= BossPlanner::MAX_DEPTH; ++k) {
+      predicted[2 * k] = x;
+      predicted[2 * k + 1] = y;
+      if (a.isWalkable(x + a.playerDx, y + a.playerDy)) {
+        x += a.playerDx;
+        y += a.playerDy;
+      }
+    }
+
+    const std::size_t cells = BossPlanner::WINDOW * BossPlanner::WINDOW *
+                              (BossPlanner::MAX_DEPTH + 1);
+    memoScore.assign(cells, 0.0f);
+    memoAttack.assign(cells, -1);
+    memoDone.assign(cells, 0);
+  }
+
+  bool lineOfSight(int x0, int y0, int x1, int y1) const {
+    const float t = rb::traverseTiles(
+        x0 + 0.5f, y0 + 0.5f, x1 + 0.5f, y1 + 0.5f, 1.0f,
+        [&](int tx, int ty, float) { return !a.isWalkable(tx, ty); });
+    return t < 0.0f;
+  }
+
+  // Fracción (ponderada) de las casillas de esquiva que cubre cada ataque
+  // disparado desde (bx, by) con el jugador previsto en (px, py)
+  float coverage(const AttackLanes &l, int bx, int by, int px, int py) const {
+    const float aim = std::atan2((float)(py - by), (float)(px - bx));
+    float hit = 0.0f, total = 0.0f;
+    for (int dy = -DODGE_RADIUS; dy <= DODGE_RADIUS; ++dy) {
+      for (int dx = -DODGE_RADIUS; dx <= DODGE_RADIUS; ++dx) {
+        const int md = std::abs(dx) + std::abs(dy);
+        const int tx = px + dx, ty = py + dy;
+        if (md > DODGE_RADIUS || !a.isWalkable(tx, ty))
+          continue;
+        // Lo más probable: quedarse cerca de la predicción
+        const float w = 1.0f / (1.0f + md);
+        total += w;
+
+        const float ex = (float)(tx - bx), ey = (float)(ty - by);
+        const float dist = std::sqrt(ex * ex + ey * ey);
+        if (dist > RANGE_TILES || (tx == bx && ty == by))
+          continue;
+        if (l.burst && md == 0) { // Estalla donde está: cubre su casilla
+          hit += w;
+          continue;
+        }
+        const float half = std::atan2(0.5f + BULLET_TILES, dist);
+        const float ang = std::atan2(ey, ex);
+        bool lane = nearFixedLane(l.fixed, ang, half);
+        if (!lane)
+          for (float o : l.aimed)
+            if (angleDiff(aim + o, ang) < half) { lane = true; break; }
+        if (lane && lineOfSight(bx, by, tx, ty))
+          hit += w;
+      }
+    }
+    return total > 0.0f ? hit / total : 0.0f;
+  }
+
+  // Lo que vale que el boss esté en (x, y) en el paso k
+  float stepScore(int x, int y, int k, int *bestAttack) {
+    const int lx = x - a.originX, ly = y - a.originY;
+    const std::size_t idx =
+        ((std::size_t)k * BossPlanner::WINDOW + ly) * BossPlanner::WINDOW + lx;
+    if (!memoDone[idx]) {
+      const int px = predicted[2 * k], py = predicted[2 * k + 1];
+      float best = 0.0f;
+      int arg = -1;
+      for (std::size_t i = 0; i < attacks.size(); ++i) {
+        const float c = coverage(attacks[i], x, y, px, py);
+        if (c > best) {
+          best = c;
+          arg = (int)i;
+        }
+      }
+      const int cheb = std::max(std::abs(px - x), std::abs(py - y));
+      memoScore[idx] =
+          ATTACK_WEIGHT * best - RANGE_WEIGHT * std::abs(cheb - preferred);
+      memoAttack[idx] = (signed char)arg;
+      memoDone[idx] = 1;
+    }
+    if (bestAttack)
+      *bestAttack = memoAttack[idx];
+    return memoScore[idx];
+  }
+
+  // Mejor suma descontada de 'left' pasos más desde (x, y) en el paso k
+  float dfs(int x, int y, int k, int left) {
+    if (left == 0)
+      return 0.0f;
+    if (exhausted || ++nodes > maxNodes) {
+      exhausted = true;
+      return 0.0f;
+    }
+
+    float best = -1e9f;
+    for (const auto &m : MOVES) {
+      const int nx = x + m[0], ny = y + m[1];
+      if (!a.isWalkable(nx, ny))
+        continue;
+      if (nx == predicted[2 * (k + 1)] && ny == predicted[2 * (k + 1) + 1])
+        continue; // No pisar al jugador
+      const float v = discount[k] * stepScore(nx, ny, k + 1, nullptr) +
+                      dfs(nx, ny, k + 1, left - 1);
+      best = std::max(best, v);
+    }
+    return best > -1e9f ? best : 0.0f;
+  }
+};
+} // namespace
+
+BossPlanner::Decision BossPlanner::plan(const Arena &arena,
+                                       std::size_t maxNodes) {
+  const double t0 = nowMs();
+  Decision d;
+  d.request = arena.request;
+  d.phase = arena.phase;
+  // Jugador fuera de la ventana: sin plan (decide la persecución normal)
+  if (!arena.inside(arena.playerX, arena.playerY) ||
+      !arena.inside(arena.bossX, arena.bossY))
+    return d;
+
+  Search s(arena);
+  s.maxNodes = maxNodes;
+
+  // Profundización iterativa: solo vale una profundidad completa
+  for (int depth = 1; depth <= MAX_DEPTH; ++depth) {
+    float best = -1e9f;
+    int bdx = 0, bdy = 0, battack = -1;
+    for (const auto &m : MOVES) {
+      const int nx = arena.bossX + m[0], ny = arena.bossY + m[1];
+      if (!arena.isWalkable(nx, ny))
+        continue;
+      if (nx == s.predicted[2] && ny == s.predicted[3])
+        continue;
+      int attack = -1;
+      const float v = s.stepScore(nx, ny, 1, &attack) +
+                      s.dfs(nx, ny, 1, depth - 1);
+      if (v > best) {
+        best = v;
+        bdx = m[0];
+        bdy = m[1];
+        battack = attack;
+      }
+    }
+    if (s.exhausted)
+      break;
+    if (best > -1e9f) {
+      d.valid = true;
+      d.dx = bdx;
+      d.dy = bdy;
+      d.attack = battack;
+      d.score = best;
+      d.depth = depth;
+    }
+  }
+  d.nodes = s.nodes;
+  d.ms = nowMs() - t0;
+  return d;
+}
+
+BossPlanner::BossPlanner(std::size_t nodeBudget) : budget(nodeBudget) {}
+
+BossPlanner::~BossPlanner() {
+#if !defined(__EMSCRIPTEN__)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopping = true;
+  }
+  cv.notify_one();
+  if (worker.joinable())
+    worker.join();
+#endif
+}
+
+std::uint64_t BossPlanner::submit(const Arena &arena) {
+  waiting = true;
+#if !defined(__EMSCRIPTEN__)
+  if (threaded) {
+    // El hilo nace con el primer encargo: fuera del nivel del boss no hay
+    if (!worker.joinable())
+      worker = std::thread([this] { workerLoop(); });
+    std::uint64_t id;
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      job = arena;
+      job.request = id = nextRequest++;
+      hasJob = true;
+      hasResult = false;
+    }
+    cv.notify_one();
+    return id;
+  }
+#endif
+  // En línea: la decisión queda lista para wait()
+  Arena a = arena;
+  a.request = nextRequest++;
+  result = plan(a, budget);
+  hasResult = true;
+  return a.request;
+}
+
+bool BossPlanner::wait(Decision &out) {
+  if (!waiting)
+    return false;
+#if !defined(__EMSCRIPTEN__)
+  // Solo vale la respuesta al último encargo; una anterior que el hilo
+  // publique mientras tanto se ignora
+  std::unique_lock<std::mutex> lock(mtx);
+  const std::uint64_t want = nextRequest - 1;
+  published.wait(lock,
+                 [&] { return hasResult && result.request == want; });
+#endif
+  waiting = false;
+  hasResult = false;
+  last = result;
+  out = result;
+  return true;
+}
+
+void BossPlanner::reset() {
+#if !defined(__EMSCRIPTEN__)
+  std::lock_guard<std::mutex> lock(mtx);
+#endif
+  hasJob = false;
+  hasResult = false;
+  waiting = false;
+  last = Decision{};
+}
+
+void BossPlanner::workerLoop() {
+  std::unique_lock<std::mutex> lock(mtx);
+  for (;;) {
+    cv.wait(lock, [this] { return stopping || hasJob; });
+    if (stopping)
+      return;
+    const Arena a = job;
+    hasJob = false;
+    const std::size_t nodes = budget;
+
+    lock.unlock();
+    const Decision d = plan(a, nodes);
+    lock.lock();
+
+    result = d;
+    hasResult = true;
+    published.notify_all();
+  }
+}
@@ -0,0 +1,144 @@
+#ifndef BOSS_PLANNER_HPP
+#define BOSS_PLANNER_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Planificador del boss (búsqueda con presupuesto de nodos)
+// En cada paso del boss, Game le pasa una foto de la arena (ventana del mapa
+// alrededor del boss, posiciones, último paso del jugador, fase). El
+// planificador prueba secuencias de pasos del boss contra una predicción de
+// hacia dónde esquivará el jugador y puntúa cada posición de la secuencia
+// por la distancia que prefiere la fase y por qué ataque de la fase cubre
+// más casillas de esquiva con carriles de bala libres de muros. La decisión
+// (siguiente paso + ataque) es para el siguiente turno del boss.
+//
+// Determinista: la búsqueda es "anytime" por profundidad creciente (1, 2,
+// ... MAX_DEPTH pasos) y se queda con la última profundidad completada
+// antes de agotar un presupuesto de NODOS, no de tiempo; la misma foto da
+// siempre la misma decisión, en cualquier máquina y con cualquier carga.
+// El encargo se hace en un turno del boss y se recoge con wait() en el
+// siguiente turno que la necesite: si aún no está, se espera. Así la
+// partida no depende de cuándo termine el hilo y las repeticiones, el
+// bot y las fotos del estado valen también en el nivel del boss.
+//
+// Por defecto la búsqueda corre dentro de submit() (simulación sin
+// ventana: bot, tests, herramientas). Con setThreaded(true) corre en un
+// hilo propio, que se crea en el primer encargo (solo el nivel del boss lo
+// paga): entre dos turnos del boss hay de sobra para terminarla y wait()
+// casi nunca espera. Sin hilos (web) siempre en línea, en el hilo
+// principal: por eso allí el presupuesto por defecto es WEB_NODE_BUDGET,
+// que llega a profundidad 4 en menos de medio milisegundo nativo. Sigue
+// siendo fijo (determinista), pero la web decide distinto que el
+// escritorio: una grabación solo se reproduce igual en el mismo tipo de
+// build.
+class BossPlanner {
+public:
+  static constexpr int WINDOW = 31; // Lado de la ventana (casillas, impar)
+  static constexpr int MAX_DEPTH = 6; // Pasos del boss que mira por delante
+  static constexpr int MAX_ATTACKS = 8; // Ataques por fase que se evalúan
+  // Nodos por decisión: la profundidad completa en sala abierta ronda 5000
+  static constexpr std::size_t FULL_NODE_BUDGET = 8192;
+  static constexpr std::size_t WEB_NODE_BUDGET = 256; // Profundidad 4
+#if defined(__EMSCRIPTEN__)
+  static constexpr std::size_t DEFAULT_NODE_BUDGET = WEB_NODE_BUDGET;
+#else
+  static constexpr std::size_t DEFAULT_NODE_BUDGET = FULL_NODE_BUDGET;
+#endif
+
+  // Foto de la arena: todo lo que la búsqueda puede leer
+  struct Arena {
+    int originX = 0, originY = 0; // Casilla del mapa en la esquina (0, 0)
+    std::array<std::uint8_t, WINDOW * WINDOW> walkable{};
+    int bossX = 0, bossY = 0;     // Coordenadas de mapa
+    int playerX = 0, playerY = 0;
+    int playerDx = 0, playerDy = 0; // Último paso del jugador
+    int phase = 1;
+    std::uint64_t request = 0; // Lo pone submit(); vuelve en la decisión
+
+    bool inside(int x, int y) const {
+      const int lx = x - originX, ly = y - originY;
+      return lx >= 0 && ly >= 0 && lx < WINDOW && ly < WINDOW;
+    }
+    bool isWalkable(int x, int y) const {
+      return inside(x, y) &&
+             walkable[(y - originY) * WINDOW + (x - originX)] != 0;
+    }
+  };
+
+  struct Decision {
+    bool valid = false;     // false: que decida la lógica de siempre
+    int dx = 0, dy = 0;     // Siguiente paso del boss
+    int attack = -1;        // Índice en bossAttacks(fase); -1 = el de turno
+    int phase = 0;          // Fase para la que se eligió 'attack'
+    float score = 0.0f;
+    int depth = 0;          // Profundidad completada
+    std::size_t nodes = 0;  // Nodos evaluados
+    double ms = 0.0;        // Tiempo de búsqueda (solo para medir)
+    std::uint64_t request = 0;
+  };
+
+  explicit BossPlanner(std::size_t nodeBudget = DEFAULT_NODE_BUDGET);
+  ~BossPlanner();
+  BossPlanner(const BossPlanner &) = delete;
+  BossPlanner &operator=(const BossPlanner &) = delete;
+
+  // Búsqueda en otro hilo (ver arriba); sin efecto en la web
+  void setThreaded(bool enable) { threaded = enable; }
+  bool isThreaded() const { return threaded; }
+
+  // Encarga una decisión (sustituye a la pendiente si aún no se recogió).
+  // Devuelve el número de encargo, que vuelve en Decision::request.
+  std::uint64_t submit(const Arena &arena);
+  // Decisión del último encargo; si el hilo no ha terminado, la espera.
+  // false si no hay encargo pendiente (ya recogido o tras reset()).
+  bool wait(Decision &out);
+  bool pending() const { return waiting; }
+  // Olvida encargos y decisiones (cambio de nivel, muerte del boss)
+  void reset();
+
+  std::size_t nodeBudget() const { return budget; }
+  const Decision &lastDecision() const { return last; } // La última de wait()
+
+  // La búsqueda en sí, síncrona (la usa el hilo; también los tests)
+  static Decision plan(const Arena &arena, std::size_t maxNodes);
+
+  // Rellena 'out' con la ventana WINDOW x WINDOW centrada en (cx, cy)
+  template <class IsWalkable>
+  static void captureWindow(int cx, int cy, IsWalkable &&isWalkable,
+                            Arena &out) {
+    out.originX = cx - WINDOW / 2;
+    out.originY = cy - WINDOW / 2;
+    for (int y = 0; y < WINDOW; ++y)
+      for (int x = 0; x < WINDOW; ++x)
+        out.walkable[y * WINDOW + x] =
+            isWalkable(out.originX + x, out.originY + y) ? 1 : 0;
+  }
+
+private:
+  void workerLoop();
+
+  std::size_t budget;
+  bool threaded = false;
+  std::uint64_t nextRequest = 1;
+  bool waiting = false; // Hay un encargo sin recoger
+  Decision last;
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::condition_variable published; // Para wait()
+  bool hasJob = false;
+  bool hasResult = false;
+  bool stopping = false;
+  Arena job;
+  Decision result;
+#if !defined(__EMSCRIPTEN__)
+  std::thread worker;
+#endif
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include "BotRun.hpp"
+#include "AutoPlayer.hpp"
+#include "FrameProfiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+namespace {
+// Lo que no puede pasar nunca tras un tick; vacío si todo cuadra
+std::string checkInvariants(const GameSim &sim) {
+  if (sim.getState() != GameState::Playing)
+    return {};
+  if (!sim.getMap().isWalkable(sim.getPlayerX(), sim.getPlayerY()))
+    return "jugador fuera del suelo (" + std::to_string(sim.getPlayerX()) +
+           ", " + std::to_string(sim.getPlayerY()) + ")";
+  if (sim.getHP() > sim.getHPMax() || sim.getHPMax() <= 0)
+    return "vida imposible " + std::to_string(sim.getHP()) + "/" +
+           std::to_string(sim.getHPMax());
+  return {};
+}
+
+// Objetos de cada tipo que hay ahora en el nivel
+std::array<int, BotLevelStats::ITEM_TYPES> countItems(const GameSim &sim) {
+  std::array<int, BotLevelStats::ITEM_TYPES> n{};
+  for (const ItemSpawn &it : sim.getItems())
+    n[static_cast<int>(it.type)]++;
+  return n;
+}
+} // namespace
+
+const char *outcomeName(BotRunResult::Outcome o) {
+  switch (o) {
+  case BotRunResult::Outcome::Victory:
+    return "victoria";
+  case BotRunResult::Outcome::Defeat:
+    return "derrota";
+  case BotRunResult::Outcome::Stuck:
+    return "atascada";
+  case BotRunResult::Outcome::Crash:
+    return "rota";
+  }
+  return "?";
+}
+
+BotRunResult playBotRun(const RunSetup &setup, const BotRunLimits &limits) {
+  BotRunResult r;
+  r.setup = setup;
+  const double t0 = FrameProfiler::clockMs();
+  try {
+    GameSim sim;
+    sim.startRun(setup);
+    AutoPlayer bot(setup.seed);
+    if (limits.record)
+      r.recording.begin(sim.getRunSetup());
+
+    // Lo que se vio en el tick anterior: las diferencias son el daño y los
+    // objetos recogidos
+    int level = sim.getCurrentLevel();
+    std::uint64_t levelStart = 0;
+    int hp = sim.getHP();
+    bool hadKey = sim.hasKeycard();
+    std::size_t itemCount = sim.getItems().size();
+    std::array<int, BotLevelStats::ITEM_TYPES> items = countItems(sim);
+    r.levels.emplace_back();
+    r.levels.back().itemsSpawned = items;
+
+    while (sim.getState() == GameState::Playing) {
+      const TickInput in = bot.next(sim);
+      if (limits.record)
+        r.recording.push(in);
+
+      // Tiempo de CPU del hilo: con más partidas que núcleos, el reloj de
+      // pared cuenta también las esperas a que le toque
+      const double tickStart = FrameProfiler::threadCpuMs();
+      sim.step(in);
+      const double tickMs = FrameProfiler::threadCpuMs() - tickStart;
+      if (tickMs > r.worstTickMs) {
+        r.worstTickMs = tickMs;
+        r.worstTick = sim.getTick();
+        r.worstTickLevel = sim.getCurrentLevel();
+      }
+      if (limits.record)
+        r.recording.markTick(sim);
+
+      BotLevelStats *lv = &r.levels.back();
+      if (sim.getCurrentLevel() != level) {
+        lv->ticks = sim.getTick() - levelStart;
+        levelStart = sim.getTick();
+        level = sim.getCurrentLevel();
+        items = countItems(sim);
+        itemCount = sim.getItems().size();
+        r.levels.emplace_back();
+        lv = &r.levels.back();
+        lv->itemsSpawned = items;
+      } else if (sim.getItems().size() != itemCount) {
+        // Recogidos (o soltados a mitad de nivel): diferencia por tipo
+        const auto now = countItems(sim);
+        for (int t = 0; t < BotLevelStats::ITEM_TYPES; ++t) {
+          lv->itemsPicked[t] += std::max(0, items[t] - now[t]);
+          lv->itemsSpawned[t] += std::max(0, now[t] - items[t]);
+        }
+        items = now;
+        itemCount = sim.getItems().size();
+      }
+      if (sim.getHP() < hp)
+        lv->damage += hp - sim.getHP();
+      hp = sim.getHP();
+      if (sim.hasKeycard() && !hadKey)
+        lv->keyTicks = static_cast<std::int64_t>(sim.getTick() - levelStart);
+      hadKey = sim.hasKeycard();
+
+      const std::string broken = checkInvariants(sim);
+      if (!broken.empty()) {
+        r.outcome = BotRunResult::Outcome::Crash;
+        r.error = broken;
+        break;
+      }
+      if (sim.getTick() >= limits.maxTicks ||
+          sim.getTick() - levelStart >= limits.maxLevelTicks) {
+        r.outcome = BotRunResult::Outcome::Stuck;
+        r.error = "nivel " + std::to_string(level) + " en (" +
+                  std::to_string(sim.getPlayerX()) + ", " +
+                  std::to_string(sim.getPlayerY()) + ")";
+        break;
+      }
+    }
+
+    if (sim.getState() == GameState::Victory)
+      r.outcome = BotRunResult::Outcome::Victory;
+    else if (sim.getState() == GameState::GameOver)
+      r.outcome = BotRunResult::Outcome::Defeat;
+    r.levels.back().ticks = sim.getTick() - levelStart; // El último nivel
+    r.ticks = sim.getTick();
+    r.levelReached = sim.getCurrentLevel();
+  } catch (const std::exception &e) {
+    r.outcome = BotRunResult::Outcome::Crash;
+    r.error = e.what();
+  } catch (...) {
+    r.outcome = BotRunResult::Outcome::Crash;
+    r.error = "excepción desconocida";
+  }
+  r.ms = FrameProfiler::clockMs() - t0;
+  return r;
+}
+
+void runParallel(std::size_t count, unsigned threads,
+                 const std::function<void(std::size_t)> &job) {
+#if defined(__EMSCRIPTEN__)
+  (void)threads;
+  for (std::size_t i = 0; i < count; ++i)
+    job(i);
+#else
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned>(
+      std::min<std::size_t>(threads, std::max<std::size_t>(count, 1)));
+
+  std::atomic<std::size_t> nextJob{0};
+  auto worker = [&]() {
+    for (std::size_t i = nextJob++; i < count; i = nextJob++)
+      job(i);
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned t = 1; t < threads; ++t)
+    pool.emplace_back(worker);
+  worker(); // El hilo que llama también trabaja
+  for (std::thread &th : pool)
+    th.join();
+#endif
+}
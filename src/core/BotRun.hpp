@@ -0,0 +1,85 @@
+#ifndef BOT_RUN_HPP
+#define BOT_RUN_HPP
+
+#include "FixedTimestep.hpp"
+#include "GameSim.hpp"
+#include "InputRecording.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Partidas del jugador automático sin ventana
+// playBotRun() juega una partida completa de GameSim con un AutoPlayer y
+// devuelve cómo acabó (victoria, derrota, atascada o rota), cómo se jugó
+// cada nivel (ticks, daño recibido, tiempo hasta la llave, objetos que
+// aparecieron y que recogió) y cuánto costó: tiempo total y el tick más
+// lento. Una partida "rota" es una excepción dentro de step() o un
+// invariante que no se cumple tras un tick (jugador fuera del suelo, vida
+// imposible); un fallo de memoria de verdad tumba el proceso y lo tiene que
+// contar quien lanza las partidas.
+// runParallel() reparte N trabajos entre hilos: es lo que usan las
+// herramientas de resistencia (roguebot_soak) y de equilibrado
+// (roguebot_balance) y los tests.
+//
+// Clave de diseño: cada partida es dueña de todo lo que toca (su GameSim,
+// su mapa y su grafo de navegación, su AutoPlayer), así que las partidas
+// corren en paralelo sin cerrojos. El reparto es dinámico (un contador
+// atómico): las partidas largas no dejan hilos parados esperando.
+struct BotRunLimits {
+  // Tope de la partida entera (20 minutos de juego)
+  std::uint64_t maxTicks = 20ull * 60 * FixedTimestep::TICK_HZ;
+  // Tope por nivel: sin cambiar de nivel en 6 minutos, atascada
+  std::uint64_t maxLevelTicks = 6ull * 60 * FixedTimestep::TICK_HZ;
+  bool record = false; // Guardar la entrada (para repetir las que fallan)
+};
+
+// Un nivel jugado. Se mide desde fuera, con lo mismo que ve el HUD.
+struct BotLevelStats {
+  static constexpr int ITEM_TYPES =
+      static_cast<int>(ItemType::LlaveMaestra) + 1;
+
+  std::uint64_t ticks = 0;
+  int damage = 0;             // Corazones perdidos (golpes, balas, pilas malas)
+  std::int64_t keyTicks = -1; // Ticks hasta coger la llave; -1 si no la cogió
+  std::array<int, ITEM_TYPES> itemsSpawned{}; // Por ItemType
+  std::array<int, ITEM_TYPES> itemsPicked{};
+};
+
+struct BotRunResult {
+  enum class Outcome { Victory, Defeat, Stuck, Crash };
+
+  RunSetup setup;
+  Outcome outcome = Outcome::Stuck;
+  std::string error;  // Qué se rompió (Crash) o dónde se quedó (Stuck)
+
+  std::uint64_t ticks = 0;
+  int levelReached = 0;
+  std::vector<BotLevelStats> levels; // Uno por nivel jugado
+
+  double ms = 0.0;           // Tiempo real de simulación
+  double worstTickMs = 0.0;  // El tick más lento (CPU del hilo)
+  std::uint64_t worstTick = 0;
+  int worstTickLevel = 0;
+
+  InputRecording recording; // Solo con BotRunLimits::record
+
+  bool failed() const {
+    return outcome == Outcome::Crash || outcome == Outcome::Stuck;
+  }
+};
+
+const char *outcomeName(BotRunResult::Outcome o);
+
+// Juega 'setup' de principio a fin con el jugador automático
+BotRunResult playBotRun(const RunSetup &setup,
+                        const BotRunLimits &limits = BotRunLimits{});
+
+// Llama a job(0..count-1) repartido entre 'threads' hilos (0 = todos los
+// núcleos). Cada índice se ejecuta una sola vez; el orden no está definido.
+void runParallel(std::size_t count, unsigned threads,
+                 const std::function<void(std::size_t)> &job);
+
+#endif
@@ -0,0 +1,156 @@
+#include "BulletPatterns.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float DEG2RAD_F = 3.14159265358979323846f / 180.0f;
+constexpr float MAX_CATCH_UP = 1.0f / 30.0f; // Segundos
+
+using P = BulletPattern;
+
+// Tabla de ataques por fase. Cada fila es un ataque (patrones simultáneos);
+// el boss los va alternando en cada turno de disparo. Campos en orden:
+// kind, bullets, volleys, interval, delay, spread, spin, speedScale.
+const std::vector<BulletAttack> PHASE_1 = {
+    {{P::AimedFan, 3, 1, 0.0f, 0.0f, 30.0f, 0.0f, 1.0f}},
+    {{P::Ring, 8, 1, 0.0f, 0.0f, 0.0f, 0.0f, 0.8f}},
+};
+
+const std::vector<BulletAttack> PHASE_2 = {
+    {{P::AimedFan, 5, 2, 0.25f, 0.0f, 40.0f, 0.0f, 1.0f}},
+    {{P::Spiral, 12, 2, 0.3f, 0.0f, 0.0f, 15.0f, 0.8f}},
+    {{P::DelayedBurst, 8, 1, 0.0f, 0.8f, 0.0f, 0.0f, 0.6f},
+     {P::AimedFan, 3, 1, 0.0f, 0.0f, 20.0f, 0.0f, 1.0f}},
+};
+
+const std::vector<BulletAttack> PHASE_3 = {
+    {{P::Spiral, 4, 12, 0.08f, 0.0f, 0.0f, 12.0f, 0.7f}},
+    {{P::AimedFan, 7, 1, 0.0f, 0.0f, 50.0f, 0.0f, 0.9f},
+     {P::DelayedBurst, 12, 1, 0.0f, 0.7f, 0.0f, 0.0f, 0.5f}},
+    {{P::Ring, 16, 3, 0.2f, 0.0f, 0.0f, 11.25f, 0.7f}},
+};
+
+const std::vector<BulletAttack> PHASE_4 = {
+    // Doble espiral en sentidos opuestos
+    {{P::Spiral, 6, 20, 0.05f, 0.0f, 0.0f, 9.0f, 0.6f},
+     {P::Spiral, 6, 20, 0.05f, 0.0f, 0.0f, -9.0f, 0.6f}},
+    {{P::Ring, 24, 4, 0.15f, 0.0f, 0.0f, 7.5f, 0.6f},
+     {P::AimedFan, 5, 3, 0.2f, 0.0f, 30.0f, 0.0f, 1.0f}},
+    {{P::DelayedBurst, 16, 1, 0.0f, 0.6f, 0.0f, 0.0f, 0.5f},
+     {P::DelayedBurst, 16, 1, 0.0f, 1.2f, 0.0f, 0.0f, 0.5f},
+     {P::AimedFan, 3, 2, 0.3f, 0.0f, 20.0f, 0.0f, 1.2f}},
+};
+} // namespace
+
+const std::vector<BulletAttack> &BulletPatternEngine::bossAttacks(int phase) {
+  switch (phase) {
+  case 1:
+    return PHASE_1;
+  case 2:
+    return PHASE_2;
+  case 3:
+    return PHASE_3;
+  default:
+    return PHASE_4;
+  }
+}
+
+bool BulletPatternEngine::trigger(const BulletPattern &p, double now,
+                                  float aimX, float aimY, const Shot &shot) {
+  if (count == MAX_RUNNING || p.bullets <= 0 || p.volleys <= 0)
+    return false;
+  Run &r = runs[count++];
+  r.pattern = p;
+  r.shot = shot;
+  r.nextAt = now + p.delay;
+  r.volley = 0;
+  r.x = aimX;
+  r.y = aimY;
+  return true;
+}
+
+std::size_t BulletPatternEngine::emitVolley(const Run &r, float ox, float oy,
+                                            float aimX, float aimY,
+                                            ProjectilePool &out) const {
+  const BulletPattern &p = r.pattern;
+  const float speed = r.shot.speed * p.speedScale;
+
+  float start = 0.0f, step = 0.0f; // Radianes
+  switch (p.kind) {
+  case BulletPattern::Ring:
+  case BulletPattern::Spiral:
+  case BulletPattern::DelayedBurst:
+    start = p.spin * DEG2RAD_F * static_cast<float>(r.volley);
+    step = 2.0f * 3.14159265358979323846f / static_cast<float>(p.bullets);
+    break;
+  case BulletPattern::AimedFan: {
+    // Se apunta en cada descarga: el abanico sigue al jugador
+    const float center = std::atan2(aimY - oy, aimX - ox);
+    if (p.bullets > 1) {
+      start = center - 0.5f * p.spread * DEG2RAD_F;
+      step = p.spread * DEG2RAD_F / static_cast<float>(p.bullets - 1);
+    } else {
+      start = center;
+    }
+    break;
+  }
+  }
+  if (p.kind == BulletPattern::DelayedBurst) {
+    ox = r.x; // Estalla donde estaba el jugador
+    oy = r.y;
+  }
+
+  std::size_t spawned = 0;
+  for (int k = 0; k < p.bullets; ++k) {
+    const float a = start + step * static_cast<float>(k);
+    if (out.spawn(ox, oy, std::cos(a) * speed, std::sin(a) * speed,
+                  r.shot.range, r.shot.damage, ProjectilePool::Enemy))
+      spawned++;
+  }
+  return spawned;
+}
+
+std::size_t BulletPatternEngine::update(double now, float originX,
+                                        float originY, float aimX, float aimY,
+                                        ProjectilePool &out) {
+  std::size_t spawned = 0;
+  // De atrás hacia delante: al acabar un patrón, el último ocupa su hueco
+  for (std::size_t i = count; i-- > 0;) {
+    Run &r = runs[i];
+    while (r.volley < r.pattern.volleys && r.nextAt <= now) {
+      const std::size_t first = out.size();
+      spawned += emitVolley(r, originX, originY, aimX, aimY, out);
+
+      // Si el frame llegó tarde, adelantar las balas lo que ya habrían
+      // recorrido: la forma del patrón no depende del frame rate. Con tope
+      // de MAX_CATCH_UP, porque ese tramo no pasa por el barrido de muros.
+      const float late = std::min(static_cast<float>(now - r.nextAt),
+                                  MAX_CATCH_UP);
+      if (late > 0.0f) {
+        for (std::size_t k = first; k < out.size(); ++k)
+          out.advance(k, late);
+      }
+
+      r.volley++;
+      r.nextAt += r.pattern.interval;
+    }
+    if (r.volley >= r.pattern.volleys)
+      runs[i] = runs[--count];
+  }
+  return spawned;
+}
+
+void BulletPatternEngine::saveState(StateWriter &out) const {
+  out.pod(count);
+  out.raw(runs.data(), count);
+}
+
+bool BulletPatternEngine::loadState(StateReader &in) {
+  std::size_t n = 0;
+  if (!in.pod(n))
+    return false;
+  if (n > MAX_RUNNING)
+    return in.fail();
+  count = n;
+  return in.raw(runs.data(), n);
+}
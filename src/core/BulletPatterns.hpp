@@ -0,0 +1,98 @@
+#ifndef BULLET_PATTERNS_HPP
+#define BULLET_PATTERNS_HPP
+
+#include "ProjectilePool.hpp"
+#include "StateBuffer.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Patrón de balas (descripción de datos, sin lógica)
+// Ring: anillo de 'bullets' balas repartidas en 360°.
+// Spiral: como Ring, pero cada descarga gira 'spin' grados.
+// AimedFan: abanico de 'spread' grados apuntado al jugador en cada descarga.
+// DelayedBurst: marca el punto donde estaba el jugador y, pasado 'delay',
+//               estalla allí un anillo (se puede esquivar si te mueves).
+struct BulletPattern {
+  enum Kind : std::uint8_t { Ring, Spiral, AimedFan, DelayedBurst };
+
+  Kind kind = Ring;
+  int bullets = 8;         // Balas por descarga
+  int volleys = 1;         // Número de descargas
+  float interval = 0.0f;   // Segundos entre descargas
+  float delay = 0.0f;      // Segundos hasta la primera
+  float spread = 0.0f;     // Apertura del abanico (grados)
+  float spin = 0.0f;       // Giro por descarga (grados)
+  float speedScale = 1.0f; // Sobre la velocidad base de la fase
+};
+
+// Un ataque del boss: varios patrones que arrancan a la vez
+using BulletAttack = std::vector<BulletPattern>;
+
+// Motor de patrones de balas del boss
+// trigger() arranca un patrón; update() emite las descargas que ya tocan
+// directamente en el ProjectilePool (mismo alcance, daño y bando que
+// cualquier otra bala enemiga, así que colisión y dibujo no cambian).
+//
+// Clave de diseño: los patrones son datos (tabla bossAttacks por fase) y el
+// motor solo guarda, por patrón en curso, cuándo toca la siguiente descarga
+// y cuántas quedan. Hay como mucho MAX_RUNNING patrones a la vez en un array
+// fijo: sin reservas por frame, y el trabajo por frame es O(balas emitidas).
+// Todo en tiempo de simulación (segundos), sin raylib.
+class BulletPatternEngine {
+public:
+  static constexpr std::size_t MAX_RUNNING = 32;
+
+  // Propiedades de cada bala que se emite
+  struct Shot {
+    float speed = 300.0f; // px/s (antes de speedScale)
+    float range = 1000.0f;
+    int damage = 1;
+  };
+
+  // Arranca 'p' en el instante 'now'. (aimX, aimY) solo se usa para fijar
+  // el punto de DelayedBurst. false si ya hay MAX_RUNNING en curso.
+  bool trigger(const BulletPattern &p, double now, float aimX, float aimY,
+               const Shot &shot);
+
+  // Emite las descargas pendientes hasta 'now' desde el origen (el boss) y
+  // apuntando a 'aim' (el jugador). Devuelve cuántas balas se crearon.
+  std::size_t update(double now, float originX, float originY, float aimX,
+                     float aimY, ProjectilePool &out);
+
+  void clear() { count = 0; }
+  std::size_t running() const { return count; }
+
+  // Foto de los patrones en curso (ver SimSnapshot)
+  void saveState(StateWriter &out) const;
+  bool loadState(StateReader &in);
+
+  // f(x, y, segundos hasta estallar) para cada DelayedBurst aún sin estallar
+  template <class F> void forEachPendingBurst(double now, F &&f) const {
+    for (std::size_t i = 0; i < count; ++i)
+      if (runs[i].pattern.kind == BulletPattern::DelayedBurst)
+        f(runs[i].x, runs[i].y, static_cast<float>(runs[i].nextAt - now));
+  }
+
+  // Ataques de cada fase (1-4), en el orden en que se van alternando
+  static const std::vector<BulletAttack> &bossAttacks(int phase);
+
+private:
+  struct Run {
+    BulletPattern pattern;
+    Shot shot;
+    double nextAt = 0.0;
+    int volley = 0;     // Descargas ya emitidas
+    float x = 0.0f;     // Punto fijo (DelayedBurst)
+    float y = 0.0f;
+  };
+
+  std::size_t emitVolley(const Run &r, float ox, float oy, float aimX,
+                         float aimY, ProjectilePool &out) const;
+
+  std::array<Run, MAX_RUNNING> runs{};
+  std::size_t count = 0;
+};
+
+#endif
@@ -2,7 +2,6 @@
 #define ENEMY_HPP
 
 #include "Map.hpp"
-#include "raylib.h"
 
 // Clase Enemigo (Sistema de Rejilla)
 // Esta clase representa a una entidad hostil en el juego.
@@ -53,15 +52,6 @@ public:
   // Como usamos enteros, la colisión es trivial: ¿Coinciden las coordenadas?
   bool collidesWith(int px, int py) const { return x == px && y == py; }
 
-  // Renderizado Básico (Placeholder / Fallback):
-  // Si no cargamos sprites, dibujamos un cuadrado rojo.
-  // Recibe 'tileSize' para saber a qué píxel de pantalla corresponde la celda
-  // (x,y).
-  void draw(int tileSize) const {
-    Color c = (type == Shooter) ? ORANGE : RED;
-    DrawRectangle(x * tileSize, y * tileSize, tileSize, tileSize, c);
-  }
-
   // Método para actualizar la animación (lo llamaremos en Update)
   void updateAnimation(float dt) {
     animTime += dt * 5.0f; // Velocidad de respiración
@@ -0,0 +1,130 @@
+#include "EnemyVision.hpp"
+#include <algorithm>
+#include <cmath>
+
+EnemyVision::EnemyVision(int radius, float halfAngleDeg) {
+  configure(radius, halfAngleDeg);
+}
+
+void EnemyVision::configure(int radius, float halfAngleDeg) {
+  r = std::clamp(radius, 1, MAX_RADIUS);
+  const float c = std::cos(halfAngleDeg * 3.14159265f / 180.0f);
+  cos2 = c * c;
+  cache.clear();
+}
+
+bool EnemyVision::inCone(int ox, int oy, int facing) const {
+  const int d2 = ox * ox + oy * oy;
+  // Conciencia periférica: lo que está pegado (incluidas diagonales) se nota
+  // aunque esté a la espalda.
+  if (d2 <= 2)
+    return true;
+
+  int fx = 0, fy = 0;
+  switch (facing) {
+  case Down:  fy = 1;  break;
+  case Up:    fy = -1; break;
+  case Left:  fx = -1; break;
+  case Right: fx = 1;  break;
+  }
+  const int dot = ox * fx + oy * fy;
+  // dot / |o| >= cos(semiángulo), sin raíces
+  return dot > 0 && float(dot * dot) >= cos2 * float(d2);
+}
+
+// Shadowcasting recursivo (un octante). (xx, xy, yx, yy) transforma las
+// coordenadas locales del octante a coordenadas del mapa.
+void EnemyVision::castLight(const Map &map, int cx, int cy, int row,
+                            float start, float end, int xx, int xy, int yx,
+                            int yy, Mask &lit) const {
+  if (start < end)
+    return;
+
+  const int r2 = r * r;
+  float newStart = 0.0f;
+
+  for (int i = row; i <= r; ++i) {
+    bool blocked = false;
+    for (int dx = -i, dy = -i; dx <= 0; ++dx) {
+      const float lSlope = (dx - 0.5f) / (dy + 0.5f);
+      const float rSlope = (dx + 0.5f) / (dy - 0.5f);
+      if (start < rSlope)
+        continue;
+      if (end > lSlope)
+        break;
+
+      const int ox = dx * xx + dy * xy;
+      const int oy = dx * yx + dy * yy;
+      const int mx = cx + ox, my = cy + oy;
+      const bool inside = mx >= 0 && my >= 0 && mx < map.width() &&
+                          my < map.height();
+
+      if (inside && ox * ox + oy * oy <= r2)
+        set(lit, bitIndex(ox, oy));
+
+      const bool opaque = !inside || map.at(mx, my) == WALL;
+      if (blocked) {
+        if (opaque) {
+          newStart = rSlope;
+        } else {
+          blocked = false;
+          start = newStart;
+        }
+      } else if (opaque && i < r) {
+        // Empieza una sombra: seguimos la parte visible en la fila siguiente
+        blocked = true;
+        castLight(map, cx, cy, i + 1, start, lSlope, xx, xy, yx, yy, lit);
+        newStart = rSlope;
+      }
+    }
+    if (blocked)
+      break;
+  }
+}
+
+const EnemyVision::TileMasks &EnemyVision::masksFor(const Map &map, int ex,
+                                                    int ey) {
+  const int key = ey * map.width() + ex;
+  auto it = cache.find(key);
+  if (it != cache.end())
+    return it->second;
+
+  // 1. Sombra completa (360º) desde la casilla
+  static constexpr int MULT[4][8] = {{1, 0, 0, -1, -1, 0, 0, 1},
+                                     {0, 1, -1, 0, 0, -1, 1, 0},
+                                     {0, 1, 1, 0, 0, -1, -1, 0},
+                                     {1, 0, 0, 1, -1, 0, 0, -1}};
+  Mask lit{};
+  set(lit, bitIndex(0, 0));
+  for (int oct = 0; oct < 8; ++oct)
+    castLight(map, ex, ey, 1, 1.0f, 0.0f, MULT[0][oct], MULT[1][oct],
+              MULT[2][oct], MULT[3][oct], lit);
+
+  // 2. Recorte por orientación
+  TileMasks masks{};
+  for (int oy = -r; oy <= r; ++oy) {
+    for (int ox = -r; ox <= r; ++ox) {
+      const int bit = bitIndex(ox, oy);
+      if (!test(lit, bit))
+        continue;
+      for (int f = 0; f < 4; ++f)
+        if (inCone(ox, oy, f))
+          set(masks[f], bit);
+    }
+  }
+
+  return cache.emplace(key, masks).first->second;
+}
+
+bool EnemyVision::sees(const Map &map, int ex, int ey, int facing, int tx,
+                       int ty) {
+  const int ox = tx - ex, oy = ty - ey;
+  if (ox < -r || ox > r || oy < -r || oy > r)
+    return false; // Descarte rápido por caja
+  if (ex < 0 || ey < 0 || ex >= map.width() || ey >= map.height())
+    return false;
+  if (facing < 0 || facing > 3)
+    facing = Down;
+
+  return test(masksFor(map, ex, ey)[facing], bitIndex(ox, oy));
+}
@@ -0,0 +1,66 @@
+#ifndef ENEMY_VISION_HPP
+#define ENEMY_VISION_HPP
+
+#include "Map.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+// Conos de visión de los enemigos
+// Un enemigo ve al jugador si está dentro de su radio, dentro del cono hacia
+// donde mira y sin muros en medio (shadowcasting recursivo por octantes).
+//
+// Clave de diseño: el mapa es estático durante el nivel, así que lo que se
+// ve desde una casilla nunca cambia. Calculamos la sombra UNA vez por
+// casilla (para las 4 orientaciones a la vez) y la guardamos como máscara de
+// bits relativa al enemigo. Consultar después cuesta un acceso a hash y un
+// test de bit, sin rayos por enemigo y por frame.
+class EnemyVision {
+public:
+  static constexpr int MAX_RADIUS = 8;
+
+  // Mismo orden que Game::EnemyFacing
+  enum Facing { Down = 0, Up = 1, Left = 2, Right = 3 };
+
+  explicit EnemyVision(int radius = 6, float halfAngleDeg = 60.0f);
+
+  // Cambia radio/ángulo (vacía la caché)
+  void configure(int radius, float halfAngleDeg);
+
+  // Nuevo mapa (nivel): la caché deja de ser válida
+  void reset() { cache.clear(); }
+
+  // ¿Ve un enemigo en (ex, ey) mirando a 'facing' la casilla (tx, ty)?
+  bool sees(const Map &map, int ex, int ey, int facing, int tx, int ty);
+
+  int radius() const { return r; }
+  std::size_t cachedTiles() const { return cache.size(); }
+
+private:
+  static constexpr int SIDE = 2 * MAX_RADIUS + 1;
+  static constexpr int WORDS = (SIDE * SIDE + 63) / 64;
+  using Mask = std::array<std::uint64_t, WORDS>;
+  using TileMasks = std::array<Mask, 4>; // Una máscara por orientación
+
+  static int bitIndex(int ox, int oy) {
+    return (oy + MAX_RADIUS) * SIDE + (ox + MAX_RADIUS);
+  }
+  static bool test(const Mask &m, int bit) {
+    return (m[bit >> 6] >> (bit & 63)) & 1u;
+  }
+  static void set(Mask &m, int bit) {
+    m[bit >> 6] |= std::uint64_t(1) << (bit & 63);
+  }
+
+  const TileMasks &masksFor(const Map &map, int ex, int ey);
+  void castLight(const Map &map, int cx, int cy, int row, float start,
+                 float end, int xx, int xy, int yx, int yy, Mask &lit) const;
+  bool inCone(int ox, int oy, int facing) const;
+
+  int r = 6;
+  float cos2 = 0.25f; // cos^2 del semiángulo del cono
+  std::unordered_map<int, TileMasks> cache;
+};
+
+#endif
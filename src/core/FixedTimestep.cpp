@@ -0,0 +1,27 @@
+#include "FixedTimestep.hpp"
+#include <cmath>
+
+int FixedTimestep::advance(double frameSeconds) {
+  if (frameSeconds > 0.0)
+    accumulator += frameSeconds;
+
+  int n = 0;
+  while (accumulator >= TICK && n < MAX_TICKS_PER_FRAME) {
+    accumulator -= TICK;
+    n++;
+  }
+  // Tope alcanzado: el retraso que no cabe se pierde (cámara lenta)
+  if (accumulator >= TICK) {
+    const double keep = std::fmod(accumulator, static_cast<double>(TICK));
+    dropped += accumulator - keep;
+    accumulator = keep;
+  }
+  total += static_cast<std::uint64_t>(n);
+  return n;
+}
+
+void FixedTimestep::reset() {
+  accumulator = 0.0;
+  dropped = 0.0;
+  total = 0;
+}
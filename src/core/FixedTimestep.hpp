@@ -0,0 +1,41 @@
+#ifndef FIXED_TIMESTEP_HPP
+#define FIXED_TIMESTEP_HPP
+
+#include <cstdint>
+
+// Paso fijo de simulación con acumulador
+// El frame aporta su tiempo real al acumulador y la simulación avanza en
+// ticks de duración fija (TICK) mientras quede tiempo acumulado. Lo que
+// sobra (menos de un tick) queda para el frame siguiente y sirve de factor
+// de interpolación para el render: alpha() = sobrante / TICK.
+//
+// Clave de diseño: la simulación solo ve TICK, nunca el tiempo del frame.
+// A 30 o a 144 FPS se ejecutan los mismos ticks con el mismo dt, así que
+// con la misma semilla y la misma entrada por tick la partida es idéntica.
+// Un frame muy lento no dispara una espiral de recuperación: como mucho se
+// ejecutan MAX_TICKS_PER_FRAME y el resto del retraso se descarta (la
+// partida va a cámara lenta en vez de congelarse).
+class FixedTimestep {
+public:
+  static constexpr int TICK_HZ = 60;
+  static constexpr float TICK = 1.0f / TICK_HZ; // Segundos por tick
+  static constexpr int MAX_TICKS_PER_FRAME = 8;
+
+  // Suma el tiempo del frame y devuelve cuántos ticks toca simular
+  int advance(double frameSeconds);
+
+  // Fracción del siguiente tick ya transcurrida (0..1): interpolación
+  float alpha() const { return static_cast<float>(accumulator / TICK); }
+
+  void reset();
+
+  std::uint64_t ticks() const { return total; }   // Ticks desde reset()
+  double droppedSeconds() const { return dropped; } // Retraso descartado
+
+private:
+  double accumulator = 0.0;
+  double dropped = 0.0;
+  std::uint64_t total = 0;
+};
+
+#endif
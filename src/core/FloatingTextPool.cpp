@@ -0,0 +1,133 @@
+#include "FloatingTextPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+FloatingTextPool::FloatingTextPool(std::size_t capacity, std::uint32_t seed)
+    : cap(std::max<std::size_t>(1, capacity)), rng(seed ? seed : 1u),
+      px(cap), py(cap), timers(cap), pops(cap), values(cap), colors(cap),
+      keys(cap), texts(cap) {}
+
+std::size_t FloatingTextPool::formatInt(int v, char (&out)[TEXT_MAX]) {
+  // A mano y sin locale: de derecha a izquierda sobre un buffer temporal
+  char tmp[TEXT_MAX];
+  std::size_t n = 0;
+  // En unsigned para que INT_MIN no desborde al cambiar de signo
+  unsigned int u = v < 0 ? 0u - static_cast<unsigned int>(v)
+                         : static_cast<unsigned int>(v);
+  do {
+    tmp[n++] = static_cast<char>('0' + u % 10);
+    u /= 10;
+  } while (u > 0);
+
+  std::size_t len = 0;
+  if (v < 0)
+    out[len++] = '-';
+  while (n > 0)
+    out[len++] = tmp[--n];
+  out[len] = '\0';
+  return len;
+}
+
+void FloatingTextPool::setText(std::size_t i) {
+  char buf[TEXT_MAX];
+  const std::size_t len = formatInt(values[i], buf);
+  std::memcpy(texts[i].data(), buf, len + 1);
+}
+
+void FloatingTextPool::remove(std::size_t i) {
+  const std::size_t last = count - 1;
+  if (i != last) {
+    px[i] = px[last];
+    py[i] = py[last];
+    timers[i] = timers[last];
+    pops[i] = pops[last];
+    values[i] = values[last];
+    colors[i] = colors[last];
+    keys[i] = keys[last];
+    texts[i] = texts[last];
+  }
+  count = last;
+}
+
+void FloatingTextPool::spawn(float x, float y, int value, std::uint32_t rgba,
+                             std::uint32_t key) {
+  // ¿Mismo objetivo golpeado hace poco? Sumar al número que ya está
+  for (std::size_t i = 0; i < count; ++i) {
+    if (keys[i] != key || colors[i] != rgba || LIFE - timers[i] > MERGE_WINDOW)
+      continue;
+    const long long sum = static_cast<long long>(values[i]) + value;
+    values[i] = static_cast<std::int32_t>(
+        std::clamp<long long>(sum, std::numeric_limits<std::int32_t>::min(),
+                              std::numeric_limits<std::int32_t>::max()));
+    setText(i);
+    py[i] = y; // Vuelve a su ancla y reinicia la vida
+    timers[i] = LIFE;
+    pops[i] = POP;
+    merges++;
+    return;
+  }
+
+  std::size_t i = count;
+  if (count < cap) {
+    count++;
+  } else {
+    // Lleno: cede el hueco el más apagado
+    i = static_cast<std::size_t>(
+        std::min_element(timers.begin(), timers.begin() + count) -
+        timers.begin());
+    evictions++;
+  }
+
+  // Un poco de dispersión horizontal (-8..7 px) para que no se solapen
+  const float offsetX = static_cast<float>(nextRandom() % 16) - 8.0f;
+  px[i] = x + offsetX;
+  py[i] = y;
+  timers[i] = LIFE;
+  pops[i] = 0.0f;
+  values[i] = value;
+  colors[i] = rgba;
+  keys[i] = key;
+  setText(i);
+}
+
+void FloatingTextPool::update(float dt) {
+  for (std::size_t i = 0; i < count; ++i) {
+    timers[i] -= dt;
+    pops[i] = std::max(0.0f, pops[i] - dt);
+    py[i] -= RISE * dt; // El texto sube (eje Y negativo)
+  }
+
+  // Borrar caducados (de atrás hacia delante por el intercambio)
+  for (std::size_t i = count; i-- > 0;)
+    if (timers[i] <= 0.0f)
+      remove(i);
+}
+
+void FloatingTextPool::saveState(StateWriter &out) const {
+  out.pod(count);
+  out.pod(merges);
+  out.pod(evictions);
+  out.pod(rng);
+  out.raw(px.data(), count);
+  out.raw(py.data(), count);
+  out.raw(timers.data(), count);
+  out.raw(pops.data(), count);
+  out.raw(values.data(), count);
+  out.raw(colors.data(), count);
+  out.raw(keys.data(), count);
+  out.raw(texts.data(), count);
+}
+
+bool FloatingTextPool::loadState(StateReader &in) {
+  std::size_t n = 0;
+  if (!(in.pod(n) && in.pod(merges) && in.pod(evictions) && in.pod(rng)))
+    return false;
+  if (n > cap)
+    return in.fail();
+  count = n;
+  return in.raw(px.data(), n) && in.raw(py.data(), n) &&
+         in.raw(timers.data(), n) && in.raw(pops.data(), n) &&
+         in.raw(values.data(), n) && in.raw(colors.data(), n) &&
+         in.raw(keys.data(), n) && in.raw(texts.data(), n);
+}
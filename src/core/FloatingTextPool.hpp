@@ -0,0 +1,90 @@
+#ifndef FLOATING_TEXT_POOL_HPP
+#define FLOATING_TEXT_POOL_HPP
+
+#include "StateBuffer.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Pool de textos flotantes (números de daño)
+// Capacidad fija y estructura de arrays, como ProjectilePool: los vivos
+// ocupan [0, size()) y al morir uno el último ocupa su hueco.
+//
+// Clave de diseño: coste acotado. Cada texto lleva una clave de objetivo;
+// si llega otro golpe con la misma clave y color mientras el texto aún es
+// reciente (MERGE_WINDOW), se suma al número existente en vez de crear uno
+// nuevo. Así una ráfaga contra el boss es un solo número que crece. El texto
+// se formatea a una cadena cacheada solo al crearlo o sumarle algo: dibujar
+// no vuelve a formatear. Si el pool se llena, el texto más apagado cede su
+// hueco. Los colores van como en PrimitiveBatch::pack.
+class FloatingTextPool {
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 128;
+  static constexpr std::size_t TEXT_MAX = 12; // "-2147483648" + '\0'
+  static constexpr float LIFE = 0.8f;          // Segundos en pantalla
+  static constexpr float RISE = 30.0f;         // Subida en px/s
+  static constexpr float MERGE_WINDOW = 0.3f;  // Desde el último golpe
+  static constexpr float POP = 0.12f;          // Realce al sumar un golpe
+
+  explicit FloatingTextPool(std::size_t capacity = DEFAULT_CAPACITY,
+                            std::uint32_t seed = 0x2545F491u);
+
+  // Nuevo número en (x, y), o suma 'value' al del mismo objetivo
+  void spawn(float x, float y, int value, std::uint32_t rgba,
+             std::uint32_t key);
+
+  // Sube, apaga y borra los caducados
+  void update(float dt);
+
+  void clear() { count = 0; }
+
+  // Foto de los textos vivos y del xorshift (ver SimSnapshot)
+  void saveState(StateWriter &out) const;
+  bool loadState(StateReader &in);
+
+  void reseed(std::uint32_t seed) { rng = seed ? seed : 1u; }
+
+  std::size_t size() const { return count; }
+  std::size_t capacity() const { return cap; }
+  std::size_t merged() const { return merges; }    // Golpes sumados
+  std::size_t evicted() const { return evictions; } // Expulsados por tope
+
+  int value(std::size_t i) const { return values[i]; }
+  const char *text(std::size_t i) const { return texts[i].data(); }
+
+  // f(x, y, alpha 0..1, pop 0..1, texto, rgba) para cada texto vivo
+  template <class F> void forEach(F &&f) const {
+    for (std::size_t i = 0; i < count; ++i)
+      f(px[i], py[i], timers[i] * (1.0f / LIFE), pops[i] * (1.0f / POP),
+        texts[i].data(), colors[i]);
+  }
+
+  // Escribe 'v' en decimal; devuelve la longitud (sin el '\0')
+  static std::size_t formatInt(int v, char (&out)[TEXT_MAX]);
+
+private:
+  std::uint32_t nextRandom() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+  }
+  void setText(std::size_t i);
+  void remove(std::size_t i);
+
+  std::size_t cap = 0;
+  std::size_t count = 0;
+  std::size_t merges = 0;
+  std::size_t evictions = 0;
+  std::uint32_t rng = 1;
+
+  std::vector<float> px, py;
+  std::vector<float> timers; // Vida restante
+  std::vector<float> pops;   // Realce restante
+  std::vector<std::int32_t> values;
+  std::vector<std::uint32_t> colors, keys;
+  std::vector<std::array<char, TEXT_MAX>> texts; // Cadena ya formateada
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "FrameProfiler.hpp"
+#include <algorithm>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+
+FrameProfiler::FrameProfiler(std::vector<std::string> sectionNames)
+    : names(std::move(sectionNames)), current(names.size(), 0.0),
+      avg(names.size(), 0.0) {}
+
+double FrameProfiler::clockMs() {
+  using namespace std::chrono;
+  return duration<double, std::milli>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double FrameProfiler::threadCpuMs() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+#endif
+  return clockMs();
+}
+
+void FrameProfiler::beginFrame(double nowMs) {
+  // El tiempo de frame es de inicio a inicio: incluye la espera de vsync
+  if (frameStart >= 0.0) {
+    const double dt = nowMs - frameStart;
+    frameAvg = blend(frameAvg, dt, dtSamples == 0);
+    history[dtSamples % HISTORY] = dt;
+    dtSamples++;
+  }
+  frameStart = nowMs;
+  std::fill(current.begin(), current.end(), 0.0);
+}
+
+void FrameProfiler::endFrame(double nowMs) {
+  if (frameStart < 0.0)
+    return;
+  const bool first = (frameCount == 0);
+  cpuAvg = blend(cpuAvg, nowMs - frameStart, first);
+  for (size_t i = 0; i < current.size(); ++i)
+    avg[i] = blend(avg[i], current[i], first);
+  frameCount++;
+}
+
+void FrameProfiler::add(int id, double ms) {
+  if (id >= 0 && id < static_cast<int>(current.size()))
+    current[id] += ms;
+}
+
+double FrameProfiler::worstFrameMs() const {
+  const size_t n = std::min(dtSamples, HISTORY);
+  double worst = 0.0;
+  for (size_t i = 0; i < n; ++i)
+    worst = std::max(worst, history[i]);
+  return worst;
+}
+
+double FrameProfiler::sectionMs(int id) const {
+  if (id < 0 || id >= static_cast<int>(avg.size()))
+    return 0.0;
+  return avg[id];
+}
@@ -0,0 +1,80 @@
+#ifndef FRAME_PROFILER_HPP
+#define FRAME_PROFILER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Perfilador por frame (overlay de rendimiento)
+// Mide el tiempo entre frames y lo que tarda cada sistema (IA, proyectiles,
+// render...) dentro del frame. Las secciones se acumulan durante el frame y
+// al cerrarlo se suavizan con una media exponencial, para que el overlay se
+// pueda leer sin que los números bailen.
+//
+// Clave de diseño: sin raylib y sin reservas por frame. Una sección es un
+// índice fijo (se registran al construir) y medir cuesta dos lecturas del
+// reloj monotónico. Los instantes se pueden pasar a mano (tests).
+class FrameProfiler {
+public:
+  static constexpr double SMOOTH = 0.1;  // Peso del frame nuevo en la media
+  static constexpr std::size_t HISTORY = 120; // Frames para el "peor"
+
+  explicit FrameProfiler(std::vector<std::string> sectionNames = {});
+
+  // Milisegundos del reloj monotónico
+  static double clockMs();
+  // Milisegundos de CPU gastados por este hilo: no cuenta el tiempo en que
+  // otros hilos le quitan el núcleo (sin soporte, el reloj monotónico)
+  static double threadCpuMs();
+
+  void beginFrame(double nowMs);
+  void endFrame(double nowMs);
+  void beginFrame() { beginFrame(clockMs()); }
+  void endFrame() { endFrame(clockMs()); }
+
+  // Suma 'ms' a la sección 'id' en el frame actual
+  void add(int id, double ms);
+
+  // Mide el bloque en el que vive (RAII)
+  class Scope {
+  public:
+    Scope(FrameProfiler &p, int id) : prof(p), section(id), t0(clockMs()) {}
+    ~Scope() { prof.add(section, clockMs() - t0); }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    FrameProfiler &prof;
+    int section;
+    double t0;
+  };
+
+  // Lecturas (suavizadas)
+  double frameMs() const { return frameAvg; } // Inicio a inicio de frame
+  double cpuMs() const { return cpuAvg; }     // Inicio a fin (sin vsync)
+  double worstFrameMs() const;                // Peor de los últimos HISTORY
+  double fps() const { return frameAvg > 0.0 ? 1000.0 / frameAvg : 0.0; }
+  double sectionMs(int id) const;
+  const std::string &sectionName(int id) const { return names[id]; }
+  int sectionCount() const { return static_cast<int>(names.size()); }
+  std::size_t frames() const { return frameCount; }
+
+private:
+  static double blend(double avg, double sample, bool first) {
+    return first ? sample : avg + (sample - avg) * SMOOTH;
+  }
+
+  std::vector<std::string> names;
+  std::vector<double> current; // Acumulado del frame en curso
+  std::vector<double> avg;     // Media suavizada por sección
+
+  double frameStart = -1.0;
+  double frameAvg = 0.0, cpuAvg = 0.0;
+  std::array<double, HISTORY> history{};
+  std::size_t frameCount = 0; // Frames cerrados
+  std::size_t dtSamples = 0;  // Intervalos entre inicios medidos
+};
+
+#endif
@@ -1,5 +1,6 @@
-#include "Game.hpp"
+#include "GameSim.hpp"
 #include "GameUtils.hpp"
+#include "SweptCollision.hpp"
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
@@ -10,114 +11,57 @@
 // IMPLEMENTACIÓN DE COMBATE Y PROYECTILES
 // -----------------------------------------------------------------------------
 
-void Game::performMeleeAttack() {
-    gAttack.rangeTiles = 1;
-    gAttack.cooldown   = CD_HANDS;
-    gAttack.swingTime  = 0.1f;
-    gAttack.frontOnly  = true; 
+void GameSim::performMeleeAttack() {
+    attack.rangeTiles = 1;
+    attack.cooldown   = CD_HANDS;
+    attack.swingTime  = 0.1f;
+    attack.shape      = MeleeShape::Line; 
 
-    gAttack.swinging   = true;
-    gAttack.swingTimer = gAttack.swingTime;
-    gAttack.cdTimer    = gAttack.cooldown; 
+    attack.swinging   = true;
+    attack.swingTimer = attack.swingTime;
+    attack.cdTimer    = attack.cooldown; 
 
     IVec2 center{px, py};
-    gAttack.lastTiles = computeMeleeTilesOccluded(
-        center, gAttack.lastDir, gAttack.rangeTiles, gAttack.frontOnly, map);
+    computeMeleeShapeOccluded(center, attack.lastDir, attack.shape,
+                              attack.rangeTiles, map, attack.lastTiles);
 
-    bool hit = false;
-    
     // 1. CHEQUEO CONTRA ENEMIGOS NORMALES
-    for (size_t i = 0; i < enemies.size(); ++i) {
-        IVec2 epos = {enemies[i].getX(), enemies[i].getY()};
-        bool impacted = false;
-        for (const auto& t : gAttack.lastTiles) {
-            if (t.x == epos.x && t.y == epos.y) { impacted = true; break; }
-        }
-        
-        if (impacted) {
-            hit = true;
-            PlaySound(sfxHit); 
-
-            if (enemyHP.size() != enemies.size()) enemyHP.assign(enemies.size(), ENEMY_BASE_HP);
-            
-            enemyHP[i] -= DMG_HANDS;
-
-            Vector2 ePos = { (float)enemies[i].getX() * tileSize + 8, 
-                             (float)enemies[i].getY() * tileSize - 10 };
-            spawnFloatingText(ePos, DMG_HANDS, RAYWHITE);
-
-            if (i < enemyFlashTimer.size()) enemyFlashTimer[i] = 0.15f;
-
+    // Se mira quién ocupa cada casilla del golpe (índice de ocupación), sin
+    // recorrer la lista de enemigos
+    const SpatialGrid &occ = enemyOccupancy();
+    for (const auto& t : attack.lastTiles) {
+        for (int id = occ.first(t.x, t.y); id != SpatialGrid::NONE; id = occ.next(id)) {
+            queueEnemyDamage((size_t)id, DMG_HANDS, Palette::RayWhite);
             std::cout << "[Melee] Puñetazo! -" << DMG_HANDS << "\n";
-            
-            // PROVOCACIÓN (IA Agresiva)
-            if (i < enemyAtkCD.size()) enemyAtkCD[i] = 0.0f;
-            int dx = px - enemies[i].getX();
-            int dy = py - enemies[i].getY();
-            if (i < enemyFacing.size()) {
-                if (std::abs(dx) >= std::abs(dy)) enemyFacing[i] = (dx > 0) ? EnemyFacing::Right : EnemyFacing::Left;
-                else enemyFacing[i] = (dy > 0) ? EnemyFacing::Down : EnemyFacing::Up;
-            }
         }
     }
 
     // 2. NUEVO: CHEQUEO CONTRA EL BOSS (Faltaba esto)
     if (boss.active) {
-        for (const auto& t : gAttack.lastTiles) {
+        for (const auto& t : attack.lastTiles) {
             // Hitbox del boss (Centro +/- 1 tile)
             if (std::abs(t.x - boss.x) <= 1 && std::abs(t.y - boss.y) <= 1) {
-                hit = true;
-                boss.hp -= DMG_HANDS;
-                boss.flashTimer = 0.15f;
-                
-                PlaySound(sfxHit);
                 // Texto flotante en la cabeza del boss
-                spawnFloatingText({(float)boss.x*tileSize, (float)boss.y*tileSize}, DMG_HANDS, RAYWHITE);
-                
-                std::cout << "[Boss] Punched! HP: " << boss.hp << "\n";
+                queueBossDamage(DMG_HANDS, {(float)boss.x*tileSize, (float)boss.y*tileSize}, Palette::RayWhite, 0.15);
+                std::cout << "[Boss] Punched! HP: " << boss.hp - DMG_HANDS << "\n";
                 break; // Solo le pegamos una vez por ataque
             }
         }
     }
-    
-    // Limpieza de muertos + EXPLOSIONES + SONIDO MUERTE
-    if (hit) {
-         std::vector<size_t> toRemove;
-         for(size_t i=0; i<enemyHP.size(); ++i) if(enemyHP[i] <= 0) toRemove.push_back(i);
-         if (!toRemove.empty()) {
-            std::sort(toRemove.rbegin(), toRemove.rend());
-            for (size_t idx : toRemove) {
-                // EXPLOSIÓN VISUAL
-                float ex = enemies[idx].getX() * tileSize + tileSize / 2.0f;
-                float ey = enemies[idx].getY() * tileSize + tileSize / 2.0f;
-                spawnExplosion({ex, ey}, 15, DARKGRAY);
-                spawnExplosion({ex, ey}, 5, RED); 
-                
-                PlaySound(sfxExplosion);
-
-                enemies.erase(enemies.begin() + idx);
-                if (idx < enemyFacing.size()) enemyFacing.erase(enemyFacing.begin() + idx);
-                if (idx < enemyHP.size()) enemyHP.erase(enemyHP.begin() + idx);
-                if (idx < enemyAtkCD.size()) enemyAtkCD.erase(enemyAtkCD.begin() + idx);
-                if (idx < enemyFlashTimer.size()) enemyFlashTimer.erase(enemyFlashTimer.begin() + idx);
-            }
-        }
-    }
-
-    enemyTryAttackFacing();
+    // Vida, muertes y contraataque: resolveDamage() al final del frame
 }
 
-void Game::performSwordAttack() {
+void GameSim::performSwordAttack() {
     int dmg = DMG_SWORD_T1;
-    Color trailColor = SKYBLUE; // Color T1 (Azul claro)
+    uint32_t trailColor = Palette::SkyBlue; // Color T1 (Azul claro)
 
     if (swordTier == 2) { 
         dmg = DMG_SWORD_T2; 
-        trailColor = LIME; // Color T2 (Verde)
+        trailColor = Palette::Lime; // Color T2 (Verde)
     }
     if (swordTier == 3) { 
         dmg = DMG_SWORD_T3; 
-        trailColor = RED;  // Color T3 (Rojo Sith)
+        trailColor = Palette::Red; // Color T3 (Rojo Sith)
     }
 
     // --- ACTIVAR EFECTO SLASH ---
@@ -125,104 +69,49 @@ void Game::performSwordAttack() {
     slashTimer = 0.15f; // Duración corta y rápida
     slashColor = trailColor;
 
-    if (gAttack.lastDir.x > 0) slashBaseAngle = 0.0f;        // Derecha
-    else if (gAttack.lastDir.x < 0) slashBaseAngle = 180.0f; // Izquierda
-    else if (gAttack.lastDir.y > 0) slashBaseAngle = 90.0f;  // Abajo
+    if (attack.lastDir.x > 0) slashBaseAngle = 0.0f;        // Derecha
+    else if (attack.lastDir.x < 0) slashBaseAngle = 180.0f; // Izquierda
+    else if (attack.lastDir.y > 0) slashBaseAngle = 90.0f;  // Abajo
     else slashBaseAngle = 270.0f;                            // Arriba
 
-    gAttack.rangeTiles = 1; 
-    gAttack.cooldown   = CD_SWORD;
-    gAttack.swingTime  = 0.15f; 
-    gAttack.frontOnly  = true; 
+    attack.rangeTiles = 1; 
+    attack.cooldown   = CD_SWORD;
+    attack.swingTime  = 0.15f; 
+    attack.shape      = MeleeShape::Line; 
 
-    gAttack.swinging   = true;
-    gAttack.swingTimer = gAttack.swingTime;
-    gAttack.cdTimer    = gAttack.cooldown;
+    attack.swinging   = true;
+    attack.swingTimer = attack.swingTime;
+    attack.cdTimer    = attack.cooldown;
     
     IVec2 center{px, py};
-    gAttack.lastTiles = computeMeleeTilesOccluded(
-        center, gAttack.lastDir, gAttack.rangeTiles, gAttack.frontOnly, map);
-
-    bool hit = false;
-    
-    // 1. CHEQUEO CONTRA ENEMIGOS NORMALES
-    for (size_t i = 0; i < enemies.size(); ++i) {
-        IVec2 epos = {enemies[i].getX(), enemies[i].getY()};
-        for (const auto& t : gAttack.lastTiles) {
-            if (t.x == epos.x && t.y == epos.y) {
-                hit = true;
-                PlaySound(sfxHit);
-
-                if (enemyHP.size() != enemies.size()) enemyHP.assign(enemies.size(), ENEMY_BASE_HP);
-                
-                enemyHP[i] -= dmg;
-
-                Vector2 ePos = { (float)enemies[i].getX() * tileSize + 8, 
-                                 (float)enemies[i].getY() * tileSize - 10 };
-                spawnFloatingText(ePos, dmg, trailColor);
-
-                if (i < enemyFlashTimer.size()) enemyFlashTimer[i] = 0.15f;
-
-                std::cout << "[Sword] Slash! -" << dmg << "\n";
-
-                if (i < enemyAtkCD.size()) enemyAtkCD[i] = 0.0f; 
-                int dx = px - enemies[i].getX();
-                int dy = py - enemies[i].getY();
-                if (i < enemyFacing.size()) {
-                    if (std::abs(dx) >= std::abs(dy)) enemyFacing[i] = (dx > 0) ? EnemyFacing::Right : EnemyFacing::Left;
-                    else enemyFacing[i] = (dy > 0) ? EnemyFacing::Down : EnemyFacing::Up;
-                }
-                break;
-            }
+    computeMeleeShapeOccluded(center, attack.lastDir, attack.shape,
+                              attack.rangeTiles, map, attack.lastTiles);
+
+    // 1. CHEQUEO CONTRA ENEMIGOS NORMALES (por ocupación de casilla)
+    const SpatialGrid &occ = enemyOccupancy();
+    for (const auto& t : attack.lastTiles) {
+        for (int id = occ.first(t.x, t.y); id != SpatialGrid::NONE; id = occ.next(id)) {
+            queueEnemyDamage((size_t)id, dmg, trailColor);
+            std::cout << "[Sword] Slash! -" << dmg << "\n";
         }
     }
 
     // 2. NUEVO: CHEQUEO CONTRA EL BOSS (Faltaba esto)
     if (boss.active) {
-        for (const auto& t : gAttack.lastTiles) {
+        for (const auto& t : attack.lastTiles) {
             // Hitbox generosa del boss (Centro +/- 1 tile)
             if (std::abs(t.x - boss.x) <= 1 && std::abs(t.y - boss.y) <= 1) {
-                hit = true;
-                boss.hp -= dmg;
-                boss.flashTimer = 0.15f;
-                
-                PlaySound(sfxHit);
-                spawnFloatingText({(float)boss.x*tileSize, (float)boss.y*tileSize}, dmg, trailColor);
-                
-                std::cout << "[Boss] Slashed! HP: " << boss.hp << "\n";
+                queueBossDamage(dmg, {(float)boss.x*tileSize, (float)boss.y*tileSize}, trailColor, 0.15);
+                std::cout << "[Boss] Slashed! HP: " << boss.hp - dmg << "\n";
                 break; 
             }
         }
     }
-    
-     if (hit) {
-         std::vector<size_t> toRemove;
-         for(size_t i=0; i<enemyHP.size(); ++i) if(enemyHP[i] <= 0) toRemove.push_back(i);
-         if (!toRemove.empty()) {
-            std::sort(toRemove.rbegin(), toRemove.rend());
-            for (size_t idx : toRemove) {
-                float ex = enemies[idx].getX() * tileSize + tileSize / 2.0f;
-                float ey = enemies[idx].getY() * tileSize + tileSize / 2.0f;
-                spawnExplosion({ex, ey}, 15, DARKGRAY);
-                spawnExplosion({ex, ey}, 5, RED); 
-                
-                PlaySound(sfxExplosion);
-
-                enemies.erase(enemies.begin() + idx);
-                if (idx < enemyFacing.size()) enemyFacing.erase(enemyFacing.begin() + idx);
-                if (idx < enemyHP.size()) enemyHP.erase(enemyHP.begin() + idx);
-                if (idx < enemyAtkCD.size()) enemyAtkCD.erase(enemyAtkCD.begin() + idx);
-                if (idx < enemyShootCD.size()) enemyShootCD.erase(enemyShootCD.begin() + idx);
-                if (idx < enemyFlashTimer.size()) enemyFlashTimer.erase(enemyFlashTimer.begin() + idx);
-            }
-        }
-    }
-
-    enemyTryAttackFacing();
+    // Vida, muertes y contraataque: resolveDamage() al final del frame
 }
 
-void Game::performPlasmaAttack() {
-    plasmaCooldown = CD_PLASMA;
+void GameSim::performPlasmaAttack() {
+    plasmaReadyAt = simTime + CD_PLASMA;
     spawnProjectile(DMG_PLASMA);
 
     if (plasmaTier >= 2) {
@@ -233,26 +122,20 @@ void Game::performPlasmaAttack() {
     }
 }
 
-void Game::spawnProjectile(int dmg) {
-    Projectile p;
-    p.pos = { px * (float)tileSize + tileSize/2.0f, py * (float)tileSize + tileSize/2.0f };
+void GameSim::spawnProjectile(int dmg) {
+    FVec2 pos = { px * (float)tileSize + tileSize/2.0f, py * (float)tileSize + tileSize/2.0f };
     
-    Vector2 dir = { (float)gAttack.lastDir.x, (float)gAttack.lastDir.y };
+    FVec2 dir = { (float)attack.lastDir.x, (float)attack.lastDir.y };
     if (dir.x == 0 && dir.y == 0) dir = {0, 1};
 
     float len = std::sqrt(dir.x*dir.x + dir.y*dir.y);
     if (len > 0) { dir.x/=len; dir.y/=len; }
 
-    p.vel = { dir.x * PLASMA_SPEED, dir.y * PLASMA_SPEED };
-    p.maxDistance = PLASMA_RANGE_TILES * tileSize;
-    p.distanceTraveled = 0.0f;
-    p.damage = dmg;
-    p.active = true;
-
-    projectiles.push_back(p);
+    projectiles.spawn(pos.x, pos.y, dir.x * PLASMA_SPEED, dir.y * PLASMA_SPEED,
+                      PLASMA_RANGE_TILES * tileSize, dmg, ProjectilePool::Player);
 }
 
-void Game::updateProjectiles(float dt) {
+void GameSim::updateProjectiles(float dt) {
     // 1. Burst Jugador
     if (burstShotsLeft > 0) {
         burstTimer -= dt;
@@ -263,147 +146,202 @@ void Game::updateProjectiles(float dt) {
         }
     }
 
-    // 2. Movimiento y Colisiones
-    for (auto &p : projectiles) {
-        if (!p.active) continue;
-
-        float step = std::sqrt(p.vel.x*p.vel.x + p.vel.y*p.vel.y) * dt;
-        p.pos.x += p.vel.x * dt;
-        p.pos.y += p.vel.y * dt;
-        p.distanceTraveled += step;
-
-        if (p.distanceTraveled >= p.maxDistance) {
-            p.active = false;
-            continue;
-        }
-
-        // Paredes
-        int tx = (int)(p.pos.x / tileSize);
-        int ty = (int)(p.pos.y / tileSize);
-        if (tx < 0 || ty < 0 || tx >= map.width() || ty >= map.height() || 
-            map.at(tx, ty) == WALL) {
-            p.active = false; 
-            continue;
-        }
+    // 2. Movimiento (todo el pool de una vez, sin ramas)
+    projectiles.integrate(dt);
+
+    // 3. Colisiones barridas: cada bala recorre el segmento de este frame
+    // (de la posición anterior a la actual) y gana el primer impacto en el
+    // tiempo, sea muro, jugador, enemigo o boss. No depende del dt.
+    // Broadphase: índice de ocupación de enemigos por casilla.
+    const SpatialGrid &occ = enemyOccupancy();
+
+    const float ts = (float)tileSize;
+    const FVec2 pCenter = { px * ts + ts/2.0f, py * ts + ts/2.0f };
+    const float playerRad = ts * 0.4f; // Hitbox pequeña para esquivar
+    const float enemyRad = ts * 0.6f;
+    const float bossRad = 45.0f;       // Hitbox generosa para el boss
+    const int W = map.width(), H = map.height();
+
+    // Se recorre de atrás hacia delante: kill() mueve el último al hueco,
+    // que ya está procesado.
+    for (size_t k = projectiles.size(); k-- > 0;) {
+        const float x1 = projectiles.x(k), y1 = projectiles.y(k);
+        const float x0 = x1 - projectiles.vx(k) * dt;
+        const float y0 = y1 - projectiles.vy(k) * dt;
+
+        // Si el alcance se agotó a mitad de frame, el tramo útil es menor
+        float tEnd = 1.0f;
+        const float stepLen = projectiles.speed(k) * dt;
+        const bool expired = projectiles.range(k) <= 0.0f;
+        if (expired)
+            tEnd = (stepLen > 0.0f) ? std::max(0.0f, 1.0f + projectiles.range(k) / stepLen) : 0.0f;
+        const float ex1 = x0 + (x1 - x0) * tEnd;
+        const float ey1 = y0 + (y1 - y0) * tEnd;
+
+        // Muros: DDA por las casillas del tramo (fuera del mapa = muro)
+        float tWall = rb::traverseTiles(x0, y0, ex1, ey1, ts, [&](int tx, int ty, float) {
+            return tx < 0 || ty < 0 || tx >= W || ty >= H || map.at(tx, ty) == WALL;
+        });
+        const float tLimit = (tWall >= 0.0f) ? tWall : 1.0f;
+        const float hx = x0 + (ex1 - x0) * tLimit; // Hasta donde llega de verdad
+        const float hy = y0 + (ey1 - y0) * tLimit;
+
+        const int damage = projectiles.damage(k);
+        bool consumed = false;
 
         // LÓGICA DE IMPACTO
-        if (p.isEnemy) {
+        if (projectiles.isEnemy(k)) {
             // --- BALA ENEMIGA -> JUGADOR ---
-            Vector2 pCenter = { px * (float)tileSize + tileSize/2.0f, py * (float)tileSize + tileSize/2.0f };
-            float dx = p.pos.x - pCenter.x;
-            float dy = p.pos.y - pCenter.y;
-            float rad = tileSize * 0.4f; // Hitbox pequeña para esquivar
-
-            if (dx*dx + dy*dy < rad*rad) {
-                p.active = false;
-                takeDamage(p.damage); 
+            const float t = rb::sweptCircle(x0, y0, hx, hy, pCenter.x, pCenter.y, playerRad);
+            if (t >= 0.0f) {
+                consumed = true;
+                takeDamage(damage); 
                 // Feedback visual
-                spawnFloatingText(p.pos, p.damage, RED);
-                break;
+                FVec2 hitPos = { x0 + (hx - x0) * t, y0 + (hy - y0) * t };
+                spawnFloatingText(hitPos, damage, Palette::Red);
             }
         } 
         else {
             // --- BALA JUGADOR -> ...
             
             // A. Chequeo vs ENEMIGOS NORMALES
-            bool hitSomething = false;
-            for (size_t i = 0; i < enemies.size(); ++i) {
-                Vector2 ePos = { 
-                    enemies[i].getX() * (float)tileSize + tileSize/2.0f,
-                    enemies[i].getY() * (float)tileSize + tileSize/2.0f
-                };
-                
-                float dx = p.pos.x - ePos.x;
-                float dy = p.pos.y - ePos.y;
-                float rad = tileSize * 0.6f; 
-
-                if (dx*dx + dy*dy < rad*rad) {
-                    p.active = false;
-                    hitSomething = true;
-                    PlaySound(sfxHit);
-
-                    if (enemyHP.size() != enemies.size()) enemyHP.assign(enemies.size(), 100);
-                    enemyHP[i] -= p.damage;
-
-                    Vector2 txtPos = { (float)enemies[i].getX() * tileSize + 8, 
-                                       (float)enemies[i].getY() * tileSize - 10 };
-                    spawnFloatingText(txtPos, p.damage, SKYBLUE); 
-
-                    if (i < enemyFlashTimer.size()) enemyFlashTimer[i] = 0.15f;
-        
-                    // Provocación
-                    if (i < enemyAtkCD.size()) enemyAtkCD[i] = 0.0f;
-                    int edx = px - enemies[i].getX();
-                    int edy = py - enemies[i].getY();
-                    if (i < enemyFacing.size()) {
-                        if (std::abs(edx) >= std::abs(edy)) enemyFacing[i] = (edx > 0) ? EnemyFacing::Right : EnemyFacing::Left;
-                        else enemyFacing[i] = (edy > 0) ? EnemyFacing::Down : EnemyFacing::Up;
-                    }
-
-                    break; 
-                }
+            // Candidatos: los de las casillas que cruza el tramo y sus
+            // vecinas (el radio de impacto es menor que una casilla y media).
+            // Gana el primer contacto; a igualdad, el de menor índice.
+            int hitIdx = -1;
+            float hitT = 2.0f;
+            rb::traverseTiles(x0, y0, hx, hy, ts, [&](int tx, int ty, float tEnter) {
+                // Un contacto en t se encuentra desde la casilla donde está
+                // la bala en t, que se entra en un instante <= t: pasado
+                // hitT ya no puede aparecer nada anterior.
+                if (hitIdx >= 0 && tEnter > hitT) return true;
+                occ.forEachNear(tx, ty, 1, [&](int id) {
+                    const float t = rb::sweptCircle(x0, y0, hx, hy,
+                        enemies[id].getX() * ts + ts/2.0f,
+                        enemies[id].getY() * ts + ts/2.0f, enemyRad);
+                    if (t < 0.0f) return;
+                    if (t < hitT || (t == hitT && id < hitIdx)) { hitT = t; hitIdx = id; }
+                });
+                return false;
+            });
+
+            // B. Chequeo vs BOSS
+            float bossT = -1.0f;
+            if (boss.active) {
+                bossT = rb::sweptCircle(x0, y0, hx, hy,
+                    boss.x * ts + ts/2.0f, boss.y * ts + ts/2.0f, bossRad);
             }
 
-            // B. NUEVO: Chequeo vs BOSS (Faltaba esto)
-            if (!hitSomething && boss.active) {
-                Vector2 bossPos = { boss.x * (float)tileSize + tileSize/2.0f, boss.y * (float)tileSize + tileSize/2.0f };
-                float dx = p.pos.x - bossPos.x;
-                float dy = p.pos.y - bossPos.y;
-                // Hitbox generosa para el boss (Radio de 45px aprox)
-                float bossRad = 45.0f; 
-
-                if (dx*dx + dy*dy < bossRad*bossRad) {
-                    p.active = false;
-                    boss.hp -= p.damage;
-                    boss.flashTimer = 0.1f;
-                    
-                    PlaySound(sfxHit);
-                    spawnFloatingText(p.pos, p.damage, PURPLE);
-                }
+            if (hitIdx >= 0 && (bossT < 0.0f || hitT <= bossT)) {
+                consumed = true;
+                queueEnemyDamage((size_t)hitIdx, damage, Palette::SkyBlue);
+            } else if (bossT >= 0.0f) {
+                consumed = true;
+                // Mismo ancla que el melee: la ráfaga se suma en un número
+                queueBossDamage(damage, {(float)boss.x*tileSize, (float)boss.y*tileSize}, Palette::Purple, 0.1);
             }
         }
+
+        // Impacto, muro o alcance agotado: la bala desaparece
+        if (consumed || tWall >= 0.0f || expired) projectiles.kill(k);
     }
+}
 
-    projectiles.erase(
-        std::remove_if(projectiles.begin(), projectiles.end(), 
-            [](const Projectile& p){ return !p.active; }),
-        projectiles.end()
-    );
+// -----------------------------------------------------------------------------
+// DAÑO POR LOTES
+// -----------------------------------------------------------------------------
 
-    // 3. Limpieza de muertos
-    std::vector<size_t> toRemove;
-    for(size_t i=0; i<enemyHP.size(); ++i) {
-        if (enemyHP[i] <= 0) toRemove.push_back(i);
-    }
-    if (!toRemove.empty()) {
-        std::sort(toRemove.rbegin(), toRemove.rend());
-        for (size_t idx : toRemove) {
-            float ex = enemies[idx].getX() * tileSize + tileSize / 2.0f;
-            float ey = enemies[idx].getY() * tileSize + tileSize / 2.0f;
-            spawnExplosion({ex, ey}, 15, DARKGRAY);
-            spawnExplosion({ex, ey}, 5, RED); 
-            PlaySound(sfxExplosion);
-
-            enemies.erase(enemies.begin() + idx);
-            if (idx < enemyFacing.size()) enemyFacing.erase(enemyFacing.begin() + idx);
-            if (idx < enemyHP.size()) enemyHP.erase(enemyHP.begin() + idx);
-            if (idx < enemyAtkCD.size()) enemyAtkCD.erase(enemyAtkCD.begin() + idx);
-            if (idx < enemyShootCD.size()) enemyShootCD.erase(enemyShootCD.begin() + idx); 
-            if (idx < enemyFlashTimer.size()) enemyFlashTimer.erase(enemyFlashTimer.begin() + idx);
+void GameSim::queueEnemyDamage(size_t i, int amount, uint32_t color) {
+    if (i >= enemies.size()) return;
+    DamageEvent e;
+    e.enemy = i;
+    e.amount = amount;
+    e.color = color;
+    damageEvents.push_back(e);
+}
+
+void GameSim::queueBossDamage(int amount, FVec2 textPos, uint32_t color, double flashFor) {
+    DamageEvent e;
+    e.boss = true;
+    e.amount = amount;
+    e.color = color;
+    e.textPos = textPos;
+    e.flashFor = flashFor;
+    damageEvents.push_back(e);
+}
+
+void GameSim::resolveDamage() {
+    // Una sola pasada por los golpes del frame. Los índices de enemigo siguen
+    // valiendo porque nadie borra enemigos hasta aquí (streamPopulation
+    // resuelve antes de aparcar).
+    if (!damageEvents.empty()) {
+        if (enemyHP.size() != enemies.size()) enemyHP.assign(enemies.size(), ENEMY_BASE_HP);
+        enemyProvoked.resize(enemies.size(), 0);
+        bool wokeSomeone = false;
+
+        for (const auto& e : damageEvents) {
+            if (e.boss) {
+                boss.hp -= e.amount;
+                boss.flashUntil = simTime + e.flashFor;
+                spawnFloatingText(e.textPos, e.amount, e.color);
+                continue;
+            }
+            const size_t i = e.enemy;
+            if (i >= enemies.size()) continue;
+
+            enemyHP[i] -= e.amount;
+
+            FVec2 txtPos = { (float)enemies[i].getX() * tileSize + 8, 
+                               (float)enemies[i].getY() * tileSize - 10 };
+            spawnFloatingText(txtPos, e.amount, e.color);
+
+            if (i < enemyFlashUntil.size()) enemyFlashUntil[i] = simTime + e.flashFor;
+
+            // PROVOCACIÓN (IA Agresiva): contraataca ya y no se vuelve a dormir
+            if (i < enemyAtkReadyAt.size()) enemyAtkReadyAt[i] = simTime;
+            enemyProvoked[i] = 1;
+            if (i >= enemyAwake.size() || !enemyAwake[i]) wokeSomeone = true;
+            int dx = px - enemies[i].getX();
+            int dy = py - enemies[i].getY();
+            if (i < enemyFacing.size()) {
+                if (std::abs(dx) >= std::abs(dy)) enemyFacing[i] = (dx > 0) ? EnemyFacing::Right : EnemyFacing::Left;
+                else enemyFacing[i] = (dy > 0) ? EnemyFacing::Down : EnemyFacing::Up;
+            }
+        }
+        damageEvents.clear();
+        onSimEvent(SimEvent::EnemyHit); // Un solo golpe sonoro aunque sean muchos
+
+        // Muertes: EXPLOSIONES + SONIDO y borrado de todos en una pasada
+        enemyDoomed.assign(enemies.size(), 0);
+        bool anyDead = false;
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            if (enemyHP[i] > 0) continue;
+            float ex = enemies[i].getX() * tileSize + tileSize / 2.0f;
+            float ey = enemies[i].getY() * tileSize + tileSize / 2.0f;
+            spawnExplosion({ex, ey}, 15, Palette::DarkGray);
+            spawnExplosion({ex, ey}, 5, Palette::Red);
+            enemyDoomed[i] = 1;
+            anyDead = true;
         }
+        if (anyDead) {
+            onSimEvent(SimEvent::EnemyKilled);
+            eraseEnemySlots(enemyDoomed); // Borra de todos los vectores paralelos
+        }
+        if (anyDead || wokeSomeone) refreshEnemyActivity();
     }
-    
+
     enemyTryAttackFacing();
 }
 
-void Game::updateShooters(float dt) {
-    for (size_t i = 0; i < enemies.size(); ++i) {
+void GameSim::updateShooters(float dt) {
+    // Los shooters dormidos (lejos del jugador) no pueden acertar: se saltan
+    for (size_t i : activeEnemies) {
         // Solo procesamos Shooters vivos
         if (enemies[i].getType() != Enemy::Shooter) continue;
         if (enemyHP[i] <= 0) continue; 
 
-        // Chequear Cooldown (Tiempo Real)
-        if (enemyShootCD[i] > 0.0f) continue;
+        // Chequear Cooldown (instante absoluto del reloj de simulación)
+        if (simTime < enemyShootReadyAt[i]) continue;
 
         const int ex = enemies[i].getX();
         const int ey = enemies[i].getY();
@@ -433,146 +371,45 @@ void Game::updateShooters(float dt) {
         else if (dy > 0) enemyFacing[i] = EnemyFacing::Down;
         else if (dy < 0) enemyFacing[i] = EnemyFacing::Up;
 
-        // B. Crear el Proyectil Enemigo
-        Projectile p;
-        p.isEnemy = true; // Importante: Daña al jugador
-        p.active = true;
-        p.damage = 1; // 1 = Medio Corazón
-        p.maxDistance = 7.0f * tileSize;
-        p.pos = { ex * (float)tileSize + tileSize/2.0f, ey * (float)tileSize + tileSize/2.0f };
-        
+        // B. Crear el Proyectil Enemigo (daña al jugador)
+        // 1 = Medio Corazón; velocidad lenta esquivable
         IVec2 dir = facingToDir(enemyFacing[i]);
-        p.vel = { dir.x * 150.0f, dir.y * 150.0f }; // Velocidad lenta esquivable
-        
-        projectiles.push_back(p);
+        projectiles.spawn(ex * (float)tileSize + tileSize/2.0f, ey * (float)tileSize + tileSize/2.0f,
+                          dir.x * 150.0f, dir.y * 150.0f, 7.0f * tileSize, 1,
+                          ProjectilePool::Enemy);
         
         // C. Reiniciar Cooldown (Dispara cada 2.5 segundos)
-        enemyShootCD[i] = 2.5f; 
+        enemyShootReadyAt[i] = simTime + 2.5;
         
         // D. Efectos
-        PlaySound(sfxDash); // Reusamos el sonido de aire/silenciador
-    }
-}
-
-void Game::spawnExplosion(Vector2 pos, int count, Color color) {
-    for (int i = 0; i < count; ++i) {
-        Particle p;
-        p.pos = pos;
-        
-        // Velocidad aleatoria en 360 grados
-        float angle = (float)GetRandomValue(0, 360) * DEG2RAD;
-        float speed = (float)GetRandomValue(50, 150); // Rapidez variable
-        
-        p.vel = { cosf(angle) * speed, sinf(angle) * speed };
-        
-        p.maxLife = (float)GetRandomValue(5, 10) / 10.0f; // Entre 0.5s y 1.0s
-        p.life = p.maxLife;
-        
-        p.size = (float)GetRandomValue(2, 5); // Tamaños variados
-        p.color = color;
-        
-        particles.push_back(p);
-    }
-}
-
-void Game::updateParticles(float dt) {
-    for (auto &p : particles) {
-        p.life -= dt;
-        
-        // Movimiento
-        p.pos.x += p.vel.x * dt;
-        p.pos.y += p.vel.y * dt;
-        
-        // Fricción (las partículas se frenan un poco)
-        p.vel.x *= 0.95f;
-        p.vel.y *= 0.95f;
-        
-        // Opcional: Hacerlas más pequeñas al morir
-        if (p.life < 0.5f) p.size *= 0.98f;
+        onSimEvent(SimEvent::EnemyFired); // El frontend reusa el sonido del dash
     }
-
-    // Borrar partículas muertas
-    particles.erase(
-        std::remove_if(particles.begin(), particles.end(), 
-            [](const Particle& p){ return p.life <= 0.0f; }),
-        particles.end()
-    );
 }
 
-void Game::drawParticles() const {
-    for (const auto& p : particles) {
-        // Fade out (se vuelven transparentes al final)
-        float alpha = p.life / p.maxLife;
-        Color c = Fade(p.color, alpha);
-        
-        DrawRectangleV(p.pos, {p.size, p.size}, c);
-    }
+void GameSim::spawnExplosion(FVec2 pos, int count, uint32_t rgba) {
+    // Velocidad, vida y tamaño aleatorios (ver ParticlePool::burst). El color
+    // viaja empaquetado en RGBA.
+    particles.burst(pos.x, pos.y, count, rgba);
 }
 
-void Game::drawSlash() const {
-    if (!slashActive) return;
-
-    // Calculamos el centro del jugador
-    Vector2 center = { 
-        px * (float)tileSize + tileSize / 2.0f, 
-        py * (float)tileSize + tileSize / 2.0f 
-    };
-
-    // Radio del corte (un poco más grande que el tile para que sobresalga)
-    float radiusInner = tileSize * 0.5f;
-    float radiusOuter = tileSize * 1.2f;
-
-    // Ángulos del arco (120 grados de amplitud)
-    float startAngle = slashBaseAngle - 60.0f;
-    float endAngle   = slashBaseAngle + 60.0f;
-
-    // Fade Out (Se vuelve transparente al final)
-    // 0.15f es la duración total del golpe
-    float alpha = std::clamp(slashTimer / 0.15f, 0.0f, 1.0f); 
-    Color c = Fade(slashColor, alpha);
-
-    // Dibujamos el arco
-    DrawRing(center, radiusInner, radiusOuter, startAngle, endAngle, 16, c);
+void GameSim::updateParticles(float dt) {
+    // Movimiento, fricción, encogido y limpieza de muertas, todo en el pool
+    particles.update(dt);
 }
 
 // SISTEMA DE TEXTOS FLOTANTES
-void Game::spawnFloatingText(Vector2 pos, int value, Color color) {
-    FloatingText ft;
-    // Un poco de aleatoriedad en la posición para que no se solapen si hay muchos
-    float offsetX = (float)(rand() % 16 - 8); 
-    ft.pos = { pos.x + offsetX, pos.y };
-    ft.value = value;
-    ft.lifeTime = 0.8f; // Duran 0.8 segundos
-    ft.timer = ft.lifeTime;
-    ft.color = color;
-    floatingTexts.push_back(ft);
+void GameSim::spawnFloatingText(FVec2 pos, int value, uint32_t rgba) {
+    // La clave de objetivo es la casilla del ancla: los textos de un mismo
+    // enemigo (o del jugador, o del boss) salen siempre del mismo punto, así
+    // que sus golpes seguidos se suman en un solo número.
+    const float ts = (float)tileSize;
+    const uint32_t tx = (uint32_t)(int)std::floor(pos.x / ts) & 0xFFFF;
+    const uint32_t ty = (uint32_t)(int)std::floor(pos.y / ts) & 0xFFFF;
+    floatingTexts.spawn(pos.x, pos.y, value, rgba, (tx << 16) | ty);
 }
 
-void Game::updateFloatingTexts(float dt) {
-    for (auto &ft : floatingTexts) {
-        ft.timer -= dt;
-        // El texto sube hacia arriba (eje Y negativo)
-        ft.pos.y -= 30.0f * dt; 
-    }
-
-    // Borrar textos expirados
-    floatingTexts.erase(
-        std::remove_if(floatingTexts.begin(), floatingTexts.end(), 
-            [](const FloatingText& ft){ return ft.timer <= 0.0f; }),
-        floatingTexts.end()
-    );
+void GameSim::updateFloatingTexts(float dt) {
+    // Subida, fade y limpieza, todo en el pool
+    floatingTexts.update(dt);
 }
 
-void Game::drawFloatingTexts() const {
-    for (const auto& ft : floatingTexts) {
-        // Calcular transparencia (fade out)
-        float alpha = ft.timer / ft.lifeTime;
-        Color c = ft.color;
-        c.a = (unsigned char)(255.0f * alpha);
-
-        // Dibujar borde negro para que se lea bien
-        const char* txt = TextFormat("%d", ft.value);
-        DrawText(txt, (int)ft.pos.x + 1, (int)ft.pos.y + 1, 10, Fade(BLACK, alpha)); // Sombra
-        DrawText(txt, (int)ft.pos.x, (int)ft.pos.y, 10, c); // Texto
-    }
-}
\ No newline at end of file
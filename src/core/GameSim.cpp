@@ -0,0 +1,833 @@
+#include "GameSim.hpp"
+#include "GameUtils.hpp"
+#include "I18n.hpp"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+
+static inline unsigned now_seed() {
+  return static_cast<unsigned>(time(nullptr));
+}
+
+GameSim::GameSim(unsigned seed) : fixedSeed(seed) {}
+
+unsigned GameSim::nextRunSeed() const {
+  return fixedSeed > 0 ? fixedSeed : now_seed();
+}
+
+unsigned GameSim::seedForLevel(unsigned base, int level) const {
+  const unsigned MIX = 0x9E3779B9u;
+  return base ^ (MIX * static_cast<unsigned>(level));
+}
+
+void GameSim::startRun(const RunSetup &setup) {
+  fixedSeed = setup.seed;
+  difficulty = setup.difficulty;
+  hordeCount = setup.hordeCount;
+  setViewport(setup.viewW, setup.viewH);
+  newRun(setup.horde);
+}
+
+RunSetup GameSim::getRunSetup() const {
+  RunSetup r;
+  r.seed = runSeed;
+  r.difficulty = difficulty;
+  r.horde = hordeMode;
+  r.hordeCount = hordeCount;
+  r.viewW = screenW;
+  r.viewH = screenH;
+  return r;
+}
+
+std::uint64_t GameSim::stateHash() const {
+  std::uint64_t h = simTicks;
+  auto mix = [&h](std::uint64_t v) { h = RngStream::mix(h, v); };
+  mix((std::uint64_t)currentLevel);
+  mix((std::uint64_t)state);
+  mix((std::uint64_t)px);
+  mix((std::uint64_t)py);
+  mix((std::uint64_t)hp);
+  mix((std::uint64_t)hpMax);
+  mix((std::uint64_t)hasKey);
+  mix((std::uint64_t)godMode);
+  mix(levelRng.stateWord());
+  mix(spawnRng.stateWord());
+  mix((std::uint64_t)enemies.size());
+  for (size_t i = 0; i < enemies.size(); ++i) {
+    mix((std::uint64_t)enemies[i].getX());
+    mix((std::uint64_t)enemies[i].getY());
+    mix((std::uint64_t)(i < enemyHP.size() ? enemyHP[i] : 0));
+  }
+  mix((std::uint64_t)projectiles.size());
+  mix((std::uint64_t)boss.hp);
+  mix((std::uint64_t)boss.x);
+  mix((std::uint64_t)boss.y);
+  mix((std::uint64_t)boss.attackCycle);
+  return h;
+}
+
+void GameSim::newRun(bool horde) {
+  hordeMode = horde;
+  runSeed = nextRunSeed();
+  std::cout << _("[Run] Seed base del run: ") << runSeed << "\n";
+
+  // Reiniciar estado básico
+  currentLevel = 1;
+  state = GameState::Playing;
+  moveCooldown = 0.0f;
+  lastStepMode = true;
+  hp = 10;
+  hpMax = 10;
+
+  // Reiniciar Inventario y Power-Ups
+  hasKey = false;
+
+  // Reloj de simulación y temporizadores (cooldowns, escudo, gafas...)
+  resetSimClock();
+  simTicks = 0;
+
+  // Escudo
+  hasShield = false;
+
+  // Batería (Vida extra)
+  hasBattery = false;
+
+  // Gafas 3D (Visión)
+  glassesFovMod = 0; // Resetear el modificador de visión extra
+
+  // Armas
+  swordTier = 0;
+  plasmaTier = 0;
+
+  // Reiniciar modo Dios (Seguridad)
+  godMode = false;
+  map.setRevealAll(false); // Apagar la luz del modo dios
+
+  // Reiniciar contexto de mejoras entre niveles
+  runCtx.espadaMejorasObtenidas = 0;
+  runCtx.plasmaMejorasObtenidas = 0;
+
+  // Reiniciar lógica de ataque
+  attack = AttackRuntime{};
+  attack.shape = MeleeShape::Line;
+
+  // Limpiar proyectiles y entidades
+  projectiles.clear();
+  clearBossCombat();
+  floatingTexts.clear(); // Limpiar números flotantes viejos
+  particles.clear();     // Limpiar explosiones viejas
+
+  // Reset boss
+  boss = Boss{};
+
+  onSimEvent(SimEvent::RunStarted);
+  newLevel(currentLevel);
+}
+
+void GameSim::newLevel(int level) {
+  // Lógica especial para Nivel 4 (Boss)
+
+  projectiles.clear(); // Limpiar balas
+  clearBossCombat();   // Patrones del boss a medias y su planificador
+  clearEnemies();      // Limpiar enemigos anteriores (y vectores paralelos)
+  items.clear();       // Limpiar items
+
+  // Cola de turnos nueva. En el nivel del boss el jugador se mueve en tiempo
+  // real y no ocupa turno: solo el boss usa la cola.
+  resetTurns(level != maxLevels);
+  enemyVision.reset(); // Mapa nuevo: la caché de sombras ya no sirve
+
+  levelSeed = seedForLevel(runSeed, level);
+  levelRng.reseed(levelSeed, RngStream::Level);
+  spawnRng.reseed(levelSeed, RngStream::Spawn);
+  fxRng.reseed(levelSeed, RngStream::Fx);
+  particles.reseed(fxRng());
+  floatingTexts.reseed(fxRng());
+
+  if (level == maxLevels) { // Nivel Final
+    std::cout << _("[Level] FINAL BOSS LEVEL Initializing...\n");
+
+    // 1. Generar Arena a pantalla completa
+    // Calculamos cuántos tiles caben en la pantalla
+    int arenaW = screenW / tileSize;
+    int arenaH = screenH / tileSize;
+
+    // Generamos la arena con esas dimensiones
+    map.generateBossArena(arenaW, arenaH);
+
+    // 2. Configurar Visibilidad
+    map.setFogEnabled(false);
+
+    // 3. Posicionar Jugador (Abajo centro)
+    px = arenaW / 2;
+    py = arenaH - 4; // Un poco separado del borde
+
+    fovTiles = 100;
+    map.computeVisibility(px, py, fovTiles);
+
+    hasKey = false;
+    spawnBoss();
+  } else {
+    // Niveles normales (1, 2, 3)
+    const float WORLD_SCALE = 1.2f;
+    int tilesX = (int)std::ceil((screenW / (float)tileSize) * WORLD_SCALE);
+    int tilesY = (int)std::ceil((screenH / (float)tileSize) * WORLD_SCALE);
+    if (hordeMode) {
+      // Horda: mapa ampliado para que quepa la multitud
+      tilesX = std::max(tilesX, hordeMapSide());
+      tilesY = std::max(tilesY, hordeMapSide());
+    }
+
+    std::cout << _("[Level] ") << level << "/" << maxLevels
+              << _(" (seed nivel: ") << levelSeed << ")\n";
+
+    map.generate(tilesX, tilesY, levelSeed);
+    map.setFogEnabled(true); // Asegurar niebla activada
+
+    fovTiles = defaultFovFromViewport();
+
+    auto r = map.firstRoom();
+    if (r.w > 0 && r.h > 0) {
+      px = r.x + r.w / 2;
+      py = r.y + r.h / 2;
+    } else {
+      px = tilesX / 2;
+      py = tilesY / 2;
+    }
+
+    map.computeVisibility(px, py, getFovRadius());
+
+    hasKey = false;
+    if (hordeMode)
+      spawnHorde();
+    else
+      spawnEnemiesForLevel();
+
+    // Generar items
+    std::vector<IVec2> enemyTiles;
+    for (const auto &e : enemies)
+      enemyTiles.push_back({e.getX(), e.getY()});
+    std::vector<std::pair<int, int>> parked; // Aparcados por el streaming
+    population.dormantTiles(parked);
+    for (const auto &t : parked)
+      enemyTiles.push_back({t.first, t.second});
+    auto isWalkable = [&](int x, int y) { return map.isWalkable(x, y); };
+    IVec2 spawnTile{px, py};
+    auto [exitX, exitY] = map.findExitTile();
+    IVec2 exitTile{exitX, exitY};
+
+    items =
+        ItemSpawner::generate(map.width(), map.height(), isWalkable, spawnTile,
+                              exitTile, enemyTiles, level, levelRng, runCtx);
+  }
+
+  influence.reset(map); // Rejillas tácticas del tamaño del nuevo mapa
+
+  // El frontend coloca aquí la cámara (fija en la arena del boss)
+  onSimEvent(SimEvent::LevelStarted);
+}
+
+// Spawn del Boss
+void GameSim::spawnBoss() {
+  boss.active = true;
+  boss.awakened = false; // Empieza dormido
+
+  // Posición del Boss: Centro arriba
+  boss.x = map.width() / 2;
+  boss.y = 4;
+
+  // Guardamos dónde está el jugador al entrar
+  boss.playerStartX = px;
+  boss.playerStartY = py;
+
+  // Configurar Vida según Dificultad
+  int baseHp = 800;
+  float diffMult = (difficulty == Difficulty::Easy)   ? 0.5f
+                   : (difficulty == Difficulty::Hard) ? 1.5f
+                                                      : 1.0f;
+
+  boss.maxHp = (int)(baseHp * diffMult);
+  boss.hp = boss.maxHp;
+
+  boss.phase = 1;
+  boss.facing = Boss::DOWN;
+
+  std::cout << _("[BOSS] SPAWNED. Waiting for movement...\n");
+}
+
+void GameSim::updateBoss(float dt) {
+  // 0. Verificar muerte
+  if (boss.hp <= 0) {
+    boss.active = false;
+    clearBossCombat();
+    spawnExplosion({(float)boss.x * tileSize, (float)boss.y * tileSize}, 200,
+                   Palette::Gold);
+    state = GameState::Victory;
+    onSimEvent(SimEvent::Victory);
+    return;
+  }
+
+  boss.animTime += dt * 3.0f;
+
+  // 1. Mecánica de despertar
+  // Si tu posición (px, py) es distinta a la inicial.
+  if (!boss.awakened) {
+    if (px != boss.playerStartX || py != boss.playerStartY) {
+      boss.awakened = true;
+      onSimEvent(SimEvent::BossAwakened); // Rugido
+      spawnFloatingText(
+          {(float)boss.x * tileSize, (float)boss.y * tileSize - 20}, 0,
+          Palette::Red);
+      std::cout << _("[BOSS] AWAKENED! TIEMBLA MORTAL!\n");
+    } else {
+      // Si el jugador dispara al boss dormido, lo despierta también
+      if (boss.hp < boss.maxHp)
+        boss.awakened = true;
+      else
+        return; // Sigue durmiendo
+    }
+  }
+
+  // 2. Configuración de fases
+  float hpPercent = (float)boss.hp / (float)boss.maxHp;
+
+  float phaseMoveDelay = 1.0f;
+  float phaseFireDelay = 2.0f;
+  int phaseDmg = 1;
+
+  // Fase 1 (100-75%)
+  if (hpPercent > 0.75f) {
+    boss.phase = 1;
+    phaseMoveDelay = 0.8f;
+    phaseFireDelay = 2.0f;
+    phaseDmg = 1;
+  }
+  // Fase 2 (75-50%)
+  else if (hpPercent > 0.50f) {
+    boss.phase = 2;
+    phaseMoveDelay = 0.6f;
+    phaseFireDelay = 1.5f;
+    phaseDmg = 2;
+  }
+  // Fase 3 (50-25%)
+  else if (hpPercent > 0.25f) {
+    boss.phase = 3;
+    phaseMoveDelay = 0.4f;
+    phaseFireDelay = 1.0f;
+    phaseDmg = 3;
+  }
+  // Fase 4 (<25%)
+  else {
+    boss.phase = 4;
+    phaseMoveDelay = 0.25f;
+    phaseFireDelay = 0.6f;
+    phaseDmg = 4;
+    if (fxRng.range(0, 10) < 2)
+      spawnExplosion({(float)boss.x * tileSize, (float)boss.y * tileSize}, 1,
+                     Palette::Red);
+  }
+
+  // Ajustes por Dificultad
+  float diffSpeedMult = 1.0f, diffFireMult = 1.0f;
+  int diffDmgBonus = 0;
+  if (difficulty == Difficulty::Easy) {
+    diffSpeedMult = 1.3f;
+    diffFireMult = 1.5f;
+  }
+  if (difficulty == Difficulty::Hard) {
+    diffSpeedMult = 0.8f;
+    diffFireMult = 0.7f;
+    diffDmgBonus = 1;
+  }
+
+  float finalMoveDelay = phaseMoveDelay * diffSpeedMult;
+  float finalFireDelay = phaseFireDelay * diffFireMult;
+  int finalDmg = phaseDmg + diffDmgBonus;
+
+  // 3. Turnos del boss (tiempo real)
+  // Paso y disparo son dos actores de la cola de turnos. Su velocidad sale
+  // del retardo de la fase: 1 s entre acciones = velocidad normal (100).
+  const ActorScheduler::Tick nowTick = static_cast<ActorScheduler::Tick>(
+      simTime * BOSS_TURN_TICKS_PER_SECOND);
+  auto speedFor = [](float delay) {
+    return std::max(1, (int)std::lround(ActorScheduler::NORMAL_SPEED / delay));
+  };
+
+  if (!turns.contains(bossMoveActor)) {
+    // Recién despertado: primer paso en 1 s y primer disparo en 2 s
+    turns.advanceTo(nowTick);
+    bossMoveActor = turns.add(speedFor(finalMoveDelay), 0,
+                              1 * BOSS_TURN_TICKS_PER_SECOND);
+    bossFireActor = turns.add(speedFor(finalFireDelay), 0,
+                              2 * BOSS_TURN_TICKS_PER_SECOND);
+    submitBossPlan(); // Que vaya pensando el primer paso
+  }
+  // Al cambiar de fase el nuevo ritmo se aplica desde la siguiente acción
+  turns.setSpeed(bossMoveActor, speedFor(finalMoveDelay));
+  turns.setSpeed(bossFireActor, speedFor(finalFireDelay));
+
+  bool moveTurn = false, fireTurn = false;
+  while (!turns.empty() && turns.peekTime() <= nowTick) {
+    const auto id = turns.pop();
+    if (id == bossMoveActor)
+      moveTurn = true;
+    else if (id == bossFireActor)
+      fireTurn = true;
+  }
+  turns.advanceTo(nowTick);
+
+  // Decisión del planificador: la del encargo del último paso, que se
+  // recoge en el primer turno que la usa (esperando al hilo si hace falta).
+  // Siempre en el mismo tick y con la misma respuesta: la partida es
+  // reproducible también aquí.
+  BossPlanner::Decision fresh;
+  if ((moveTurn || fireTurn) && bossPlanner.wait(fresh))
+    bossPlan = fresh;
+  const bool planReady = bossPlan.valid && bossPlan.request == bossPlanRequest;
+  const int plannedAttack =
+      (planReady && bossPlan.phase == boss.phase) ? bossPlan.attack : -1;
+
+  // Movimiento
+  if (moveTurn) {
+    int dx = px - boss.x, dy = py - boss.y;
+    const int planX = boss.x + bossPlan.dx, planY = boss.y + bossPlan.dy;
+
+    if (planReady && map.isWalkable(planX, planY) &&
+        !(planX == px && planY == py)) {
+      // Paso elegido por el planificador (quedarse quieto también vale)
+      boss.x = planX;
+      boss.y = planY;
+    } else if (std::abs(dx) > 1 || std::abs(dy) > 1) {
+      // Camino real por el grafo de navegación (rodea obstáculos)
+      const auto [nx, ny] = map.nav().nextStep(boss.x, boss.y, px, py);
+      if (nx != boss.x || ny != boss.y) {
+        boss.x = nx;
+        boss.y = ny;
+      } else {
+        // Sin camino: avance por ejes de siempre
+        int stepX = 0, stepY = 0;
+        if (std::abs(dx) >= std::abs(dy))
+          stepX = (dx > 0) ? 1 : -1;
+        else
+          stepY = (dy > 0) ? 1 : -1;
+
+        if (map.isWalkable(boss.x + stepX, boss.y + stepY)) {
+          boss.x += stepX;
+          boss.y += stepY;
+        } else {
+          if (stepX != 0)
+            stepY = (dy > 0) ? 1 : -1;
+          else
+            stepX = (dx > 0) ? 1 : -1;
+          if (map.isWalkable(boss.x + stepX, boss.y + stepY)) {
+            boss.x += stepX;
+            boss.y += stepY;
+          }
+        }
+      }
+    }
+    if (std::abs(dx) > std::abs(dy))
+      boss.facing = (dx > 0) ? Boss::RIGHT : Boss::LEFT;
+    else
+      boss.facing = (dy > 0) ? Boss::DOWN : Boss::UP;
+
+    submitBossPlan(); // Encarga ya la decisión del siguiente paso
+  }
+
+  // 4. Ataque (Disparo)
+  // Cada turno de disparo arranca el siguiente ataque de la tabla de la fase
+  // (ver BulletPatternEngine::bossAttacks); el motor emite sus descargas a lo
+  // largo de los frames siguientes.
+  const float ts = (float)tileSize;
+  const FVec2 bossCenter = {boss.x * ts + ts / 2.0f, boss.y * ts + ts / 2.0f};
+  const FVec2 playerCenter = {px * ts + ts / 2.0f, py * ts + ts / 2.0f};
+  if (fireTurn) {
+    BulletPatternEngine::Shot shot;
+    shot.speed = 250.0f + (boss.phase * 50.0f);
+    shot.range = 1000.0f;
+    shot.damage = finalDmg;
+
+    // El ataque lo elige el planificador si tiene uno para esta fase; si
+    // no, el siguiente de la tabla
+    const auto &attacks = BulletPatternEngine::bossAttacks(boss.phase);
+    const size_t pick = (plannedAttack >= 0 && (size_t)plannedAttack < attacks.size())
+                            ? (size_t)plannedAttack
+                            : (size_t)boss.attackCycle % attacks.size();
+    const BulletAttack &attack = attacks[pick];
+    boss.attackCycle++;
+    for (const BulletPattern &p : attack)
+      bossBullets.trigger(p, simTime, playerCenter.x, playerCenter.y, shot);
+
+    if (boss.phase == 4)
+      onSimEvent(SimEvent::BossBlast);
+  }
+  bossBullets.update(simTime, bossCenter.x, bossCenter.y, playerCenter.x,
+                     playerCenter.y, projectiles);
+
+  // 5. Colisión Melee
+  if (std::abs(px - boss.x) <= 1 && std::abs(py - boss.y) <= 1) {
+    if (!isInvulnerable()) {
+      takeDamage(finalDmg + 1);
+      invulnUntil = simTime + DAMAGE_COOLDOWN;
+      int pushX = (px > boss.x) ? 2 : (px < boss.x ? -2 : 0);
+      int pushY = (py > boss.y) ? 2 : (py < boss.y ? -2 : 0);
+      if (map.isWalkable(px + pushX, py + pushY)) {
+        px += pushX;
+        py += pushY;
+      } else if (map.isWalkable(px + pushX / 2, py + pushY / 2)) {
+        px += pushX / 2;
+        py += pushY / 2;
+      }
+      spawnFloatingText({(float)px * tileSize, (float)py * tileSize},
+                        finalDmg + 1, Palette::Red);
+    }
+  }
+}
+
+void GameSim::submitBossPlan() {
+  // Foto de la arena alrededor del boss para el planificador
+  BossPlanner::Arena a;
+  BossPlanner::captureWindow(
+      boss.x, boss.y, [this](int x, int y) { return map.isWalkable(x, y); },
+      a);
+  a.bossX = boss.x;
+  a.bossY = boss.y;
+  a.playerX = px;
+  a.playerY = py;
+  a.playerDx = attack.lastDir.x;
+  a.playerDy = attack.lastDir.y;
+  a.phase = boss.phase;
+  bossPlanArena = a;
+  bossPlanRequest = bossPlanner.submit(a);
+}
+
+void GameSim::clearBossCombat() {
+  bossBullets.clear();
+  bossPlanner.reset();
+  bossPlan = BossPlanner::Decision{};
+  bossPlanRequest = 0;
+}
+
+// Implementación del toggle
+void GameSim::toggleGodMode(bool enable) {
+  godMode = enable;
+
+  // Le decimos al mapa que lo revele todo (o vuelva a la normalidad)
+  map.setRevealAll(godMode);
+
+  if (godMode) {
+    std::cout << _("[GOD MODE] ACTIVADO - IDDQD\n");
+
+    onSimEvent(SimEvent::GodModeOn);
+    // Mensaje visual (puedes usar tu sistema de texto flotante)
+    spawnFloatingText({(float)px * tileSize, (float)py * tileSize}, 9999,
+                      Palette::Gold); // Truco visual
+
+    // Opcional: Curar al jugador
+    hp = hpMax;
+  } else {
+    std::cout << _("[GOD MODE] DESACTIVADO\n");
+    // Al desactivar, forzamos un recálculo de visión para que
+    // la niebla vuelva a aparecer correctamente alrededor del jugador.
+    // Sonido de error/apagado (ej. Hurt o Loose)
+    onSimEvent(SimEvent::GodModeOff);
+    map.computeVisibility(px, py, getFovRadius());
+  }
+}
+
+// Un tick de partida: primero la entrada del jugador, luego el mundo. El
+// frontend llama aquí una vez por tick del paso fijo; un bot o un test lo
+// llaman en bucle, sin ventana y tan rápido como dé la CPU.
+void GameSim::step(const TickInput &in) {
+  if (state != GameState::Playing)
+    return;
+  simTicks++;
+  applyTickInput(in, FixedTimestep::TICK);
+  if (state != GameState::Playing)
+    return; // La entrada cerró el nivel o la partida
+  simulateTick(FixedTimestep::TICK);
+}
+
+void GameSim::simulateTick(float dt) {
+  // El reloj avanza también durante el dash: los cooldowns son exactos
+  advanceSimClock(dt);
+
+  // Dash
+  if (isDashing) {
+    dashTimer -= dt;
+
+    // Efectos visuales
+    if (fxRng.range(0, 10) < 8) {
+      float t = 1.0f - (dashTimer / DASH_DURATION);
+      FVec2 lerpPos = {dashStartPos.x + (dashEndPos.x - dashStartPos.x) * t,
+                         dashStartPos.y + (dashEndPos.y - dashStartPos.y) * t};
+      // spawnExplosion(lerpPos, 1, SKYBLUE);
+    }
+
+    if (dashTimer <= 0.0f)
+      isDashing = false;
+
+    return;
+  }
+
+  tryAutoPickup();
+
+  if (slashActive) {
+    slashTimer -= dt;
+    if (slashTimer <= 0.0f)
+      slashActive = false;
+  }
+
+  // Solo los enemigos activos (cerca del jugador) se animan; los dormidos
+  // quedan congelados hasta que el jugador se acerque.
+  for (size_t i : activeEnemies)
+    enemies[i].updateAnimation(dt);
+
+  {
+    FrameProfiler::Scope t(profiler, PerfEnemyAI);
+    if (boss.active) {
+      updateBoss(dt);
+    } else {
+      updateShooters(dt);
+    }
+  }
+
+  {
+    FrameProfiler::Scope t(profiler, PerfProjectiles);
+    updateProjectiles(dt);
+    resolveDamage(); // Golpes del frame (ataques + balas) de una vez
+  }
+  {
+    FrameProfiler::Scope t(profiler, PerfEffects);
+    updateFloatingTexts(dt);
+    updateParticles(dt);
+  }
+
+  if (currentLevel < maxLevels && map.at(px, py) == EXIT) {
+    if (hasKey)
+      onExitReached();
+  }
+
+  // El temblor lo pinta el frontend sobre la cámara; aquí solo se agota
+  if (shakeTimer > 0.0f)
+    shakeTimer -= dt;
+
+  if (hp <= 0) {
+    if (hasBattery) {
+      hasBattery = false;
+      hp = hpMax / 2;
+      if (hp < 1)
+        hp = 1;
+      std::cout << _("[Bateria] Resucitado.\n");
+      invulnUntil = simTime + 2.0;
+      shakeTimer = 0.5f;
+      onSimEvent(SimEvent::PlayerRevived);
+    } else {
+      state = GameState::GameOver;
+      attack.swinging = false;
+      attack.lastTiles.clear();
+      onSimEvent(SimEvent::Defeat);
+    }
+    return;
+  }
+
+}
+
+void GameSim::applyTickInput(const TickInput &in, float dt) {
+  if (in.toggleGod)
+    toggleGodMode(!godMode);
+
+  // Cambio de modo de movimiento: la repetición empieza sin espera
+  if (in.stepMode != lastStepMode) {
+    lastStepMode = in.stepMode;
+    moveCooldown = 0.0f;
+  }
+
+  // Interacción (Pickup)
+  if (in.interact)
+    tryManualPickup();
+
+  // --------------------------------------------------------
+  // 1. Dash (Esquiva)
+  // --------------------------------------------------------
+  if (in.dash && !isDashing && simTime >= dashReadyAt) {
+    // Prioridad: dirección mantenida ahora; si no, última dirección
+    int ddx = in.holdX, ddy = in.holdY;
+    if (ddx == 0 && ddy == 0) {
+      ddx = attack.lastDir.x;
+      ddy = attack.lastDir.y;
+    }
+
+    if (ddx != 0 || ddy != 0) {
+      int targetX = px;
+      int targetY = py;
+
+      // Calcular destino (hasta DASH_DISTANCE)
+      for (int i = 1; i <= DASH_DISTANCE; i++) {
+        int nextX = px + ddx * i;
+        int nextY = py + ddy * i;
+        if (!map.isWalkable(nextX, nextY))
+          break; // Pared
+
+        bool enemyBlock = false;
+        for (const auto &e : enemies)
+          if (e.getX() == nextX && e.getY() == nextY)
+            enemyBlock = true;
+        if (enemyBlock)
+          break; // Enemigo
+
+        targetX = nextX;
+        targetY = nextY;
+      }
+
+      if (targetX != px || targetY != py) {
+        // Configurar estado Dash
+        isDashing = true;
+        dashTimer = DASH_DURATION;
+        dashReadyAt = simTime + DASH_COOLDOWN;
+
+        dashStartPos = {px * (float)tileSize, py * (float)tileSize};
+        dashEndPos = {targetX * (float)tileSize, targetY * (float)tileSize};
+
+        px = targetX;
+        py = targetY;
+
+        onSimEvent(SimEvent::PlayerDashed);
+
+        onSuccessfulStep(0, 0);
+        return;
+      }
+    }
+  }
+
+  // --------------------------------------------------------
+  // 2. Movimiento normal
+  // --------------------------------------------------------
+  bool moved = false;
+
+  if (in.stepMode) {
+    const int dx = in.stepX, dy = in.stepY;
+    if (dx != 0 || dy != 0) {
+      attack.lastDir = {dx, dy};
+      onSimEvent(SimEvent::PlayerTurned);
+      int oldx = px, oldy = py;
+      tryMove(dx, dy);
+      moved = (px != oldx || py != oldy);
+      if (moved)
+        onSuccessfulStep(dx, dy);
+    }
+  } else {
+    moveCooldown -= dt;
+    const int dx = in.holdX, dy = in.holdY;
+
+    if (dx != 0 || dy != 0) {
+      attack.lastDir = {dx, dy};
+      onSimEvent(SimEvent::PlayerTurned);
+    }
+
+    if (in.movePressed || ((dx != 0 || dy != 0) && moveCooldown <= 0.0f)) {
+      int oldx = px, oldy = py;
+      tryMove(dx, dy);
+      moved = (px != oldx || py != oldy);
+      if (moved)
+        onSuccessfulStep(dx, dy);
+      moveCooldown = MOVE_INTERVAL;
+    }
+  }
+
+  // --------------------------------------------------------
+  // 3. Sistema de combate
+  // --------------------------------------------------------
+  attack.cdTimer = std::max(0.f, attack.cdTimer - dt);
+
+  if (attack.swinging) {
+    attack.swingTimer = std::max(0.f, attack.swingTimer - dt);
+    if (attack.swingTimer <= 0.f) {
+      attack.swinging = false;
+      attack.lastTiles.clear();
+    }
+  }
+
+  // A) Puños
+  if (in.attackHands && attack.cdTimer <= 0.f)
+    performMeleeAttack();
+
+  // B) Espada
+  if (in.attackSword) {
+    if (swordTier > 0) {
+      if (attack.cdTimer <= 0.f)
+        performSwordAttack();
+    } else {
+      std::cout << "No tienes espada\n";
+    }
+  }
+
+  // C) Pistola Plasma
+  if (in.attackPlasma) {
+    if (plasmaTier > 0) {
+      if (simTime >= plasmaReadyAt)
+        performPlasmaAttack();
+    } else {
+      std::cout << "No tienes plasma\n";
+    }
+  }
+}
+
+// Reloj de simulación
+void GameSim::advanceSimClock(float dt) {
+  // Todos los cooldowns se comparan contra simTime, así que avanzarlo es
+  // lo único que hay que hacer por frame. La rueda solo ejecuta los
+  // temporizadores que vencen en este intervalo (escudo, gafas...).
+  simTime += dt;
+  timers.advance(simTime);
+}
+
+void GameSim::resetSimClock() {
+  simTime = 0.0;
+  timers.reset(0.0);
+  shieldTimerId = TimerWheel::INVALID_TIMER;
+  glassesTimerId = TimerWheel::INVALID_TIMER;
+
+  invulnUntil = 0.0;
+  shieldUntil = 0.0;
+  glassesUntil = 0.0;
+  dashReadyAt = 0.0;
+  plasmaReadyAt = 0.0;
+}
+
+void GameSim::onExitReached() {
+  // En la horda solo hay un nivel: salir con la llave es ganar
+  if (hordeMode) {
+    state = GameState::Victory;
+    onSimEvent(SimEvent::Victory);
+    return;
+  }
+
+  // Si completamos nivel 3, vamos al 4 (Boss)
+  if (currentLevel < maxLevels) {
+    currentLevel++;
+    newLevel(currentLevel);
+  }
+}
+
+int GameSim::getFovRadius() const {
+  int r = fovTiles;
+  if (simTime < glassesUntil) {
+    r += glassesFovMod;
+  }
+  return std::clamp(r, 2, 30);
+}
+
+int GameSim::defaultFovFromViewport() const {
+  int tilesX = screenW / tileSize;
+  int tilesY = screenH / tileSize;
+  int r = static_cast<int>(std::floor(std::min(tilesX, tilesY) * 0.15f));
+  return std::clamp(r, 3, 20);
+}
+
+void GameSim::recomputeFovIfNeeded() {
+  if (map.fogEnabled()) {
+    map.computeVisibility(px, py, getFovRadius());
+  }
+}
@@ -0,0 +1,576 @@
+#ifndef GAME_SIM_HPP
+#define GAME_SIM_HPP
+
+#include "ActorScheduler.hpp"
+#include "BossPlanner.hpp"
+#include "BulletPatterns.hpp"
+#include "Enemy.hpp"
+#include "EnemyVision.hpp"
+#include "FixedTimestep.hpp"
+#include "FloatingTextPool.hpp"
+#include "FrameProfiler.hpp"
+#include "InfluenceMap.hpp"
+#include "ItemSpawner.hpp"
+#include "Map.hpp"
+#include "MeleeAttack.hpp"
+#include "ParticlePool.hpp"
+#include "PopulationStreamer.hpp"
+#include "ProjectilePool.hpp"
+#include "RngStream.hpp"
+#include "SpatialGrid.hpp"
+#include "StateBuffer.hpp"
+#include "TickInput.hpp"
+#include "TimerWheel.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Simulación de la partida (sin ventana ni audio)
+// Mapa, jugador, enemigos, combate, IA, objetos y boss: todo lo que decide
+// cómo va la partida, sin una sola llamada a raylib. Avanza a golpe de
+// step(TickInput), así que corre igual detrás de la ventana del juego que
+// en un test, un bot o un benchmark sin pantalla (miles de ticks/segundo).
+//
+// Clave de diseño: la simulación no dibuja ni suena, avisa. Lo que el
+// frontend tiene que reflejar (sonidos, cámara, sprite del jugador) sale
+// como un SimEvent por onSimEvent(); sin frontend, el aviso no hace nada.
+// Los colores de los efectos van empaquetados en RGBA (Palette) y las
+// posiciones en FVec2: ningún tipo de raylib cruza esta frontera.
+
+// Posición en píxeles de mundo (textos flotantes, partículas, dash)
+struct FVec2 {
+  float x = 0.0f, y = 0.0f;
+};
+
+// Colores de efectos: RGBA empaquetado (r | g<<8 | b<<16 | a<<24), con los
+// mismos valores que la paleta de raylib para que nada cambie en pantalla
+namespace Palette {
+constexpr std::uint32_t rgba(std::uint8_t r, std::uint8_t g, std::uint8_t b,
+                             std::uint8_t a = 255) {
+  return (std::uint32_t)r | ((std::uint32_t)g << 8) |
+         ((std::uint32_t)b << 16) | ((std::uint32_t)a << 24);
+}
+inline constexpr std::uint32_t White = rgba(255, 255, 255);
+inline constexpr std::uint32_t RayWhite = rgba(245, 245, 245);
+inline constexpr std::uint32_t Red = rgba(230, 41, 55);
+inline constexpr std::uint32_t SkyBlue = rgba(102, 191, 255);
+inline constexpr std::uint32_t Lime = rgba(0, 158, 47);
+inline constexpr std::uint32_t Purple = rgba(200, 122, 255);
+inline constexpr std::uint32_t DarkGray = rgba(80, 80, 80);
+inline constexpr std::uint32_t Gold = rgba(255, 203, 0);
+} // namespace Palette
+
+// Estructuras de datos auxiliares (Entidades ligeras)
+// Golpe pendiente de aplicar (buffer de daño del frame)
+// Melee, espada y proyectiles solo los apuntan; resolveDamage() los aplica
+// todos juntos una vez por frame.
+struct DamageEvent {
+  size_t enemy = 0; // Índice del enemigo (si no es al boss)
+  bool boss = false;
+  int amount = 0;
+  std::uint32_t color = Palette::White; // Color del número flotante
+  FVec2 textPos{};                      // Solo boss: dónde sale el número
+  double flashFor = 0.15;
+};
+
+// Enums de estado
+// Modo de movimiento del jugador:
+// StepByStep: Clásico Roguelike (1 pulsación = 1 paso). Preciso.
+// RepeatCooldown: Tipo Action-RPG (mantener pulsado para correr). Fluido.
+enum class MovementMode { StepByStep, RepeatCooldown };
+
+enum class GameState {
+  MainMenu,
+  Playing,
+  Paused,
+  Victory,
+  GameOver,
+  OptionsMenu,
+  Tutorial
+};
+
+// Dificultad del juego. Permite seleccionar entre modos Fácil, Medio y Difícil.
+// Esto afecta al número de enemigos y a su salud en cada nivel.
+enum class Difficulty { Easy, Medium, Hard };
+
+// Avisos de la simulación al frontend (ver GameSim::onSimEvent)
+enum class SimEvent : std::uint8_t {
+  RunStarted,    // newRun: partida nueva
+  LevelStarted,  // newLevel: mapa nuevo y jugador colocado
+  StateRestored, // loadSnapshot: todo el estado viene de una foto
+  PlayerMoved,   // Paso (o dash) completado: px/py nuevos
+  PlayerTurned,  // Nueva dirección de mirada (attack.lastDir)
+  PlayerDashed,
+  PlayerHurt,
+  PlayerRevived, // La batería de vida extra salta
+  EnemyHit,      // Golpes resueltos en el tick (uno o muchos)
+  EnemyKilled,   // Alguna baja en el tick
+  EnemyFired,    // Un shooter dispara
+  ItemPicked,
+  PowerUpPicked,
+  BossAwakened,
+  BossBlast,     // Ataque de la fase 4
+  GodModeOn,
+  GodModeOff,
+  Victory,
+  Defeat
+};
+
+// Todo lo que fija una partida antes del primer tick. Con esto y la entrada
+// de cada tick, la partida se repite idéntica (ver InputRecording).
+struct RunSetup {
+  unsigned seed = 0;
+  Difficulty difficulty = Difficulty::Medium;
+  bool horde = false;
+  int hordeCount = 0;
+  int viewW = 1280, viewH = 720; // Tamaño de la arena del boss y del FOV
+};
+
+// Foto del estado completo de una partida (ver GameSim::saveSnapshot)
+// Un único bloque de bytes: cabecera (formato, huella del binario, longitud
+// y suma) y el volcado de cada sistema en orden. Se puede copiar, guardar en memoria
+// tantas como haga falta (carga rápida, "reintentar nivel", clones para
+// buscar jugadas) y reutilizar: tomar otra foto en la misma no reserva.
+struct SimSnapshot {
+  static constexpr std::uint32_t VERSION = 2;
+
+  std::vector<std::uint8_t> bytes; // Vacío = sin foto
+  std::uint64_t tick = 0;          // getTick() al tomarla
+  int level = 0;
+
+  bool empty() const { return bytes.empty(); }
+  std::size_t size() const { return bytes.size(); }
+  void clear() { bytes.clear(); } // Conserva la memoria
+  // ¿Es de este formato y de este binario, y está entera? (recorre la foto:
+  // microsegundos)
+  bool compatible() const;
+};
+
+struct Boss {
+  bool active = false;
+  bool awakened = false; // ¿Se ha despertado ya?
+  int x = 0, y = 0;      // Posición lógica del Boss
+
+  // Para detectar si el jugador se ha movido
+  int playerStartX = 0;
+  int playerStartY = 0;
+
+  int hp = 0;
+  int maxHp = 0;
+  int phase = 1; // Fase 1, 2, 3, 4
+  int attackCycle = 0; // Siguiente ataque de la tabla de su fase
+
+  // Dirección
+  enum Facing { UP, DOWN, LEFT, RIGHT } facing = DOWN;
+
+  // Temporizadores de Combate
+  // El ritmo de paso y de disparo lo marca el planificador de turnos
+  // (GameSim::bossMoveActor / GameSim::bossFireActor) según la fase.
+  double flashUntil = 0.0;     // Feedback de daño rojo (instante de fin)
+  float animTime = 0.0f;       // Animación
+};
+
+class GameSim {
+public:
+  explicit GameSim(unsigned seed = 0);
+  virtual ~GameSim() = default;
+
+  // Uso sin ventana (tests, bots, benchmarks)
+  // startRun() empieza partida con la semilla del constructor (0 = reloj) y
+  // step() avanza un tick de FixedTimestep::TICK con la entrada dada.
+  // Fuera de GameState::Playing, step() no hace nada.
+  void startRun(bool horde = false) { newRun(horde); }
+  void startRun(const RunSetup &setup); // Misma partida que 'setup'
+  RunSetup getRunSetup() const;         // La de la partida en curso
+  void step(const TickInput &in);
+  std::uint64_t getTick() const { return simTicks; } // Ticks de esta partida
+
+  // Huella del estado que decide la partida (jugador, enemigos, balas,
+  // nivel). Dos partidas con la misma huella en el mismo tick van igual.
+  std::uint64_t stateHash() const;
+
+  // Fotos del estado (ver SimSnapshot)
+  // saveSnapshot() vuelca todo lo que decide la partida y lo que se ve de
+  // ella (mapa y niebla, enemigos, turnos, objetos, boss, balas, efectos,
+  // temporizadores, semillas y flujos RNG); loadSnapshot() lo repone entre
+  // dos ticks, aquí o en otro GameSim (clon). Tras cargar, los mismos
+  // TickInput dan la misma partida, boss incluido. Lo derivado no viaja:
+  // grafo de navegación, caché de visión e índice de ocupación se rehacen
+  // solo si hace falta. false, sin tocar nada, si la foto es de otro
+  // formato o de otro binario, o si está truncada o dañada.
+  void saveSnapshot(SimSnapshot &snap) const;
+  bool loadSnapshot(const SimSnapshot &snap);
+
+  // Tamaño de la vista en píxeles: fija el tamaño de la arena del boss, de
+  // los mapas y el radio de visión por defecto. El frontend pone la ventana.
+  void setViewport(int w, int h) {
+    screenW = w;
+    screenH = h;
+  }
+  void setDifficulty(Difficulty d) { difficulty = d; }
+  Difficulty getDifficulty() const { return difficulty; }
+  GameState getState() const { return state; }
+
+  // Getters públicos (Para el HUD y Renderizado)
+  // Son const porque el HUD solo lee, no modifica.
+
+  const std::vector<Enemy> &getEnemies() const { return enemies; }
+  const std::vector<ItemSpawn> &getItems() const { return items; }
+  const Boss &getBoss() const { return boss; }
+
+  int getScreenW() const { return screenW; }
+  int getScreenH() const { return screenH; }
+
+  // Semillas para reproducibilidad (Debug/Speedrun)
+  unsigned getRunSeed() const { return runSeed; }
+  unsigned getLevelSeed() const { return levelSeed; }
+
+  int getCurrentLevel() const { return currentLevel; }
+  int getMaxLevels() const { return maxLevels; }
+
+  const char *
+  movementModeText() const; // Texto para la UI ("Modo Pasos" / "Modo Continuo")
+
+  const Map &getMap() const { return map; }
+  int getPlayerX() const { return px; }
+  int getPlayerY() const { return py; }
+
+  int getFovRadius() const; // Radio de visión actual (afectado por Gafas 3D)
+
+  // Estadísticas del Jugador
+  int getHP() const { return hp; }
+  int getHPMax() const { return hpMax; }
+
+  // Estados de Power-Ups
+  bool isShieldActive() const { return hasShield; }
+  float getShieldTime() const { return remaining(shieldUntil); }
+  float getGlassesTime() const { return remaining(glassesUntil); }
+  float getDashCooldown() const { return remaining(dashReadyAt); }
+
+  // Inventario (llave y armas)
+  bool hasKeycard() const { return hasKey; }
+  int getSwordTier() const { return swordTier; }
+  int getPlasmaTier() const { return plasmaTier; }
+
+  // Modo Dios
+  bool isGodMode() const { return godMode; }
+
+  // Dirección del Enemigo (para saber qué sprite dibujar)
+  enum class EnemyFacing { Down, Up, Left, Right };
+
+protected:
+  // Aviso al frontend. Se llama en mitad del tick, con el estado ya
+  // actualizado; sin frontend (headless) no hace nada.
+  virtual void onSimEvent(SimEvent) {}
+
+  // Sistemas core
+  Map map;
+
+  // Vista (ver setViewport). Por defecto, la ventana web (1280x720).
+  int screenW = 1280;
+  int screenH = 720;
+  int tileSize = 32;
+
+  // Estado del Jugador
+  int px = 0, py = 0; // Posición en rejilla
+  int hp = 10;
+  int hpMax = 10;
+
+  // Reloj de simulación
+  // Los cooldowns se guardan como instantes absolutos ("listo en" / "hasta")
+  // contra 'simTime', que solo avanza mientras se juega. Un cooldown inactivo
+  // no cuesta nada por frame. Los efectos con consecuencia al terminar
+  // (escudo, gafas) se programan en la rueda de temporizadores.
+  double simTime = 0.0;
+  std::uint64_t simTicks = 0;
+  TimerWheel timers;
+  TimerWheel::TimerId shieldTimerId = TimerWheel::INVALID_TIMER;
+  TimerWheel::TimerId glassesTimerId = TimerWheel::INVALID_TIMER;
+
+  void advanceSimClock(float dt); // Avanza el reloj y dispara los vencidos
+  void resetSimClock();           // Nueva partida: reloj a 0 y sin timers
+
+  // Un tick: la entrada del jugador y después el mundo
+  void applyTickInput(const TickInput &in, float dt);
+  void simulateTick(float dt);
+  float remaining(double until) const {
+    return until > simTime ? static_cast<float>(until - simTime) : 0.0f;
+  }
+
+  // Invulnerabilidad tras recibir daño (i-frames)
+  double invulnUntil = 0.0;
+  const float DAMAGE_COOLDOWN = 0.4f;
+  bool isInvulnerable() const { return simTime < invulnUntil; }
+
+  // Generación Aleatoria (RNG)
+  unsigned fixedSeed = 0; // Si != 0, fuerza la semilla
+  unsigned runSeed = 0;   // Semilla global de la partida
+  unsigned levelSeed = 0; // Semilla específica del nivel actual
+  // Flujos deterministas derivados de levelSeed (ver RngStream)
+  RngStream levelRng; // Generación y colocación inicial del nivel
+  RngStream spawnRng; // Apariciones durante la partida
+  RngStream fxRng;    // Solo efectos visuales: no altera la partida
+
+  // Contexto persistente entre niveles (armas desbloqueadas, batería usada,
+  // etc.)
+  RunContext runCtx;
+
+  // Objetos en el suelo
+  std::vector<ItemSpawn> items;
+
+  // Gestión de enemigos
+  // Vectores paralelos (SoA - Structure of Arrays) para rendimiento
+  std::vector<Enemy> enemies;
+  std::vector<int> enemyHP;
+  std::vector<int> enemyMaxHP;
+  std::vector<double> enemyAtkReadyAt;    // Instante en que puede volver a atacar
+  std::vector<double> enemyShootReadyAt;  // Ídem para disparar (Shooter)
+  std::vector<double> enemyFlashUntil;    // Feedback visual de golpe (fin)
+  std::vector<EnemyFacing> enemyFacing;
+
+  int ENEMY_DETECT_RADIUS_PX = 32 * 6; // Radio de agresión
+
+  // Visión de los enemigos: cono de 120º hacia donde miran, con radio de
+  // agresión y bloqueada por muros. Se evalúa en lote en cada paso del
+  // jugador (enemySeesPlayer) con la caché por casilla de EnemyVision.
+  EnemyVision enemyVision{ENEMY_DETECT_RADIUS_PX / 32, 60.0f};
+  std::vector<uint8_t> enemySeesPlayer; // Resultado del último lote
+  void updateEnemyVision(const std::vector<size_t> &group);
+
+  // Comportamiento de grupo: mapas de influencia (amenaza del arma del
+  // jugador, aglomeración de enemigos, flancos libres). Se recalculan una vez
+  // por paso y los enemigos los muestrean al elegir casilla.
+  InfluenceMaps influence;
+  void updateInfluence();
+
+  // Nivel de detalle de la IA (LOD)
+  // Los enemigos fuera del radio de actividad quedan "dormidos": no animan,
+  // no descuentan cooldowns ni disparan. El coste por frame depende solo de
+  // los enemigos cercanos (los que están en 'activeEnemies').
+  int ENEMY_ACTIVE_RADIUS_TILES = 10;  // > radio de agresión y alcance shooter
+  std::vector<uint8_t> enemyAwake;     // 1 = activo, 0 = dormido
+  std::vector<uint8_t> enemyProvoked;  // Despertado por un golpe (no se duerme)
+  std::vector<size_t> activeEnemies;   // Índices de los enemigos activos
+
+  // Turnos (planificador por energía)
+  // Jugador, enemigos activos y boss comparten una cola de prioridad. En los
+  // niveles normales el reloj avanza con las acciones del jugador; en el
+  // nivel del boss avanza en tiempo real (BOSS_TURN_TICKS_PER_SECOND).
+  ActorScheduler turns;
+  ActorScheduler::ActorId playerActor = ActorScheduler::INVALID_ACTOR;
+  ActorScheduler::ActorId bossMoveActor = ActorScheduler::INVALID_ACTOR;
+  ActorScheduler::ActorId bossFireActor = ActorScheduler::INVALID_ACTOR;
+  int playerSpeed = ActorScheduler::NORMAL_SPEED; // > 100 = jugador acelerado
+  std::vector<ActorScheduler::ActorId> enemyActor; // INVALID si está dormido
+
+  void resetTurns(bool withPlayer); // Cola vacía (+ jugador) al cargar nivel
+  int enemySpeed(size_t i) const;   // Velocidad según el arquetipo
+  std::vector<std::vector<size_t>> collectEnemyTurns(); // Oleadas del turno
+
+  void refreshEnemyActivity();   // Reparte activos/dormidos según el jugador
+  // Borra los marcados en 'doomed' de todos los vectores paralelos (una
+  // pasada por vector, sin recalcular activos)
+  void eraseEnemySlots(const std::vector<uint8_t> &doomed);
+  void clearEnemies();           // Vacía todos los vectores paralelos
+
+  // Población por streaming
+  // Solo existen como enemigos vivos los que están cerca del jugador (hasta
+  // ENEMY_LIVE_CAP); el resto queda aparcado como registro en su sector.
+  // En mapas mayores que ENEMY_REFERENCE_MAP_TILES, enemyDensity > 0
+  // rellena además cada sector al entrar en rango.
+  PopulationStreamer population;
+  float enemyDensity = 0.0f; // Enemigos por casilla de suelo (0 = fijo)
+  std::vector<PopulationStreamer::Record> streamRestore; // Scratch por paso
+  std::vector<std::pair<int, int>> streamFresh;
+  void streamPopulation();                // Aparca/recupera + LOD
+  void reserveEnemySlots(size_t n);       // Pool de los vectores paralelos
+  void spawnEnemyAt(int x, int y, Enemy::Type t, int hp, int maxHp,
+                    EnemyFacing facing);
+  int enemyHpForLevel() const;
+  Enemy::Type rollEnemyType();
+
+  void spawnEnemiesForLevel();
+  int enemiesPerLevel(int lvl) const {
+    // Determina cuántos enemigos debe haber por nivel según la dificultad.
+    // Easy: 3,5,7  / Medium: 4,6,8  / Hard: 5,8,12
+    switch (difficulty) {
+    case Difficulty::Easy:
+      return (lvl == 1) ? 2 : (lvl == 2) ? 4 : 6;
+    case Difficulty::Medium:
+      return (lvl == 1) ? 3 : (lvl == 2) ? 5 : 7;
+    case Difficulty::Hard:
+    default:
+      return (lvl == 1) ? 4 : (lvl == 2) ? 7 : 11;
+    }
+  }
+
+  // IA: Mueve a los enemigos cuando el jugador se mueve
+  void updateEnemiesAfterPlayerMove(bool moved);
+  void enemyTryAttackFacing(); // IA: Intenta atacar si tiene rango
+  void takeDamage(int amount);
+
+  // Estado de la partida
+  GameState state = GameState::MainMenu;
+
+  MovementMode moveMode = MovementMode::StepByStep;
+  float moveCooldown = 0.0f;         // Temporizador para repetición de tecla
+  bool lastStepMode = true;          // Modo del tick anterior (TickInput)
+  const float MOVE_INTERVAL = 0.12f; // Velocidad de repetición
+
+  // Niveles
+  int currentLevel = 1;
+  const int maxLevels = 4;
+
+  // Transiciones de Nivel/Juego
+  void newRun(bool horde = false);
+  void newLevel(int level);
+
+  // Modo horda: un único nivel ampliado con miles de enemigos (melee y
+  // shooters) para medir que la IA, las colisiones y el render escalan.
+  // Llegar a la salida con la llave gana la partida.
+  bool hordeMode = false;
+  int hordeCount = 0;              // 0 = HORDE_DEFAULT_ENEMIES
+  int hordeMapSide() const;        // Lado del mapa según la población
+  void spawnHorde();
+
+  // Tiempos por sistema (el overlay de F3 los enseña; la simulación mide
+  // sus propias secciones)
+  enum PerfSection {
+    PerfInput,
+    PerfUpdate,
+    PerfEnemyAI,
+    PerfProjectiles,
+    PerfEffects,
+    PerfRender,
+    PerfRenderEnemies,
+    PerfSectionCount
+  };
+  FrameProfiler profiler{{"entrada", "update", "IA enemigos", "proyectiles",
+                          "efectos", "render", "render enemigos"}};
+  unsigned nextRunSeed() const;
+  unsigned seedForLevel(unsigned base, int level) const; // Hash determinista
+
+  // Temblor de pantalla pendiente (lo pinta el frontend)
+  float shakeTimer = 0.0f;
+
+  bool fogEnabled = true;
+  int fovTiles = 8;                   // Radio de visión base
+  int defaultFovFromViewport() const; // Calcula FOV según tamaño de vista
+  void recomputeFovIfNeeded();        // Raycasting de visión
+
+  // Gestión del Boss
+  Boss boss;                        // Instancia del jefe
+  BulletPatternEngine bossBullets;  // Patrones de disparo en curso
+  BossPlanner bossPlanner;          // Decide paso y ataque del boss
+  BossPlanner::Decision bossPlan;   // Última decisión recogida
+  uint64_t bossPlanRequest = 0;     // Encargo del que esperamos respuesta
+  BossPlanner::Arena bossPlanArena; // Foto del último encargo
+  void submitBossPlan();            // Foto de la arena -> planificador
+  void clearBossCombat();           // Balas en curso + planificador
+  void spawnBoss();
+  void updateBoss(float dt);
+
+  // Helpers colisión Boss (como es grande, necesitamos saber si un punto toca
+  // su "área")
+  bool isBossCell(int x, int y) const;
+
+  // Lógica de movimiento
+  void tryMove(int dx, int dy);          // Intenta mover, gestiona colisiones
+  void onSuccessfulStep(int dx, int dy); // Se llama si el movimiento fue válido
+  void onExitReached();                  // Jugador pisa la salida
+
+  // Inventario y habilidades pasivas
+  bool hasKey = false;    // Necesaria para pasar de nivel
+  bool hasShield = false; // Invulnerabilidad temporal
+  double shieldUntil = 0.0;
+  bool hasBattery = false; // Vida extra (1-UP)
+
+  // Gafas 3D (Modificadores de FOV)
+  double glassesUntil = 0.0;
+  int glassesFovMod = 0;
+
+  void activateShield(float seconds);  // Al expirar: escudo fuera
+  void breakShield();                  // Absorbe un golpe y cancela el timer
+  void activateGlasses(float seconds); // Al expirar: recalcular FOV
+  void armShieldTimer();               // Programa el fin en shieldUntil
+  void armGlassesTimer();              // Ídem en glassesUntil
+
+  // Niveles de armas (0 = sin arma, 1..3 = tiers)
+  int swordTier = 0;
+  int plasmaTier = 0;
+
+  // Recogida de objetos
+  void tryAutoPickup();   // Para la llave
+  void tryManualPickup(); // Para consumibles
+  void onPickup(const ItemSpawn &it);
+
+  // Sistema de combate avanzado (Proyectiles & Skills)
+  AttackRuntime attack;       // Golpe cuerpo a cuerpo en curso y dirección
+  ProjectilePool projectiles; // SoA de capacidad fija
+  // Índice de ocupación: enemigos por casilla (broadphase de balas y golpes).
+  // Se rehace perezosamente, solo si algún enemigo apareció, se movió o se
+  // borró desde la última consulta.
+  SpatialGrid enemyGrid;
+  bool enemyGridDirty = true;
+  const SpatialGrid &enemyOccupancy();
+
+  // Daño por lotes: todos los ataques apuntan aquí y se resuelven juntos
+  // (vida, muertes, efectos, sonido y contraataque) una vez por frame
+  std::vector<DamageEvent> damageEvents;
+  std::vector<uint8_t> enemyDoomed; // Scratch de resolveDamage
+  void queueEnemyDamage(size_t i, int amount, std::uint32_t color);
+  void queueBossDamage(int amount, FVec2 textPos, std::uint32_t color,
+                       double flashFor);
+  void resolveDamage();
+
+  double plasmaReadyAt = 0.0;
+  int burstShotsLeft = 0; // Para disparo en ráfaga (opcional)
+  float burstTimer = 0.0f;
+
+  bool slashActive = false;
+  float slashTimer = 0.0f;
+  float slashBaseAngle = 0.0f; // Ángulo central del corte
+  std::uint32_t slashColor = Palette::White;
+
+  void performMeleeAttack();     // Puñetazo
+  void performSwordAttack();     // Espadazo
+  void performPlasmaAttack();    // Disparo
+  void updateShooters(float dt); // Lógica de disparo de enemigos independiente
+
+  void spawnProjectile(int dmg);
+  void updateProjectiles(float dt);
+
+  // Efectos visuales (Juiciness)
+  // Son estado de la simulación (salen de golpes y muertes), pero solo el
+  // frontend los dibuja.
+  // Textos flotantes
+  FloatingTextPool floatingTexts; // Golpes al mismo objetivo se suman
+  void spawnFloatingText(FVec2 pos, int value, std::uint32_t color);
+  void updateFloatingTexts(float dt);
+
+  // Partículas
+  ParticlePool particles; // Anillo de capacidad fija
+  void spawnExplosion(FVec2 pos, int count, std::uint32_t color);
+  void updateParticles(float dt);
+
+  // Dificultad actual. Por defecto, modo Medio.
+  Difficulty difficulty = Difficulty::Medium;
+
+  // Modo Dios
+  bool godMode = false; // ¿Está activo el modo dios?
+  void toggleGodMode(bool enable);
+
+  // Habilidad activa: Dash (Esquiva)
+  bool isDashing = false;         // Estado de inmunidad/velocidad
+  float dashTimer = 0.0f;         // Duración del dash
+  double dashReadyAt = 0.0;       // Instante en que se recarga
+
+  const float DASH_DURATION = 0.15f;
+  const float DASH_COOLDOWN = 2.0f;
+  const int DASH_DISTANCE = 3; // Salta 3 casillas
+
+  FVec2 dashStartPos{}; // Para interpolación suave (Lerp)
+  FVec2 dashEndPos{};
+};
+
+#endif
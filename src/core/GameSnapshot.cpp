@@ -0,0 +1,272 @@
+#include "GameSim.hpp"
+#include <algorithm>
+#include <cstring>
+
+// -----------------------------------------------------------------------------
+// FOTOS DEL ESTADO (SimSnapshot)
+// -----------------------------------------------------------------------------
+// El orden de volcado es el de carga: cualquier campo nuevo va en los dos
+// sitios y sube SimSnapshot::VERSION.
+
+namespace {
+const char MAGIC[4] = {'R', 'B', 'S', 'S'};
+// Cabecera: marca, versión, huella, longitud y suma del volcado
+constexpr std::size_t SIZE_AT = 12, SUM_AT = 20, HEADER_BYTES = 28;
+
+// Huella del binario: las fotos llevan los structs tal cual están en
+// memoria, así que solo valen con los mismos tamaños y el mismo endianness
+std::uint32_t layoutFingerprint() {
+  std::uint64_t h = 1;
+  auto mix = [&h](std::uint64_t v) { h = RngStream::mix(h, v); };
+  const std::uint32_t probe = 0x01020304u;
+  mix(*reinterpret_cast<const std::uint8_t *>(&probe));
+  mix(sizeof(std::size_t));
+  mix(sizeof(Enemy));
+  mix(sizeof(ItemSpawn));
+  mix(sizeof(RunContext));
+  mix(sizeof(Boss));
+  mix(sizeof(BossPlanner::Arena));
+  mix(sizeof(BossPlanner::Decision));
+  mix(sizeof(AttackRuntime));
+  mix(sizeof(PopulationStreamer::Record));
+  mix(sizeof(RngStream));
+  mix(sizeof(FVec2));
+  return static_cast<std::uint32_t>(h ^ (h >> 32));
+}
+
+// Suma del volcado (tipo Fletcher sobre palabras de 64 bits): detecta
+// bytes cambiados y cortes, y cuesta lo que leer la foto una vez
+std::uint64_t payloadChecksum(const std::uint8_t *p, std::size_t n) {
+  std::uint64_t a = 0, b = 0;
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    std::uint64_t w;
+    std::memcpy(&w, p + i, sizeof(w));
+    a += w;
+    b += a;
+  }
+  std::uint64_t tail = 0;
+  std::memcpy(&tail, p + i, n - i);
+  a += tail;
+  b += a;
+  return RngStream::mix(RngStream::mix(n, a), b);
+}
+
+bool readHeader(StateReader &in, std::uint64_t &size, std::uint64_t &sum) {
+  char magic[4] = {};
+  std::uint32_t version = 0, layout = 0;
+  return in.raw(magic, sizeof(magic)) && in.pod(version) && in.pod(layout) &&
+         in.pod(size) && in.pod(sum) && std::equal(magic, magic + 4, MAGIC) &&
+         version == SimSnapshot::VERSION && layout == layoutFingerprint();
+}
+} // namespace
+
+bool SimSnapshot::compatible() const {
+  StateReader in(bytes.data(), bytes.size());
+  std::uint64_t size = 0, sum = 0;
+  return readHeader(in, size, sum) && size == in.remaining() &&
+         sum == payloadChecksum(bytes.data() + HEADER_BYTES, in.remaining());
+}
+
+void GameSim::saveSnapshot(SimSnapshot &snap) const {
+  StateWriter out(snap.bytes);
+  out.raw(MAGIC, sizeof(MAGIC));
+  out.pod(SimSnapshot::VERSION);
+  out.pod(layoutFingerprint());
+  out.pod(std::uint64_t{0}); // Longitud y suma: se rellenan al final
+  out.pod(std::uint64_t{0});
+
+  // El mapa primero: al cargar decide si hay que rehacer lo derivado
+  map.saveState(out);
+  out.pod(screenW);
+  out.pod(screenH);
+  out.pod(tileSize);
+
+  // Jugador y reloj. Los temporizadores no se copian (son callbacks):
+  // basta saber cuáles estaban pendientes, que su instante ya está guardado.
+  out.pod(px);
+  out.pod(py);
+  out.pod(hp);
+  out.pod(hpMax);
+  out.pod(simTime);
+  out.pod(simTicks);
+  out.pod(timers.isPending(shieldTimerId));
+  out.pod(timers.isPending(glassesTimerId));
+  out.pod(invulnUntil);
+
+  // Semillas y flujos RNG (fixedSeed es una opción de arranque, no estado)
+  out.pod(runSeed);
+  out.pod(levelSeed);
+  out.pod(levelRng);
+  out.pod(spawnRng);
+  out.pod(fxRng);
+  out.pod(runCtx);
+  out.vec(items);
+
+  // Enemigos (vectores paralelos), su IA y la población aparcada
+  out.vec(enemies);
+  out.vec(enemyHP);
+  out.vec(enemyMaxHP);
+  out.vec(enemyAtkReadyAt);
+  out.vec(enemyShootReadyAt);
+  out.vec(enemyFlashUntil);
+  out.vec(enemyFacing);
+  out.vec(enemySeesPlayer);
+  influence.saveState(out);
+  out.vec(enemyAwake);
+  out.vec(enemyProvoked);
+  out.vec(activeEnemies);
+  population.saveState(out);
+  out.pod(enemyDensity);
+
+  // Turnos
+  turns.saveState(out);
+  out.pod(playerActor);
+  out.pod(bossMoveActor);
+  out.pod(bossFireActor);
+  out.pod(playerSpeed);
+  out.vec(enemyActor);
+
+  // Partida
+  out.pod(state);
+  out.pod(moveCooldown);
+  out.pod(lastStepMode);
+  out.pod(currentLevel);
+  out.pod(hordeMode);
+  out.pod(hordeCount);
+  out.pod(difficulty);
+  out.pod(godMode);
+  out.pod(shakeTimer);
+  out.pod(fogEnabled);
+  out.pod(fovTiles);
+
+  // Boss y su planificador: un encargo sin recoger se vuelve a hacer al
+  // cargar con la misma foto de la arena (misma decisión)
+  out.pod(boss);
+  bossBullets.saveState(out);
+  out.pod(bossPlanner.pending());
+  out.pod(bossPlanArena);
+  out.pod(bossPlan);
+  out.pod(bossPlanRequest);
+
+  // Inventario
+  out.pod(hasKey);
+  out.pod(hasShield);
+  out.pod(shieldUntil);
+  out.pod(hasBattery);
+  out.pod(glassesUntil);
+  out.pod(glassesFovMod);
+  out.pod(swordTier);
+  out.pod(plasmaTier);
+
+  // Combate
+  out.pod(attack);
+  projectiles.saveState(out);
+  out.pod(plasmaReadyAt);
+  out.pod(burstShotsLeft);
+  out.pod(burstTimer);
+  out.pod(slashActive);
+  out.pod(slashTimer);
+  out.pod(slashBaseAngle);
+  out.pod(slashColor);
+  out.pod(isDashing);
+  out.pod(dashTimer);
+  out.pod(dashReadyAt);
+  out.pod(dashStartPos);
+  out.pod(dashEndPos);
+
+  // Efectos
+  floatingTexts.saveState(out);
+  particles.saveState(out);
+
+  const std::uint64_t size = snap.bytes.size() - HEADER_BYTES;
+  const std::uint64_t sum =
+      payloadChecksum(snap.bytes.data() + HEADER_BYTES, size);
+  std::memcpy(snap.bytes.data() + SIZE_AT, &size, sizeof(size));
+  std::memcpy(snap.bytes.data() + SUM_AT, &sum, sizeof(sum));
+  snap.tick = simTicks;
+  snap.level = currentLevel;
+}
+
+bool GameSim::loadSnapshot(const SimSnapshot &snap) {
+  // Antes de tocar nada: este formato y este binario, longitud exacta y
+  // suma correcta. Una foto así es byte a byte lo que escribió
+  // saveSnapshot(), así que se lee entera.
+  if (!snap.compatible())
+    return false;
+  StateReader in(snap.bytes.data() + HEADER_BYTES,
+                 snap.bytes.size() - HEADER_BYTES);
+
+  bool geometryChanged = false;
+  if (!map.loadState(in, geometryChanged))
+    return false;
+  if (geometryChanged) {
+    // Otro nivel: lo que depende de las casillas ya no sirve
+    enemyVision.reset();
+    influence.reset(map);
+  }
+
+  bool shieldPending = false, glassesPending = false, planPending = false;
+  const bool ok =
+      in.pod(screenW) && in.pod(screenH) && in.pod(tileSize) &&
+      in.pod(px) && in.pod(py) && in.pod(hp) && in.pod(hpMax) &&
+      in.pod(simTime) && in.pod(simTicks) && in.pod(shieldPending) &&
+      in.pod(glassesPending) && in.pod(invulnUntil) &&
+
+      in.pod(runSeed) && in.pod(levelSeed) && in.pod(levelRng) &&
+      in.pod(spawnRng) && in.pod(fxRng) && in.pod(runCtx) && in.vec(items) &&
+
+      in.vec(enemies) && in.vec(enemyHP) && in.vec(enemyMaxHP) &&
+      in.vec(enemyAtkReadyAt) && in.vec(enemyShootReadyAt) &&
+      in.vec(enemyFlashUntil) && in.vec(enemyFacing) &&
+      in.vec(enemySeesPlayer) && influence.loadState(in) &&
+      in.vec(enemyAwake) && in.vec(enemyProvoked) && in.vec(activeEnemies) &&
+      population.loadState(in) && in.pod(enemyDensity) &&
+
+      turns.loadState(in) && in.pod(playerActor) && in.pod(bossMoveActor) &&
+      in.pod(bossFireActor) && in.pod(playerSpeed) && in.vec(enemyActor) &&
+
+      in.pod(state) && in.pod(moveCooldown) && in.pod(lastStepMode) &&
+      in.pod(currentLevel) && in.pod(hordeMode) && in.pod(hordeCount) &&
+      in.pod(difficulty) && in.pod(godMode) && in.pod(shakeTimer) &&
+      in.pod(fogEnabled) && in.pod(fovTiles) &&
+
+      in.pod(boss) && bossBullets.loadState(in) && in.pod(planPending) &&
+      in.pod(bossPlanArena) && in.pod(bossPlan) && in.pod(bossPlanRequest) &&
+
+      in.pod(hasKey) && in.pod(hasShield) && in.pod(shieldUntil) &&
+      in.pod(hasBattery) && in.pod(glassesUntil) && in.pod(glassesFovMod) &&
+      in.pod(swordTier) && in.pod(plasmaTier) &&
+
+      in.pod(attack) && projectiles.loadState(in) && in.pod(plasmaReadyAt) &&
+      in.pod(burstShotsLeft) && in.pod(burstTimer) && in.pod(slashActive) &&
+      in.pod(slashTimer) && in.pod(slashBaseAngle) && in.pod(slashColor) &&
+      in.pod(isDashing) && in.pod(dashTimer) && in.pod(dashReadyAt) &&
+      in.pod(dashStartPos) && in.pod(dashEndPos) &&
+
+      floatingTexts.loadState(in) && particles.loadState(in) && in.done();
+  if (!ok)
+    return false; // No pasa con una foto válida (ver compatible())
+
+  // Temporizadores: rueda vacía en el instante de la foto y vuelta a
+  // programar los que estaban pendientes
+  timers.reset(simTime);
+  shieldTimerId = TimerWheel::INVALID_TIMER;
+  glassesTimerId = TimerWheel::INVALID_TIMER;
+  if (shieldPending)
+    armShieldTimer();
+  if (glassesPending)
+    armGlassesTimer();
+
+  enemyGridDirty = true;
+  damageEvents.clear();
+
+  // Lo que estuviera pensando el planificador era para otra partida; el
+  // encargo de la foto se repite tal cual
+  bossPlanner.reset();
+  if (planPending)
+    bossPlanRequest = bossPlanner.submit(bossPlanArena);
+
+  onSimEvent(SimEvent::StateRestored);
+  return true;
+}
@@ -1,14 +1,7 @@
 #include "GameUtils.hpp"
-#include "raylib.h"
 #include <algorithm>
 #include <cmath>
 
-// Definición de estado global
-// En el .hpp pusimos 'extern AttackRuntime gAttack;', que solo "promete" que
-// existe. Aquí es donde realmente reservamos la memoria para esa variable
-// global.
-AttackRuntime gAttack{};
-
 // Matemáticas vectoriales
 // Convierte un vector libre (ej: input analógico) en una dirección cardinal
 // estricta. Compara las magnitudes absolutas de X e Y para ver cuál eje "gana".
@@ -23,81 +16,107 @@ IVec2 dominantAxis(IVec2 d) {
 // Cálculo de áreas de efecto (AOE)
 
 // Versión Simple: Ignora paredes (Ataque "Fantasma" o etéreo)
-std::vector<IVec2> computeMeleeTiles(IVec2 center, IVec2 lastDir, int range,
-                                     bool frontOnly) {
+// Las casillas salen ordenadas por distancia Manhattan al jugador, de modo
+// que al recorrerlas cada una llega después de las que la "tapan".
+void computeMeleeShape(IVec2 center, IVec2 lastDir, MeleeShape shape,
+                       int range, MeleeTiles &out) {
+  out.clear();
+  range = std::min(range, MELEE_MAX_RANGE);
   if (range <= 0)
-    return {};
-
-  std::vector<IVec2> out;
-  // Reservamos memoria anticipadamente para evitar re-allocations
-  // (optimización)
-  out.reserve(frontOnly ? range : range * 4);
-
-  if (frontOnly) {
-    // Modo Estocada: Una línea recta hacia donde miras
-    IVec2 f = dominantAxis((lastDir.x == 0 && lastDir.y == 0) ? IVec2{0, 1}
-                                                              : lastDir);
-    for (int t = 1; t <= range; ++t)
-      out.push_back({center.x + f.x * t, center.y + f.y * t});
-  } else {
-    // Modo Explosión: Cruz en 4 direcciones
-    for (int t = 1; t <= range; ++t) {
-      out.push_back({center.x + t, center.y}); // Der
-      out.push_back({center.x - t, center.y}); // Izq
-      out.push_back({center.x, center.y + t}); // Abajo
-      out.push_back({center.x, center.y - t}); // Arriba
+    return;
+
+  // Dirección segura (si lastDir es 0,0 forzamos Abajo)
+  const IVec2 f = dominantAxis(
+      (lastDir.x == 0 && lastDir.y == 0) ? IVec2{0, 1} : lastDir);
+  const IVec2 side{-f.y, f.x}; // Perpendicular (para el tajo)
+
+  // Offsets de la forma, agrupados por distancia (máx. 2·range)
+  for (int d = 1; d <= 2 * range; ++d) {
+    switch (shape) {
+    case MeleeShape::Line:
+      // Modo Estocada: Una línea recta hacia donde miras
+      if (d <= range)
+        out.push({center.x + f.x * d, center.y + f.y * d});
+      break;
+    case MeleeShape::Cross:
+      // Modo Explosión: Cruz en 4 direcciones
+      if (d <= range) {
+        out.push({center.x + d, center.y}); // Der
+        out.push({center.x - d, center.y}); // Izq
+        out.push({center.x, center.y + d}); // Abajo
+        out.push({center.x, center.y - d}); // Arriba
+      }
+      break;
+    case MeleeShape::Cleave:
+      // Fila t (1..range) de 3 de ancho: distancia t (centro) o t + 1
+      if (d <= range)
+        out.push({center.x + f.x * d, center.y + f.y * d});
+      if (d >= 2 && d - 1 <= range) {
+        const int t = d - 1;
+        out.push({center.x + f.x * t + side.x, center.y + f.y * t + side.y});
+        out.push({center.x + f.x * t - side.x, center.y + f.y * t - side.y});
+      }
+      break;
+    case MeleeShape::Spin:
+      // Anillo de distancia Manhattan d dentro del cuadrado de lado range
+      for (int dx = -range; dx <= range; ++dx) {
+        const int dy = d - std::abs(dx);
+        if (dy < 0 || dy > range)
+          continue;
+        out.push({center.x + dx, center.y + dy});
+        if (dy != 0)
+          out.push({center.x + dx, center.y - dy});
+      }
+      break;
     }
   }
-  return out;
 }
 
 // Versión Avanzada: con oclusión (Respeta paredes)
-// Esta es la que usa la espada para no atravesar muros.
-std::vector<IVec2> computeMeleeTilesOccluded(IVec2 center, IVec2 lastDir,
-                                             int range, bool frontOnly,
-                                             const Map &map) {
-  if (range <= 0)
-    return {};
-
+// Esta es la que usan los puños y la espada para no atravesar muros.
+void computeMeleeShapeOccluded(IVec2 center, IVec2 lastDir, MeleeShape shape,
+                               int range, const Map &map, MeleeTiles &out) {
   // Lambda auxiliar para chequear límites y colisiones
   auto walkable = [&](int x, int y) -> bool {
     return x >= 0 && y >= 0 && x < map.width() && y < map.height() &&
            map.isWalkable(x, y);
   };
 
-  std::vector<IVec2> out;
-  out.reserve(range * (frontOnly ? 1 : 4));
-
-  // Lambda "Raycast": Avanza casilla a casilla en una dirección
-  auto pushRay = [&](IVec2 dir) {
-    for (int t = 1; t <= range; ++t) {
-      int tx = center.x + dir.x * t;
-      int ty = center.y + dir.y * t;
-
-      // Lógica de corte:
-      // Si encontramos una pared, el ataque se detiene aquí.
-      // El 'break' impide que se añadan las casillas que están detrás de la
-      // pared.
-      if (!walkable(tx, ty))
-        break;
+  MeleeTiles shapeTiles;
+  computeMeleeShape(center, lastDir, shape, range, shapeTiles);
+
+  // Lógica de corte: una casilla de suelo cuenta si alguna vecina (cruz)
+  // es el jugador o una casilla ya alcanzada. Como vienen ordenadas por
+  // distancia, una pared corta todo lo que queda detrás de ella.
+  out.clear();
+  for (const IVec2 &t : shapeTiles) {
+    if (!walkable(t.x, t.y))
+      continue;
+    bool reached = isAdjacent4(t.x, t.y, center.x, center.y);
+    for (int k = 0; k < out.size() && !reached; ++k)
+      reached = isAdjacent4(t.x, t.y, out.tiles[k].x, out.tiles[k].y);
+    if (reached)
+      out.push(t);
+  }
+}
 
-      out.push_back({tx, ty});
-    }
-  };
+std::vector<IVec2> computeMeleeTiles(IVec2 center, IVec2 lastDir, int range,
+                                     bool frontOnly) {
+  MeleeTiles out;
+  computeMeleeShape(center, lastDir,
+                    frontOnly ? MeleeShape::Line : MeleeShape::Cross, range,
+                    out);
+  return std::vector<IVec2>(out.begin(), out.end());
+}
 
-  if (frontOnly) {
-    // Calcula dirección segura (si lastDir es 0,0 forzamos Abajo)
-    IVec2 f = dominantAxis((lastDir.x == 0 && lastDir.y == 0) ? IVec2{0, 1}
-                                                              : lastDir);
-    pushRay(f);
-  } else {
-    // Lanza 4 rayos independientes
-    pushRay({1, 0});
-    pushRay({-1, 0});
-    pushRay({0, 1});
-    pushRay({0, -1});
-  }
-  return out;
+std::vector<IVec2> computeMeleeTilesOccluded(IVec2 center, IVec2 lastDir,
+                                             int range, bool frontOnly,
+                                             const Map &map) {
+  MeleeTiles out;
+  computeMeleeShapeOccluded(center, lastDir,
+                            frontOnly ? MeleeShape::Line : MeleeShape::Cross,
+                            range, map, out);
+  return std::vector<IVec2>(out.begin(), out.end());
 }
 
 // Helpers de Adyacencia
@@ -109,15 +128,15 @@ bool isAdjacent4(int ax, int ay, int bx, int by) {
 }
 
 // Traductor de Enum a Vector Matemático
-IVec2 facingToDir(Game::EnemyFacing f) {
+IVec2 facingToDir(GameSim::EnemyFacing f) {
   switch (f) {
-  case Game::EnemyFacing::Up:
+  case GameSim::EnemyFacing::Up:
     return {0, -1};
-  case Game::EnemyFacing::Down:
+  case GameSim::EnemyFacing::Down:
     return {0, 1};
-  case Game::EnemyFacing::Left:
+  case GameSim::EnemyFacing::Left:
     return {-1, 0};
-  case Game::EnemyFacing::Right:
+  case GameSim::EnemyFacing::Right:
     return {1, 0};
   }
   return {0, 1}; // Fallback
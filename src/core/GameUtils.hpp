@@ -1,6 +1,5 @@
 #pragma once
-#include "Game.hpp" // Necesario para IVec2 y definiciones de Game::EnemyFacing
-#include "raylib.h"
+#include "GameSim.hpp" // IVec2, MeleeTiles y GameSim::EnemyFacing
 #include <vector>
 
 // Tabla de balanceo (Constantes de combate)
@@ -12,6 +11,28 @@ inline constexpr int ENEMY_BASE_HP = 100;            // Vida estándar (tanky)
 inline constexpr int ENEMY_CONTACT_DMG = 1;          // Daño al tocar al jugador (1 corazón)
 inline constexpr float ENEMY_ATTACK_COOLDOWN = 1.5f; // Los enemigos atacan 1 vez por segundo
 
+// Velocidades de turno (100 = un paso por cada paso del jugador)
+inline constexpr int ENEMY_SPEED_MELEE = 100;
+inline constexpr int ENEMY_SPEED_SHOOTER = 80; // Más lentos: prefieren disparar
+
+// Máximo de enemigos vivos a la vez (el resto, aparcados por el streaming)
+inline constexpr int ENEMY_LIVE_CAP = 256;
+// enemiesPerLevel está pensado para mapas de hasta una ventana de 1920x1080
+// (72x41 casillas). En mapas mayores se mantiene esa densidad.
+inline constexpr int ENEMY_REFERENCE_MAP_TILES = 72 * 41;
+
+// Modo horda (prueba de estrés)
+inline constexpr int HORDE_DEFAULT_ENEMIES = 2000;
+inline constexpr int HORDE_MAX_ENEMIES = 10000;
+inline constexpr int HORDE_TILES_PER_ENEMY = 24; // Área de mapa por enemigo
+inline constexpr int HORDE_MAX_MAP_SIDE = 512;
+inline constexpr int HORDE_SHOOTER_PCT = 30;
+
+// Nivel del boss: el reloj de turnos avanza en tiempo real. Con este valor un
+// actor de velocidad normal (100) actúa una vez por segundo.
+inline constexpr int BOSS_TURN_TICKS_PER_SECOND =
+    static_cast<int>(ActorScheduler::TICKS_PER_ACTION);
+
 // Bando Jugador: Puños (Default)
 // DPS bajo, alto riesgo (hay que acercarse mucho)
 inline constexpr int DMG_HANDS = 20;     // Requiere 5 golpes para matar a un enemigo base
@@ -31,57 +52,38 @@ inline constexpr float CD_PLASMA = 0.80f;         // Cadencia baja (tipo cañón
 inline constexpr float PLASMA_SPEED = 300.0f;     // Velocidad del proyectil en px/s
 inline constexpr float PLASMA_RANGE_TILES = 6.5f; // Alcance máximo antes de disiparse
 
-// Estado de ejecución del ataque (Runtime)
-// Esta estructura actúa como una "Máquina de Estados" pequeña para el combate.
-struct AttackRuntime {
-    // Configuración (Stats del arma actual)
-    int   rangeTiles = 1;     // Alcance en casillas (1 = Daga, 2 = Lanza/Látigo)
-    float cooldown   = 0.20f; // Tiempo mínimo entre ataques
-    float swingTime  = 0.10f; // Duración visual del "flash" de ataque (Hitbox activa)
-
-    // Estado Dinámico (Cambia frame a frame)
-    float cdTimer    = 0.f;   // Cuenta atrás para poder atacar de nuevo
-    float swingTimer = 0.f;   // Cuenta atrás de la duración del golpe actual
-    bool  swinging   = false; // true = La hitbox está activa ahora mismo
-
-    // Lógica de Apuntado
-    // false = Ataque en área (tipo Bomberman, 4 direcciones a la vez)
-    // true  = Ataque direccional (tipo Zelda, solo al frente)
-    bool  frontOnly  = true;
-
-    // "Memoria" de dirección: Si el jugador suelta las teclas (vector 0,0),
-    // recordamos hacia dónde miraba para atacar en esa dirección.
-    IVec2 lastDir    = {0, 1};
-
-    // Debug / Render: Guardamos qué casillas fueron golpeadas en el último frame
-    // para dibujar los efectos visuales o los cuadrados rojos de depuración.
-    std::vector<IVec2> lastTiles;
-};
-
-// Importante: Declaramos la variable global, pero se debería definir en el .cpp
-// (ej: en GameUtils.cpp poner: "AttackRuntime gAttack;")
-extern AttackRuntime gAttack;
-
 // Utilidades geométricas y de IA
 // Convierte un vector libre (ej: joystick analógico) a una de las 4 direcciones cardinales.
 // Prioriza el eje con mayor magnitud.
 IVec2 dominantAxis(IVec2 d);
 
 // Cálculo de Hitboxes (Sin tener en cuenta paredes)
-// Útil para armas "fantasmas" o efectos de área.
-std::vector<IVec2> computeMeleeTiles(IVec2 center, IVec2 lastDir,
-                                     int range, bool frontOnly);
+// Útil para armas "fantasmas" o efectos de área. 'range' se recorta a
+// MELEE_MAX_RANGE.
+void computeMeleeShape(IVec2 center, IVec2 lastDir, MeleeShape shape,
+                       int range, MeleeTiles &out);
 
 // Cálculo de Hitboxes (Con Oclusión)
-// "Corta" el ataque si encuentra una pared (Map::isWalkable == false).
-// Esto evita que el jugador mate enemigos a través de los muros (anti-cheese).
+// "Corta" el ataque si encuentra una pared (Map::isWalkable == false): una
+// casilla solo cuenta si se llega a ella desde el jugador por casillas de la
+// forma. Esto evita que el jugador mate enemigos a través de los muros
+// (anti-cheese).
+void computeMeleeShapeOccluded(IVec2 center, IVec2 lastDir, MeleeShape shape,
+                               int range, const Map &map, MeleeTiles &out);
+
+// Las mismas formas en un vector nuevo (Line si 'frontOnly', si no Cross).
+// Cómodas para pruebas y herramientas; el combate usa las de arriba, que no
+// reservan memoria. Como ellas, recortan 'range' a MELEE_MAX_RANGE: con
+// rango 5 la estocada da 3 casillas, no 5.
+std::vector<IVec2> computeMeleeTiles(IVec2 center, IVec2 lastDir, int range,
+                                     bool frontOnly);
 std::vector<IVec2> computeMeleeTilesOccluded(IVec2 center, IVec2 lastDir,
                                              int range, bool frontOnly,
-                                             const Map& map);
+                                             const Map &map);
 
 // Chequeo rápido de vecindad (Cruz de Von Neumann)
 // Devuelve true si (bx,by) está justo Arriba, Abajo, Izq o Der de (ax,ay).
 bool isAdjacent4(int ax, int ay, int bx, int by);
 
 // Convierte el Enum de estado del enemigo a vector matemático (ej: Up -> {0, -1})
-IVec2 facingToDir(Game::EnemyFacing f);
+IVec2 facingToDir(GameSim::EnemyFacing f);
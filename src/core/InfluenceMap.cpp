@@ -0,0 +1,111 @@
+#include "InfluenceMap.hpp"
+#include <algorithm>
+
+void InfluenceMaps::reset(const Map &map) {
+  w = map.width();
+  h = map.height();
+  const size_t n = static_cast<size_t>(w) * static_cast<size_t>(h);
+
+  threatG.assign(n, 0.0f);
+  crowdG.assign(n, 0.0f);
+  flankG.assign(n, 0.0f);
+  scratch.assign(n, 0.0f);
+
+  floorMask.assign(n, 0.0f);
+  for (int y = 0; y < h; ++y)
+    for (int x = 0; x < w; ++x)
+      floorMask[y * w + x] = map.isWalkable(x, y) ? 1.0f : 0.0f;
+}
+
+void InfluenceMaps::blur(std::vector<float> &g, int x0, int y0, int x1,
+                         int y1) {
+  // Pasada horizontal -> scratch
+  for (int y = y0; y <= y1; ++y) {
+    const float *src = &g[y * w];
+    float *dst = &scratch[y * w];
+    for (int x = x0; x <= x1; ++x) {
+      const float l = (x > 0) ? src[x - 1] : 0.0f;
+      const float r = (x < w - 1) ? src[x + 1] : 0.0f;
+      dst[x] = 0.25f * l + 0.5f * src[x] + 0.25f * r;
+    }
+  }
+
+  // Pasada vertical -> g (con máscara de suelo)
+  for (int y = y0; y <= y1; ++y) {
+    const float *up = (y > 0) ? &scratch[(y - 1) * w] : nullptr;
+    const float *mid = &scratch[y * w];
+    const float *down = (y < h - 1) ? &scratch[(y + 1) * w] : nullptr;
+    const float *mask = &floorMask[y * w];
+    float *dst = &g[y * w];
+    for (int x = x0; x <= x1; ++x) {
+      const float u = up ? up[x] : 0.0f;
+      const float d = down ? down[x] : 0.0f;
+      dst[x] = (0.25f * u + 0.5f * mid[x] + 0.25f * d) * mask[x];
+    }
+  }
+}
+
+void InfluenceMaps::update(
+    int px, int py, const std::vector<std::pair<int, int>> &enemies,
+    const std::vector<std::pair<int, int>> &threatTiles) {
+  if (w == 0 || h == 0)
+    return;
+
+  const int x0 = std::max(0, px - WINDOW), x1 = std::min(w - 1, px + WINDOW);
+  const int y0 = std::max(0, py - WINDOW), y1 = std::min(h - 1, py + WINDOW);
+  if (x0 > x1 || y0 > y1)
+    return;
+
+  auto inWindow = [&](int x, int y) {
+    return x >= x0 && x <= x1 && y >= y0 && y <= y1;
+  };
+
+  // 1. Decaimiento (crowd recuerda un poco los pasos anteriores) y limpieza
+  for (int y = y0; y <= y1; ++y) {
+    float *c = &crowdG[y * w];
+    float *t = &threatG[y * w];
+    for (int x = x0; x <= x1; ++x) {
+      c[x] *= CROWD_DECAY;
+      t[x] = 0.0f;
+    }
+  }
+
+  // 2. Fuentes
+  for (const auto &e : enemies)
+    if (inWindow(e.first, e.second))
+      crowdG[e.second * w + e.first] += 1.0f;
+  for (const auto &t : threatTiles)
+    if (inWindow(t.first, t.second))
+      threatG[t.second * w + t.first] = 1.0f;
+
+  // 3. Propagación
+  blur(crowdG, x0, y0, x1, y1);
+  blur(threatG, x0, y0, x1, y1);
+
+  // 4. Flancos: anillos alrededor del jugador (distancia Manhattan 1 y 2)
+  // que sigan libres de enemigos.
+  static constexpr float RING[3] = {0.0f, 1.0f, 0.5f};
+  for (int y = y0; y <= y1; ++y) {
+    const float *c = &crowdG[y * w];
+    const float *mask = &floorMask[y * w];
+    float *f = &flankG[y * w];
+    const int ady = std::abs(y - py);
+    for (int x = x0; x <= x1; ++x) {
+      const int d = std::min(std::abs(x - px) + ady, 3);
+      const float ring = (d < 3) ? RING[d] : 0.0f;
+      f[x] = ring * std::max(0.0f, 1.0f - c[x]) * mask[x];
+    }
+  }
+}
+
+void InfluenceMaps::saveState(StateWriter &out) const {
+  out.vec(threatG);
+  out.vec(crowdG);
+  out.vec(flankG);
+}
+
+bool InfluenceMaps::loadState(StateReader &in) {
+  const std::size_t n = floorMask.size();
+  return in.vecOfSize(threatG, n) && in.vecOfSize(crowdG, n) &&
+         in.vecOfSize(flankG, n);
+}
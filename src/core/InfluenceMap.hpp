@@ -0,0 +1,111 @@
+#ifndef INFLUENCE_MAP_HPP
+#define INFLUENCE_MAP_HPP
+
+#include "Map.hpp"
+#include "StateBuffer.hpp"
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+// Mapas de influencia tácticos
+// Tres rejillas de floats del tamaño del nivel:
+// - threat: casillas que cubre el arma del jugador (mejor no pararse ahí).
+// - crowd:  densidad de enemigos (con decaimiento temporal y difusión).
+// - flank:  huecos libres alrededor del jugador (para rodearle).
+//
+// Clave de diseño: se actualizan una vez por paso del jugador y solo en una
+// ventana alrededor de él. Los bucles recorren filas contiguas sin ramas
+// (decay, difusión 3x3 separable, máscara de suelo), así que el compilador
+// los vectoriza. El coste por paso es fijo: no hay comprobaciones entre
+// parejas de enemigos, cada uno solo "muestrea" las rejillas.
+class InfluenceMaps {
+public:
+  static constexpr int WINDOW = 12;         // Semilado de la ventana (tiles)
+  static constexpr float CROWD_DECAY = 0.5f; // Memoria de pasos anteriores
+
+  // Pesos al puntuar un paso (menores que el valor de acercarse 1 casilla)
+  static constexpr float W_FLANK = 0.6f;
+  static constexpr float W_CROWD = 0.5f;
+  static constexpr float W_THREAT = 0.3f;
+
+  // Nuevo nivel: dimensiones y máscara de suelo (los muros no influyen)
+  void reset(const Map &map);
+
+  // Foto de las tres rejillas (ver SimSnapshot). La máscara de suelo sale
+  // del mapa: cargar exige haber hecho reset() con el mismo mapa.
+  void saveState(StateWriter &out) const;
+  bool loadState(StateReader &in);
+
+  // Recalcula las rejillas alrededor de (px, py)
+  void update(int px, int py, const std::vector<std::pair<int, int>> &enemies,
+              const std::vector<std::pair<int, int>> &threatTiles);
+
+  float threat(int x, int y) const { return sample(threatG, x, y); }
+  float crowd(int x, int y) const { return sample(crowdG, x, y); }
+  float flank(int x, int y) const { return sample(flankG, x, y); }
+
+  // Puntuación táctica de estar en (x, y): alta = buena casilla
+  float score(int x, int y) const {
+    return W_FLANK * flank(x, y) - W_CROWD * crowd(x, y) -
+           W_THREAT * threat(x, y);
+  }
+
+  // Siguiente paso hacia (tx, ty): de los (hasta dos) pasos que acercan,
+  // el de mejor puntuación táctica. Empate: eje dominante, como el avance
+  // voraz clásico. Si ninguno es posible, se queda quieto.
+  template <class CanFn>
+  std::pair<int, int> bestStep(int ex, int ey, int tx, int ty,
+                               CanFn &&can) const {
+    const int dx = tx - ex, dy = ty - ey;
+    if (dx == 0 && dy == 0)
+      return {ex, ey};
+    const int sx = (dx > 0) - (dx < 0);
+    const int sy = (dy > 0) - (dy < 0);
+
+    std::pair<int, int> cand[2];
+    if (std::abs(dx) >= std::abs(dy)) {
+      cand[0] = {ex + sx, ey};
+      cand[1] = {ex, ey + sy};
+    } else {
+      cand[0] = {ex, ey + sy};
+      cand[1] = {ex + sx, ey};
+    }
+
+    bool found = false;
+    std::pair<int, int> best{ex, ey};
+    float bestScore = 0.0f;
+    for (const auto &c : cand) {
+      if (c.first == ex && c.second == ey)
+        continue; // Eje sin distancia que recorrer
+      if (!can(c.first, c.second))
+        continue;
+      const float s = score(c.first, c.second);
+      if (!found || s > bestScore) {
+        found = true;
+        best = c;
+        bestScore = s;
+      }
+    }
+    return best;
+  }
+
+  int width() const { return w; }
+  int height() const { return h; }
+
+private:
+  float sample(const std::vector<float> &g, int x, int y) const {
+    if (x < 0 || y < 0 || x >= w || y >= h)
+      return 0.0f;
+    return g[y * w + x];
+  }
+
+  // Difusión 3x3 separable [1/4 1/2 1/4] dentro de la ventana
+  void blur(std::vector<float> &g, int x0, int y0, int x1, int y1);
+
+  int w = 0, h = 0;
+  std::vector<float> threatG, crowdG, flankG;
+  std::vector<float> floorMask; // 1 suelo, 0 muro
+  std::vector<float> scratch;
+};
+
+#endif
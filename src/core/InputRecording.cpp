@@ -0,0 +1,321 @@
+#include "InputRecording.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+// Dirección de -1..1 en 2 bits (0, 1, 3) y vuelta
+std::uint16_t packDir(std::int8_t d) {
+  return static_cast<std::uint16_t>(d) & 3u;
+}
+std::int8_t unpackDir(std::uint16_t bits) {
+  return bits == 3 ? -1 : static_cast<std::int8_t>(bits);
+}
+
+// Escritura y lectura little-endian. Los enteros que suelen ser pequeños
+// (repeticiones, ticks) van como varint: 7 bits por byte.
+void putVarint(std::vector<std::uint8_t> &out, std::uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(v));
+}
+
+void putFixed(std::vector<std::uint8_t> &out, std::uint64_t v, int bytes) {
+  for (int i = 0; i < bytes; ++i)
+    out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+
+struct Reader {
+  const std::vector<std::uint8_t> &in;
+  std::size_t at = 0;
+  bool ok = true;
+
+  std::uint64_t varint() {
+    std::uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (at >= in.size())
+        break;
+      const std::uint8_t b = in[at++];
+      v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+      if (!(b & 0x80))
+        return v;
+    }
+    ok = false;
+    return 0;
+  }
+
+  std::uint64_t fixed(int bytes) {
+    if (at + bytes > in.size()) {
+      ok = false;
+      return 0;
+    }
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i)
+      v |= static_cast<std::uint64_t>(in[at++]) << (8 * i);
+    return v;
+  }
+};
+
+const char MAGIC[4] = {'R', 'B', 'R', 'P'};
+} // namespace
+
+std::uint16_t InputRecording::pack(const TickInput &in) {
+  std::uint16_t w = 0;
+  w |= packDir(in.holdX);
+  w |= packDir(in.holdY) << 2;
+  w |= (in.stepMode ? 1u : 0u) << 4;
+  w |= packDir(in.stepX) << 5;
+  w |= packDir(in.stepY) << 7;
+  w |= (in.movePressed ? 1u : 0u) << 9;
+  w |= (in.dash ? 1u : 0u) << 10;
+  w |= (in.interact ? 1u : 0u) << 11;
+  w |= (in.attackHands ? 1u : 0u) << 12;
+  w |= (in.attackSword ? 1u : 0u) << 13;
+  w |= (in.attackPlasma ? 1u : 0u) << 14;
+  w |= (in.toggleGod ? 1u : 0u) << 15;
+  return w;
+}
+
+TickInput InputRecording::unpack(std::uint16_t w) {
+  TickInput in;
+  in.holdX = unpackDir(w & 3u);
+  in.holdY = unpackDir((w >> 2) & 3u);
+  in.stepMode = (w >> 4) & 1u;
+  in.stepX = unpackDir((w >> 5) & 3u);
+  in.stepY = unpackDir((w >> 7) & 3u);
+  in.movePressed = (w >> 9) & 1u;
+  in.dash = (w >> 10) & 1u;
+  in.interact = (w >> 11) & 1u;
+  in.attackHands = (w >> 12) & 1u;
+  in.attackSword = (w >> 13) & 1u;
+  in.attackPlasma = (w >> 14) & 1u;
+  in.toggleGod = (w >> 15) & 1u;
+  return in;
+}
+
+void InputRecording::begin(const RunSetup &setup) {
+  runSetup = setup;
+  runs.clear();
+  frames.clear();
+  totalTicks = 0;
+  markedLevel = 0;
+}
+
+void InputRecording::push(const TickInput &in, std::uint8_t zoom) {
+  const std::uint16_t w = pack(in);
+  if (!runs.empty() && runs.back().word == w && runs.back().zoom == zoom &&
+      runs.back().count < UINT32_MAX) {
+    runs.back().count++;
+  } else {
+    Run r;
+    r.start = totalTicks;
+    r.count = 1;
+    r.word = w;
+    r.zoom = zoom;
+    runs.push_back(r);
+  }
+  totalTicks++;
+}
+
+void InputRecording::addKeyframe(std::uint64_t tick, std::uint64_t hash,
+                                 int level) {
+  // Dos avisos en el mismo tick (nivel nuevo y periódico): basta uno
+  if (!frames.empty() && frames.back().tick >= tick)
+    return;
+  frames.push_back({tick, hash, level});
+}
+
+void InputRecording::markTick(const GameSim &sim) {
+  const std::uint64_t t = sim.getTick();
+  if (t % KEYFRAME_TICKS == 0 || sim.getCurrentLevel() != markedLevel ||
+      sim.getState() != GameState::Playing) {
+    addKeyframe(t, sim.stateHash(), sim.getCurrentLevel());
+    markedLevel = sim.getCurrentLevel();
+  }
+}
+
+void InputRecording::truncate(std::uint64_t tick) {
+  if (tick >= totalTicks)
+    return;
+  // Rachas enteras por detrás del corte fuera; la que lo contiene, recortada
+  while (!runs.empty() && runs.back().start >= tick)
+    runs.pop_back();
+  if (!runs.empty())
+    runs.back().count = static_cast<std::uint32_t>(
+        std::min<std::uint64_t>(runs.back().count, tick - runs.back().start));
+  totalTicks = tick;
+
+  while (!frames.empty() && frames.back().tick > tick)
+    frames.pop_back();
+  markedLevel = frames.empty() ? 0 : frames.back().level;
+}
+
+const InputRecording::Keyframe *
+InputRecording::keyframeAt(std::uint64_t tick) const {
+  auto it = std::lower_bound(
+      frames.begin(), frames.end(), tick,
+      [](const Keyframe &k, std::uint64_t t) { return k.tick < t; });
+  return (it != frames.end() && it->tick == tick) ? &*it : nullptr;
+}
+
+std::vector<std::uint8_t> InputRecording::encode() const {
+  std::vector<std::uint8_t> out;
+  out.reserve(32 + runs.size() * 4 + frames.size() * 12);
+  for (char c : MAGIC)
+    out.push_back(static_cast<std::uint8_t>(c));
+  putFixed(out, VERSION, 4);
+
+  putFixed(out, runSetup.seed, 4);
+  out.push_back(static_cast<std::uint8_t>(runSetup.difficulty));
+  out.push_back(runSetup.horde ? 1 : 0);
+  putVarint(out, static_cast<std::uint64_t>(std::max(0, runSetup.hordeCount)));
+  putVarint(out, static_cast<std::uint64_t>(std::max(0, runSetup.viewW)));
+  putVarint(out, static_cast<std::uint64_t>(std::max(0, runSetup.viewH)));
+
+  putVarint(out, runs.size());
+  for (const Run &r : runs) {
+    putVarint(out, r.count);
+    putFixed(out, r.word, 2);
+    out.push_back(r.zoom);
+  }
+
+  putVarint(out, frames.size());
+  for (const Keyframe &k : frames) {
+    putVarint(out, k.tick);
+    putFixed(out, k.hash, 8);
+    putVarint(out, static_cast<std::uint64_t>(std::max(0, k.level)));
+  }
+  return out;
+}
+
+std::size_t InputRecording::sizeBytes() const { return encode().size(); }
+
+bool InputRecording::save(const std::string &path) const {
+  const std::vector<std::uint8_t> data = encode();
+  std::ofstream f(path, std::ios::binary | std::ios::trunc);
+  if (!f)
+    return false;
+  f.write(reinterpret_cast<const char *>(data.data()),
+          static_cast<std::streamsize>(data.size()));
+  return static_cast<bool>(f);
+}
+
+bool InputRecording::load(const std::string &path) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f)
+    return false;
+  const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(f)),
+                                       std::istreambuf_iterator<char>());
+  if (data.size() < 8 || !std::equal(MAGIC, MAGIC + 4, data.begin()))
+    return false;
+
+  Reader in{data, 4};
+  if (in.fixed(4) != VERSION)
+    return false; // Otra versión: mejor no reproducir algo distinto
+
+  // Se lee en una copia: si el archivo está roto, la grabación no cambia
+  InputRecording rec;
+  rec.runSetup.seed = static_cast<unsigned>(in.fixed(4));
+  const std::uint64_t diff = in.fixed(1);
+  if (diff > static_cast<std::uint64_t>(Difficulty::Hard))
+    return false;
+  rec.runSetup.difficulty = static_cast<Difficulty>(diff);
+  rec.runSetup.horde = in.fixed(1) != 0;
+  rec.runSetup.hordeCount = static_cast<int>(in.varint());
+  rec.runSetup.viewW = static_cast<int>(in.varint());
+  rec.runSetup.viewH = static_cast<int>(in.varint());
+
+  const std::uint64_t nRuns = in.varint();
+  for (std::uint64_t i = 0; i < nRuns && in.ok; ++i) {
+    Run r;
+    r.start = rec.totalTicks;
+    r.count = static_cast<std::uint32_t>(in.varint());
+    r.word = static_cast<std::uint16_t>(in.fixed(2));
+    r.zoom = static_cast<std::uint8_t>(in.fixed(1));
+    if (r.count == 0)
+      in.ok = false;
+    rec.runs.push_back(r);
+    rec.totalTicks += r.count;
+  }
+
+  const std::uint64_t nFrames = in.varint();
+  for (std::uint64_t i = 0; i < nFrames && in.ok; ++i) {
+    Keyframe k;
+    k.tick = in.varint();
+    k.hash = in.fixed(8);
+    k.level = static_cast<int>(in.varint());
+    rec.frames.push_back(k);
+  }
+  if (!in.ok)
+    return false;
+
+  *this = std::move(rec);
+  return true;
+}
+
+TickInput InputRecording::Cursor::input() const {
+  return done() ? TickInput{} : unpack(rec->runs[run].word);
+}
+
+std::uint8_t InputRecording::Cursor::zoom() const {
+  return done() ? 0 : rec->runs[run].zoom;
+}
+
+void InputRecording::Cursor::next() {
+  if (done())
+    return;
+  at++;
+  const Run &r = rec->runs[run];
+  if (at >= r.start + r.count && run + 1 < rec->runs.size())
+    run++;
+}
+
+void InputRecording::Cursor::seek(std::uint64_t tick) {
+  at = std::min(tick, rec->totalTicks);
+  // Última racha que empieza en o antes de 'at'
+  auto it = std::upper_bound(
+      rec->runs.begin(), rec->runs.end(), at,
+      [](std::uint64_t t, const Run &r) { return t < r.start; });
+  run = it == rec->runs.begin()
+            ? 0
+            : static_cast<std::size_t>(it - rec->runs.begin()) - 1;
+}
+
+void ReplayStats::add(const ReplayStats &o) {
+  if (o.desyncs > 0 && desyncs == 0)
+    firstDesync = o.firstDesync;
+  ticks += o.ticks;
+  keyframesChecked += o.keyframesChecked;
+  desyncs += o.desyncs;
+  ms += o.ms;
+  worstTickMs = std::max(worstTickMs, o.worstTickMs);
+}
+
+ReplayStats replayRecording(GameSim &sim, InputRecording::Cursor &cursor,
+                            const InputRecording &rec,
+                            std::uint64_t untilTick) {
+  ReplayStats st;
+  const double t0 = FrameProfiler::clockMs();
+  while (!cursor.done() && cursor.tick() < untilTick &&
+         sim.getState() == GameState::Playing) {
+    const double tickStart = FrameProfiler::clockMs();
+    sim.step(cursor.input());
+    cursor.next();
+    st.worstTickMs =
+        std::max(st.worstTickMs, FrameProfiler::clockMs() - tickStart);
+    st.ticks++;
+
+    if (const InputRecording::Keyframe *k = rec.keyframeAt(sim.getTick())) {
+      st.keyframesChecked++;
+      if (k->hash != sim.stateHash()) {
+        if (st.desyncs == 0)
+          st.firstDesync = k->tick;
+        st.desyncs++;
+      }
+    }
+  }
+  st.ms = FrameProfiler::clockMs() - t0;
+  return st;
+}
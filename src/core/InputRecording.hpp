@@ -0,0 +1,114 @@
+#ifndef INPUT_RECORDING_HPP
+#define INPUT_RECORDING_HPP
+
+#include "GameSim.hpp"
+#include "TickInput.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Grabación de una partida: la configuración (RunSetup, con runSeed) y la
+// entrada del jugador en cada tick. La simulación es determinista, así que
+// reproducir esa entrada desde la misma configuración repite la partida
+// exacta: informes de fallos reproducibles y cargas de trabajo repetibles.
+//
+// Clave de diseño: compacta. Cada tick se reduce a una palabra de 16 bits
+// (dirección, modo, flancos) más un byte de zoom de la cámara (solo del
+// frontend: la simulación no lo usa), y los ticks seguidos con la misma
+// entrada se guardan como una racha (repeticiones + palabra). Una partida
+// de varios minutos ocupa pocos KB. Cada KEYFRAME_TICKS (y al empezar cada
+// nivel) se apunta un keyframe con la huella del estado (stateHash): sirve
+// para saltar a ese punto y para detectar en qué tick se desincroniza una
+// reproducción.
+class InputRecording {
+public:
+  // 2: la huella incluye la posición del boss y su planificador es
+  // determinista (las grabaciones de la 1 no se repiten igual en el nivel 4)
+  static constexpr std::uint32_t VERSION = 2;
+  static constexpr std::uint64_t KEYFRAME_TICKS = 10 * FixedTimestep::TICK_HZ;
+
+  struct Keyframe {
+    std::uint64_t tick = 0; // Tras simular este tick...
+    std::uint64_t hash = 0; // ...el estado tiene esta huella
+    int level = 0;
+  };
+
+  // Palabra de 16 bits de un TickInput (y vuelta)
+  static std::uint16_t pack(const TickInput &in);
+  static TickInput unpack(std::uint16_t word);
+
+  // Grabación
+  void begin(const RunSetup &setup); // Vacía y apunta la configuración
+  void push(const TickInput &in, std::uint8_t zoom = 0); // Un tick
+  void addKeyframe(std::uint64_t tick, std::uint64_t hash, int level);
+  // Tras cada tick grabado: keyframe si toca (cada KEYFRAME_TICKS, nivel
+  // nuevo o partida terminada)
+  void markTick(const GameSim &sim);
+  // Vuelta atrás (carga de una foto en el tick 'tick'): olvida la entrada
+  // desde ese tick y los keyframes posteriores, y se sigue grabando desde ahí
+  void truncate(std::uint64_t tick);
+
+  const RunSetup &setup() const { return runSetup; }
+  std::uint64_t ticks() const { return totalTicks; }
+  const std::vector<Keyframe> &keyframes() const { return frames; }
+  const Keyframe *keyframeAt(std::uint64_t tick) const; // nullptr si no hay
+  std::size_t sizeBytes() const; // Lo que ocupa en disco
+
+  // Archivo binario (little-endian, versionado). false si no se pudo.
+  bool save(const std::string &path) const;
+  bool load(const std::string &path);
+
+  // Lectura tick a tick (y salto a un tick cualquiera)
+  class Cursor {
+  public:
+    explicit Cursor(const InputRecording &rec) : rec(&rec) { seek(0); }
+    bool done() const { return at >= rec->totalTicks; }
+    std::uint64_t tick() const { return at; } // Siguiente tick a reproducir
+    TickInput input() const;
+    std::uint8_t zoom() const;
+    void next();
+    void seek(std::uint64_t tick);
+
+  private:
+    const InputRecording *rec;
+    std::uint64_t at = 0;  // Tick
+    std::size_t run = 0;   // Racha que lo contiene
+  };
+
+private:
+  struct Run {
+    std::uint64_t start = 0; // Primer tick de la racha
+    std::uint32_t count = 0;
+    std::uint16_t word = 0;
+    std::uint8_t zoom = 0;
+  };
+
+  std::vector<std::uint8_t> encode() const; // Contenido del archivo
+
+  RunSetup runSetup;
+  std::vector<Run> runs;
+  std::vector<Keyframe> frames;
+  std::uint64_t totalTicks = 0;
+  int markedLevel = 0; // Nivel del último keyframe de markTick
+};
+
+// Resultado de reproducir una grabación sobre una simulación
+struct ReplayStats {
+  std::uint64_t ticks = 0;       // Ticks simulados en esta llamada
+  int keyframesChecked = 0;
+  int desyncs = 0;               // Keyframes cuya huella no coincide
+  std::uint64_t firstDesync = 0; // Tick del primero (si desyncs > 0)
+  double ms = 0.0;               // Tiempo de pared
+  double worstTickMs = 0.0;      // Tick más lento
+
+  void add(const ReplayStats &o); // Suma de varios tramos
+};
+
+// Avanza 'sim' con la entrada grabada desde el cursor hasta 'untilTick' (o
+// el final, o hasta que la partida termine), sin ventana y tan rápido como
+// dé la CPU, comprobando las huellas de los keyframes por el camino.
+ReplayStats replayRecording(GameSim &sim, InputRecording::Cursor &cursor,
+                            const InputRecording &rec,
+                            std::uint64_t untilTick = UINT64_MAX);
+
+#endif
@@ -1,7 +1,7 @@
 #include "Map.hpp"
+#include "RngStream.hpp"
 #include <algorithm>
 #include <random>
-#include "raylib.h"
 
 // Helper: Limita un valor entre un mínimo (lo) y un máximo (hi)
 static inline int clampi(int v, int lo, int hi) { return std::max(lo, std::min(v, hi)); }
@@ -31,8 +31,9 @@ void Map::generate(int W, int H, unsigned seed) {
     m_discovered.assign(W*H, 0);
     m_rooms.clear();
 
-    // Semilla aleatoria (seed) para reproducibilidad
-    std::mt19937 rng(seed ? seed : std::random_device{}());
+    // Semilla aleatoria (seed) para reproducibilidad. Flujo portable: la
+    // misma semilla da el mismo mapa en cualquier compilador/plataforma.
+    RngStream rng(seed ? seed : std::random_device{}(), RngStream::Level);
 
     // 1. Configuración dinámica de tamaños
     // Las salas escalan según el tamaño total del mapa.
@@ -56,18 +57,14 @@ void Map::generate(int W, int H, unsigned seed) {
         attempts++;
 
         // Generar dimensiones aleatorias
-        std::uniform_int_distribution<int> rw(minRoomW, maxRoomW);
-        std::uniform_int_distribution<int> rh(minRoomH, maxRoomH);
         Room r;
-        r.w = rw(rng);
-        r.h = rh(rng);
+        r.w = rng.range(minRoomW, maxRoomW);
+        r.h = rng.range(minRoomH, maxRoomH);
 
         // Generar posición aleatoria (respetando bordes)
         if (W - r.w - 2 <= 0 || H - r.h - 2 <= 0) continue; 
-        std::uniform_int_distribution<int> rx(1, W - r.w - 1);
-        std::uniform_int_distribution<int> ry(1, H - r.h - 1);
-        r.x = rx(rng);
-        r.y = ry(rng);
+        r.x = rng.range(1, W - r.w - 1);
+        r.y = rng.range(1, H - r.h - 1);
 
         // Chequeo de colisión con salas existentes
         bool ok = true;
@@ -81,7 +78,6 @@ void Map::generate(int W, int H, unsigned seed) {
     }
 
     // 3. Conexión de pasillos (Tubo en 'L')
-    std::uniform_int_distribution<int> coin(0,1);
     // Grosor dinámico de pasillos (más anchos en mapas grandes)
     const int thickness = clampi((int)std::round(std::min(W,H) / 50.0), 2, 2);
 
@@ -95,7 +91,7 @@ void Map::generate(int W, int H, unsigned seed) {
         int bx = b.x + b.w/2, by = b.y + b.h/2;
 
         // Decisión aleatoria: ¿Primero horizontal y luego vertical, o al revés?
-        if (coin(rng)) {
+        if (rng.range(0, 1)) {
             carveHTunnel(std::min(ax,bx), std::max(ax,bx), ay, thickness);
             carveVTunnel(std::min(ay,by), std::max(ay,by), bx, thickness);
         } else {
@@ -124,6 +120,9 @@ void Map::generate(int W, int H, unsigned seed) {
         int cx = e.x + e.w/2, cy = e.y + e.h/2;
         m_tiles[cy * m_w + cx] = EXIT;
     }
+
+    // 5. Grafo de navegación (salas, pasillos y portales)
+    rebuildNav();
 }
 
 void Map::setTile(int x, int y, Tile t) {
@@ -198,6 +197,8 @@ void Map::generateTutorialMap(int W, int H) {
 
     // 4. Iluminación total
     m_revealAll = true; 
+
+    rebuildNav();
 }
 
 // Genera una arena cerrada para el Boss (Nivel 4)
@@ -223,6 +224,7 @@ void Map::generateBossArena(int W, int H) {
     
     // Guardamos esta "habitación" para saber dónde colocar al Boss/Jugador
     m_rooms.push_back(arena);
+    rebuildNav();
 }
 
 // Cambia celdas de WALL a FLOOR en el rectángulo dado
@@ -274,71 +276,37 @@ void Map::computeVisibility(int px, int py, int radius) {
     }
 }
 
-// Renderizado
-void Map::draw(int tileSize, int px, int py, int radius, 
-               const Texture2D& wallTex, const Texture2D& floorTex) const {
-               
-    for (int y = 0; y < m_h; ++y) {
-        for (int x = 0; x < m_w; ++x) {
-            
-            // Si no está descubierto, Negro absoluto
-            if (!m_revealAll && m_discovered[y * m_w + x] == 0) continue;
-
-            // --- CÁLCULO DE ILUMINACIÓN ---
-            Color tint = WHITE;
-            
-            if (!m_revealAll && m_fogEnabled) {
-                // 1. ZONA DE MEMORIA
-                if (m_visible[y * m_w + x] == 0) {
-                     tint = { 40, 40, 50, 255 }; 
-                } 
-                // 2. ZONA VISIBLE (Antorcha)
-                else {
-                    // Calculamos distancia al jugador
-                    float dx = (float)(x - px);
-                    float dy = (float)(y - py);
-                    float dist = std::sqrt(dx*dx + dy*dy);
-                    
-                    // Factor de luz (1.0 en el centro, 0.0 en el borde del radio)
-                    // El "+ 1.0f" es para suavizar el borde
-                    float light = 1.0f - (dist / (float)(radius + 1));
-                    light = std::clamp(light, 0.0f, 1.0f);
-                    
-                    // Curva de luz para que el centro sea muy brillante y caiga rápido
-                    // (Efecto linterna)
-                    light = powf(light, 0.5f); 
-
-                    // Aplicamos la luz, pero asegurando un mínimo para que se vea
-                    unsigned char val = (unsigned char)(255.0f * light);
-                    if (val < 60) val = 60; // Mínimo de luz en zona visible
-                    
-                    tint = { val, val, val, 255 };
-                }
-            }
+// Foto del mapa
+void Map::saveState(StateWriter& out) const {
+    out.pod(m_w);
+    out.pod(m_h);
+    out.vec(m_tiles);
+    out.vec(m_rooms);
+    out.vec(m_visible);
+    out.vec(m_discovered);
+    out.pod(m_revealAll);
+    out.pod(m_fogEnabled);
+}
 
-            // Dibujado
-            Rectangle dest = { 
-                (float)(x * tileSize), 
-                (float)(y * tileSize), 
-                (float)tileSize, 
-                (float)tileSize 
-            };
-            Vector2 origin = { 0, 0 };
-            Tile t = at(x, y);
-
-            if (t == WALL) {
-                Rectangle src = { 0, 0, (float)wallTex.width, (float)wallTex.height };
-                DrawTexturePro(wallTex, src, dest, origin, 0.0f, tint);
-            } 
-            else if (t == FLOOR || t == EXIT) {
-                Rectangle src = { 0, 0, (float)floorTex.width, (float)floorTex.height };
-                DrawTexturePro(floorTex, src, dest, origin, 0.0f, tint);
-
-                if (t == EXIT) {
-                    DrawRectangleRec(dest, Fade(GREEN, 0.4f));
-                    DrawRectangleLinesEx(dest, 2, LIME);
-                }
-            }
-        }
-    }
+bool Map::loadState(StateReader& in, bool& geometryChanged) {
+    int w = 0, h = 0;
+    std::uint64_t n = 0;
+    if (!in.pod(w) || !in.pod(h) || !in.pod(n))
+        return false;
+    if (w < 0 || h < 0 || n != static_cast<std::uint64_t>(w) * static_cast<std::uint64_t>(h))
+        return in.fail();
+
+    // Volver atrás dentro del mismo nivel (lo normal) no rehace el grafo
+    geometryChanged = !(w == m_w && h == m_h && in.matches(m_tiles.data(), m_tiles.size()));
+    m_w = w;
+    m_h = h;
+    m_tiles.resize(static_cast<std::size_t>(n));
+    if (!in.raw(m_tiles.data(), m_tiles.size()) || !in.vec(m_rooms) ||
+        !in.vecOfSize(m_visible, m_tiles.size()) || !in.vecOfSize(m_discovered, m_tiles.size()) ||
+        !in.pod(m_revealAll) || !in.pod(m_fogEnabled))
+        return false;
+
+    if (geometryChanged)
+        rebuildNav();
+    return true;
 }
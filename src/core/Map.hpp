@@ -3,8 +3,9 @@
 
 #include <vector>
 #include <cstdint>
-#include "raylib.h"
 #include <utility>
+#include "NavGraph.hpp"
+#include "StateBuffer.hpp"
 
 // Tipos de celda. Usamos uint8_t para ahorrar memoria (1 byte por tile).
 enum Tile : uint8_t { 
@@ -32,9 +33,10 @@ public:
     // Genera la arena del Boss (espacio abierto)
     void generateBossArena(int width, int height);
 
-    // Renderiza el mapa usando Raylib (Tile por tile).
-    void draw(int tileSize, int px, int py, int radius, 
-              const Texture2D& wallTex, const Texture2D& floorTex) const;    // Sistema de visión (FOV, "FOG OF WAR")
+    // El dibujado vive en el frontend (Game::drawMap): el mapa no sabe de
+    // texturas ni de raylib.
+
+    // Sistema de visión (FOV, "FOG OF WAR")
     
     // Calcula qué celdas ve el jugador desde (px, py) con un radio 'radius'.
     // Actualiza los vectores 'm_visible' y 'm_discovered'.
@@ -51,6 +53,7 @@ public:
     bool isVisible(int x, int y) const { return m_revealAll || m_visible[y * m_w + x] != 0; }
     bool isDiscovered(int x, int y) const { return m_revealAll || m_discovered[y * m_w + x] != 0; }
     bool fogEnabled() const { return m_fogEnabled; }
+    bool revealAll() const { return m_revealAll; }
 
     // Acceso a datos (Geometría)
     
@@ -80,6 +83,18 @@ public:
     // Helpers para obtener puntos de inicio (jugador) y fin (meta)
     Room firstRoom() const { return m_rooms.empty() ? Room{0,0,0,0} : m_rooms.front(); }
     Room lastRoom()  const { return m_rooms.empty() ? Room{0,0,0,0} : m_rooms.back(); }
+    const std::vector<Room>& rooms() const { return m_rooms; }
+
+    // Navegación de largo alcance (salas/pasillos). Se construye al generar
+    // el nivel; si se cambia la transitabilidad a mano, llamar a rebuildNav().
+    const NavGraph& nav() const { return m_nav; }
+    void rebuildNav() { m_nav.build(*this); }
+
+    // Foto del mapa (ver SimSnapshot): casillas, salas y niebla.
+    // El grafo de navegación no viaja: al cargar se rehace solo si las
+    // casillas no son las que ya había ('geometryChanged' lo dice).
+    void saveState(StateWriter& out) const;
+    bool loadState(StateReader& in, bool& geometryChanged);
 
 private:
     int m_w = 0, m_h = 0;
@@ -88,6 +103,7 @@ private:
     // Usamos vectores planos (1D) en lugar de vector<vector<T>> por eficiencia de caché.
     std::vector<Tile> m_tiles; // El mapa físico
     std::vector<Room> m_rooms; // Lista de habitaciones generadas
+    NavGraph m_nav;            // Grafo de regiones y portales del nivel
     
     // Arrays paralelos para la niebla de guerra:
     std::vector<uint8_t> m_visible;    // 1 si está en FOV actual, 0 si no.
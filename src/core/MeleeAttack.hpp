@@ -0,0 +1,73 @@
+#ifndef MELEE_ATTACK_HPP
+#define MELEE_ATTACK_HPP
+
+#include "ItemSpawner.hpp" // IVec2
+#include <cstdint>
+
+// Golpes cuerpo a cuerpo: forma, casillas alcanzadas y estado del ataque
+// Vivía en GameUtils.hpp junto a la global gAttack. Ahora el estado es un
+// miembro de GameSim (GameSim::attack): cada simulación lleva el suyo y
+// pueden correr varias a la vez (bots, pruebas en paralelo).
+
+// Formas de golpe cuerpo a cuerpo
+// Line:   estocada al frente (puños, espada; con alcance 3, lanza)
+// Cross:  cruz en las 4 direcciones (tipo Bomberman)
+// Cleave: tajo ancho, 3 casillas de frente por cada paso de alcance
+// Spin:   giro, todo el cuadrado alrededor del jugador
+enum class MeleeShape : uint8_t { Line, Cross, Cleave, Spin };
+
+inline constexpr int MELEE_MAX_RANGE = 3;
+
+// Casillas golpeadas por un ataque, en un buffer de capacidad fija (sin
+// memoria dinámica). CAPACITY cubre la forma más grande: Spin de alcance
+// MELEE_MAX_RANGE = 7x7 - 1.
+struct MeleeTiles {
+    static constexpr int CAPACITY =
+        (2 * MELEE_MAX_RANGE + 1) * (2 * MELEE_MAX_RANGE + 1) - 1;
+
+    IVec2 tiles[CAPACITY];
+    int count = 0;
+
+    void clear() { count = 0; }
+    bool push(IVec2 t) {
+        if (count >= CAPACITY) return false;
+        tiles[count++] = t;
+        return true;
+    }
+    bool contains(int x, int y) const {
+        for (int i = 0; i < count; ++i)
+            if (tiles[i].x == x && tiles[i].y == y) return true;
+        return false;
+    }
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    const IVec2 *begin() const { return tiles; }
+    const IVec2 *end() const { return tiles + count; }
+};
+
+// Estado de ejecución del ataque (Runtime)
+// Esta estructura actúa como una "Máquina de Estados" pequeña para el combate.
+struct AttackRuntime {
+    // Configuración (Stats del arma actual)
+    int   rangeTiles = 1;     // Alcance en casillas (1 = Daga, 2 = Lanza/Látigo)
+    float cooldown   = 0.20f; // Tiempo mínimo entre ataques
+    float swingTime  = 0.10f; // Duración visual del "flash" de ataque (Hitbox activa)
+
+    // Estado Dinámico (Cambia frame a frame)
+    float cdTimer    = 0.f;   // Cuenta atrás para poder atacar de nuevo
+    float swingTimer = 0.f;   // Cuenta atrás de la duración del golpe actual
+    bool  swinging   = false; // true = La hitbox está activa ahora mismo
+
+    // Lógica de Apuntado: forma del golpe (ver MeleeShape)
+    MeleeShape shape = MeleeShape::Line;
+
+    // "Memoria" de dirección: Si el jugador suelta las teclas (vector 0,0),
+    // recordamos hacia dónde miraba para atacar en esa dirección.
+    IVec2 lastDir    = {0, 1};
+
+    // Debug / Render: Guardamos qué casillas fueron golpeadas en el último frame
+    // para dibujar los efectos visuales o los cuadrados rojos de depuración.
+    MeleeTiles lastTiles;
+};
+
+#endif
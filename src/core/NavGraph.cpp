@@ -0,0 +1,388 @@
+#include "NavGraph.hpp"
+#include "Map.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <tuple>
+
+namespace {
+constexpr int INF = INT_MAX / 4;
+constexpr int DX[4] = {1, -1, 0, 0};
+constexpr int DY[4] = {0, 0, 1, -1};
+} // namespace
+
+void NavGraph::Search::begin(int n) {
+  if (static_cast<int>(stamp.size()) != n) {
+    stamp.assign(n, 0);
+    dist.assign(n, 0);
+    parent.assign(n, -1);
+    gen = 0;
+  }
+  if (++gen == 0) { // Desbordamiento del sello: limpieza real
+    std::fill(stamp.begin(), stamp.end(), 0);
+    gen = 1;
+  }
+  open.clear();
+  heap.clear();
+}
+
+void NavGraph::clear() {
+  w = h = 0;
+  regions = 0;
+  region.clear();
+  nodes.clear();
+  nodeAt.clear();
+  regionNodes.clear();
+  links.clear();
+  segTiles.clear();
+}
+
+int NavGraph::regionAt(int x, int y) const {
+  if (x < 0 || y < 0 || x >= w || y >= h)
+    return -1;
+  return region[y * w + x];
+}
+
+int NavGraph::nodeFor(int tile) {
+  if (nodeAt[tile] >= 0)
+    return nodeAt[tile];
+  const int id = static_cast<int>(nodes.size());
+  nodes.push_back({tile, region[tile]});
+  regionNodes[region[tile]].push_back(id);
+  nodeAt[tile] = id;
+  return id;
+}
+
+void NavGraph::build(const Map &map) {
+  clear();
+  w = map.width();
+  h = map.height();
+  const int n = w * h;
+  if (n <= 0)
+    return;
+
+  region.assign(n, -1);
+  nodeAt.assign(n, -1);
+
+  // 1. Etiqueta por casilla: índice de sala, o para pasillos un bloque de
+  // CORRIDOR_CHUNK x CORRIDOR_CHUNK (negativo). Los túneles se cruzan y
+  // forman redes enormes: trocearlos acota el rodeo dentro de una región.
+  const int chunksX = (w + CORRIDOR_CHUNK - 1) / CORRIDOR_CHUNK;
+  std::vector<int> roomTag(n);
+  for (int y = 0; y < h; ++y)
+    for (int x = 0; x < w; ++x)
+      roomTag[y * w + x] =
+          -1 - ((y / CORRIDOR_CHUNK) * chunksX + x / CORRIDOR_CHUNK);
+  const auto &rooms = map.rooms();
+  for (int r = static_cast<int>(rooms.size()) - 1; r >= 0; --r) {
+    const Room &rm = rooms[r]; // Recorremos al revés: la primera sala gana
+    for (int y = std::max(0, rm.y); y < std::min(h, rm.y + rm.h); ++y)
+      for (int x = std::max(0, rm.x); x < std::min(w, rm.x + rm.w); ++x)
+        roomTag[y * w + x] = r;
+  }
+
+  // 2. Regiones: componentes conexas de suelo con la misma etiqueta. Una
+  // sala partida por muros da varias regiones; cada pasillo, la suya.
+  std::vector<int> stack;
+  for (int t = 0; t < n; ++t) {
+    if (region[t] >= 0 || !map.isWalkable(t % w, t / w))
+      continue;
+    const int id = regions++;
+    region[t] = id;
+    stack.push_back(t);
+    while (!stack.empty()) {
+      const int c = stack.back();
+      stack.pop_back();
+      const int cx = c % w, cy = c / w;
+      for (int d = 0; d < 4; ++d) {
+        const int nx = cx + DX[d], ny = cy + DY[d];
+        if (!map.isWalkable(nx, ny))
+          continue;
+        const int nt = ny * w + nx;
+        if (region[nt] < 0 && roomTag[nt] == roomTag[t]) {
+          region[nt] = id;
+          stack.push_back(nt);
+        }
+      }
+    }
+  }
+  regionNodes.assign(regions, {});
+
+  // 3. Portales: casillas vecinas de regiones distintas, agrupadas en tramos
+  // contiguos del mismo borde. Un portal por tramo, en la casilla central.
+  struct Edge {
+    int dir, fixed, ra, rb, var;
+  };
+  std::vector<Edge> edges;
+  for (int y = 0; y < h; ++y) {
+    for (int x = 0; x < w; ++x) {
+      const int a = region[y * w + x];
+      if (a < 0)
+        continue;
+      if (x + 1 < w) {
+        const int b = region[y * w + x + 1];
+        if (b >= 0 && b != a)
+          edges.push_back({0, x, a, b, y});
+      }
+      if (y + 1 < h) {
+        const int b = region[(y + 1) * w + x];
+        if (b >= 0 && b != a)
+          edges.push_back({1, y, a, b, x});
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end(), [](const Edge &l, const Edge &r) {
+    return std::tie(l.dir, l.fixed, l.ra, l.rb, l.var) <
+           std::tie(r.dir, r.fixed, r.ra, r.rb, r.var);
+  });
+
+  std::vector<std::pair<int, int>> steps; // Pares de nodos a un paso
+  for (size_t i = 0; i < edges.size();) {
+    size_t j = i + 1;
+    while (j < edges.size() && edges[j].dir == edges[i].dir &&
+           edges[j].fixed == edges[i].fixed && edges[j].ra == edges[i].ra &&
+           edges[j].rb == edges[i].rb &&
+           edges[j].var == edges[j - 1].var + 1)
+      ++j;
+    auto link = [&](const Edge &e) {
+      const int ax = e.dir == 0 ? e.fixed : e.var;
+      const int ay = e.dir == 0 ? e.var : e.fixed;
+      const int bx = ax + (e.dir == 0), by = ay + (e.dir == 1);
+      steps.push_back({nodeFor(ay * w + ax), nodeFor(by * w + bx)});
+    };
+    link(edges[i + (j - i) / 2]);
+    i = j;
+  }
+
+  // 4. Aristas entre portales
+  links.assign(nodes.size(), {});
+  for (const auto &st : steps) {
+    links[st.first].push_back({st.second, -1, 1});
+    links[st.second].push_back({st.first, -1, 1});
+  }
+
+  // Caminos dentro de cada región: un BFS por portal, guardando el tramo
+  // casilla a casilla hacia cada otro portal de la región.
+  for (int r = 0; r < regions; ++r) {
+    for (int u : regionNodes[r]) {
+      bfs(fromS, nodes[u].tile, r);
+      for (int v : regionNodes[r]) {
+        if (v == u || !fromS.reached(nodes[v].tile))
+          continue;
+        const int offset = static_cast<int>(segTiles.size());
+        for (int t = nodes[v].tile; t != nodes[u].tile; t = fromS.parent[t])
+          segTiles.push_back(t);
+        std::reverse(segTiles.begin() + offset, segTiles.end());
+        links[u].push_back(
+            {v, offset, static_cast<int>(segTiles.size()) - offset});
+      }
+    }
+  }
+}
+
+// BFS restringido a una región (las salas son pequeñas: es barato)
+void NavGraph::bfs(Search &s, int src, int reg) const {
+  s.begin(w * h);
+  s.visit(src, 0, -1);
+  s.open.push_back(src);
+  for (size_t head = 0; head < s.open.size(); ++head) {
+    const int c = s.open[head];
+    const int cx = c % w, cy = c / w;
+    for (int d = 0; d < 4; ++d) {
+      const int nx = cx + DX[d], ny = cy + DY[d];
+      if (nx < 0 || ny < 0 || nx >= w || ny >= h)
+        continue;
+      const int nt = ny * w + nx;
+      if (region[nt] != reg || s.reached(nt))
+        continue;
+      s.visit(nt, s.dist[c] + 1, c);
+      s.open.push_back(nt);
+    }
+  }
+}
+
+// A* local dentro de una región (heurística Manhattan). Devuelve el coste o
+// -1. El montículo guarda (f, casilla) codificado en un int64.
+int NavGraph::localAStar(Search &s, int src, int dst, int reg) const {
+  s.begin(w * h);
+  const int tx = dst % w, ty = dst / w;
+  auto heur = [&](int t) { return std::abs(t % w - tx) + std::abs(t / w - ty); };
+
+  auto &heap = s.heap;
+  auto push = [&](int f, int t) {
+    heap.push_back((static_cast<long long>(f) << 32) | static_cast<unsigned>(t));
+    std::push_heap(heap.begin(), heap.end(), std::greater<long long>());
+  };
+
+  s.visit(src, 0, -1);
+  push(heur(src), src);
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<long long>());
+    const long long top = heap.back();
+    heap.pop_back();
+    const int c = static_cast<int>(top & 0xFFFFFFFF);
+    const int f = static_cast<int>(top >> 32);
+    if (f != s.dist[c] + heur(c))
+      continue; // Entrada obsoleta
+    if (c == dst)
+      return s.dist[c];
+
+    const int cx = c % w, cy = c / w;
+    for (int d = 0; d < 4; ++d) {
+      const int nx = cx + DX[d], ny = cy + DY[d];
+      if (nx < 0 || ny < 0 || nx >= w || ny >= h)
+        continue;
+      const int nt = ny * w + nx;
+      if (region[nt] != reg)
+        continue;
+      const int g = s.dist[c] + 1;
+      if (s.reached(nt) && s.dist[nt] <= g)
+        continue;
+      s.visit(nt, g, c);
+      push(g + heur(nt), nt);
+    }
+  }
+  return -1;
+}
+
+// Mejor camino por el grafo de portales: sale de cualquier portal de la
+// región de origen (coste: su BFS) y entra en la de destino por el portal q.
+// A* con heurística Manhattan al destino: admisible y consistente, así que
+// en cuanto el menor f abierto no mejora la mejor llegada, esta es óptima.
+// Deja en 'portals' los padres para reconstruir la cadena desde q.
+int NavGraph::route(int src, int rs, int dst, int rt, int &q) const {
+  bfs(fromS, src, rs);
+  bfs(fromT, dst, rt);
+  Search &s = portals;
+  s.begin(static_cast<int>(nodes.size()));
+  const int tx = dst % w, ty = dst / w;
+  auto heur = [&](int u) {
+    const int t = nodes[u].tile;
+    return std::abs(t % w - tx) + std::abs(t / w - ty);
+  };
+
+  auto &heap = s.heap;
+  auto push = [&](int f, int u) {
+    heap.push_back((static_cast<long long>(f) << 32) | static_cast<unsigned>(u));
+    std::push_heap(heap.begin(), heap.end(), std::greater<long long>());
+  };
+
+  for (int a : regionNodes[rs]) {
+    if (!fromS.reached(nodes[a].tile))
+      continue;
+    s.visit(a, fromS.dist[nodes[a].tile], -1);
+    push(s.dist[a] + heur(a), a);
+  }
+
+  int best = INF;
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<long long>());
+    const long long top = heap.back();
+    heap.pop_back();
+    const int u = static_cast<int>(top & 0xFFFFFFFF);
+    const int f = static_cast<int>(top >> 32);
+    if (f != s.dist[u] + heur(u))
+      continue; // Entrada obsoleta
+    if (f >= best)
+      break;
+
+    if (nodes[u].region == rt && fromT.reached(nodes[u].tile)) {
+      const int d = s.dist[u] + fromT.dist[nodes[u].tile];
+      if (d < best) {
+        best = d;
+        q = u;
+      }
+    }
+    for (const Link &l : links[u]) {
+      const int g = s.dist[u] + l.length;
+      if (s.reached(l.to) && s.dist[l.to] <= g)
+        continue;
+      s.visit(l.to, g, u);
+      push(g + heur(l.to), l.to);
+    }
+  }
+  return best < INF ? best : -1;
+}
+
+// Añade el camino from -> to siguiendo los padres de 's' (raíz en from)
+void NavGraph::appendTrace(const Search &s, int from, int to,
+                           std::vector<Step> &out) const {
+  traceBuf.clear();
+  for (int t = to; t != from && t >= 0; t = s.parent[t])
+    traceBuf.push_back(t);
+  for (auto it = traceBuf.rbegin(); it != traceBuf.rend(); ++it)
+    out.push_back(xy(*it));
+}
+
+bool NavGraph::findPath(int sx, int sy, int tx, int ty,
+                        std::vector<Step> &out) const {
+  out.clear();
+  const int rs = regionAt(sx, sy), rt = regionAt(tx, ty);
+  if (rs < 0 || rt < 0)
+    return false;
+  const int src = sy * w + sx, dst = ty * w + tx;
+  if (src == dst)
+    return true;
+
+  // Misma región: A* local
+  if (rs == rt) {
+    if (localAStar(fromS, src, dst, rs) < 0)
+      return false;
+    appendTrace(fromS, src, dst, out);
+    return true;
+  }
+
+  int q = -1;
+  if (route(src, rs, dst, rt, q) < 0)
+    return false;
+
+  // Cadena de portales, del primero (p) al último (q)
+  chainBuf.clear();
+  for (int u = q; u >= 0; u = portals.parent[u])
+    chainBuf.push_back(u);
+  std::reverse(chainBuf.begin(), chainBuf.end());
+  const int p = chainBuf.front();
+
+  // 1. Origen -> primer portal
+  appendTrace(fromS, src, nodes[p].tile, out);
+
+  // 2. Portal a portal por las aristas (tramos cacheados o saltos de 1
+  // casilla); la arista es la que da la diferencia de coste del A*
+  for (size_t k = 1; k < chainBuf.size(); ++k) {
+    const int u = chainBuf[k - 1], v = chainBuf[k];
+    const int g = portals.dist[v] - portals.dist[u];
+    for (const Link &l : links[u]) {
+      if (l.to != v || l.length != g)
+        continue;
+      if (l.offset < 0)
+        out.push_back(xy(nodes[v].tile));
+      else
+        for (int i = 0; i < l.length; ++i)
+          out.push_back(xy(segTiles[l.offset + i]));
+      break;
+    }
+  }
+
+  // 3. Último portal -> destino (el BFS de destino apunta hacia él)
+  for (int t = fromT.parent[nodes[q].tile]; t >= 0; t = fromT.parent[t])
+    out.push_back(xy(t));
+  return true;
+}
+
+NavGraph::Step NavGraph::nextStep(int sx, int sy, int tx, int ty) const {
+  if (!findPath(sx, sy, tx, ty, stepBuf) || stepBuf.empty())
+    return {sx, sy};
+  return stepBuf.front();
+}
+
+int NavGraph::distance(int sx, int sy, int tx, int ty) const {
+  const int rs = regionAt(sx, sy), rt = regionAt(tx, ty);
+  if (rs < 0 || rt < 0)
+    return -1;
+  const int src = sy * w + sx, dst = ty * w + tx;
+  if (rs == rt)
+    return localAStar(fromS, src, dst, rs);
+  int q = -1;
+  return route(src, rs, dst, rt, q);
+}
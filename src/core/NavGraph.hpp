@@ -0,0 +1,107 @@
+#ifndef NAV_GRAPH_HPP
+#define NAV_GRAPH_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class Map;
+
+// Grafo de navegación jerárquico (salas y pasillos)
+// Nivel alto: cada sala y cada trozo de pasillo es una "región"; donde dos
+// regiones se tocan hay un portal (una casilla a cada lado). Nivel bajo: la
+// rejilla de casillas de siempre.
+//
+// Clave de diseño: el mapa no cambia durante el nivel, así que al generarlo
+// precalculamos los caminos casilla a casilla entre los portales de cada
+// región: son las aristas del grafo de portales. Hay cientos de portales en
+// un mapa normal y más de mil en los de la horda, así que no guardamos una
+// tabla entre todos los pares (memoria N², tiempo N³). Una consulta lejana
+// cuesta un BFS dentro de la región de origen y otro en la de destino
+// (salas pequeñas) más un A* sobre el grafo de portales; dentro de una
+// misma región basta un A* local. Ninguna consulta recorre el mapa entero.
+class NavGraph {
+public:
+  using Step = std::pair<int, int>;
+
+  // Lado (en casillas) de los bloques en que se trocean los pasillos
+  static constexpr int CORRIDOR_CHUNK = 8;
+
+  // Reconstruye el grafo para el mapa actual (lo llama Map al generar)
+  void build(const Map &map);
+  void clear();
+
+  // Región de la casilla (-1 si es muro o está fuera del mapa)
+  int regionAt(int x, int y) const;
+  int regionCount() const { return regions; }
+  int portalCount() const { return static_cast<int>(nodes.size()); }
+
+  // Camino de (sx, sy) a (tx, ty): casillas en orden, sin el origen y con el
+  // destino. false si no hay camino (o si origen/destino no son suelo).
+  // Usa memoria de trabajo interna: no llamar desde varios hilos a la vez.
+  bool findPath(int sx, int sy, int tx, int ty, std::vector<Step> &out) const;
+
+  // Primer paso del camino; (sx, sy) si no hay camino o ya está en destino
+  Step nextStep(int sx, int sy, int tx, int ty) const;
+
+  // Longitud del camino en pasos (-1 si no hay)
+  int distance(int sx, int sy, int tx, int ty) const;
+
+private:
+  struct Node {
+    int tile;   // Índice y * w + x
+    int region;
+  };
+
+  // Arista del grafo de portales. Dentro de una región, el tramo cacheado
+  // (casillas en segTiles, sin el portal de salida); entre regiones, un
+  // paso de una casilla (length 1, offset -1).
+  struct Link {
+    int to;
+    int offset, length;
+  };
+
+  // Memoria de búsqueda reutilizable. 'stamp' evita limpiar los vectores en
+  // cada consulta: una casilla vale solo si su sello es el actual.
+  struct Search {
+    std::vector<std::uint32_t> stamp;
+    std::vector<int> dist, parent;
+    std::vector<int> open;        // Cola del BFS
+    std::vector<long long> heap;  // Abiertos del A*
+    std::uint32_t gen = 0;
+
+    void begin(int n);
+    bool reached(int t) const { return stamp[t] == gen; }
+    void visit(int t, int d, int from) {
+      stamp[t] = gen;
+      dist[t] = d;
+      parent[t] = from;
+    }
+  };
+
+  Step xy(int t) const { return {t % w, t / w}; }
+  int nodeFor(int tile);
+
+  void bfs(Search &s, int src, int reg) const;
+  int localAStar(Search &s, int src, int dst, int reg) const;
+  int route(int src, int rs, int dst, int rt, int &q) const;
+  void appendTrace(const Search &s, int from, int to,
+                   std::vector<Step> &out) const;
+
+  int w = 0, h = 0;
+  int regions = 0;
+  std::vector<int> region;                  // Región por casilla (-1 muro)
+  std::vector<Node> nodes;                  // Portales (uno por lado)
+  std::vector<int> nodeAt;                  // Nodo por casilla (-1 ninguno)
+  std::vector<std::vector<int>> regionNodes; // Portales de cada región
+  std::vector<std::vector<Link>> links;      // Aristas de cada portal
+  std::vector<int> segTiles;
+
+  mutable Search fromS, fromT;
+  mutable Search portals; // A* sobre portales (parent = portal anterior)
+  mutable std::vector<int> traceBuf;
+  mutable std::vector<int> chainBuf; // Portales del camino, en orden
+  mutable std::vector<Step> stepBuf;
+};
+
+#endif
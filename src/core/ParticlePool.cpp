@@ -0,0 +1,135 @@
+#include "ParticlePool.hpp"
+#include <algorithm>
+#include <cmath>
+
+ParticlePool::ParticlePool(std::size_t capacity, std::uint32_t seed)
+    : cap(std::max<std::size_t>(1, capacity)), rng(seed ? seed : 1u),
+      px(cap), py(cap), vx(cap), vy(cap), life(cap), invMaxLife(cap),
+      sizes(cap), colors(cap) {}
+
+const std::array<float, 2 * ParticlePool::DIRECTIONS> &
+ParticlePool::directionTable() {
+  // (cos, sin) intercalados; se calcula una sola vez
+  static const std::array<float, 2 * DIRECTIONS> table = [] {
+    std::array<float, 2 * DIRECTIONS> t{};
+    const double step = 2.0 * 3.14159265358979323846 / DIRECTIONS;
+    for (int i = 0; i < DIRECTIONS; ++i) {
+      t[2 * i] = static_cast<float>(std::cos(i * step));
+      t[2 * i + 1] = static_cast<float>(std::sin(i * step));
+    }
+    return t;
+  }();
+  return table;
+}
+
+void ParticlePool::burst(float x, float y, int n, std::uint32_t rgba) {
+  const auto &dirs = directionTable();
+  for (int k = 0; k < n; ++k) {
+    std::size_t i;
+    if (count < cap) {
+      i = slot(count++);
+    } else {
+      // Lleno: la más vieja deja su hueco a la nueva
+      i = tail;
+      tail = (tail + 1 == cap) ? 0 : tail + 1;
+      evictions++;
+    }
+
+    const std::uint32_t r = nextRandom();
+    const int d = static_cast<int>(r & (DIRECTIONS - 1));
+    const float speed = 50.0f + static_cast<float>((r >> 8) % 101);   // 50-150
+    const float maxLife = 0.5f + 0.1f * static_cast<float>((r >> 16) % 6); // 0.5-1.0
+    const float size = 2.0f + static_cast<float>((r >> 24) % 4);      // 2-5
+
+    px[i] = x;
+    py[i] = y;
+    vx[i] = dirs[2 * d] * speed;
+    vy[i] = dirs[2 * d + 1] * speed;
+    life[i] = maxLife;
+    invMaxLife[i] = 1.0f / maxLife;
+    sizes[i] = size;
+    colors[i] = rgba;
+  }
+}
+
+void ParticlePool::integrate(std::size_t from, std::size_t to, float dt,
+                             float friction, float shrink) {
+  float *__restrict x = px.data();
+  float *__restrict y = py.data();
+  float *__restrict u = vx.data();
+  float *__restrict v = vy.data();
+  float *__restrict l = life.data();
+  float *__restrict s = sizes.data();
+
+  for (std::size_t i = from; i < to; ++i)
+    l[i] -= dt;
+  for (std::size_t i = from; i < to; ++i) {
+    x[i] += u[i] * dt;
+    y[i] += v[i] * dt;
+  }
+  for (std::size_t i = from; i < to; ++i) {
+    u[i] *= friction;
+    v[i] *= friction;
+  }
+  // Se encogen en su último medio segundo (sin ramas)
+  for (std::size_t i = from; i < to; ++i)
+    s[i] *= (l[i] < 0.5f) ? shrink : 1.0f;
+}
+
+void ParticlePool::update(float dt) {
+  if (count == 0)
+    return;
+
+  // Fricción y encogido eran 0.95 y 0.98 por frame a 60 fps; así no
+  // dependen del frame rate
+  const float friction = std::pow(0.95f, dt * 60.0f);
+  const float shrink = std::pow(0.98f, dt * 60.0f);
+
+  // La ventana ocupa como mucho dos tramos contiguos del anillo
+  const std::size_t end = tail + count;
+  integrate(tail, std::min(end, cap), dt, friction, shrink);
+  if (end > cap)
+    integrate(0, end - cap, dt, friction, shrink);
+
+  // Recuperar por la cola las que ya murieron
+  while (count > 0 && life[tail] <= 0.0f) {
+    tail = (tail + 1 == cap) ? 0 : tail + 1;
+    count--;
+  }
+  if (count == 0)
+    tail = 0;
+}
+
+void ParticlePool::saveState(StateWriter &out) const {
+  out.pod(count);
+  out.pod(evictions);
+  out.pod(rng);
+  // La ventana da la vuelta al anillo como mucho una vez: dos tramos
+  const std::size_t first = std::min(count, cap - tail);
+  auto window = [&](const auto &v) {
+    out.raw(v.data() + tail, first);
+    out.raw(v.data(), count - first);
+  };
+  window(px);
+  window(py);
+  window(vx);
+  window(vy);
+  window(life);
+  window(invMaxLife);
+  window(sizes);
+  window(colors);
+}
+
+bool ParticlePool::loadState(StateReader &in) {
+  std::size_t n = 0;
+  if (!(in.pod(n) && in.pod(evictions) && in.pod(rng)))
+    return false;
+  if (n > cap)
+    return in.fail();
+  tail = 0;
+  count = n;
+  return in.raw(px.data(), n) && in.raw(py.data(), n) &&
+         in.raw(vx.data(), n) && in.raw(vy.data(), n) &&
+         in.raw(life.data(), n) && in.raw(invMaxLife.data(), n) &&
+         in.raw(sizes.data(), n) && in.raw(colors.data(), n);
+}
@@ -0,0 +1,87 @@
+#ifndef PARTICLE_POOL_HPP
+#define PARTICLE_POOL_HPP
+
+#include "StateBuffer.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Pool de partículas (anillo de capacidad fija, estructura de arrays)
+// Las partículas se escriben en orden de creación sobre un anillo: las vivas
+// forman una ventana [tail, tail + count). Cada frame se integra la ventana
+// entera con bucles planos (vida, posición, fricción, encogido) y se
+// recuperan por la cola las que ya murieron.
+//
+// Clave de diseño: presupuesto duro. La capacidad no crece nunca; si una
+// explosión no cabe, sobrescribe las partículas más viejas (que son las que
+// están a punto de desvanecerse). Crear una partícula no llama a rand() ni
+// a sin/cos: usa un xorshift local y una tabla de direcciones precalculada.
+// Así una explosión de 200 cuesta lo mismo que 200 escrituras en arrays.
+// Colores en el formato de PrimitiveBatch::pack.
+class ParticlePool {
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+  static constexpr int DIRECTIONS = 256; // Resolución de la tabla de ángulos
+
+  explicit ParticlePool(std::size_t capacity = DEFAULT_CAPACITY,
+                        std::uint32_t seed = 0x9E3779B9u);
+
+  // Explosión: 'count' partículas desde (x, y) en direcciones aleatorias.
+  // Velocidad 50-150 px/s, vida 0.5-1.0 s, tamaño 2-5 px.
+  void burst(float x, float y, int count, std::uint32_t rgba);
+
+  // Integra todas y recupera las muertas más viejas
+  void update(float dt);
+
+  void clear() { tail = count = 0; }
+
+  // Foto de la ventana, de la más vieja a la más nueva (ver SimSnapshot).
+  // Al cargarla la ventana empieza en el hueco 0: mismo orden, mismo efecto.
+  void saveState(StateWriter &out) const;
+  bool loadState(StateReader &in);
+  void reseed(std::uint32_t seed) { rng = seed ? seed : 1u; }
+
+  std::size_t size() const { return count; } // Ventana (incluye muertas)
+  std::size_t capacity() const { return cap; }
+  std::size_t evicted() const { return evictions; } // Sobrescritas por tope
+
+  // f(x, y, size, alpha 0..1, rgba) para cada partícula viva, de la más
+  // vieja a la más nueva
+  template <class F> void forEachAlive(F &&f) const {
+    for (std::size_t k = 0; k < count; ++k) {
+      const std::size_t i = slot(k);
+      if (life[i] > 0.0f)
+        f(px[i], py[i], sizes[i], life[i] * invMaxLife[i], colors[i]);
+    }
+  }
+
+private:
+  std::size_t slot(std::size_t k) const {
+    const std::size_t i = tail + k;
+    return i < cap ? i : i - cap;
+  }
+  std::uint32_t nextRandom() {
+    // xorshift32: suficiente para efectos visuales y muy barato
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+  }
+  void integrate(std::size_t from, std::size_t to, float dt, float friction,
+                 float shrink);
+
+  std::size_t cap = 0;
+  std::size_t tail = 0;  // Partícula más vieja
+  std::size_t count = 0; // Tamaño de la ventana
+  std::size_t evictions = 0;
+  std::uint32_t rng = 1;
+
+  std::vector<float> px, py, vx, vy;
+  std::vector<float> life, invMaxLife, sizes;
+  std::vector<std::uint32_t> colors;
+
+  static const std::array<float, 2 * DIRECTIONS> &directionTable();
+};
+
+#endif
@@ -0,0 +1,156 @@
+#include "PopulationStreamer.hpp"
+
+void PopulationStreamer::reset(const Map &map, unsigned seed, float density,
+                               int liveCap) {
+  w = map.width();
+  h = map.height();
+  sx = (w + SECTOR - 1) / SECTOR;
+  sy = (h + SECTOR - 1) / SECTOR;
+  cap = std::max(0, liveCap);
+  quota = 0;
+  dormant = 0;
+  sectors.assign(static_cast<size_t>(sx) * sy, {});
+  rng.reseed(seed);
+
+  if (density <= 0.0f || w <= 0 || h <= 0)
+    return;
+
+  // Cuota por sector: densidad x suelo (la parte fraccionaria, a sorteo)
+  std::vector<int> floorCount(sectors.size(), 0);
+  for (int y = 0; y < h; ++y)
+    for (int x = 0; x < w; ++x)
+      if (map.isWalkable(x, y))
+        floorCount[sectorIndex(x, y)]++;
+
+  for (size_t s = 0; s < sectors.size(); ++s) {
+    const float want = density * static_cast<float>(floorCount[s]);
+    int q = static_cast<int>(want);
+    if (rng.chance(want - static_cast<float>(q)))
+      q++;
+    sectors[s].quota = q;
+    quota += q;
+  }
+}
+
+void PopulationStreamer::park(const Record &r) {
+  if (r.x < 0 || r.y < 0 || r.x >= w || r.y >= h)
+    return;
+  sectors[sectorIndex(r.x, r.y)].parked.push_back(r);
+  dormant++;
+}
+
+int PopulationStreamer::sectorDistance(int s, int px, int py) const {
+  const int x0 = (s % sx) * SECTOR, y0 = (s / sx) * SECTOR;
+  const int x1 = std::min(w, x0 + SECTOR) - 1, y1 = std::min(h, y0 + SECTOR) - 1;
+  const int dx = (px < x0) ? x0 - px : (px > x1 ? px - x1 : 0);
+  const int dy = (py < y0) ? y0 - py : (py > y1 ? py - y1 : 0);
+  return std::max(dx, dy);
+}
+
+void PopulationStreamer::update(const Map &map, int px, int py,
+                                std::size_t liveCount,
+                                std::vector<Record> &restore,
+                                std::vector<std::pair<int, int>> &fresh) {
+  restore.clear();
+  fresh.clear();
+  if (sectors.empty())
+    return;
+  size_t room = (liveCount < static_cast<size_t>(cap))
+                    ? static_cast<size_t>(cap) - liveCount
+                    : 0;
+  if (room == 0)
+    return;
+
+  // Solo miramos los sectores de la caja de entrada, no el mapa entero
+  const int r = STREAM_IN_TILES;
+  const int s0x = std::max(0, (px - r) / SECTOR);
+  const int s1x = std::min(sx - 1, std::max(0, px + r) / SECTOR);
+  const int s0y = std::max(0, (py - r) / SECTOR);
+  const int s1y = std::min(sy - 1, std::max(0, py + r) / SECTOR);
+
+  // 1. Primero vuelven los aparcados (enemigos que el jugador ya pudo ver)
+  for (int cy = s0y; cy <= s1y && room > 0; ++cy) {
+    for (int cx = s0x; cx <= s1x && room > 0; ++cx) {
+      const int s = cy * sx + cx;
+      auto &parked = sectors[s].parked;
+      if (parked.empty() || sectorDistance(s, px, py) > r)
+        continue;
+      while (!parked.empty() && room > 0) {
+        restore.push_back(parked.back());
+        parked.pop_back();
+        dormant--;
+        room--;
+      }
+    }
+  }
+
+  // 2. Cuotas de densidad, en casillas de suelo fuera de la vista
+  if (quota == 0)
+    return;
+  const int minD = SPAWN_MIN_TILES;
+  for (int cy = s0y; cy <= s1y && room > 0; ++cy) {
+    for (int cx = s0x; cx <= s1x && room > 0; ++cx) {
+      const int s = cy * sx + cx;
+      Sector &sec = sectors[s];
+      if (sec.quota == 0 || sectorDistance(s, px, py) > r)
+        continue;
+
+      const int x0 = cx * SECTOR, y0 = cy * SECTOR;
+      const int spanX = std::min(w, x0 + SECTOR) - x0 - 1;
+      const int spanY = std::min(h, y0 + SECTOR) - y0 - 1;
+
+      // Intentos acotados: si el sector está demasiado cerca, la cuota
+      // queda pendiente para otro paso.
+      for (int tries = sec.quota * 4; tries > 0 && sec.quota > 0 && room > 0;
+           --tries) {
+        const int x = x0 + rng.range(0, spanX);
+        const int y = y0 + rng.range(0, spanY);
+        if (!map.isWalkable(x, y))
+          continue;
+        if (std::max(std::abs(x - px), std::abs(y - py)) < minD)
+          continue;
+        fresh.push_back({x, y});
+        sec.quota--;
+        quota--;
+        room--;
+      }
+    }
+  }
+}
+
+void PopulationStreamer::dormantTiles(
+    std::vector<std::pair<int, int>> &out) const {
+  for (const auto &sec : sectors)
+    for (const auto &r : sec.parked)
+      out.push_back({r.x, r.y});
+}
+
+void PopulationStreamer::saveState(StateWriter &out) const {
+  out.pod(w);
+  out.pod(h);
+  out.pod(sx);
+  out.pod(sy);
+  out.pod(cap);
+  out.pod(quota);
+  out.pod(dormant);
+  out.pod(rng);
+  out.pod(static_cast<std::uint64_t>(sectors.size()));
+  for (const Sector &sec : sectors) {
+    out.pod(sec.quota);
+    out.vec(sec.parked);
+  }
+}
+
+bool PopulationStreamer::loadState(StateReader &in) {
+  std::uint64_t n = 0;
+  if (!(in.pod(w) && in.pod(h) && in.pod(sx) && in.pod(sy) && in.pod(cap) &&
+        in.pod(quota) && in.pod(dormant) && in.pod(rng) && in.pod(n)))
+    return false;
+  if (n != static_cast<std::uint64_t>(sx) * static_cast<std::uint64_t>(sy))
+    return in.fail();
+  sectors.resize(static_cast<std::size_t>(n)); // Conserva los vectores
+  for (Sector &sec : sectors)
+    if (!in.pod(sec.quota) || !in.vec(sec.parked))
+      return false;
+  return true;
+}
@@ -0,0 +1,96 @@
+#ifndef POPULATION_STREAMER_HPP
+#define POPULATION_STREAMER_HPP
+
+#include "Map.hpp"
+#include "RngStream.hpp"
+#include "StateBuffer.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+// Población por streaming
+// El mapa se divide en sectores de SECTOR x SECTOR casillas. Solo los
+// enemigos cercanos al jugador existen como enemigos "vivos" (con sprite,
+// turnos, IA...). Los lejanos se guardan serializados en su sector como un
+// registro compacto y vuelven a la vida cuando el jugador se acerca.
+//
+// Clave de diseño: el conjunto vivo está acotado (liveCap) sea cual sea el
+// tamaño del mapa o la población total. Hay dos fuentes de enemigos:
+// - Registros aparcados (park): población fija decidida al generar el nivel
+//   o enemigos vivos que se alejaron.
+// - Densidad: cada sector tiene una cuota (densidad x casillas de suelo) que
+//   se va creando al entrar en rango, siempre fuera de la vista del jugador.
+// Entrar usa un radio menor que salir (histéresis) para que un enemigo en el
+// borde no entre y salga en cada paso.
+class PopulationStreamer {
+public:
+  static constexpr int SECTOR = 8;            // Lado del sector (tiles)
+  static constexpr int STREAM_IN_TILES = 20;  // Sectores a esta distancia entran
+  static constexpr int STREAM_OUT_TILES = 28; // Enemigos más lejos se aparcan
+  static constexpr int SPAWN_MIN_TILES = 12;  // Lo nuevo no aparece a la vista
+
+  // Enemigo serializado (16 bytes: 2 de relleno antes de hp)
+  struct Record {
+    std::int16_t x = 0, y = 0;
+    std::uint8_t type = 0, facing = 0;
+    std::int32_t hp = 0, maxHp = 0;
+  };
+  static_assert(sizeof(Record) == 16, "Record: revisar el tamaño comentado");
+
+  // Nuevo nivel. density = enemigos por casilla de suelo (0 = sin cuota,
+  // solo registros aparcados). liveCap = máximo de enemigos vivos.
+  void reset(const Map &map, unsigned seed, float density, int liveCap);
+
+  // Sin nivel (tutorial, boss): no aparca ni crea nada
+  void clear() { *this = PopulationStreamer{}; }
+  bool active() const { return !sectors.empty(); }
+
+  // Guarda un enemigo en el sector de su casilla
+  void park(const Record &r);
+
+  // ¿Debe aparcarse un enemigo vivo en (x, y)? (distancia de Chebyshev)
+  bool shouldPark(int px, int py, int x, int y) const {
+    return std::max(std::abs(x - px), std::abs(y - py)) > STREAM_OUT_TILES;
+  }
+
+  // Paso del jugador: devuelve los registros que vuelven a la vida y las
+  // casillas donde crear enemigos nuevos, sin pasar de liveCap en total.
+  void update(const Map &map, int px, int py, std::size_t liveCount,
+              std::vector<Record> &restore,
+              std::vector<std::pair<int, int>> &fresh);
+
+  // Casillas de todos los aparcados (para no poner objetos encima)
+  void dormantTiles(std::vector<std::pair<int, int>> &out) const;
+
+  // Foto de los sectores y sus aparcados (ver SimSnapshot)
+  void saveState(StateWriter &out) const;
+  bool loadState(StateReader &in);
+
+  std::size_t dormantCount() const { return dormant; }
+  int pendingQuota() const { return quota; }
+  int liveCap() const { return cap; }
+
+private:
+  struct Sector {
+    std::vector<Record> parked;
+    int quota = 0; // Enemigos nuevos por crear en este sector
+  };
+
+  int sectorIndex(int x, int y) const {
+    return (y / SECTOR) * sx + (x / SECTOR);
+  }
+  int sectorDistance(int s, int px, int py) const; // Chebyshev a su caja
+
+  int w = 0, h = 0;
+  int sx = 0, sy = 0; // Sectores por eje
+  int cap = 0;
+  int quota = 0;      // Suma de cuotas pendientes
+  std::size_t dormant = 0;
+  std::vector<Sector> sectors;
+  RngStream rng;
+};
+
+#endif
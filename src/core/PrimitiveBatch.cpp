@@ -0,0 +1,70 @@
+#include "PrimitiveBatch.hpp"
+#include <cmath>
+
+const std::array<float, 2 * (PrimitiveBatch::CIRCLE_SEGMENTS + 1)> &
+PrimitiveBatch::unitCircle() {
+  // (cos, sin) intercalados; el último repite el primero para cerrar
+  static const std::array<float, 2 * (CIRCLE_SEGMENTS + 1)> table = [] {
+    std::array<float, 2 * (CIRCLE_SEGMENTS + 1)> t{};
+    const double step = 2.0 * 3.14159265358979323846 / CIRCLE_SEGMENTS;
+    for (int i = 0; i <= CIRCLE_SEGMENTS; ++i) {
+      t[2 * i] = static_cast<float>(std::cos(i * step));
+      t[2 * i + 1] = static_cast<float>(std::sin(i * step));
+    }
+    return t;
+  }();
+  return table;
+}
+
+void PrimitiveBatch::rect(float x, float y, float w, float h,
+                          std::uint32_t rgba) {
+  if (w <= 0.0f || h <= 0.0f)
+    return;
+  // Sentido antihorario en pantalla (Y hacia abajo), como raylib
+  Vertex *v = grow(6);
+  v[0] = {x, y, rgba};
+  v[1] = {x, y + h, rgba};
+  v[2] = {x + w, y + h, rgba};
+  v[3] = {x, y, rgba};
+  v[4] = {x + w, y + h, rgba};
+  v[5] = {x + w, y, rgba};
+  cur.primitives++;
+}
+
+void PrimitiveBatch::rectLines(float x, float y, float w, float h, float thick,
+                               std::uint32_t rgba) {
+  rect(x, y, w, thick, rgba);                         // Arriba
+  rect(x, y + h - thick, w, thick, rgba);             // Abajo
+  rect(x, y + thick, thick, h - 2 * thick, rgba);     // Izquierda
+  rect(x + w - thick, y + thick, thick, h - 2 * thick, rgba); // Derecha
+}
+
+void PrimitiveBatch::circle(float cx, float cy, float r, std::uint32_t rgba) {
+  // Los círculos pequeños (núcleos de bala) no necesitan tantos lados
+  const int stride = r < SMALL_CIRCLE ? 2 : 1;
+  const int segs = CIRCLE_SEGMENTS / stride;
+  const auto &u = unitCircle();
+  Vertex *v = grow(3 * static_cast<std::size_t>(segs));
+  for (int s = 0; s < segs; ++s) {
+    // Abanico desde el centro, en el mismo sentido que rect()
+    const int i = 2 * s * stride, j = 2 * (s + 1) * stride;
+    v[0] = {cx, cy, rgba};
+    v[1] = {cx + u[j] * r, cy + u[j + 1] * r, rgba};
+    v[2] = {cx + u[i] * r, cy + u[i + 1] * r, rgba};
+    v += 3;
+  }
+  cur.primitives++;
+}
+
+void PrimitiveBatch::markSubmitted(std::size_t drawCalls) {
+  cur.vertices += verts.size();
+  cur.submits++;
+  cur.draws += drawCalls;
+  verts.clear();
+}
+
+void PrimitiveBatch::beginFrame() {
+  last = cur;
+  cur = Stats{};
+  verts.clear();
+}
@@ -0,0 +1,78 @@
+#ifndef PRIMITIVE_BATCH_HPP
+#define PRIMITIVE_BATCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Lote de primitivas 2D (rectángulos y círculos rellenos)
+// Los sistemas de efectos no dibujan directamente: apuntan sus primitivas
+// aquí como triángulos (x, y, color) en un único flujo de vértices, y el
+// render los envía todos de golpe a rlgl (Game::flushBatch).
+//
+// Clave de diseño: una bala, una partícula o una barra de vida dejan de ser
+// llamadas sueltas a raylib y pasan a ser unos pocos vértices en un vector
+// que no se libera entre frames. El envío recorre ese vector una vez, así
+// que el coste por primitiva es escribir vértices y no una llamada de
+// dibujo. Los círculos usan una tabla de senos/cosenos precalculada.
+class PrimitiveBatch {
+public:
+  static constexpr int CIRCLE_SEGMENTS = 12; // Lados de un círculo normal
+  static constexpr float SMALL_CIRCLE = 3.0f; // Radio (px): menos, mitad de lados
+
+  struct Vertex {
+    float x, y;
+    std::uint32_t rgba;
+  };
+
+  // Contadores del frame para el overlay de rendimiento
+  struct Stats {
+    std::size_t primitives = 0; // Rectángulos + círculos apuntados
+    std::size_t vertices = 0;   // Vértices enviados
+    std::size_t submits = 0;    // Envíos (flushBatch)
+    std::size_t draws = 0;      // Llamadas de dibujo que generaron
+  };
+
+  PrimitiveBatch() { verts.reserve(1 << 16); }
+
+  void rect(float x, float y, float w, float h, std::uint32_t rgba);
+  // Borde de 'thick' píxeles hacia dentro (como DrawRectangleLines con 1)
+  void rectLines(float x, float y, float w, float h, float thick,
+                 std::uint32_t rgba);
+  void circle(float cx, float cy, float r, std::uint32_t rgba);
+
+  const std::vector<Vertex> &vertices() const { return verts; }
+  bool empty() const { return verts.empty(); }
+
+  // Tras enviar: cuenta el envío y vacía el flujo (conserva la memoria)
+  void markSubmitted(std::size_t drawCalls);
+  // Al empezar el frame: publica los contadores del anterior
+  void beginFrame();
+
+  const Stats &lastFrame() const { return last; }
+  const Stats &current() const { return cur; }
+
+  // Color sin raylib: RGBA en 32 bits, R en el byte bajo, igual que
+  // Palette::rgba. Lo usan también ParticlePool y FloatingTextPool; el
+  // frontend lo abre con unpackColor().
+  static std::uint32_t pack(unsigned char r, unsigned char g, unsigned char b,
+                            unsigned char a) {
+    return (std::uint32_t)r | ((std::uint32_t)g << 8) |
+           ((std::uint32_t)b << 16) | ((std::uint32_t)a << 24);
+  }
+
+private:
+  // Amplía el flujo en n vértices y devuelve dónde escribirlos
+  Vertex *grow(std::size_t n) {
+    const std::size_t at = verts.size();
+    verts.resize(at + n);
+    return verts.data() + at;
+  }
+  static const std::array<float, 2 * (CIRCLE_SEGMENTS + 1)> &unitCircle();
+
+  std::vector<Vertex> verts;
+  Stats cur, last;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "ProjectilePool.hpp"
+#include <cmath>
+
+ProjectilePool::ProjectilePool(std::size_t capacity)
+    : cap(capacity), px(capacity), py(capacity), vxs(capacity), vys(capacity),
+      speeds(capacity), ranges(capacity), damages(capacity), owners(capacity) {}
+
+bool ProjectilePool::spawn(float x, float y, float vx, float vy, float range,
+                           int damage, Owner owner) {
+  if (count >= cap)
+    return false;
+  const std::size_t i = count++;
+  px[i] = x;
+  py[i] = y;
+  vxs[i] = vx;
+  vys[i] = vy;
+  speeds[i] = std::sqrt(vx * vx + vy * vy);
+  ranges[i] = range;
+  damages[i] = damage;
+  owners[i] = owner;
+  return true;
+}
+
+void ProjectilePool::integrate(float dt) {
+  // Punteros locales: sin aliasing visible entre arrays, bucles simples
+  const std::size_t n = count;
+  float *__restrict x = px.data();
+  float *__restrict y = py.data();
+  float *__restrict r = ranges.data();
+  const float *__restrict vx = vxs.data();
+  const float *__restrict vy = vys.data();
+  const float *__restrict s = speeds.data();
+
+  for (std::size_t i = 0; i < n; ++i)
+    x[i] += vx[i] * dt;
+  for (std::size_t i = 0; i < n; ++i)
+    y[i] += vy[i] * dt;
+  for (std::size_t i = 0; i < n; ++i)
+    r[i] -= s[i] * dt;
+}
+
+void ProjectilePool::advance(std::size_t i, float dt) {
+  if (i >= count)
+    return;
+  px[i] += vxs[i] * dt;
+  py[i] += vys[i] * dt;
+  ranges[i] -= speeds[i] * dt;
+}
+
+void ProjectilePool::kill(std::size_t i) {
+  if (i >= count)
+    return;
+  const std::size_t last = --count;
+  if (i == last)
+    return;
+  px[i] = px[last];
+  py[i] = py[last];
+  vxs[i] = vxs[last];
+  vys[i] = vys[last];
+  speeds[i] = speeds[last];
+  ranges[i] = ranges[last];
+  damages[i] = damages[last];
+  owners[i] = owners[last];
+}
+
+void ProjectilePool::saveState(StateWriter &out) const {
+  out.pod(count);
+  out.raw(px.data(), count);
+  out.raw(py.data(), count);
+  out.raw(vxs.data(), count);
+  out.raw(vys.data(), count);
+  out.raw(speeds.data(), count);
+  out.raw(ranges.data(), count);
+  out.raw(damages.data(), count);
+  out.raw(owners.data(), count);
+}
+
+bool ProjectilePool::loadState(StateReader &in) {
+  std::size_t n = 0;
+  if (!in.pod(n))
+    return false;
+  if (n > cap)
+    return in.fail();
+  count = n;
+  return in.raw(px.data(), n) && in.raw(py.data(), n) &&
+         in.raw(vxs.data(), n) && in.raw(vys.data(), n) &&
+         in.raw(speeds.data(), n) && in.raw(ranges.data(), n) &&
+         in.raw(damages.data(), n) && in.raw(owners.data(), n);
+}
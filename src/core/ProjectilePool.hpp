@@ -0,0 +1,72 @@
+#ifndef PROJECTILE_POOL_HPP
+#define PROJECTILE_POOL_HPP
+
+#include "StateBuffer.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Pool de proyectiles (estructura de arrays)
+// Cada campo vive en su propio array contiguo: posición x/y, velocidad x/y,
+// alcance restante, paso por segundo, daño y bando. Los vivos ocupan siempre
+// los índices [0, size()); al morir uno, el último ocupa su hueco.
+//
+// Clave de diseño: capacidad fija reservada al construir, así que disparar
+// nunca reserva memoria ni mueve los arrays. La velocidad escalar se calcula
+// una vez al crear el proyectil (nada de sqrt por frame) y integrate() son
+// bucles planos sobre floats que el compilador vectoriza. Si el pool está
+// lleno el disparo se descarta: con miles de balas en pantalla una más no
+// se nota y el coste queda acotado.
+class ProjectilePool {
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 8192;
+
+  enum Owner : std::uint8_t { Player = 0, Enemy = 1 };
+
+  explicit ProjectilePool(std::size_t capacity = DEFAULT_CAPACITY);
+
+  // Crea un proyectil con 'range' píxeles de alcance. false si está lleno.
+  bool spawn(float x, float y, float vx, float vy, float range, int damage,
+             Owner owner);
+
+  // Mueve todos los proyectiles y descuenta el alcance recorrido
+  void integrate(float dt);
+
+  // Mueve solo el proyectil i (para recién creados que van con retraso)
+  void advance(std::size_t i, float dt);
+
+  // Borra el proyectil i (el último pasa a ocupar i). Para borrar mientras
+  // se recorre, recorrer de atrás hacia delante.
+  void kill(std::size_t i);
+  void clear() { count = 0; }
+
+  // Foto de los vivos (ver SimSnapshot). Cargar falla si no caben.
+  void saveState(StateWriter &out) const;
+  bool loadState(StateReader &in);
+
+  std::size_t size() const { return count; }
+  std::size_t capacity() const { return cap; }
+  bool empty() const { return count == 0; }
+
+  float x(std::size_t i) const { return px[i]; }
+  float y(std::size_t i) const { return py[i]; }
+  float vx(std::size_t i) const { return vxs[i]; }
+  float vy(std::size_t i) const { return vys[i]; }
+  float speed(std::size_t i) const { return speeds[i]; }
+  float range(std::size_t i) const { return ranges[i]; } // <= 0: agotado
+  int damage(std::size_t i) const { return damages[i]; }
+  Owner owner(std::size_t i) const { return static_cast<Owner>(owners[i]); }
+  bool isEnemy(std::size_t i) const { return owners[i] == Enemy; }
+
+private:
+  std::size_t cap = 0;
+  std::size_t count = 0;
+  std::vector<float> px, py;   // Posición (píxeles de mundo)
+  std::vector<float> vxs, vys; // Velocidad (px/s)
+  std::vector<float> speeds;   // |v| precalculada
+  std::vector<float> ranges;   // Alcance restante (px)
+  std::vector<std::int32_t> damages;
+  std::vector<std::uint8_t> owners;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef RNG_STREAM_HPP
+#define RNG_STREAM_HPP
+
+#include <cstdint>
+
+// Flujo de números aleatorios determinista (PCG32)
+// Toda la aleatoriedad de la partida sale de flujos como este, sembrados a
+// partir de la semilla del run. Cada uso tiene su propio flujo (generación
+// del nivel, apariciones, efectos...), así que consumir más números en uno
+// (p. ej. más partículas) no cambia lo que sale en los demás.
+//
+// Clave de diseño: resultados idénticos en cualquier máquina. Las
+// distribuciones de <random> (uniform_int_distribution...) dependen de la
+// librería estándar, por eso el flujo trae las suyas: range() sin sesgo
+// (multiplicación de Lemire), unit() y chance(). Cumple además la interfaz
+// UniformRandomBitGenerator por si alguien necesita std::shuffle.
+class RngStream {
+public:
+  using result_type = std::uint32_t;
+
+  // Identificadores de flujo: la misma semilla da secuencias independientes
+  enum Stream : std::uint64_t {
+    Level = 1, // Generación del nivel y colocación inicial
+    Spawn = 2, // Apariciones durante la partida (streaming)
+    Fx = 3,    // Efectos visuales (temblor, partículas)
+    Bot = 4,   // Decisiones del jugador automático (AutoPlayer)
+  };
+
+  explicit RngStream(std::uint64_t seed = 0, std::uint64_t stream = 0) {
+    reseed(seed, stream);
+  }
+
+  void reseed(std::uint64_t seed, std::uint64_t stream = 0) {
+    // Siembra estándar de PCG: el flujo elige el incremento (impar) y la
+    // semilla, ya mezclada, el punto de partida
+    state = 0;
+    inc = (mix(stream, 0x5EED) << 1u) | 1u;
+    (*this)();
+    state += mix(seed, stream);
+    (*this)();
+  }
+
+  result_type operator()() {
+    const std::uint64_t old = state;
+    state = old * 6364136223846793005ULL + inc;
+    const std::uint32_t xorshifted =
+        static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+    const std::uint32_t rot = static_cast<std::uint32_t>(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+  }
+
+  // Entero uniforme en [lo, hi] (ambos incluidos; lo >= hi devuelve lo)
+  int range(int lo, int hi) {
+    if (lo >= hi)
+      return lo;
+    const std::uint32_t span =
+        static_cast<std::uint32_t>(static_cast<std::int64_t>(hi) - lo + 1);
+    if (span == 0) // [INT_MIN, INT_MAX]: cualquier palabra vale
+      return static_cast<int>((*this)());
+
+    // Lemire: se escala con una multiplicación y se rechaza solo la pequeña
+    // franja que introduciría sesgo
+    std::uint64_t m = static_cast<std::uint64_t>((*this)()) * span;
+    std::uint32_t low = static_cast<std::uint32_t>(m);
+    if (low < span) {
+      const std::uint32_t threshold = (0u - span) % span;
+      while (low < threshold) {
+        m = static_cast<std::uint64_t>((*this)()) * span;
+        low = static_cast<std::uint32_t>(m);
+      }
+    }
+    return static_cast<int>(static_cast<std::int64_t>(lo) +
+                            static_cast<std::int64_t>(m >> 32));
+  }
+  // Real uniforme en [0, 1) con 24 bits (exacto en float)
+  float unit() {
+    return static_cast<float>((*this)() >> 8) * (1.0f / 16777216.0f);
+  }
+  bool chance(float p) { return unit() < p; }
+
+  // Estado completo (dos palabras): basta para guardar y reanudar el flujo
+  std::uint64_t stateWord() const { return state; }
+  std::uint64_t streamWord() const { return inc; }
+  void restore(std::uint64_t s, std::uint64_t i) {
+    state = s;
+    inc = i | 1u;
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+  // Mezcla SplitMix64: de una semilla y un índice saca otra semilla
+  static std::uint64_t mix(std::uint64_t seed, std::uint64_t salt) {
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (salt + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+private:
+  std::uint64_t state = 0;
+  std::uint64_t inc = 1;
+};
+
+#endif
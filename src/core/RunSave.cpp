@@ -0,0 +1,207 @@
+#include "RunSave.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+const char MAGIC[4] = {'R', 'B', 'S', 'V'};
+
+// FNV-1a de 64 bits: detecta archivos cortados o tocados a mano
+std::uint64_t checksum(const std::vector<std::uint8_t> &bytes) {
+  std::uint64_t h = 0xcbf29ce484222325ull;
+  for (std::uint8_t b : bytes) {
+    h ^= b;
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+} // namespace
+
+// ----------------------------------------------------------------------------
+// Archivo
+// ----------------------------------------------------------------------------
+void RunSave::capture(const GameSim &sim) {
+  seed = sim.getRunSeed();
+  difficulty = sim.getDifficulty();
+  level = sim.getCurrentLevel();
+  tick = sim.getTick();
+  sim.saveSnapshot(snapshot);
+}
+
+bool RunSave::save(const std::string &path) const {
+  std::vector<std::uint8_t> header;
+  StateWriter out(header);
+  out.raw(MAGIC, sizeof(MAGIC));
+  out.pod(VERSION);
+  out.pod(seed);
+  out.pod(difficulty);
+  out.pod(level);
+  out.pod(tick);
+  out.pod(static_cast<std::uint64_t>(snapshot.size()));
+  const std::uint64_t sum = checksum(snapshot.bytes);
+
+  std::error_code ec;
+  const std::filesystem::path target(path);
+  if (target.has_parent_path())
+    std::filesystem::create_directories(target.parent_path(), ec);
+
+  const std::string tmp = path + ".tmp";
+  {
+    std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+    if (!f)
+      return false;
+    f.write(reinterpret_cast<const char *>(header.data()),
+            static_cast<std::streamsize>(header.size()));
+    f.write(reinterpret_cast<const char *>(snapshot.bytes.data()),
+            static_cast<std::streamsize>(snapshot.size()));
+    f.write(reinterpret_cast<const char *>(&sum), sizeof(sum));
+    f.close();
+    if (!f) {
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+  }
+  // El cambio de nombre sustituye al anterior de una vez
+  std::filesystem::rename(tmp, target, ec);
+  if (ec) {
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+  return true;
+}
+
+bool RunSave::load(const std::string &path) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f)
+    return false;
+  const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(f)),
+                                       std::istreambuf_iterator<char>());
+
+  // Se lee en una copia: si el archivo está roto, esto no cambia
+  RunSave r;
+  char magic[4] = {};
+  std::uint32_t version = 0;
+  std::uint64_t sum = 0;
+  StateReader in(data.data(), data.size());
+  if (!in.raw(magic, sizeof(magic)) || !std::equal(magic, magic + 4, MAGIC) ||
+      !in.pod(version) || version != VERSION)
+    return false; // Otra versión del archivo
+  if (!in.pod(r.seed) || !in.pod(r.difficulty) || !in.pod(r.level) ||
+      !in.pod(r.tick) || !in.vec(r.snapshot.bytes) || !in.pod(sum) ||
+      !in.done() || sum != checksum(r.snapshot.bytes))
+    return false;
+  if (!r.snapshot.compatible())
+    return false; // Foto de otro binario: no se puede reponer
+  r.snapshot.tick = r.tick;
+  r.snapshot.level = r.level;
+
+  *this = std::move(r);
+  return true;
+}
+
+bool RunSave::erase(const std::string &path) {
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+  return !ec;
+}
+
+// ----------------------------------------------------------------------------
+// Autoguardado
+// ----------------------------------------------------------------------------
+AutosaveWriter::AutosaveWriter(std::string path) : file(std::move(path)) {
+#if !defined(__EMSCRIPTEN__)
+  worker = std::thread([this] { workerLoop(); });
+#endif
+}
+
+AutosaveWriter::~AutosaveWriter() {
+#if !defined(__EMSCRIPTEN__)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopping = true;
+  }
+  cv.notify_one();
+  if (worker.joinable())
+    worker.join();
+#endif
+}
+
+void AutosaveWriter::submit(const RunSave &save) {
+#if defined(__EMSCRIPTEN__)
+  run(Job::Write, save);
+#else
+  // La copia, fuera del cerrojo (reutiliza la capacidad de la anterior);
+  // dentro solo se intercambian búferes
+  staging = save;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::swap(staging, job);
+    pending = Job::Write;
+  }
+  cv.notify_one();
+#endif
+}
+
+void AutosaveWriter::erase() {
+#if defined(__EMSCRIPTEN__)
+  run(Job::Erase, job);
+#else
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    pending = Job::Erase; // Una escritura pendiente ya no hace falta
+  }
+  cv.notify_one();
+#endif
+}
+
+void AutosaveWriter::flush() {
+#if !defined(__EMSCRIPTEN__)
+  std::unique_lock<std::mutex> lock(mtx);
+  idle.wait(lock, [this] { return pending == Job::None && !busy; });
+#endif
+}
+
+std::uint64_t AutosaveWriter::completed() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  return done;
+}
+
+bool AutosaveWriter::lastOk() const {
+  std::lock_guard<std::mutex> lock(mtx);
+  return ok;
+}
+
+// Sin el cerrojo: en el hilo, 'save' es el búfer propio ('writing')
+void AutosaveWriter::run(Job j, const RunSave &save) {
+  const bool result = j == Job::Write ? save.save(file) : RunSave::erase(file);
+#if !defined(__EMSCRIPTEN__)
+  std::lock_guard<std::mutex> lock(mtx);
+#endif
+  ok = result;
+  ++done;
+}
+
+void AutosaveWriter::workerLoop() {
+  std::unique_lock<std::mutex> lock(mtx);
+  for (;;) {
+    cv.wait(lock, [this] { return stopping || pending != Job::None; });
+    if (pending == Job::None)
+      return; // Saliendo y sin nada pendiente
+    const Job j = pending;
+    pending = Job::None;
+    if (j == Job::Write)
+      std::swap(job, writing);
+    busy = true;
+
+    lock.unlock();
+    run(j, writing);
+    lock.lock();
+
+    busy = false;
+    idle.notify_all();
+  }
+}
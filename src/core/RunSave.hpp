@@ -0,0 +1,80 @@
+#ifndef RUN_SAVE_HPP
+#define RUN_SAVE_HPP
+
+#include "GameSim.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Partida guardada en disco ("Continuar")
+// Archivo binario versionado: un resumen para el menú (semilla, dificultad,
+// nivel, tick) y la foto completa de la partida (SimSnapshot: mapa y
+// niebla, enemigos, inventario, temporizadores, flujos RNG...), cerrado con
+// una suma de comprobación. Como la foto va tal cual está en memoria, un
+// guardado de otra versión del juego no se carga (load() devuelve false).
+//
+// save() escribe en "<ruta>.tmp" y lo renombra encima del anterior: si el
+// juego se cierra a mitad de escritura, queda el guardado viejo entero.
+struct RunSave {
+  static constexpr std::uint32_t VERSION = 1;
+
+  unsigned seed = 0;
+  Difficulty difficulty = Difficulty::Medium;
+  int level = 0;
+  std::uint64_t tick = 0;
+  SimSnapshot snapshot;
+
+  void capture(const GameSim &sim); // Resumen + foto (microsegundos)
+  bool save(const std::string &path) const;
+  bool load(const std::string &path); // Si falla, este objeto no cambia
+  static bool erase(const std::string &path); // true si ya no existe
+};
+
+// Autoguardado en segundo plano
+// El hilo principal solo copia la partida (capture() y una copia de bytes
+// a un búfer reutilizado; bajo el cerrojo, un intercambio de punteros) y
+// sigue; abrir, escribir y renombrar el archivo lo hace otro hilo. Si
+// llegan encargos mientras escribe, el último sustituye al pendiente: en
+// disco acaba siempre el más reciente. Sin hilos (web) se escribe dentro
+// de submit().
+class AutosaveWriter {
+public:
+  explicit AutosaveWriter(std::string path);
+  ~AutosaveWriter(); // Termina lo pendiente antes de salir
+  AutosaveWriter(const AutosaveWriter &) = delete;
+  AutosaveWriter &operator=(const AutosaveWriter &) = delete;
+
+  void submit(const RunSave &save); // Escribe esta partida (un solo hilo)
+  void erase();                     // Borra el guardado (partida terminada)
+  void flush();                     // Espera a que no quede nada pendiente
+
+  const std::string &path() const { return file; }
+  std::uint64_t completed() const; // Encargos terminados
+  bool lastOk() const;             // ¿El último salió bien?
+
+private:
+  enum class Job { None, Write, Erase };
+  void run(Job job, const RunSave &save);
+  void workerLoop();
+
+  std::string file;
+
+  mutable std::mutex mtx;
+  std::condition_variable cv;
+  std::condition_variable idle; // Para flush()
+  Job pending = Job::None;
+  bool busy = false;
+  bool stopping = false;
+  RunSave staging; // Copia de submit(), solo del hilo que encarga
+  RunSave job;     // Lo encargado
+  RunSave writing; // Lo que escribe el hilo (se intercambia con 'job')
+  std::uint64_t done = 0;
+  bool ok = true;
+#if !defined(__EMSCRIPTEN__)
+  std::thread worker;
+#endif
+};
+
+#endif
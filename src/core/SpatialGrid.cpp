@@ -0,0 +1,34 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+
+void SpatialGrid::resize(int width, int height) {
+  width = std::max(0, width);
+  height = std::max(0, height);
+  if (width != w || height != h) {
+    w = width;
+    h = height;
+    head.assign(static_cast<size_t>(w) * h, NONE);
+    stamp.assign(static_cast<size_t>(w) * h, 0);
+    gen = 0;
+  }
+  clear();
+}
+
+void SpatialGrid::clear() {
+  if (++gen == 0) {
+    // Vuelta completa del contador: limpiamos de verdad una vez
+    std::fill(stamp.begin(), stamp.end(), 0);
+    gen = 1;
+  }
+}
+
+void SpatialGrid::insert(int id, int x, int y) {
+  if (id < 0 || x < 0 || y < 0 || x >= w || y >= h)
+    return;
+  if (id >= static_cast<int>(nextId.size()))
+    nextId.resize(static_cast<size_t>(id) + 1, NONE);
+  const int c = y * w + x;
+  nextId[id] = (stamp[c] == gen) ? head[c] : NONE;
+  head[c] = id;
+  stamp[c] = gen;
+}
@@ -0,0 +1,55 @@
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <cstdint>
+#include <vector>
+
+// Rejilla uniforme de entidades (broadphase)
+// Una celda por casilla del mapa; cada celda guarda la lista de ids (índices
+// de enemigo, por ejemplo) que están en ella. Sirve para preguntar "¿qué hay
+// en esta casilla y en sus vecinas?" sin recorrer todas las entidades.
+//
+// Clave de diseño: se reconstruye entera cada frame en O(entidades). Las
+// listas son enlazadas dentro de dos arrays (cabeza por celda, siguiente por
+// id) y cada cabeza lleva un sello de generación: clear() solo incrementa el
+// sello, así que vaciar una rejilla de 512x512 no toca su memoria.
+class SpatialGrid {
+public:
+  static constexpr int NONE = -1;
+
+  // Ajusta el tamaño (solo reserva si cambia) y vacía la rejilla
+  void resize(int width, int height);
+  void clear();
+
+  // Añade 'id' (>= 0) a la celda (x, y). Fuera de la rejilla se ignora.
+  void insert(int id, int x, int y);
+
+  // Primer id de la celda (NONE si vacía) y siguiente de la lista
+  int first(int x, int y) const {
+    if (x < 0 || y < 0 || x >= w || y >= h)
+      return NONE;
+    const int c = y * w + x;
+    return stamp[c] == gen ? head[c] : NONE;
+  }
+  int next(int id) const { return nextId[id]; }
+
+  // Llama f(id) para cada id en las celdas a distancia <= r (cuadrado)
+  template <class F> void forEachNear(int x, int y, int r, F &&f) const {
+    for (int cy = y - r; cy <= y + r; ++cy)
+      for (int cx = x - r; cx <= x + r; ++cx)
+        for (int id = first(cx, cy); id != NONE; id = nextId[id])
+          f(id);
+  }
+
+  int width() const { return w; }
+  int height() const { return h; }
+
+private:
+  int w = 0, h = 0;
+  std::uint32_t gen = 1;
+  std::vector<int> head;
+  std::vector<std::uint32_t> stamp; // head[c] vale solo si stamp[c] == gen
+  std::vector<int> nextId;          // Crece al ver ids mayores (una vez)
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef STATE_BUFFER_HPP
+#define STATE_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Escritura y lectura de fotos del estado (ver SimSnapshot)
+// Cada sistema vuelca lo suyo con saveState(StateWriter&) y lo recupera con
+// loadState(StateReader&), en el mismo orden. Los campos van tal cual están
+// en memoria (sin conversión de endianness ni de tamaños): una foto solo vale
+// para el mismo binario, y por eso la cabecera de SimSnapshot lleva una
+// huella del formato.
+//
+// Clave de diseño: todo son copias de bloques contiguos (memcpy de vectores
+// de tipos trivialmente copiables) sobre un único búfer que se reutiliza, así
+// que tomar una foto no reserva memoria tras la primera y cuesta lo que
+// copiar unos KB. El lector comprueba límites y, si algo no cuadra, se queda
+// en error sin tocar nada más: loadState() devuelve false y GameSim descarta
+// la foto entera.
+class StateWriter {
+public:
+  explicit StateWriter(std::vector<std::uint8_t> &out) : buf(out) {
+    buf.clear(); // Conserva la capacidad de la foto anterior
+  }
+
+  template <class T> void pod(const T &v) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "solo tipos trivialmente copiables");
+    bytes(&v, sizeof(T));
+  }
+
+  // 'n' elementos seguidos, sin longitud (el lector ya sabe cuántos son)
+  template <class T> void raw(const T *p, std::size_t n) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "solo tipos trivialmente copiables");
+    bytes(p, n * sizeof(T));
+  }
+
+  // Longitud + contenido
+  template <class T> void vec(const std::vector<T> &v) {
+    pod(static_cast<std::uint64_t>(v.size()));
+    raw(v.data(), v.size());
+  }
+
+  std::size_t size() const { return buf.size(); }
+
+private:
+  void bytes(const void *p, std::size_t n) {
+    const auto *b = static_cast<const std::uint8_t *>(p);
+    buf.insert(buf.end(), b, b + n);
+  }
+
+  std::vector<std::uint8_t> &buf;
+};
+
+class StateReader {
+public:
+  StateReader(const std::uint8_t *data, std::size_t size)
+      : at(data), end(data + size) {}
+
+  template <class T> bool pod(T &v) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "solo tipos trivialmente copiables");
+    return bytes(&v, sizeof(T));
+  }
+
+  template <class T> bool raw(T *p, std::size_t n) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "solo tipos trivialmente copiables");
+    if (n > remaining() / sizeof(T))
+      return fail();
+    return bytes(p, n * sizeof(T));
+  }
+
+  // Reutiliza la capacidad de 'v' (mismo tamaño: sin reservas)
+  template <class T> bool vec(std::vector<T> &v) {
+    std::uint64_t n = 0;
+    if (!pod(n))
+      return false;
+    if (n > remaining() / sizeof(T))
+      return fail();
+    v.resize(static_cast<std::size_t>(n));
+    return raw(v.data(), v.size());
+  }
+
+  // Como vec(), pero la longitud tiene que ser exactamente 'n'
+  template <class T> bool vecOfSize(std::vector<T> &v, std::size_t n) {
+    std::uint64_t got = 0;
+    if (!pod(got))
+      return false;
+    if (got != n)
+      return fail();
+    v.resize(n);
+    return raw(v.data(), n);
+  }
+
+  // ¿Los próximos 'n' elementos son iguales a p[0..n)? No avanza.
+  template <class T> bool matches(const T *p, std::size_t n) const {
+    return good && n <= remaining() / sizeof(T) &&
+           (n == 0 || std::memcmp(at, p, n * sizeof(T)) == 0);
+  }
+
+  bool ok() const { return good; }
+  bool done() const { return good && at == end; }
+  std::size_t remaining() const { return static_cast<std::size_t>(end - at); }
+  bool fail() {
+    good = false;
+    return false;
+  }
+
+private:
+  bool bytes(void *p, std::size_t n) {
+    if (!good || n > remaining())
+      return fail();
+    if (n > 0)
+      std::memcpy(p, at, n);
+    at += n;
+    return true;
+  }
+
+  const std::uint8_t *at;
+  const std::uint8_t *end;
+  bool good = true;
+};
+
+#endif
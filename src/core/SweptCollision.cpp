@@ -0,0 +1,27 @@
+#include "SweptCollision.hpp"
+
+namespace rb {
+
+float sweptCircle(float x0, float y0, float x1, float y1, float cx, float cy,
+                  float r) {
+  // |A + t·d - C|² = r²  ->  a·t² + 2b·t + c = 0
+  const float fx = x0 - cx, fy = y0 - cy;
+  const float c = fx * fx + fy * fy - r * r;
+  if (c < 0.0f)
+    return 0.0f; // Empieza dentro
+
+  const float dx = x1 - x0, dy = y1 - y0;
+  const float a = dx * dx + dy * dy;
+  const float b = fx * dx + fy * dy;
+  if (a <= 0.0f || b >= 0.0f)
+    return -1.0f; // Quieto o alejándose
+
+  const float disc = b * b - a * c;
+  if (disc < 0.0f)
+    return -1.0f; // Pasa de largo
+
+  const float t = (-b - std::sqrt(disc)) / a;
+  return (t <= 1.0f) ? t : -1.0f;
+}
+
+} // namespace rb
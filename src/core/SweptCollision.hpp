@@ -0,0 +1,81 @@
+#ifndef SWEPT_COLLISION_HPP
+#define SWEPT_COLLISION_HPP
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+// Colisión continua (barrida) para proyectiles
+// Un proyectil no salta de A a B: recorre el segmento A->B. Aquí están las
+// dos piezas para tratarlo así:
+// - traverseTiles: DDA sobre la rejilla (Amanatides-Woo). Visita en orden
+//   todas las casillas que toca el segmento, con el instante t (0..1) en que
+//   entra en cada una.
+// - sweptCircle: primer instante t en que un punto que va de A a B entra en
+//   un círculo (hitbox de una entidad).
+//
+// Clave de diseño: el resultado no depende del dt. Un frame largo solo
+// alarga el segmento; no hay "túneles" a través de muros ni hitboxes
+// saltadas. Cuando el segmento pasa justo por una esquina se visitan las dos
+// casillas laterales antes que la diagonal, para no colarse entre dos muros
+// que solo se tocan en un vértice.
+namespace rb {
+
+// Recorre las casillas (tamaño 'tile') que toca el segmento (x0,y0)->(x1,y1).
+// visit(tx, ty, t) devuelve true para parar; traverseTiles devuelve ese t
+// (o -1 si se recorrió entero sin parar).
+template <class Visit>
+float traverseTiles(float x0, float y0, float x1, float y1, float tile,
+                    Visit &&visit) {
+  const float inf = std::numeric_limits<float>::infinity();
+  const float dx = x1 - x0, dy = y1 - y0;
+  int tx = static_cast<int>(std::floor(x0 / tile));
+  int ty = static_cast<int>(std::floor(y0 / tile));
+  const int endX = static_cast<int>(std::floor(x1 / tile));
+  const int endY = static_cast<int>(std::floor(y1 / tile));
+
+  if (visit(tx, ty, 0.0f))
+    return 0.0f;
+
+  const int stepX = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+  const int stepY = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+  float tMaxX = stepX ? ((tx + (stepX > 0)) * tile - x0) / dx : inf;
+  float tMaxY = stepY ? ((ty + (stepY > 0)) * tile - y0) / dy : inf;
+  const float tDeltaX = stepX ? tile / std::fabs(dx) : inf;
+  const float tDeltaY = stepY ? tile / std::fabs(dy) : inf;
+
+  // Cota de pasos: casillas entre los extremos (+ margen por redondeo)
+  int budget = std::abs(endX - tx) + std::abs(endY - ty) + 4;
+  while (budget-- > 0) {
+    const float t = std::fmin(tMaxX, tMaxY);
+    if (t > 1.0f)
+      break;
+    if (tMaxX < tMaxY) {
+      tx += stepX;
+      tMaxX += tDeltaX;
+    } else if (tMaxY < tMaxX) {
+      ty += stepY;
+      tMaxY += tDeltaY;
+    } else {
+      // Esquina exacta: primero las dos laterales
+      if (visit(tx + stepX, ty, t) || visit(tx, ty + stepY, t))
+        return t;
+      tx += stepX;
+      ty += stepY;
+      tMaxX += tDeltaX;
+      tMaxY += tDeltaY;
+    }
+    if (visit(tx, ty, t))
+      return t;
+  }
+  return -1.0f;
+}
+
+// Primer t en [0, 1] en que el punto (x0,y0)->(x1,y1) está a menos de 'r'
+// de (cx, cy). 0 si ya empieza dentro; -1 si no llega a tocarlo.
+float sweptCircle(float x0, float y0, float x1, float y1, float cx, float cy,
+                  float r);
+
+} // namespace rb
+
+#endif
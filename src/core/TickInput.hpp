@@ -0,0 +1,59 @@
+#ifndef TICK_INPUT_HPP
+#define TICK_INPUT_HPP
+
+#include <cstdint>
+
+// Entrada del jugador para un tick de simulación
+// El frontend lee teclado y mando una vez por frame y lo resume aquí; la
+// simulación solo consume TickInput (GameSim::applyTickInput), nunca raylib.
+// Todo lo que cambia la partida pasa por aquí, así que grabar un TickInput por
+// tick basta para repetirla (ver InputRecording).
+//
+// Clave de diseño: separar lo mantenido de lo pulsado. Lo mantenido
+// (dirección, modo de movimiento) es el estado del último frame leído. Lo
+// pulsado (flancos: paso, dash, ataques...) se acumula entre frames hasta
+// que un tick lo consume, así que a 144 FPS (frames sin tick) no se pierde
+// ninguna pulsación y a 30 FPS (varios ticks por frame) no se repite.
+struct TickInput {
+  // Mantenido
+  std::int8_t holdX = 0, holdY = 0; // Dirección mantenida (-1, 0, 1)
+  bool stepMode = true;             // MovementMode::StepByStep
+
+  // Flancos (solo el primer tick que los ve)
+  std::int8_t stepX = 0, stepY = 0; // Dirección pulsada (paso a paso)
+  bool movePressed = false;         // Alguna dirección recién pulsada
+  bool dash = false;
+  bool interact = false;
+  bool attackHands = false;
+  bool attackSword = false;
+  bool attackPlasma = false;
+  bool toggleGod = false; // Modo dios (contraseña o código del mando)
+
+  // Suma la lectura de un frame nuevo a la pendiente
+  void merge(const TickInput &f) {
+    holdX = f.holdX;
+    holdY = f.holdY;
+    stepMode = f.stepMode;
+    if (f.stepX != 0 || f.stepY != 0) {
+      stepX = f.stepX;
+      stepY = f.stepY;
+    }
+    movePressed |= f.movePressed;
+    dash |= f.dash;
+    interact |= f.interact;
+    attackHands |= f.attackHands;
+    attackSword |= f.attackSword;
+    attackPlasma |= f.attackPlasma;
+    toggleGod |= f.toggleGod;
+  }
+
+  // Tras el primer tick: lo mantenido sigue, los flancos ya se usaron
+  void clearEdges() {
+    stepX = stepY = 0;
+    movePressed = dash = interact = false;
+    attackHands = attackSword = attackPlasma = false;
+    toggleGod = false;
+  }
+};
+
+#endif
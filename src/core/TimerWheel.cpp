@@ -0,0 +1,127 @@
+#include "TimerWheel.hpp"
+#include <algorithm>
+#include <cmath>
+
+TimerWheel::TimerWheel(double tickSeconds)
+    : tick(tickSeconds > 0.0 ? tickSeconds : 1.0 / 64.0) {}
+
+TimerWheel::TimerId TimerWheel::schedule(double expireAt,
+                                         std::function<void()> cb) {
+  TimerId id = nextId++;
+  if (nextId == INVALID_TIMER)
+    nextId = 1; // Saltamos el 0 al desbordar
+
+  // Redondeamos hacia arriba: el tick elegido nunca es anterior al instante
+  double t = std::min(std::ceil(expireAt / tick), 4.0e18);
+  std::uint64_t et = (t <= 0.0) ? 0 : static_cast<std::uint64_t>(t);
+
+  live.insert(id);
+  Node n{expireAt, et, id, std::move(cb)};
+  if (et <= curTick)
+    overdue.push_back(std::move(n));
+  else
+    place(std::move(n));
+  return id;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+  // Borrado perezoso: el nodo sigue en su casilla pero ya no se ejecuta
+  return live.erase(id) != 0;
+}
+
+void TimerWheel::place(Node &&n) {
+  // Elegimos el nivel más bajo cuya "distancia en bloques" cabe en 64
+  // casillas. Así la casilla nunca coincide con un bloque ya procesado.
+  for (int level = 0; level < LEVELS; ++level) {
+    const int shift = level * SLOT_BITS;
+    const std::uint64_t dist = (n.expireTick >> shift) - (curTick >> shift);
+    if (dist < SLOTS) {
+      slots[level][(n.expireTick >> shift) & (SLOTS - 1)].push_back(
+          std::move(n));
+      return;
+    }
+  }
+
+  // Más allá del horizonte: lo aparcamos en la última casilla del nivel alto
+  // y se reubicará al bajar en cascada.
+  const int shift = (LEVELS - 1) * SLOT_BITS;
+  const std::uint64_t slot = ((curTick >> shift) + SLOTS - 1) & (SLOTS - 1);
+  slots[LEVELS - 1][slot].push_back(std::move(n));
+}
+
+void TimerWheel::cascade(int level) {
+  const int shift = level * SLOT_BITS;
+  auto &slot = slots[level][(curTick >> shift) & (SLOTS - 1)];
+  std::vector<Node> moving;
+  moving.swap(slot);
+  for (auto &n : moving) {
+    if (live.count(n.id))
+      place(std::move(n));
+  }
+}
+
+void TimerWheel::fire(std::vector<Node> &due) {
+  // Orden determinista: primero el que expira antes; empate por id
+  std::sort(due.begin(), due.end(), [](const Node &a, const Node &b) {
+    if (a.expireAt != b.expireAt)
+      return a.expireAt < b.expireAt;
+    return a.id < b.id;
+  });
+  for (auto &n : due) {
+    if (live.erase(n.id) == 0)
+      continue; // Cancelado
+    if (n.cb)
+      n.cb();
+  }
+}
+
+void TimerWheel::advance(double now) {
+  if (now > clock)
+    clock = now;
+
+  const double t = std::floor(clock / tick);
+  const std::uint64_t target = (t <= 0.0) ? 0 : static_cast<std::uint64_t>(t);
+
+  // Atrasados (programados para un instante que ya había pasado)
+  if (!overdue.empty()) {
+    std::vector<Node> due;
+    due.swap(overdue);
+    fire(due);
+  }
+
+  while (curTick < target) {
+    ++curTick;
+
+    // Al cruzar un múltiplo de 64^L bajamos la casilla correspondiente
+    for (int level = LEVELS - 1; level >= 1; --level) {
+      const std::uint64_t mask = (std::uint64_t(1) << (level * SLOT_BITS)) - 1;
+      if ((curTick & mask) == 0)
+        cascade(level);
+    }
+
+    auto &slot = slots[0][curTick & (SLOTS - 1)];
+    if (slot.empty())
+      continue;
+    std::vector<Node> due;
+    due.swap(slot);
+    fire(due);
+
+    // Un callback pudo programar algo para "ya"
+    if (!overdue.empty()) {
+      std::vector<Node> late;
+      late.swap(overdue);
+      fire(late);
+    }
+  }
+}
+
+void TimerWheel::reset(double now) {
+  for (auto &level : slots)
+    for (auto &slot : level)
+      slot.clear();
+  overdue.clear();
+  live.clear();
+  clock = now;
+  const double t = std::floor(now / tick);
+  curTick = (t <= 0.0) ? 0 : static_cast<std::uint64_t>(t);
+}
@@ -0,0 +1,73 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+// Rueda de temporizadores jerárquica (Hierarchical Timing Wheel)
+// Guarda temporizadores con un instante absoluto de expiración (segundos del
+// reloj de simulación) y ejecuta su callback cuando el reloj lo alcanza.
+//
+// Clave de diseño:
+// - El tiempo se discretiza en "ticks" (por defecto 1/64 s).
+// - 4 niveles de 64 casillas: el nivel 0 cubre 64 ticks, el 1 cubre 64^2...
+//   Un temporizador lejano se guarda en un nivel alto y "baja" (cascade)
+//   cuando el reloj se acerca a su instante.
+// - Un temporizador inactivo no cuesta nada por frame: avanzar el reloj solo
+//   visita la casilla del tick actual.
+// - Nunca dispara antes de tiempo: expira en el primer tick >= su instante.
+class TimerWheel {
+public:
+  using TimerId = std::uint32_t;
+  static constexpr TimerId INVALID_TIMER = 0;
+
+  explicit TimerWheel(double tickSeconds = 1.0 / 64.0);
+
+  // Programa 'cb' para el instante absoluto 'expireAt'.
+  // Si el instante ya pasó, se dispara en el siguiente advance().
+  TimerId schedule(double expireAt, std::function<void()> cb);
+
+  // Cancela un temporizador pendiente. Devuelve false si ya no existía.
+  bool cancel(TimerId id);
+  bool isPending(TimerId id) const { return live.count(id) != 0; }
+
+  // Avanza el reloj hasta 'now' y ejecuta, en orden de expiración, todos los
+  // temporizadores vencidos. Los callbacks pueden programar o cancelar otros.
+  void advance(double now);
+
+  // Vacía la rueda y coloca el reloj en 'now' (nueva partida).
+  void reset(double now = 0.0);
+
+  double now() const { return clock; }
+  std::size_t pending() const { return live.size(); }
+
+private:
+  static constexpr int LEVELS = 4;
+  static constexpr int SLOT_BITS = 6;
+  static constexpr int SLOTS = 1 << SLOT_BITS;
+
+  struct Node {
+    double expireAt;
+    std::uint64_t expireTick;
+    TimerId id;
+    std::function<void()> cb;
+  };
+
+  void place(Node &&n);             // Inserta según distancia al tick actual
+  void cascade(int level);          // Baja una casilla de nivel 'level'
+  void fire(std::vector<Node> &due); // Ejecuta los vivos en orden
+
+  double tick;
+  double clock = 0.0;
+  std::uint64_t curTick = 0;
+  TimerId nextId = 1;
+
+  std::vector<Node> slots[LEVELS][SLOTS];
+  std::vector<Node> overdue;         // Programados para un tick ya pasado
+  std::unordered_set<TimerId> live;  // Pendientes (cancel = borrar de aquí)
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include "Game.hpp"
+#include "GameUtils.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <cmath>
+
+// Renderizado de enemigos
+void Game::drawEnemies() const {
+  // Calculamos la vida máxima para la barra según la dificultad y el nivel.
+  // En modo fácil: 60/80/100; en medio: 70/90/110; en difícil: 100/125/150.
+  int maxHPLevel;
+  switch (difficulty) {
+  case Difficulty::Easy:
+    maxHPLevel = (currentLevel == 1) ? 60 : (currentLevel == 2) ? 80 : 100;
+    break;
+  case Difficulty::Medium:
+    maxHPLevel = (currentLevel == 1) ? 70 : (currentLevel == 2) ? 90 : 110;
+    break;
+  case Difficulty::Hard:
+  default:
+    // Fórmula original: 100 + 25*(nivel-1)
+    maxHPLevel = ENEMY_BASE_HP + (currentLevel - 1) * 25;
+    break;
+  }
+  float maxHP = static_cast<float>(maxHPLevel);
+
+  auto visible = [&](int x, int y) {
+    return !map.fogEnabled() || map.isVisible(x, y);
+  };
+
+  const uint32_t barBack = PrimitiveBatch::pack(60, 60, 60, 200);
+  const uint32_t barFill = PrimitiveBatch::pack(RED.r, RED.g, RED.b, RED.a);
+  const uint32_t barEdge = PrimitiveBatch::pack(BLACK.r, BLACK.g, BLACK.b, BLACK.a);
+
+  for (size_t i = 0; i < enemies.size(); ++i) {
+    const auto &e = enemies[i];
+    if (!visible(e.getX(), e.getY()))
+      continue;
+
+    const Texture2D *tex = nullptr;
+
+    EnemyFacing face =
+        (i < enemyFacing.size()) ? enemyFacing[i] : EnemyFacing::Down;
+
+    // Alternamos frame 1 / frame 2 con el tiempo de animación del enemigo
+    // (no depende de si se mueve o no, pero te asegura que NUNCA se quedará en
+    // idle “por error de assets”)
+    bool frame2 = ((int)std::floor(e.getAnimTime() * 4.0f) % 2) == 1;
+
+    // Elegimos set según tipo
+    const bool isEnemy2 = (e.getType() == Enemy::Shooter);
+
+    if (!isEnemy2) {
+      switch (face) {
+      case EnemyFacing::Up:
+        tex = frame2 ? &itemSprites.enemy1Up2 : &itemSprites.enemy1Up1;
+        break;
+      case EnemyFacing::Down:
+        tex = frame2 ? &itemSprites.enemy1Down2 : &itemSprites.enemy1Down1;
+        break;
+      case EnemyFacing::Left:
+        tex = frame2 ? &itemSprites.enemy1Left2 : &itemSprites.enemy1Left1;
+        break;
+      case EnemyFacing::Right:
+        tex = frame2 ? &itemSprites.enemy1Right2 : &itemSprites.enemy1Right1;
+        break;
+      }
+    } else {
+      switch (face) {
+      case EnemyFacing::Up:
+        tex = frame2 ? &itemSprites.enemy2Up2 : &itemSprites.enemy2Up1;
+        break;
+      case EnemyFacing::Down:
+        tex = frame2 ? &itemSprites.enemy2Down2 : &itemSprites.enemy2Down1;
+        break;
+      case EnemyFacing::Left:
+        tex = frame2 ? &itemSprites.enemy2Left2 : &itemSprites.enemy2Left1;
+        break;
+      case EnemyFacing::Right:
+        tex = frame2 ? &itemSprites.enemy2Right2 : &itemSprites.enemy2Right1;
+        break;
+      }
+    }
+
+    const float xpx = (float)(e.getX() * tileSize);
+    const float ypx = (float)(e.getY() * tileSize);
+
+    Color tint = WHITE;
+
+    // 1. Respiración (Squash & Stretch)
+    // Usamos el seno del tiempo para calcular una escala Y que oscila entre
+    // 0.95 y 1.05
+    float breathe = 1.0f + sinf(e.getAnimTime()) * 0.05f;
+
+    // 2. Origen de rotación
+    // Queremos que roten desde sus "pies" (centro-abajo), no desde la esquina
+    // El centro del tile es (16, 16). Los pies son (16, 32).
+    Vector2 origin = {(float)tileSize / 2.0f, (float)tileSize};
+
+    // 3. Destino ajustado
+    // Como rotamos desde los pies, la posición Y de destino debe ser la base
+    // del tile
+    Rectangle dest = {
+        xpx + tileSize / 2.0f,    // Centro X
+        ypx + tileSize,           // Pies Y
+        (float)tileSize,          // Ancho
+        (float)tileSize * breathe // Alto (Respirando)
+    };
+
+    if (tex && tex->id != 0) {
+      Rectangle src{0, 0, (float)tex->width, (float)tex->height};
+      // Usamos la rotación (tilt)
+      DrawTexturePro(*tex, src, dest, origin, e.getTilt(), tint);
+    } else {
+      // Fallback a idle del tipo correspondiente
+      const Texture2D &idle = (e.getType() == Enemy::Shooter)
+                                  ? itemSprites.enemy2Idle
+                                  : itemSprites.enemy1Idle;
+      if (idle.id != 0) {
+        Rectangle src{0, 0, (float)idle.width, (float)idle.height};
+        DrawTexturePro(idle, src, dest, origin, e.getTilt(), tint);
+      } else {
+        // Sin sprites: cuadrado rojo (naranja el shooter)
+        Color c = (e.getType() == Enemy::Shooter) ? ORANGE : RED;
+        DrawRectangle(e.getX() * tileSize, e.getY() * tileSize, tileSize,
+                      tileSize, c);
+      }
+    }
+
+    // Flash blanco
+    if (i < enemyFlashUntil.size() && enemyFlashUntil[i] > simTime) {
+      // Dibujamos el cuadrado simple encima porque rotar un rectángulo sin
+      // textura es complejo en Raylib simple Pero como es un flash rápido, no
+      // se nota la discrepancia
+      batch.rect(xpx, ypx, (float)tileSize, (float)tileSize,
+                 PrimitiveBatch::pack(255, 255, 255, 178));
+    }
+
+    // Barra de vida (al lote: se envía junta tras el último enemigo)
+    if (i < enemyHP.size()) {
+      const int w = tileSize, h = 4;
+      const int x = static_cast<int>(xpx);
+      const int y = static_cast<int>(ypx) - (h + 2);
+
+      // Calculamos la fracción de vida usando maxHP como denominador
+      int hpw = static_cast<int>(std::lround(w * (enemyHP[i] / maxHP)));
+      hpw = std::clamp(hpw, 0, w);
+
+      batch.rect((float)x, (float)y, (float)w, (float)h, barBack);
+      batch.rect((float)x, (float)y, (float)hpw, (float)h, barFill);
+      batch.rectLines((float)x, (float)y, (float)w, (float)h, 1.0f, barEdge);
+    }
+  }
+}
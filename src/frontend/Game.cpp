@@ -18,10 +18,6 @@
     #include <emscripten/emscripten.h>
 #endif
 
-static inline unsigned now_seed() {
-  return static_cast<unsigned>(time(nullptr));
-}
-
 bool gQuitRequested = false;
 
 static Texture2D loadTex(const char *path) {
@@ -188,7 +184,7 @@ void ItemSprites::unload() {
   loaded = false;
 }
 
-Game::Game(unsigned seed) : fixedSeed(seed) {
+Game::Game(unsigned seed) : GameSim(seed) {
   #if defined(__EMSCRIPTEN__)
     // En web: Resolución fija segura (el CSS se encarga de estirarlo)
     // Quitamos FLAG_FULLSCREEN_MODE para evitar conflictos con el navegador
@@ -221,8 +217,11 @@ Game::Game(unsigned seed) : fixedSeed(seed) {
   player.load("assets/sprites/player");
   itemSprites.load();
 
-  screenW = GetScreenWidth();
-  screenH = GetScreenHeight();
+  // La simulación dimensiona arena y visión según la ventana real
+  setViewport(GetScreenWidth(), GetScreenHeight());
+
+  // Con ventana, el boss piensa en otro hilo entre sus turnos
+  bossPlanner.setThreaded(true);
 
   camera.target = {0.0f, 0.0f};
   camera.offset = {(float)screenW / 2, (float)screenH / 2};
@@ -233,15 +232,14 @@ Game::Game(unsigned seed) : fixedSeed(seed) {
 
   state = GameState::MainMenu;
   mainMenuSelection = 0;
-}
-
-unsigned Game::nextRunSeed() const {
-  return fixedSeed > 0 ? fixedSeed : now_seed();
-}
 
-unsigned Game::seedForLevel(unsigned base, int level) const {
-  const unsigned MIX = 0x9E3779B9u;
-  return base ^ (MIX * static_cast<unsigned>(level));
+  // Partida a medias de otra sesión: el menú ofrece continuarla
+  hasSavedRun = savedRun.load(runSavePath());
+  if (hasSavedRun) {
+    mainMenuSelection = MENU_CONTINUE;
+    std::cout << _("[SAVE] Partida guardada: nivel ") << savedRun.level
+              << " (seed " << savedRun.seed << ")\n";
+  }
 }
 
 std::string Game::settingsPath() {
@@ -369,392 +367,28 @@ void Game::saveSettings() const {
   f << "volume=" << volPct << "\n";
 }
 
-void Game::newRun() {
-  runSeed = nextRunSeed();
-  std::cout << _("[Run] Seed base del run: ") << runSeed << "\n";
-
-  // Reiniciar estado básico
-  currentLevel = 1;
-  state = GameState::Playing;
-  moveCooldown = 0.0f;
-  hp = 10;
-  hpMax = 10;
-
-  // Reiniciar Inventario y Power-Ups
-  hasKey = false;
-
-  // Escudo
-  hasShield = false;
-  shieldTimer = 0.0f; // Resetear el tiempo
-
-  // Batería (Vida extra)
-  hasBattery = false;
-
-  // Gafas 3D (Visión)
-  glassesTimer = 0.0f; // Si no es 0, el juego cree que siguen activas
-  glassesFovMod = 0;   // Resetear el modificador de visión extra
-
-  // Armas
-  swordTier = 0;
-  plasmaTier = 0;
-
-  // Reiniciar modo Dios (Seguridad)
-  godMode = false;
-  showGodModeInput = false;
-  map.setRevealAll(false); // Apagar la luz del modo dios
-
-  // Reiniciar contexto de mejoras entre niveles
-  runCtx.espadaMejorasObtenidas = 0;
-  runCtx.plasmaMejorasObtenidas = 0;
-
-  // Reiniciar lógica de ataque
-  gAttack = AttackRuntime{};
-  gAttack.frontOnly = true;
-
-  // Limpiar proyectiles y entidades
-  projectiles.clear();
-  floatingTexts.clear(); // Limpiar números flotantes viejos
-  particles.clear();     // Limpiar explosiones viejas
-
-  // Reset boss
-  boss = Boss{};
-
-  newLevel(currentLevel);
-}
-
-void Game::newLevel(int level) {
-  // Lógica especial para Nivel 4 (Boss)
-
-  projectiles.clear(); // Limpiar balas
-  enemies.clear();     // Limpiar enemigos anteriores
-  items.clear();       // Limpiar items
-
-  levelSeed = seedForLevel(runSeed, level);
-  rng = std::mt19937(levelSeed);
-
-  if (level == maxLevels) { // Nivel Final
-    std::cout << _("[Level] FINAL BOSS LEVEL Initializing...\n");
-
-    // 1. Generar Arena a pantalla completa
-    // Calculamos cuántos tiles caben en la pantalla
-    int arenaW = screenW / tileSize;
-    int arenaH = screenH / tileSize;
-
-    // Generamos la arena con esas dimensiones
-    map.generateBossArena(arenaW, arenaH);
-
-    // 2. Configurar Visibilidad
-    map.setFogEnabled(false);
-
-    // 3. Posicionar Jugador (Abajo centro)
-    px = arenaW / 2;
-    py = arenaH - 4; // Un poco separado del borde
-    player.setGridPos(px, py);
-
-    // 4. Centrar cámara (Fija en el centro de la pantalla)
-    // Al ser tamaño exacto de pantalla, el centro es screenW/2, screenH/2
-    camera.target = {(float)screenW / 2.0f, (float)screenH / 2.0f};
-
-    fovTiles = 100;
-    map.computeVisibility(px, py, fovTiles);
-
-    hasKey = false;
-    spawnBoss();
-  } else {
-    // Niveles normales (1, 2, 3)
-    const float WORLD_SCALE = 1.2f;
-    int tilesX = (int)std::ceil((screenW / (float)tileSize) * WORLD_SCALE);
-    int tilesY = (int)std::ceil((screenH / (float)tileSize) * WORLD_SCALE);
-
-    std::cout << _("[Level] ") << level << "/" << maxLevels
-              << _(" (seed nivel: ") << levelSeed << ")\n";
-
-    map.generate(tilesX, tilesY, levelSeed);
-    map.setFogEnabled(true); // Asegurar niebla activada
-
-    fovTiles = defaultFovFromViewport();
-
-    auto r = map.firstRoom();
-    if (r.w > 0 && r.h > 0) {
-      px = r.x + r.w / 2;
-      py = r.y + r.h / 2;
-    } else {
-      px = tilesX / 2;
-      py = tilesY / 2;
-    }
-
-    player.setGridPos(px, py);
-    map.computeVisibility(px, py, getFovRadius());
-
-    Vector2 playerCenterPx = {px * (float)tileSize + tileSize / 2.0f,
-                              py * (float)tileSize + tileSize / 2.0f};
-    camera.target = playerCenterPx;
-    clampCameraToMap();
-
-    hasKey = false;
-    spawnEnemiesForLevel();
-
-    // Generar items
-    std::vector<IVec2> enemyTiles;
-    for (const auto &e : enemies)
-      enemyTiles.push_back({e.getX(), e.getY()});
-    auto isWalkable = [&](int x, int y) { return map.isWalkable(x, y); };
-    IVec2 spawnTile{px, py};
-    auto [exitX, exitY] = map.findExitTile();
-    IVec2 exitTile{exitX, exitY};
-
-    items =
-        ItemSpawner::generate(map.width(), map.height(), isWalkable, spawnTile,
-                              exitTile, enemyTiles, level, rng, runCtx);
-  }
-}
-
-// Spawn del Boss
-void Game::spawnBoss() {
-  boss.active = true;
-  boss.awakened = false; // Empieza dormido
-
-  // Posición del Boss: Centro arriba
-  boss.x = map.width() / 2;
-  boss.y = 4;
-
-  // Guardamos dónde está el jugador al entrar
-  boss.playerStartX = px;
-  boss.playerStartY = py;
-
-  // Configurar Vida según Dificultad
-  int baseHp = 800;
-  float diffMult = (difficulty == Difficulty::Easy)   ? 0.5f
-                   : (difficulty == Difficulty::Hard) ? 1.5f
-                                                      : 1.0f;
-
-  boss.maxHp = (int)(baseHp * diffMult);
-  boss.hp = boss.maxHp;
-
-  boss.phase = 1;
-  boss.actionCooldown = 2.0f;
-  boss.moveTimer = 1.0f;
-  boss.facing = Boss::DOWN;
-
-  std::cout << _("[BOSS] SPAWNED. Waiting for movement...\n");
+void Game::requestHorde(int count) {
+  // 0 o negativo = población por defecto
+  hordeCount = count > 0 ? std::min(count, HORDE_MAX_ENEMIES) : 0;
+  launchHordeOnStart = true;
 }
 
-void Game::updateBoss(float dt) {
-  // 0. Verificar muerte
-  if (boss.hp <= 0) {
-    boss.active = false;
-    spawnExplosion({(float)boss.x * tileSize, (float)boss.y * tileSize}, 200,
-                   GOLD);
-    state = GameState::Victory;
-    PlaySound(sfxWin);
-    return;
-  }
-
-  boss.animTime += dt * 3.0f;
-  boss.flashTimer = std::max(0.0f, boss.flashTimer - dt);
-
-  // 1. Mecánica de despertar
-  // Si tu posición (px, py) es distinta a la inicial.
-  if (!boss.awakened) {
-    if (px != boss.playerStartX || py != boss.playerStartY) {
-      boss.awakened = true;
-      PlaySound(sfxExplosion); // Rugido
-      spawnFloatingText(
-          {(float)boss.x * tileSize, (float)boss.y * tileSize - 20}, 0, RED);
-      std::cout << _("[BOSS] AWAKENED! TIEMBLA MORTAL!\n");
-    } else {
-      // Si el jugador dispara al boss dormido, lo despierta también
-      if (boss.hp < boss.maxHp)
-        boss.awakened = true;
-      else
-        return; // Sigue durmiendo
-    }
-  }
-
-  // 2. Configuración de fases
-  float hpPercent = (float)boss.hp / (float)boss.maxHp;
-
-  float phaseMoveDelay = 1.0f;
-  float phaseFireDelay = 2.0f;
-  int phaseDmg = 1;
-
-  // Fase 1 (100-75%)
-  if (hpPercent > 0.75f) {
-    boss.phase = 1;
-    phaseMoveDelay = 0.8f;
-    phaseFireDelay = 2.0f;
-    phaseDmg = 1;
-  }
-  // Fase 2 (75-50%)
-  else if (hpPercent > 0.50f) {
-    boss.phase = 2;
-    phaseMoveDelay = 0.6f;
-    phaseFireDelay = 1.5f;
-    phaseDmg = 2;
-  }
-  // Fase 3 (50-25%)
-  else if (hpPercent > 0.25f) {
-    boss.phase = 3;
-    phaseMoveDelay = 0.4f;
-    phaseFireDelay = 1.0f;
-    phaseDmg = 3;
-  }
-  // Fase 4 (<25%)
-  else {
-    boss.phase = 4;
-    phaseMoveDelay = 0.25f;
-    phaseFireDelay = 0.6f;
-    phaseDmg = 4;
-    if (GetRandomValue(0, 10) < 2)
-      spawnExplosion({(float)boss.x * tileSize, (float)boss.y * tileSize}, 1,
-                     RED);
-  }
-
-  // Ajustes por Dificultad
-  float diffSpeedMult = 1.0f, diffFireMult = 1.0f;
-  int diffDmgBonus = 0;
-  if (difficulty == Difficulty::Easy) {
-    diffSpeedMult = 1.3f;
-    diffFireMult = 1.5f;
-  }
-  if (difficulty == Difficulty::Hard) {
-    diffSpeedMult = 0.8f;
-    diffFireMult = 0.7f;
-    diffDmgBonus = 1;
-  }
-
-  float finalMoveDelay = phaseMoveDelay * diffSpeedMult;
-  float finalFireDelay = phaseFireDelay * diffFireMult;
-  int finalDmg = phaseDmg + diffDmgBonus;
-
-  // 3. Movimiento
-  boss.moveTimer -= dt;
-  if (boss.moveTimer <= 0.0f) {
-    boss.moveTimer = finalMoveDelay;
-    int dx = px - boss.x, dy = py - boss.y;
-
-    if (std::abs(dx) > 1 || std::abs(dy) > 1) {
-      int stepX = 0, stepY = 0;
-      if (std::abs(dx) >= std::abs(dy))
-        stepX = (dx > 0) ? 1 : -1;
-      else
-        stepY = (dy > 0) ? 1 : -1;
-
-      if (map.isWalkable(boss.x + stepX, boss.y + stepY)) {
-        boss.x += stepX;
-        boss.y += stepY;
-      } else {
-        if (stepX != 0)
-          stepY = (dy > 0) ? 1 : -1;
-        else
-          stepX = (dx > 0) ? 1 : -1;
-        if (map.isWalkable(boss.x + stepX, boss.y + stepY)) {
-          boss.x += stepX;
-          boss.y += stepY;
-        }
-      }
-    }
-    if (std::abs(dx) > std::abs(dy))
-      boss.facing = (dx > 0) ? Boss::RIGHT : Boss::LEFT;
-    else
-      boss.facing = (dy > 0) ? Boss::DOWN : Boss::UP;
-  }
-
-  // 4. Ataque (Disparo)
-  boss.actionCooldown -= dt;
-  if (boss.actionCooldown <= 0.0f) {
-    boss.actionCooldown = finalFireDelay;
-
-    auto shoot = [&](float vx, float vy) {
-      Projectile p;
-      p.isEnemy = true;
-      p.damage = finalDmg;
-      p.pos = {(float)boss.x * tileSize + tileSize / 2.0f,
-               (float)boss.y * tileSize + tileSize / 2.0f};
-      p.maxDistance = 1000.0f;
-      p.vel = {vx, vy};
-      projectiles.push_back(p);
-    };
-
-    float speed = 250.0f + (boss.phase * 50.0f);
-    float vx = 0, vy = 0;
-    switch (boss.facing) {
-    case Boss::UP:
-      vy = -speed;
-      break;
-    case Boss::DOWN:
-      vy = speed;
-      break;
-    case Boss::LEFT:
-      vx = -speed;
-      break;
-    case Boss::RIGHT:
-      vx = speed;
-      break;
+// Lógica de un frame extraída del bucle while
+void Game::loopStep() {
+    profiler.beginFrame();
+    {
+      FrameProfiler::Scope t(profiler, PerfInput);
+      processInput();
     }
-
-    shoot(vx, vy);
-    if (boss.phase >= 3)
-      shoot(-vx, -vy);
-    if (boss.phase == 4) {
-      shoot(vy, vx);
-      shoot(-vy, -vx);
-      PlaySound(sfxExplosion);
+    {
+      FrameProfiler::Scope t(profiler, PerfUpdate);
+      update();
     }
-  }
-
-  // 5. Colisión Melee
-  if (std::abs(px - boss.x) <= 1 && std::abs(py - boss.y) <= 1) {
-    if (damageCooldown <= 0.0f) {
-      takeDamage(finalDmg + 1);
-      damageCooldown = DAMAGE_COOLDOWN;
-      int pushX = (px > boss.x) ? 2 : (px < boss.x ? -2 : 0);
-      int pushY = (py > boss.y) ? 2 : (py < boss.y ? -2 : 0);
-      if (map.isWalkable(px + pushX, py + pushY)) {
-        px += pushX;
-        py += pushY;
-      } else if (map.isWalkable(px + pushX / 2, py + pushY / 2)) {
-        px += pushX / 2;
-        py += pushY / 2;
-      }
-      spawnFloatingText({(float)px * tileSize, (float)py * tileSize},
-                        finalDmg + 1, RED);
+    {
+      FrameProfiler::Scope t(profiler, PerfRender);
+      render();
     }
-  }
-}
-
-// Implementación del toggle
-void Game::toggleGodMode(bool enable) {
-  godMode = enable;
-
-  // Le decimos al mapa que lo revele todo (o vuelva a la normalidad)
-  map.setRevealAll(godMode);
-
-  if (godMode) {
-    std::cout << _("[GOD MODE] ACTIVADO - IDDQD\n");
-
-    PlaySound(sfxPowerUp);
-    // Mensaje visual (puedes usar tu sistema de texto flotante)
-    spawnFloatingText({(float)px * tileSize, (float)py * tileSize}, 9999,
-                      GOLD); // Truco visual
-
-    // Opcional: Curar al jugador
-    hp = hpMax;
-  } else {
-    std::cout << _("[GOD MODE] DESACTIVADO\n");
-    // Al desactivar, forzamos un recálculo de visión para que
-    // la niebla vuelva a aparecer correctamente alrededor del jugador.
-    // Sonido de error/apagado (ej. Hurt o Loose)
-    PlaySound(sfxLoose);
-    map.computeVisibility(px, py, getFovRadius());
-  }
-}
-
-// Lógica de un frame extraída del bucle while
-void Game::loopStep() {
-    processInput();
-    update();
-    render();
+    profiler.endFrame();
 
     // Gestión de música ambiente (Tu lógica original)
     if (state == GameState::Playing || state == GameState::Paused) {
@@ -779,6 +413,14 @@ void globalLoopWrapper(void* arg) {
 }
 
 void Game::run() {
+  if (launchReplayOnStart) {
+    launchReplayOnStart = false;
+    startReplay();
+  } else if (launchHordeOnStart) {
+    launchHordeOnStart = false;
+    newRun(true);
+  }
+
 #if defined(__EMSCRIPTEN__)
   // EN WEB: Le damos el control al navegador.
   // 0 fps = usar requestAnimationFrame (sincronizado con pantalla)
@@ -789,6 +431,9 @@ void Game::run() {
   while (!WindowShouldClose() && !gQuitRequested) {
     loopStep();
   }
+  saveRecording(); // Partida a medias: se guarda igualmente
+  if (runInProgress())
+    autosaveRun(); // El destructor de AutosaveWriter espera a que se escriba
   
   // Descargar sonidos
   UnloadSound(sfxHit);
@@ -809,130 +454,157 @@ void Game::run() {
 #endif
 }
 
-void Game::update() {
-  if (state != GameState::Playing)
-    return;
+bool Game::isSimulating() const {
   if (showGodModeInput)
-    return;
-
-  float dt = GetFrameTime();
-
-  // Dash
-  if (isDashing) {
-    dashTimer -= dt;
-
-    // Efectos visuales
-    if (GetRandomValue(0, 10) < 8) {
-      float t = 1.0f - (dashTimer / DASH_DURATION);
-      Vector2 lerpPos = {dashStartPos.x + (dashEndPos.x - dashStartPos.x) * t,
-                         dashStartPos.y + (dashEndPos.y - dashStartPos.y) * t};
-      // spawnExplosion(lerpPos, 1, SKYBLUE);
-    }
-
-    if (dashTimer <= 0.0f)
-      isDashing = false;
-
-    // Solo movemos la cámara si NO estamos en el nivel del boss.
-    // Si es el boss, la cámara se queda quieta.
-    if (currentLevel != maxLevels) {
-      Vector2 desired = {px * (float)tileSize + tileSize / 2.0f,
-                         py * (float)tileSize + tileSize / 2.0f};
-      camera.target.x = desired.x;
-      camera.target.y = desired.y;
-      clampCameraToMap();
-    }
+    return false;
+  return state == GameState::Playing ||
+         (state == GameState::Tutorial &&
+          tutorialStep != TutorialStep::FinishedMenu);
+}
 
+void Game::update() {
+  if (!isSimulating()) {
+    // Sin simulación (menús, pausa...): nada que interpolar, y lo pulsado
+    // mientras tanto no debe llegar al siguiente tick
+    renderAlpha = 1.0f;
+    pendingInput.clearEdges();
+    if (state == GameState::MainMenu)
+      stopReplay();
     return;
   }
 
-  dashCooldownTimer = std::max(0.0f, dashCooldownTimer - dt);
-  tryAutoPickup();
-
-  if (hasShield) {
-    shieldTimer -= dt;
-    if (shieldTimer <= 0.0f)
-      hasShield = false;
-  }
-  if (glassesTimer > 0.0f) {
-    glassesTimer -= dt;
-    if (glassesTimer <= 0.0f)
-      recomputeFovIfNeeded();
-  }
-  if (slashActive) {
-    slashTimer -= dt;
-    if (slashTimer <= 0.0f)
-      slashActive = false;
-  }
-
-  for (auto &t : enemyFlashTimer)
-    t = std::max(0.0f, t - dt);
-  for (auto &e : enemies)
-    e.updateAnimation(dt);
-
-  if (boss.active) {
-    updateBoss(dt);
-  } else {
-    updateShooters(dt);
-  }
-
-  updateProjectiles(dt);
-  updateFloatingTexts(dt);
-  updateParticles(dt);
-
-  if (currentLevel < maxLevels && map.at(px, py) == EXIT) {
-    if (hasKey)
-      onExitReached();
-  }
-
-  // Cámara Suave (Solo en niveles normales)
-  if (currentLevel != maxLevels) {
-    auto Lerp = [](float a, float b, float t) { return a + (b - a) * t; };
-    Vector2 desired = {px * (float)tileSize + tileSize / 2.0f,
-                       py * (float)tileSize + tileSize / 2.0f};
-    float smooth = 10.0f * dt;
-    camera.target.x = Lerp(camera.target.x, desired.x, smooth);
-    camera.target.y = Lerp(camera.target.y, desired.y, smooth);
-    clampCameraToMap();
-  }
-
-  if (shakeTimer > 0.0f) {
-    shakeTimer -= dt;
-    float intensity = 5.0f;
-    camera.target.x += (float)GetRandomValue(-100, 100) / 100.0f * intensity;
-    camera.target.y += (float)GetRandomValue(-100, 100) / 100.0f * intensity;
-  }
-
-  if (hp <= 0) {
-    if (hasBattery) {
-      hasBattery = false;
-      hp = hpMax / 2;
-      if (hp < 1)
-        hp = 1;
-      std::cout << _("[Bateria] Resucitado.\n");
-      damageCooldown = 2.0f;
-      shakeTimer = 0.5f;
-      PlaySound(sfxPowerUp);
+  // Paso fijo: el tiempo del frame solo llena el acumulador. Cada tick
+  // consume la entrada pendiente y avanza la partida TICK segundos.
+  // En la repetición, x4 o x16 son más ticks por frame (sin tope)
+  const int ticks = stepper.advance(GetFrameTime()) * (replaying ? replaySpeed : 1);
+  for (int t = 0; t < ticks && isSimulating(); ++t) {
+    cameraPrev = camera.target;
+    steppedThisTick = false;
+    if (godTogglePending) {
+      pendingInput.toggleGod = true;
+      godTogglePending = false;
+    }
+    if (replaying) {
+      if (replayCursor.done())
+        break; // Grabación de una partida a medias: se queda en el final
+      cameraZoom = unpackZoom(replayCursor.zoom());
+      camera.zoom = cameraZoom;
+      const ReplayStats st = replayRecording(*this, replayCursor, recording,
+                                             replayCursor.tick() + 1);
+      if (st.desyncs > 0 && replayCheck.desyncs == 0)
+        std::cerr << _("[REPLAY] Desincronizada en el tick ") << st.firstDesync
+                  << "\n";
+      replayCheck.add(st);
+      followCamera(FixedTimestep::TICK);
+    } else if (state == GameState::Tutorial) {
+      // El tutorial guioniza su propio mundo: no es una partida de GameSim
+      applyTickInput(pendingInput, FixedTimestep::TICK);
+      if (isSimulating())
+        updateTutorial(FixedTimestep::TICK);
     } else {
-      state = GameState::GameOver;
-      gAttack.swinging = false;
-      gAttack.lastTiles.clear();
-      PlaySound(sfxLoose);
+      if (levelStartPending) {
+        // Nivel recién empezado: foto para reintentarlo tal cual
+        saveSnapshot(levelStart);
+        levelStartPending = false;
+        if (autosaveActive)
+          autosaveRun();
+      }
+      recordTick(pendingInput);
+      step(pendingInput);
+      recordKeyframe();
+      autosaveAfterTick();
+      followCamera(FixedTimestep::TICK);
     }
-    return;
+    pendingInput.clearEdges();
+    player.update(FixedTimestep::TICK, steppedThisTick);
   }
-
-  damageCooldown = std::max(0.0f, damageCooldown - GetFrameTime());
-  for (auto &cd : enemyAtkCD)
-    cd = std::max(0.0f, cd - dt);
-  for (auto &cd : enemyShootCD)
-    cd = std::max(0.0f, cd - dt);
+  renderAlpha = isSimulating() ? stepper.alpha() : 1.0f;
 }
 
-void Game::onExitReached() {
-  // Si completamos nivel 3, vamos al 4 (Boss)
-  if (currentLevel < maxLevels) {
-    currentLevel++;
-    newLevel(currentLevel);
+void Game::onSimEvent(SimEvent e) {
+  switch (e) {
+  case SimEvent::RunStarted:
+    showPerfOverlay = hordeMode; // En la horda el overlay es parte de la prueba
+    stepper.reset();
+    pendingInput = TickInput{};
+    showGodModeInput = false;
+    godTogglePending = false;
+    if (replaying) {
+      const RunSetup a = getRunSetup(), b = recording.setup();
+      if (a.seed == b.seed && a.difficulty == b.difficulty &&
+          a.horde == b.horde) {
+        // Reinicio dentro de la repetición: vuelve a empezar la grabación
+        replayCursor.seek(0);
+        replayCheck = ReplayStats{};
+        break;
+      }
+      stopReplay(); // Otra partida (p. ej. cambió la dificultad): se juega
+    }
+    saveRecording(); // La anterior, si quedó a medias
+    recording.begin(getRunSetup());
+    recordingActive = true;
+    quickSave.clear(); // Las fotos eran de la partida anterior
+    levelStart.clear();
+    autosaveActive = !replaying && !hordeMode; // La horda es una prueba
+    lastAutosaveTick = 0;
+    break;
+  case SimEvent::LevelStarted:
+    placeCameraForLevel();
+    levelStartPending = !replaying;
+    break;
+  case SimEvent::StateRestored:
+    // Vuelta a una foto: lo grabado después ya no pasó
+    placeCameraForLevel();
+    stepper.reset();
+    pendingInput = TickInput{};
+    godTogglePending = false;
+    if (!replaying) {
+      recording.truncate(getTick());
+      recordingActive = true;
+    }
+    autosaveActive = !replaying && !hordeMode;
+    lastAutosaveTick = getTick();
+    break;
+  case SimEvent::PlayerMoved:
+    player.setGridPos(px, py);
+    centerCameraOnPlayer();
+    steppedThisTick = true;
+    break;
+  case SimEvent::PlayerTurned:
+    player.setDirectionFromDelta(attack.lastDir.x, attack.lastDir.y);
+    break;
+
+  // Sonidos
+  case SimEvent::PlayerDashed:
+  case SimEvent::EnemyFired: // Reusamos el sonido de aire/silenciador
+    PlaySound(sfxDash);
+    break;
+  case SimEvent::PlayerHurt:
+    PlaySound(sfxHurt);
+    break;
+  case SimEvent::PlayerRevived:
+  case SimEvent::PowerUpPicked:
+  case SimEvent::GodModeOn:
+    PlaySound(sfxPowerUp);
+    break;
+  case SimEvent::EnemyHit:
+    PlaySound(sfxHit);
+    break;
+  case SimEvent::EnemyKilled:
+  case SimEvent::BossAwakened: // Rugido
+  case SimEvent::BossBlast:
+    PlaySound(sfxExplosion);
+    break;
+  case SimEvent::ItemPicked:
+    PlaySound(sfxPickup);
+    break;
+  case SimEvent::GodModeOff:
+  case SimEvent::Defeat:
+    PlaySound(sfxLoose);
+    break;
+  case SimEvent::Victory:
+    PlaySound(sfxWin);
+    break;
   }
 }
 
@@ -1055,7 +727,7 @@ void Game::drawBoss() const {
 
   // Dibujado
   Color tint = WHITE;
-  if (boss.flashTimer > 0.0f)
+  if (boss.flashUntil > simTime)
     tint = RED;
   else if (boss.phase == 2)
     tint = {255, 200, 200, 255};
@@ -1078,6 +750,13 @@ void Game::drawBoss() const {
   float fill = ((float)boss.hp / (float)boss.maxHp) * barW;
   DrawRectangle(barX, barY, fill, barH, PURPLE);
   DrawRectangleLines(barX, barY, barW, barH, WHITE);
+
+  // Aviso de las explosiones retardadas: el círculo se cierra hasta estallar
+  bossBullets.forEachPendingBurst(simTime, [&](float x, float y, float left) {
+    const float r = tileSize * (0.5f + 2.0f * std::max(0.0f, left));
+    DrawCircleLines((int)x, (int)y, r, Fade(RED, 0.8f));
+    DrawCircleV({x, y}, 4.0f, Fade(ORANGE, 0.6f));
+  });
 }
 
 const char *Game::getInputText(const char *kb, const char *gp) const {
@@ -1094,27 +773,25 @@ void Game::startTutorial() {
 
   hpMax = 8;
   hp = 4;
+  resetSimClock();
   hasKey = false;
   hasShield = false;
   hasBattery = false;
   swordTier = 0;
   plasmaTier = 0;
 
-  enemies.clear();
+  clearEnemies();
+  resetTurns(true);
+  enemyVision.reset();
   items.clear();
   projectiles.clear();
+  clearBossCombat();
   floatingTexts.clear();
   particles.clear();
 
-  enemyHP.clear();
-  enemyMaxHP.clear();
-  enemyAtkCD.clear();
-  enemyShootCD.clear();
-  enemyFlashTimer.clear();
-  enemyFacing.clear();
-
   // Generar mapa
   map.generateTutorialMap(50, 25);
+  influence.reset(map);
   map.setFogEnabled(false);
 
   // Posición Jugador (Centro del Lobby)
@@ -1126,11 +803,11 @@ void Game::startTutorial() {
 }
 
 void Game::updateTutorial(float dt) {
-  // 1. Lógica core
-  player.update(dt, false);
+  // 1. Lógica core (el jugador se anima al final de cada tick)
   updateFloatingTexts(dt);
   updateParticles(dt);
   updateProjectiles(dt);
+  resolveDamage();
   tryAutoPickup();
 
   // 2. Físicas
@@ -1144,17 +821,12 @@ void Game::updateTutorial(float dt) {
     if (dashTimer <= 0.0f)
       isDashing = false;
     if ((int)(dashTimer * 20) % 2 == 0) {
-      Vector2 centerPos = {(float)px * tileSize + tileSize / 2.0f,
-                           (float)py * tileSize + tileSize / 2.0f};
-      spawnExplosion(centerPos, 1, SKYBLUE);
+      FVec2 centerPos = {(float)px * tileSize + tileSize / 2.0f,
+                         (float)py * tileSize + tileSize / 2.0f};
+      spawnExplosion(centerPos, 1, Palette::SkyBlue);
     }
   }
-  dashCooldownTimer = std::max(0.0f, dashCooldownTimer - dt);
-  damageCooldown = std::max(0.0f, damageCooldown - dt);
-  if (hasShield)
-    shieldTimer -= dt;
-  if (glassesTimer > 0.0f)
-    glassesTimer -= dt;
+  advanceSimClock(dt);
 
   // Centro vertical del mapa
   int cy = map.height() / 2;
@@ -1243,8 +915,7 @@ void Game::updateTutorial(float dt) {
   case TutorialStep::ItemEscudo:
     if (items.empty()) {
       PlaySound(sfxPowerUp);
-      hasShield = true;
-      shieldTimer = 3.0f;
+      activateShield(3.0f);
       tutorialStep = TutorialStep::PreGafas;
       tutorialTimer = 3.0f;
       map.setFogEnabled(true);
@@ -1386,16 +1057,8 @@ void Game::updateTutorial(float dt) {
       tutorialStep = TutorialStep::Combat;
 
       // Enemigo en el centro de la Arena (x=42)
-      Enemy dummy;
-      dummy.setPos(42, cy);
-      enemies.push_back(dummy);
-
-      enemyHP.push_back(60);
-      enemyMaxHP.push_back(60);
-      enemyAtkCD.push_back(0);
-      enemyShootCD.push_back(0);
-      enemyFlashTimer.push_back(0);
-      enemyFacing.push_back(EnemyFacing::Down);
+      spawnEnemyAt(42, cy, Enemy::Melee, 60, 60, EnemyFacing::Down);
+      refreshEnemyActivity();
     }
     break;
 
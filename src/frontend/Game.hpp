@@ -0,0 +1,394 @@
+#ifndef GAME_HPP
+#define GAME_HPP
+
+#include "FixedTimestep.hpp"
+#include "GameSim.hpp"
+#include "HUD.hpp"
+#include "InputRecording.hpp"
+#include "PrimitiveBatch.hpp"
+#include "Player.hpp"
+#include "RunSave.hpp"
+#include "TickInput.hpp"
+#include "raylib.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Color de raylib a partir del RGBA empaquetado de la simulación (Palette)
+inline Color unpackColor(std::uint32_t rgba) {
+  return {(unsigned char)(rgba & 0xFF), (unsigned char)((rgba >> 8) & 0xFF),
+          (unsigned char)((rgba >> 16) & 0xFF), (unsigned char)(rgba >> 24)};
+}
+
+enum class TutorialStep {
+  Intro,
+  Movement,
+  Dash,
+  MoveMode,
+  CameraZoom,
+  CameraReset,
+
+  // Secuencia de Objetos (Vida)
+  ItemPilaBuena, // Cura
+  ItemPilaMala,  // Daña
+
+  ItemEscudo, // Protege
+
+  // Secuencia de Visión
+  PreGafas, // Activar niebla
+  ItemGafasBuenas,
+  ItemGafasMalas,
+  BadGlassesEffect,
+  PostGafas, // Quitar niebla
+
+  // Items Especiales
+  ItemVidaExtra, // Batería extra
+
+  // Secuencia de Armas (Progresión)
+  SwordT1,
+  SwordT2,
+  SwordT3,
+  PlasmaT1,
+  PlasmaT2,
+
+  // Combate Final
+  Combat,
+  Exit,
+  FinishedMenu
+};
+
+// Para mostrar prompts correctos ("Presiona E" vs "Presiona A")
+enum class InputDevice { Keyboard, Gamepad };
+
+enum class Language { ES, EN };
+
+// Contenedor de todas las texturas del juego para carga centralizada
+struct ItemSprites {
+  // Texturas mapa
+  Texture2D wall{};
+  Texture2D floor{};
+
+  // Items
+  Texture2D keycard{};
+  Texture2D shield{};
+  Texture2D pila{};
+  Texture2D glasses{};
+  Texture2D battery{};
+
+  // Armas
+  Texture2D swordBlue{};
+  Texture2D swordGreen{};
+  Texture2D swordRed{};
+  Texture2D plasma1{};
+  Texture2D plasma2{};
+
+  // Enemigos (2 tipos, 2 frames por dirección + idle)
+  Texture2D enemy1Idle{};
+  Texture2D enemy1Up1{}, enemy1Up2{};
+  Texture2D enemy1Down1{}, enemy1Down2{};
+  Texture2D enemy1Left1{}, enemy1Left2{};
+  Texture2D enemy1Right1{}, enemy1Right2{};
+
+  Texture2D enemy2Idle{};
+  Texture2D enemy2Up1{}, enemy2Up2{};
+  Texture2D enemy2Down1{}, enemy2Down2{};
+  Texture2D enemy2Left1{}, enemy2Left2{};
+  Texture2D enemy2Right1{}, enemy2Right2{};
+
+  // Texturas del Boss
+  Texture2D bossUpIdle{};
+  Texture2D bossDownIdle{};
+  Texture2D bossLeftIdle{};
+  Texture2D bossRightIdle{};
+  Texture2D bossUpWalk1{};
+  Texture2D bossUpWalk2{};
+  Texture2D bossDownWalk1{};
+  Texture2D bossDownWalk2{};
+  Texture2D bossLeftWalk1{};
+  Texture2D bossLeftWalk2{};
+  Texture2D bossRightWalk1{};
+  Texture2D bossRightWalk2{};
+
+  bool loaded = false;
+  void load();   // Carga todo
+  void unload(); // Libera todo
+};
+
+// Frontend del juego (ventana, entrada, render, audio y menús)
+// La partida en sí es GameSim; Game la envuelve con raylib: lee la entrada,
+// la pasa a step() a paso fijo, dibuja el estado y reacciona a los avisos
+// de la simulación (onSimEvent) con sonido, cámara y sprite del jugador.
+class Game : public GameSim {
+public:
+  // Constructor explícito para evitar conversiones implícitas accidentales de
+  // int a Game
+  explicit Game(unsigned seed = 0);
+
+  // Bucle principal: Init -> Update -> Render -> Cleanup
+  void run();
+
+  // Función para ejecutar un solo frame (necesario para Web)
+  void loopStep();
+
+  // Modo horda (prueba de estrés): arranca directamente una partida con
+  // 'count' enemigos (se recorta a HORDE_MAX_ENEMIES). Lo usa --horde.
+  void requestHorde(int count);
+
+  // Repetición (--replay=archivo): carga una grabación y run() la reproduce
+  // en la ventana en lugar de abrir el menú. false si no se pudo leer.
+  bool requestReplay(const std::string &path);
+
+  // Modo Dios (cuadro de contraseña)
+  bool isInputtingGodPassword() const { return showGodModeInput; }
+  const std::string &getGodPasswordInput() const { return godModeInput; }
+
+  // Hay foto del principio del nivel (la pantalla de derrota ofrece L)
+  bool canRetryLevel() const { return !levelStart.empty(); }
+
+protected:
+  // Sonidos, cámara y sprite del jugador según lo que pasa en la simulación
+  void onSimEvent(SimEvent e) override;
+
+private:
+  // Sistemas del frontend
+  Player player;
+  HUD hud;
+
+  // Paso fijo: update() ejecuta ticks de FixedTimestep::TICK con la entrada
+  // acumulada; el render interpola entre el tick anterior y el actual.
+  FixedTimestep stepper;
+  TickInput pendingInput;  // Lectura de teclado/mando aún sin consumir
+  Vector2 cameraPrev{};    // camera.target al empezar el último tick
+  float renderAlpha = 1.0f; // Fracción del siguiente tick (interpolación)
+  bool steppedThisTick = false; // El jugador cambió de casilla en el tick
+  bool isSimulating() const; // Jugando o en la parte jugable del tutorial
+
+  // Grabación de la partida (ver InputRecording)
+  // Cada tick jugado apunta su TickInput y el zoom; al terminar la partida
+  // (o al empezar otra, o al salir) se guarda en replayDir().
+  InputRecording recording;
+  bool recordingActive = false;
+  bool godTogglePending = false; // Modo dios pedido: entra en el siguiente tick
+  void recordTick(const TickInput &in);
+  void recordKeyframe();
+  void saveRecording();
+  static std::string replayDir();
+  static std::uint8_t packZoom(float zoom);
+  static float unpackZoom(std::uint8_t z);
+
+  // Repetición en la ventana: F cambia la velocidad (x1, x4, x16),
+  // izquierda/derecha salta 10 s y RePág/AvPág va de keyframe en keyframe.
+  // Saltar atrás vuelve a empezar la partida y la adelanta sin ventana.
+  bool replaying = false;
+  bool launchReplayOnStart = false;
+  unsigned seedBeforeReplay = 0; // fixedSeed a devolver al terminar
+  int replaySpeed = 1;
+  InputRecording::Cursor replayCursor{recording};
+  ReplayStats replayCheck; // Keyframes comprobados y desincronizaciones
+  void startReplay();
+  void stopReplay(); // Vuelta al menú: lo siguiente ya es una partida normal
+  void seekReplay(std::uint64_t tick);
+  void handleReplayInput();
+  void drawReplayOverlay() const;
+
+  // Fotos del estado (ver SimSnapshot): F5 guarda rápido, F9 vuelve a la
+  // última y L, en la pantalla de derrota, reintenta el nivel sin volver a
+  // generarlo. Empezar otra partida las descarta; cargar una recorta la
+  // grabación a su tick para que la repetición siga valiendo.
+  SimSnapshot quickSave;
+  SimSnapshot levelStart;
+  bool levelStartPending = false; // Nivel nuevo: se fotografía antes del tick
+  const char *snapshotNotice = nullptr; // Aviso breve en pantalla
+  double snapshotNoticeUntil = 0.0;
+  void quickSaveState();
+  bool restoreState(const SimSnapshot &snap, const char *notice);
+  void drawSnapshotNotice() const;
+
+  // Partida guardada (ver RunSave): se carga al arrancar y el menú ofrece
+  // CONTINUAR. Se autoguarda al empezar cada nivel, cada AUTOSAVE_TICKS y al
+  // salir a mitad de partida; al ganar o perder se borra. La escritura la
+  // hace el hilo de AutosaveWriter: aquí solo se toma la foto.
+  static constexpr std::uint64_t AUTOSAVE_TICKS = 30 * FixedTimestep::TICK_HZ;
+  AutosaveWriter autosave{runSavePath()};
+  RunSave savedRun;          // Lo último guardado (lo que cargaría CONTINUAR)
+  bool hasSavedRun = false;
+  bool autosaveActive = false; // Partida normal en curso (ni horda ni repetición)
+  std::uint64_t lastAutosaveTick = 0;
+  void autosaveRun();
+  void autosaveAfterTick(); // Periódico; al terminar la partida, borra
+  void continueRun();
+  bool runInProgress() const; // Jugando, o en pausa/ajustes desde la partida
+  static std::string runSavePath();
+
+  ItemSprites itemSprites;
+
+  // Variables del tutorial
+  TutorialStep tutorialStep = TutorialStep::Intro;
+  float tutorialTimer = 0.0f;
+  bool tutorialFlag = false;
+  int tutorialMenuSelection = 0;
+
+  // Función auxiliar para texto dinámico (Teclado vs Mando)
+  // Devuelve el texto 'kb' si usa teclado, o 'gp' si usa gamepad
+  const char *getInputText(const char *kb, const char *gp) const;
+
+  void startTutorial();
+  void updateTutorial(float dt);
+  void renderTutorialUI();
+
+  // Variables de Cheat Mode (Mando)
+  // Secuencia: Arriba, Arriba, Abajo, Abajo, Izq, Der, Izq, Der, B, A
+  const std::vector<int> konamiCode = {
+      GAMEPAD_BUTTON_LEFT_FACE_UP,     GAMEPAD_BUTTON_LEFT_FACE_UP,
+      GAMEPAD_BUTTON_LEFT_FACE_DOWN,   GAMEPAD_BUTTON_LEFT_FACE_DOWN,
+      GAMEPAD_BUTTON_LEFT_FACE_LEFT,   GAMEPAD_BUTTON_LEFT_FACE_RIGHT,
+      GAMEPAD_BUTTON_LEFT_FACE_LEFT,   GAMEPAD_BUTTON_LEFT_FACE_RIGHT,
+      GAMEPAD_BUTTON_RIGHT_FACE_RIGHT, GAMEPAD_BUTTON_RIGHT_FACE_DOWN};
+
+  // Índice actual de la secuencia (cuántos has acertado seguidos)
+  size_t cheatCodeIndex = 0;
+
+  void drawEnemies() const;
+
+  // Gestión de input
+  InputDevice lastInput = InputDevice::Keyboard;
+
+  bool launchHordeOnStart = false; // Pedido por línea de comandos
+
+  // Overlay de rendimiento (F3; siempre visible en modo horda)
+  bool showPerfOverlay = false;
+  void drawPerfOverlay() const;
+
+  // Bucle principal desglosado
+  void processInput();
+  void update();
+  void render();
+
+  // UI Screens
+  void renderMainMenu();
+  static constexpr int MAIN_MENU_ITEMS = 6; // Jugar, tutorial, horda, salir, ajustes, continuar
+  static constexpr int MENU_CONTINUE = 5;   // Encima de JUGAR; solo con partida guardada
+  Rectangle mainMenuButtonRect(int index) const;
+  void stepMainMenu(int dir); // Selección anterior (-1) o siguiente (+1)
+  void renderHelpOverlay();
+  void renderOptionsMenu();
+  void handleOptionsInput();
+
+  Rectangle uiCenterRect(float w, float h) const;
+
+  // CÁMARA
+  Camera2D camera{};
+  float cameraZoom = 1.0f;
+
+  void clampCameraToMap(); // Evita ver el vacío negro fuera del mapa
+  void centerCameraOnPlayer();
+  void placeCameraForLevel(); // Al empezar nivel o cargar una foto
+  void followCamera(float dt); // Seguimiento suave y temblor, una vez por tick
+  RngStream shakeRng{0, RngStream::Fx}; // Temblor: no toca la simulación
+
+  void drawMap() const;
+  void drawBoss() const;
+  void drawItems() const;
+  void drawItemSprite(const ItemSpawn &it) const;
+
+  // UI Menu
+  bool showHelp = false;
+  int helpScroll = 0;
+  std::string helpText;
+  int mainMenuSelection = 0;
+  int pauseSelection = 0;
+  GameState previousState = GameState::MainMenu;
+  GameState pauseOrigin = GameState::Playing;
+
+  void handleMenuInput();
+  void handlePlayingInput(float dt);
+  void renderPauseMenu();
+  void handlePauseInput();
+
+  void drawSlash() const; // Función para dibujarlo
+  void drawProjectiles() const;
+  void drawFloatingTexts() const;
+  void drawParticles() const;
+
+  // Glifos de los números de daño ('0'-'9' y '-', lo único que escribe
+  // FloatingTextPool::formatInt), sacados una vez del atlas de la fuente por
+  // defecto. Cada texto se dibuja copiando sus quads, sin que raylib vuelva
+  // a maquetar la cadena en cada frame.
+  struct DigitGlyph {
+    float u0 = 0, v0 = 0, u1 = 0, v1 = 0; // Recorte en el atlas
+    float dx = 0, dy = 0, w = 0, h = 0;   // Quad a tamaño base
+    float advance = 0;
+  };
+  static constexpr int DIGIT_GLYPHS = 11; // 0-9 y el signo
+  mutable std::array<DigitGlyph, DIGIT_GLYPHS> digitGlyphs{};
+  mutable unsigned int digitAtlas = 0; // Textura del atlas (0: sin cachear)
+  mutable float digitBaseSize = 10.0f;
+  void cacheDigitGlyphs() const;
+
+  // Lote de primitivas (balas, partículas, barras de vida). Los draw* const
+  // apuntan aquí y flushBatch() lo envía a rlgl de golpe.
+  mutable PrimitiveBatch batch;
+  void flushBatch() const;
+
+  // ---------------------------------------------------------------------
+  // Ajustes del menú principal y dificultad
+  // ---------------------------------------------------------------------
+  // Si es true, se muestra el panel de ajustes en el menú principal
+  bool showSettingsMenu = false;
+  bool showDifficultyWarning = false;
+  Difficulty pendingDifficulty = Difficulty::Medium;
+
+  // Cambia la dificultad de forma cíclica (Easy → Medium → Hard → Easy)
+  void cycleDifficulty();
+  // Devuelve un texto descriptivo de la dificultad actual para la UI
+  const char *getDifficultyLabel(Difficulty d) const;
+
+  Language language = Language::ES;
+  Language pendingLanguage = language;
+
+  void cycleLanguage();
+  std::string getLanguageLabel() const;
+
+  // Variables del Modo Dios
+  bool showGodModeInput = false; // ¿Mostrando el cuadro de contraseña?
+  std::string godModeInput = ""; // Texto que el usuario está escribiendo
+
+  // Sistema de audio (Procedural)
+  // Generamos sonidos con código si no hay archivos .wav
+
+  float audioVolume = 0.2f;
+  std::string getVolumeLabel() const;
+
+  void loadSettings();
+  void saveSettings() const;
+  void applyCurrentLanguage();
+  static std::string settingsPath();
+
+  // Tipos de sonido para el generador
+  enum SoundType {
+    SND_HIT,
+    SND_EXPLOSION,
+    SND_PICKUP,
+    SND_POWERUP,
+    SND_HURT,
+    SND_WIN,
+    SND_LOOSE,
+    SND_AMBIENT,
+    SND_DASH
+  };
+
+  Sound generateSound(int type);
+
+  Sound sfxHit{};
+  Sound sfxExplosion{};
+  Sound sfxPickup{};
+  Sound sfxPowerUp{};
+  Sound sfxHurt{};
+  Sound sfxWin{};
+  Sound sfxLoose{};
+  Sound sfxDash{};
+  Sound sfxAmbient{};
+};
+
+#endif
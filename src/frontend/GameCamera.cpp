@@ -0,0 +1,64 @@
+#include "Game.hpp"
+#include <algorithm>
+#include <cmath>
+
+void Game::clampCameraToMap() {
+    const float worldW = map.width() * (float)tileSize;
+    const float worldH = map.height() * (float)tileSize;
+    const float viewW = screenW / camera.zoom;
+    const float viewH = screenH / camera.zoom;
+    const float halfW = viewW * 0.5f;
+    const float halfH = viewH * 0.5f;
+
+    if (worldW <= viewW) camera.target.x = worldW * 0.5f;
+    else camera.target.x = std::clamp(camera.target.x, halfW, worldW - halfW);
+
+    if (worldH <= viewH) camera.target.y = worldH * 0.5f;
+    else camera.target.y = std::clamp(camera.target.y, halfH, worldH - halfH);
+}
+
+void Game::centerCameraOnPlayer() {
+    camera.target = { px * (float)tileSize + tileSize / 2.0f,
+                      py * (float)tileSize + tileSize / 2.0f };
+    clampCameraToMap();
+    cameraPrev = camera.target; // Salto: nada que interpolar
+}
+
+void Game::placeCameraForLevel() {
+    player.setGridPos(px, py);
+    if (currentLevel == maxLevels) {
+        // Arena del boss: tamaño exacto de pantalla, cámara fija en el centro
+        camera.target = {(float)screenW / 2.0f, (float)screenH / 2.0f};
+        cameraPrev = camera.target;
+    } else {
+        centerCameraOnPlayer();
+    }
+}
+
+
+// Cámara de la partida, una vez por tick (la simulación ya avanzó)
+void Game::followCamera(float dt) {
+    // Nivel del boss: la cámara se queda quieta en el centro de la arena
+    if (currentLevel != maxLevels) {
+        const Vector2 desired = { px * (float)tileSize + tileSize / 2.0f,
+                                  py * (float)tileSize + tileSize / 2.0f };
+        if (isDashing) {
+            // Durante el dash la cámara va pegada al jugador
+            camera.target = desired;
+        } else {
+            // Cámara Suave (Solo en niveles normales)
+            auto Lerp = [](float a, float b, float t) { return a + (b - a) * t; };
+            const float smooth = 10.0f * dt;
+            camera.target.x = Lerp(camera.target.x, desired.x, smooth);
+            camera.target.y = Lerp(camera.target.y, desired.y, smooth);
+        }
+        clampCameraToMap();
+    }
+
+    // Temblor mientras la simulación lo tenga pendiente
+    if (shakeTimer > 0.0f && !isDashing) {
+        const float intensity = 5.0f;
+        camera.target.x += (float)shakeRng.range(-100, 100) / 100.0f * intensity;
+        camera.target.y += (float)shakeRng.range(-100, 100) / 100.0f * intensity;
+    }
+}
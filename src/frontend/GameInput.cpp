@@ -174,7 +174,7 @@ void Game::processInput() {
 
         if (cheatCodeIndex >= konamiCode.size()) {
           std::cout << "[CHEAT] GOD MODE ACTIVADO!\n";
-          toggleGodMode(!godMode);
+          godTogglePending = true; // Lo aplica el siguiente tick (y se graba)
           cheatCodeIndex = 0;
           PlaySound(sfxPowerUp);
         }
@@ -189,6 +189,10 @@ void Game::processInput() {
     }
   }
 
+  // Overlay de rendimiento (tiempos por sistema)
+  if (IsKeyPressed(KEY_F3))
+    showPerfOverlay = !showPerfOverlay;
+
   // --------------------------------------------------------
   // 1. Detección de activación (F12) - Modo Dios
   // --------------------------------------------------------
@@ -212,7 +216,7 @@ void Game::processInput() {
 
     if (IsKeyPressed(KEY_ENTER)) {
       if (godModeInput == "IDDQD")
-        toggleGodMode(!godMode);
+        godTogglePending = true;
       showGodModeInput = false;
       godModeInput.clear();
     }
@@ -222,6 +226,27 @@ void Game::processInput() {
     return;
   }
 
+  // --------------------------------------------------------
+  // Fotos del estado: F5 guarda, F9 vuelve a lo guardado y L, tras
+  // perder, reintenta el nivel (no en la repetición: la manda la grabación)
+  // --------------------------------------------------------
+  if (!replaying) {
+    if (IsKeyPressed(KEY_F5) && state == GameState::Playing) {
+      quickSaveState();
+      return;
+    }
+    if (IsKeyPressed(KEY_F9) && !quickSave.empty() &&
+        (state == GameState::Playing || state == GameState::GameOver)) {
+      restoreState(quickSave, _("Carga rápida"));
+      return;
+    }
+    if (IsKeyPressed(KEY_L) && state == GameState::GameOver &&
+        canRetryLevel()) {
+      restoreState(levelStart, _("Nivel reiniciado"));
+      return;
+    }
+  }
+
   // --------------------------------------------------------
   // Sistema de pausa (Toggle)
   // --------------------------------------------------------
@@ -271,8 +296,8 @@ void Game::processInput() {
 
     if (escPressed) {
       showHelp = false;
-      gAttack.swinging = false;
-      gAttack.lastTiles.clear();
+      attack.swinging = false;
+      attack.lastTiles.clear();
 
       if (godMode) {
         godMode = false;
@@ -290,7 +315,7 @@ void Game::processInput() {
   auto restartRun = [&]() {
     if (fixedSeed == 0)
       runSeed = nextRunSeed();
-    newRun();
+    newRun(hordeMode); // Reintentar en el mismo modo
   };
 
   // 1. Reinicio Teclado (Bloqueado en Tutorial)
@@ -312,7 +337,6 @@ void Game::processInput() {
     moveMode = (moveMode == MovementMode::StepByStep)
                    ? MovementMode::RepeatCooldown
                    : MovementMode::StepByStep;
-    moveCooldown = 0.0f;
   }
 
   const float dt = GetFrameTime();
@@ -396,13 +420,15 @@ void Game::processInput() {
         }
       }
     } else {
-      // Juego normal durante el tutorial
+      // Juego normal durante el tutorial (los ticks los corre update())
       handlePlayingInput(dt);
-      updateTutorial(dt);
     }
     return;
   } else if (state == GameState::Playing) {
-    handlePlayingInput(dt);
+    if (replaying)
+      handleReplayInput(); // La entrada de la partida viene de la grabación
+    else
+      handlePlayingInput(dt);
     return;
   }
 
@@ -484,27 +510,13 @@ void Game::handleMenuInput() {
     return;
   }
 
-  // Definición de botones
-  int bw = (int)std::round(screenW * 0.35f);
-  bw = std::clamp(bw, 320, 560);
-  int bh = (int)std::round(screenH * 0.12f);
-  bh = std::clamp(bh, 72, 120);
-  int startY = (int)std::round(screenH * 0.52f);
-  int gap = (int)std::round(screenH * 0.04f);
-
-  Rectangle playBtn = {(float)((screenW - bw) / 2), (float)startY, (float)bw,
-                       (float)bh};
-  Rectangle readBtn = {(float)((screenW - bw) / 2), (float)(startY + bh + gap),
-                       (float)bw, (float)bh};
-  Rectangle quitBtn = {(float)((screenW - bw) / 2),
-                       (float)(startY + (bh + gap) * 2), (float)bw, (float)bh};
-
-  // Rectángulo del botón ajustes (Coincide con GameUI)
-  int settingsSize = (int)std::round(screenH * 0.08f);
-  settingsSize = std::clamp(settingsSize, 48, 120);
-  Rectangle settingsRect = {(float)(screenW - settingsSize - 20),
-                            (float)(screenH - settingsSize - 20),
-                            (float)settingsSize, (float)settingsSize};
+  // Definición de botones (mismos rectángulos que dibuja renderMainMenu)
+  Rectangle playBtn = mainMenuButtonRect(0);
+  Rectangle readBtn = mainMenuButtonRect(1);
+  Rectangle hordeBtn = mainMenuButtonRect(2);
+  Rectangle quitBtn = mainMenuButtonRect(3);
+  Rectangle settingsRect = mainMenuButtonRect(4);
+  Rectangle continueBtn = mainMenuButtonRect(MENU_CONTINUE);
 
   // El rectángulo "diffRect" solo es relevante si showSettingsMenu es true,
   // pero aquí estamos en el menú principal para ir a opciones, así que
@@ -523,6 +535,10 @@ void Game::handleMenuInput() {
       return;
     }
 
+    if (hasSavedRun && CheckCollisionPointRec(mp, continueBtn)) {
+      continueRun();
+      return;
+    }
     if (CheckCollisionPointRec(mp, playBtn)) {
       newRun();
       return;
@@ -531,6 +547,10 @@ void Game::handleMenuInput() {
       startTutorial();
       return;
     }
+    if (CheckCollisionPointRec(mp, hordeBtn)) {
+      newRun(true);
+      return;
+    }
     if (CheckCollisionPointRec(mp, quitBtn)) {
       gQuitRequested = true;
       return;
@@ -544,20 +564,24 @@ void Game::handleMenuInput() {
     } else if (mainMenuSelection == 1) {
       startTutorial();
     } else if (mainMenuSelection == 2) {
-      gQuitRequested = true;
+      newRun(true);
     } else if (mainMenuSelection == 3) {
+      gQuitRequested = true;
+    } else if (mainMenuSelection == 4) {
       previousState = GameState::MainMenu;
       state = GameState::OptionsMenu;
       mainMenuSelection = 0;
+    } else if (mainMenuSelection == MENU_CONTINUE) {
+      continueRun();
     }
   };
 
   // Navegación Teclado
   if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W)) {
-    mainMenuSelection = (mainMenuSelection + 4 - 1) % 4;
+    stepMainMenu(-1);
   }
   if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_S)) {
-    mainMenuSelection = (mainMenuSelection + 1) % 4;
+    stepMainMenu(+1);
   }
   if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
     activateSelection();
@@ -567,10 +591,10 @@ void Game::handleMenuInput() {
   // Navegación Gamepad
   if (IsGamepadAvailable(menuGamepad)) {
     if (IsGamepadButtonPressed(menuGamepad, GAMEPAD_BUTTON_LEFT_FACE_UP)) {
-      mainMenuSelection = (mainMenuSelection + 4 - 1) % 4;
+      stepMainMenu(-1);
     }
     if (IsGamepadButtonPressed(menuGamepad, GAMEPAD_BUTTON_LEFT_FACE_DOWN)) {
-      mainMenuSelection = (mainMenuSelection + 1) % 4;
+      stepMainMenu(+1);
     }
 
     static bool stickNeutral = true;
@@ -580,10 +604,7 @@ void Game::handleMenuInput() {
     if (std::fabs(ay) < dead) {
       stickNeutral = true;
     } else if (stickNeutral) {
-      if (ay < 0.0f)
-        mainMenuSelection = (mainMenuSelection + 4 - 1) % 4;
-      else
-        mainMenuSelection = (mainMenuSelection + 1) % 4;
+      stepMainMenu(ay < 0.0f ? -1 : +1);
       stickNeutral = false;
     }
 
@@ -709,18 +730,24 @@ void Game::handlePauseInput() {
       break;
 
     case 2: // Salir al menú
+      // Antes de limpiar: la partida queda guardada para CONTINUAR
+      if (runInProgress())
+        autosaveRun();
+      autosaveActive = false;
+
       state = GameState::MainMenu;
       StopSound(sfxAmbient);
-      mainMenuSelection = 0;
+      mainMenuSelection = hasSavedRun ? MENU_CONTINUE : 0;
 
       // Limpieza de la partida
-      enemies.clear();
+      clearEnemies();
       items.clear();
       projectiles.clear();
+      clearBossCombat();
       particles.clear();
       floatingTexts.clear();
       isDashing = false;
-      gAttack.swinging = false;
+      attack.swinging = false;
       showGodModeInput = false;
 
       std::cout << "[GAME] Partida terminada. Volviendo al Menu.\n";
@@ -778,7 +805,7 @@ void Game::handleOptionsInput() {
       // Aplicar cambios y reiniciar
       difficulty = pendingDifficulty; // Confirmamos el cambio
       applyLanguageIfChanged();
-      newRun();
+      newRun(hordeMode);
       state = GameState::Playing;
       ResumeSound(sfxAmbient);
       showDifficultyWarning = false;
@@ -1052,94 +1079,27 @@ void Game::handlePlayingInput(float dt) {
     clampCameraToMap();
   }
 
-  // Interacción (Pickup)
-  bool interact = IsKeyPressed(KEY_E);
+  // --------------------------------------------------------
+  // 3. Acciones del jugador -> TickInput
+  // --------------------------------------------------------
+  // Aquí solo se lee el dispositivo. Lo que cambia la partida (moverse,
+  // dash, atacar, recoger) lo aplica applyTickInput() en cada tick.
+  TickInput f;
+
+  f.interact = IsKeyPressed(KEY_E);
   if (IsGamepadAvailable(gpId)) {
     if (IsGamepadButtonPressed(gpId, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))
-      interact = true;
+      f.interact = true;
   }
-  if (interact)
-    tryManualPickup();
 
-  // --------------------------------------------------------
-  // 3. Dash (Esquiva)
-  // --------------------------------------------------------
-  bool dashPressed =
-      IsKeyPressed(KEY_LEFT_SHIFT) || IsKeyPressed(KEY_RIGHT_SHIFT);
+  f.dash = IsKeyPressed(KEY_LEFT_SHIFT) || IsKeyPressed(KEY_RIGHT_SHIFT);
   if (IsGamepadAvailable(gpId)) {
     if (IsGamepadButtonPressed(gpId, GAMEPAD_BUTTON_LEFT_TRIGGER_1) ||
         IsGamepadButtonPressed(gpId, GAMEPAD_BUTTON_LEFT_TRIGGER_2)) {
-      dashPressed = true;
+      f.dash = true;
     }
   }
 
-  if (dashPressed && !isDashing && dashCooldownTimer <= 0.0f) {
-    int ddx = 0, ddy = 0;
-    // Prioridad: Dirección pulsada ahora
-    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))
-      ddy = -1;
-    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN))
-      ddy = 1;
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))
-      ddx = -1;
-    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT))
-      ddx = 1;
-
-    // Si no, última dirección
-    if (ddx == 0 && ddy == 0) {
-      ddx = gAttack.lastDir.x;
-      ddy = gAttack.lastDir.y;
-    }
-
-    if (ddx != 0 || ddy != 0) {
-      int targetX = px;
-      int targetY = py;
-
-      // Calcular destino (hasta DASH_DISTANCE)
-      for (int i = 1; i <= DASH_DISTANCE; i++) {
-        int nextX = px + ddx * i;
-        int nextY = py + ddy * i;
-        if (!map.isWalkable(nextX, nextY))
-          break; // Pared
-
-        bool enemyBlock = false;
-        for (const auto &e : enemies)
-          if (e.getX() == nextX && e.getY() == nextY)
-            enemyBlock = true;
-        if (enemyBlock)
-          break; // Enemigo
-
-        targetX = nextX;
-        targetY = nextY;
-      }
-
-      if (targetX != px || targetY != py) {
-        // Configurar estado Dash
-        isDashing = true;
-        dashTimer = DASH_DURATION;
-        dashCooldownTimer = DASH_COOLDOWN;
-
-        dashStartPos = {px * (float)tileSize, py * (float)tileSize};
-        dashEndPos = {targetX * (float)tileSize, targetY * (float)tileSize};
-
-        px = targetX;
-        py = targetY;
-        player.setGridPos(px, py);
-
-        PlaySound(sfxDash);
-
-        onSuccessfulStep(0, 0);
-        return;
-      }
-    }
-  }
-
-  // --------------------------------------------------------
-  // 4. Movimiento normal
-  // --------------------------------------------------------
-  int dx = 0, dy = 0;
-  bool moved = false;
-
   int gpDx = 0, gpDy = 0;
   bool gpDpadPressed = false;
   bool gpAnalogActive = false;
@@ -1187,126 +1147,63 @@ void Game::handlePlayingInput(float dt) {
     else if (gpDpadPressed)
       moveMode = MovementMode::StepByStep;
   }
+  f.stepMode = (moveMode == MovementMode::StepByStep);
 
-  if (moveMode == MovementMode::StepByStep) {
-    if (IsKeyPressed(KEY_W) || IsKeyPressed(KEY_UP))
-      dy = -1;
-    if (IsKeyPressed(KEY_S) || IsKeyPressed(KEY_DOWN))
-      dy = +1;
-    if (IsKeyPressed(KEY_A) || IsKeyPressed(KEY_LEFT))
-      dx = -1;
-    if (IsKeyPressed(KEY_D) || IsKeyPressed(KEY_RIGHT))
-      dx = +1;
-
-    if (dx == 0 && dy == 0 && (gpDx != 0 || gpDy != 0)) {
-      dx = gpDx;
-      dy = gpDy;
-    }
-
-    if (dx != 0 || dy != 0) {
-      gAttack.lastDir = {dx, dy};
-      player.setDirectionFromDelta(dx, dy);
-      int oldx = px, oldy = py;
-      tryMove(dx, dy);
-      moved = (px != oldx || py != oldy);
-      if (moved)
-        onSuccessfulStep(dx, dy);
-    }
-    player.update(dt, moved);
-  } else {
-    moveCooldown -= dt;
-    bool pressedNow =
-        IsKeyPressed(KEY_W) || IsKeyPressed(KEY_S) || IsKeyPressed(KEY_A) ||
-        IsKeyPressed(KEY_D) || IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_DOWN) ||
-        IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_RIGHT) || gpDpadPressed;
-
-    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))
-      dy = -1;
-    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN))
-      dy = +1;
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))
-      dx = -1;
-    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT))
-      dx = +1;
-
-    if (dx == 0 && gpDx != 0)
-      dx = gpDx;
-    if (dy == 0 && gpDy != 0)
-      dy = gpDy;
-
-    if (dx != 0 || dy != 0) {
-      gAttack.lastDir = {dx, dy};
-      player.setDirectionFromDelta(dx, dy);
-    }
-
-    if (pressedNow) {
-      int oldx = px, oldy = py;
-      tryMove(dx, dy);
-      moved = (px != oldx || py != oldy);
-      if (moved)
-        onSuccessfulStep(dx, dy);
-      moveCooldown = MOVE_INTERVAL;
-    } else if ((dx != 0 || dy != 0) && moveCooldown <= 0.0f) {
-      int oldx = px, oldy = py;
-      tryMove(dx, dy);
-      moved = (px != oldx || py != oldy);
-      if (moved)
-        onSuccessfulStep(dx, dy);
-      moveCooldown = MOVE_INTERVAL;
-    }
-    player.update(dt, moved);
-  }
-
-  // --------------------------------------------------------
-  // 5. Sistema de combate (Input)
-  // --------------------------------------------------------
-  gAttack.cdTimer = std::max(0.f, gAttack.cdTimer - dt);
-  plasmaCooldown = std::max(0.f, plasmaCooldown - dt);
-
-  if (gAttack.swinging) {
-    gAttack.swingTimer = std::max(0.f, gAttack.swingTimer - dt);
-    if (gAttack.swingTimer <= 0.f) {
-      gAttack.swinging = false;
-      gAttack.lastTiles.clear();
-    }
+  // Dirección pulsada en este frame (paso a paso)
+  int dx = 0, dy = 0;
+  if (IsKeyPressed(KEY_W) || IsKeyPressed(KEY_UP))
+    dy = -1;
+  if (IsKeyPressed(KEY_S) || IsKeyPressed(KEY_DOWN))
+    dy = +1;
+  if (IsKeyPressed(KEY_A) || IsKeyPressed(KEY_LEFT))
+    dx = -1;
+  if (IsKeyPressed(KEY_D) || IsKeyPressed(KEY_RIGHT))
+    dx = +1;
+  if (dx == 0 && dy == 0 && (gpDx != 0 || gpDy != 0)) {
+    dx = gpDx;
+    dy = gpDy;
   }
-
-  // A) Puños
-  bool attackHands = IsKeyPressed(KEY_SPACE);
+  f.stepX = static_cast<int8_t>(dx);
+  f.stepY = static_cast<int8_t>(dy);
+  f.movePressed =
+      IsKeyPressed(KEY_W) || IsKeyPressed(KEY_S) || IsKeyPressed(KEY_A) ||
+      IsKeyPressed(KEY_D) || IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_DOWN) ||
+      IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_RIGHT) || gpDpadPressed;
+
+  // Dirección mantenida (movimiento continuo y dash)
+  dx = 0;
+  dy = 0;
+  if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))
+    dy = -1;
+  if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN))
+    dy = +1;
+  if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))
+    dx = -1;
+  if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT))
+    dx = +1;
+  if (dx == 0 && gpDx != 0)
+    dx = gpDx;
+  if (dy == 0 && gpDy != 0)
+    dy = gpDy;
+  f.holdX = static_cast<int8_t>(dx);
+  f.holdY = static_cast<int8_t>(dy);
+
+  f.attackHands = IsKeyPressed(KEY_SPACE);
   if (IsGamepadAvailable(gpId) &&
       IsGamepadButtonPressed(gpId, GAMEPAD_BUTTON_RIGHT_FACE_LEFT))
-    attackHands = true;
+    f.attackHands = true;
 
-  if (attackHands && gAttack.cdTimer <= 0.f)
-    performMeleeAttack();
-
-  // B) Espada
-  bool attackSword = IsKeyPressed(KEY_ONE);
+  f.attackSword = IsKeyPressed(KEY_ONE);
   if (IsGamepadAvailable(gpId) &&
       IsGamepadButtonPressed(gpId, GAMEPAD_BUTTON_RIGHT_TRIGGER_1))
-    attackSword = true;
+    f.attackSword = true;
 
-  if (attackSword) {
-    if (swordTier > 0) {
-      if (gAttack.cdTimer <= 0.f)
-        performSwordAttack();
-    } else {
-      std::cout << "No tienes espada\n";
-    }
-  }
-
-  // C) Pistola Plasma
-  bool attackPlasma = IsKeyPressed(KEY_TWO);
+  f.attackPlasma = IsKeyPressed(KEY_TWO);
   if (IsGamepadAvailable(gpId)) {
     if (IsGamepadButtonPressed(gpId, GAMEPAD_BUTTON_RIGHT_TRIGGER_2))
-      attackPlasma = true;
-  }
-  if (attackPlasma) {
-    if (plasmaTier > 0) {
-      if (plasmaCooldown <= 0.f)
-        performPlasmaAttack();
-    } else {
-      std::cout << "No tienes plasma\n";
-    }
+      f.attackPlasma = true;
   }
+
+  pendingInput.merge(f);
 }
+
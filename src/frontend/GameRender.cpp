@@ -0,0 +1,443 @@
+#include "Game.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "I18n.hpp"
+#include "rlgl.h"
+
+
+Rectangle Game::uiCenterRect(float w, float h) const {
+    return {(screenW - w) * 0.5f, (screenH - h) * 0.5f, w, h};
+}
+
+void Game::drawProjectiles() const {
+    // Halo y núcleo por bando, al lote (ver flushBatch)
+    const uint32_t enemyHalo = PrimitiveBatch::pack(RED.r, RED.g, RED.b, RED.a);
+    const uint32_t playerHalo = PrimitiveBatch::pack(SKYBLUE.r, SKYBLUE.g, SKYBLUE.b, SKYBLUE.a);
+    // Si es enemiga, el núcleo lo hacemos naranja para que parezca fuego/láser dañino
+    // Si es tuya, el núcleo es blanco puro (plasma)
+    const uint32_t enemyCore = PrimitiveBatch::pack(ORANGE.r, ORANGE.g, ORANGE.b, ORANGE.a);
+    const uint32_t playerCore = PrimitiveBatch::pack(WHITE.r, WHITE.g, WHITE.b, WHITE.a);
+
+    // Entre dos ticks: la bala se dibuja en el tramo que le falta por
+    // recorrer (posición del tick anterior + alpha del recorrido)
+    const float back = (1.0f - renderAlpha) * FixedTimestep::TICK;
+    for (size_t i = 0; i < projectiles.size(); ++i) {
+        const bool isEnemy = projectiles.isEnemy(i);
+        const float x = projectiles.x(i) - projectiles.vx(i) * back;
+        const float y = projectiles.y(i) - projectiles.vy(i) * back;
+        batch.circle(x, y, 5.0f, isEnemy ? enemyHalo : playerHalo); // Halo exterior
+        batch.circle(x, y, 2.0f, isEnemy ? enemyCore : playerCore); // Núcleo brillante
+    }
+}
+
+void Game::flushBatch() const {
+    // Todo el lote como triángulos en un solo rlBegin por tramo. Cada tramo
+    // cabe en el buffer de rlgl; si no queda hueco, rlgl dibuja lo que lleva
+    // (una llamada) y seguimos. Al final queda una más pendiente que rlgl
+    // envía al cambiar de estado o en EndMode2D.
+    const auto& v = batch.vertices();
+    if (v.empty()) return;
+
+#if defined(__EMSCRIPTEN__)
+    const size_t bufferVerts = 2048 * 4; // WebGL (GLES2): buffer más pequeño
+#else
+    const size_t bufferVerts = (size_t)RL_DEFAULT_BATCH_BUFFER_ELEMENTS * 4;
+#endif
+    const size_t chunk = bufferVerts - 6; // Múltiplo de 3
+    size_t draws = 1;
+    rlSetTexture(rlGetTextureIdDefault());
+    for (size_t first = 0; first < v.size(); first += chunk) {
+        const size_t n = std::min(chunk, v.size() - first);
+        if (rlCheckRenderBatchLimit((int)n)) draws++;
+        rlBegin(RL_TRIANGLES);
+        for (size_t k = first; k < first + n; ++k) {
+            const uint32_t c = v[k].rgba;
+            rlColor4ub(c & 0xFF, (c >> 8) & 0xFF, (c >> 16) & 0xFF, c >> 24);
+            rlVertex2f(v[k].x, v[k].y);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+    batch.markSubmitted(draws);
+}
+
+void Game::drawPerfOverlay() const {
+    // Panel de depuración en pantalla (F3). Texto sin traducir: son métricas.
+    const int secs = profiler.sectionCount();
+    const int lineH = 16;
+    const int panelW = 300;
+    const int panelH = 10 + lineH * (5 + secs) + 10;
+    const int x0 = 10;
+    const int y0 = 10;
+
+    DrawRectangle(x0, y0, panelW, panelH, Fade(BLACK, 0.75f));
+    DrawRectangleLines(x0, y0, panelW, panelH, Fade(LIME, 0.6f));
+
+    int y = y0 + 8;
+    const float frame = (float)profiler.frameMs();
+    // Verde a 60 fps, amarillo por debajo de 30, rojo peor
+    const Color fpsColor = frame <= 17.0f ? LIME : (frame <= 34.0f ? YELLOW : RED);
+    DrawText(TextFormat("FPS %.0f  frame %.2f ms  cpu %.2f ms",
+                        profiler.fps(), frame, profiler.cpuMs()),
+             x0 + 8, y, 10, fpsColor);
+    y += lineH;
+    DrawText(TextFormat("peor frame (%d) %.2f ms", (int)FrameProfiler::HISTORY,
+                        profiler.worstFrameMs()),
+             x0 + 8, y, 10, RAYWHITE);
+    y += lineH;
+
+    // Una barra por sistema, escalada a un frame de 60 fps (16.6 ms)
+    const int barX = x0 + 150;
+    const int barW = panelW - 160;
+    for (int i = 0; i < secs; ++i) {
+        const float ms = (float)profiler.sectionMs(i);
+        DrawText(TextFormat("%-16s %6.2f", profiler.sectionName(i).c_str(), ms),
+                 x0 + 8, y, 10, RAYWHITE);
+        const float k = std::min(1.0f, ms / 16.6f);
+        DrawRectangle(barX, y + 1, barW, 8, Fade(DARKGRAY, 0.6f));
+        DrawRectangle(barX, y + 1, (int)(barW * k), 8, k < 0.5f ? LIME : ORANGE);
+        y += lineH;
+    }
+
+    size_t awake = 0;
+    for (uint8_t a : enemyAwake) awake += a;
+    DrawText(TextFormat("enemigos %d  activos %d  aparcados %d",
+                        (int)enemies.size(), (int)awake,
+                        (int)population.dormantCount()),
+             x0 + 8, y, 10, SKYBLUE);
+    y += lineH;
+
+    // Lote de primitivas del frame anterior (este aún se está llenando)
+    const auto& b = batch.lastFrame();
+    DrawText(TextFormat("lote %d prims  %d verts  %d envios  %d draws",
+                        (int)b.primitives, (int)b.vertices, (int)b.submits,
+                        (int)b.draws),
+             x0 + 8, y, 10, SKYBLUE);
+    y += lineH;
+
+    // Planificador del boss: lo que costó la última decisión
+    const auto& d = bossPlanner.lastDecision();
+    DrawText(TextFormat("boss plan prof %d  nodos %d  %.2f ms (%s)",
+                        d.depth, (int)d.nodes, d.ms,
+                        bossPlanner.isThreaded() ? "hilo" : "en linea"),
+             x0 + 8, y, 10, SKYBLUE);
+}
+
+void Game::render() {
+    // --------------------------------------------------------
+    // 1. Menús de pantalla (Salida anticipada)
+    // --------------------------------------------------------
+    if (state == GameState::MainMenu) {
+        renderMainMenu();
+        return;
+    }
+
+    if (state == GameState::OptionsMenu) {
+        renderOptionsMenu();
+        return;
+    }
+
+    BeginDrawing();
+    ClearBackground(BLACK);
+
+    // ----------------------------------------------------------
+    // 2. Mundo de juego (Capa 2D)
+    // Se dibuja siempre (Jugando, Tutorial, Pausa, GameOver...)
+    // ----------------------------------------------------------
+    // Cámara interpolada entre los dos últimos ticks (ver update)
+    Camera2D view = camera;
+    view.target.x = cameraPrev.x + (camera.target.x - cameraPrev.x) * renderAlpha;
+    view.target.y = cameraPrev.y + (camera.target.y - cameraPrev.y) * renderAlpha;
+
+    BeginMode2D(view);
+    batch.beginFrame();
+
+        // 2.1 Mapa (Suelo y Paredes con iluminación)
+        drawMap();
+        
+        // 2.2 Entidades
+        drawItems();
+        {
+            FrameProfiler::Scope t(profiler, PerfRenderEnemies);
+            drawEnemies(); // Dibuja enemigos normales
+            flushBatch();  // Barras de vida encima de todos los enemigos
+        }
+        drawBoss();    // Dibuja al Boss (si está activo)
+        
+        // 2.3 Jugador
+        player.draw(tileSize, px, py);
+        
+        // 2.4 Efectos Visuales y Partículas
+        if (slashActive) drawSlash(); // Estela del ataque melee
+        drawProjectiles();            // Balas de plasma
+        drawParticles();              // Explosiones y sangre
+        flushBatch();                 // Balas y partículas en pocas llamadas
+        drawFloatingTexts();          // Números de daño flotantes
+
+    EndMode2D();
+
+    // --------------------------------------------------------
+    // 3. Interfaz de usuario (HUD y Menús superpuestos)
+    // --------------------------------------------------------
+
+    // Caso A: Tutorial
+    if (state == GameState::Tutorial) {
+        hud.drawPlaying(*this); // Mostramos vida para ver efecto de pociones
+        renderTutorialUI();     // Instrucciones amarillas arriba
+    }
+    // Caso B: Jugando normal
+    else if (state == GameState::Playing) {
+        hud.drawPlaying(*this);
+    }
+    // Caso C: Pausa (Juego congelado de fondo + Menú)
+    else if (state == GameState::Paused) {
+        hud.drawPlaying(*this); // Mantenemos el HUD visible
+        renderPauseMenu();
+    }
+    // Caso D: Pantallas finales
+    else if (state == GameState::Victory) {
+        hud.drawVictory(*this);
+    }
+    else if (state == GameState::GameOver) {
+        hud.drawGameOver(*this);
+    }
+
+    // --------------------------------------------------------
+    // 4. Overlays globales (Siempre encima de todo)
+    // --------------------------------------------------------
+    
+    // Tiempos por sistema (F3 / modo horda)
+    if (showPerfOverlay) drawPerfOverlay();
+
+    // Repetición: velocidad, posición y si se ha desincronizado
+    if (replaying) drawReplayOverlay();
+
+    // Guardado/carga rápida y reintento del nivel
+    drawSnapshotNotice();
+
+    // Consola modo Dios (Terminal Hacker)
+    if (showGodModeInput) {
+        // Fondo Dimmer
+        DrawRectangle(0, 0, screenW, screenH, Fade(BLACK, 0.85f)); 
+
+        int panelW = 500;
+        int panelH = 200;
+        int cx = (screenW - panelW) / 2;
+        int cy = (screenH - panelH) / 2;
+
+        float time = (float)GetTime();
+        float pulse = (sinf(time * 4.0f) + 1.0f) * 0.5f;
+        Color borderColor = ColorAlpha(LIME, 0.6f + (0.4f * pulse)); 
+        Color glowColor   = ColorAlpha(LIME, 0.2f * pulse);
+
+        // Panel estilo retro
+        DrawRectangle(cx + 10, cy + 10, panelW, panelH, Color{0, 0, 0, 200}); // Sombra
+        DrawRectangle(cx, cy, panelW, panelH, Color{10, 30, 10, 255});        // Fondo
+        DrawRectangleLinesEx({(float)cx, (float)cy, (float)panelW, (float)panelH}, 4, borderColor);
+        DrawRectangle(cx, cy, panelW, panelH, glowColor);
+
+        // Scanlines
+        for (int i = 0; i < panelH; i += 4) {
+            DrawRectangle(cx, cy + i, panelW, 1, Fade(LIME, 0.1f));
+        }
+
+        // Título
+        const char* title = _("/// SYSTEM OVERRIDE ///");
+        int titleW = MeasureText(title, 20);
+        DrawRectangle(cx, cy, panelW, 30, borderColor);
+        DrawText(title, cx + (panelW - titleW) / 2, cy + 5, 20, BLACK);
+
+        // Input Box
+        DrawText(_("ENTER ACCESS CODE:"), cx + 30, cy + 50, 20, LIME);
+        DrawRectangle(cx + 30, cy + 80, panelW - 60, 40, BLACK);
+        DrawRectangleLines(cx + 30, cy + 80, panelW - 60, 40, borderColor);
+
+        // Texto con cursor
+        std::string displayTxt = godModeInput;
+        if ((int)(time * 2.0f) % 2 == 0) displayTxt += "_"; 
+        DrawText(displayTxt.c_str(), cx + 45, cy + 90, 20, LIME);
+
+        // Footer
+        DrawText(_("STATUS: WAITING FOR INPUT..."), cx + 30, cy + 140, 10, Fade(LIME, 0.7f));
+        DrawText(_("[ENTER] EXECUTE   [ESC] ABORT"), cx + panelW - 180, cy + 170, 10, Fade(LIME, 0.5f));
+    }
+
+    EndDrawing();
+}
+
+// Renderizado del mapa (antes Map::draw: el mapa ya no sabe de raylib)
+void Game::drawMap() const {
+    const int radius = getFovRadius();
+    const Texture2D& wallTex = itemSprites.wall;
+    const Texture2D& floorTex = itemSprites.floor;
+
+    for (int y = 0; y < map.height(); ++y) {
+        for (int x = 0; x < map.width(); ++x) {
+            
+            // Si no está descubierto, Negro absoluto
+            if (!map.isDiscovered(x, y)) continue;
+
+            // --- CÁLCULO DE ILUMINACIÓN ---
+            Color tint = WHITE;
+            
+            if (!map.revealAll() && map.fogEnabled()) {
+                // 1. ZONA DE MEMORIA
+                if (!map.isVisible(x, y)) {
+                     tint = { 40, 40, 50, 255 }; 
+                } 
+                // 2. ZONA VISIBLE (Antorcha)
+                else {
+                    // Calculamos distancia al jugador
+                    float dx = (float)(x - px);
+                    float dy = (float)(y - py);
+                    float dist = std::sqrt(dx*dx + dy*dy);
+                    
+                    // Factor de luz (1.0 en el centro, 0.0 en el borde del radio)
+                    // El "+ 1.0f" es para suavizar el borde
+                    float light = 1.0f - (dist / (float)(radius + 1));
+                    light = std::clamp(light, 0.0f, 1.0f);
+                    
+                    // Curva de luz para que el centro sea muy brillante y caiga rápido
+                    // (Efecto linterna)
+                    light = powf(light, 0.5f); 
+
+                    // Aplicamos la luz, pero asegurando un mínimo para que se vea
+                    unsigned char val = (unsigned char)(255.0f * light);
+                    if (val < 60) val = 60; // Mínimo de luz en zona visible
+                    
+                    tint = { val, val, val, 255 };
+                }
+            }
+
+            // Dibujado
+            Rectangle dest = { 
+                (float)(x * tileSize), 
+                (float)(y * tileSize), 
+                (float)tileSize, 
+                (float)tileSize 
+            };
+            Vector2 origin = { 0, 0 };
+            Tile t = map.at(x, y);
+
+            if (t == WALL) {
+                Rectangle src = { 0, 0, (float)wallTex.width, (float)wallTex.height };
+                DrawTexturePro(wallTex, src, dest, origin, 0.0f, tint);
+            } 
+            else if (t == FLOOR || t == EXIT) {
+                Rectangle src = { 0, 0, (float)floorTex.width, (float)floorTex.height };
+                DrawTexturePro(floorTex, src, dest, origin, 0.0f, tint);
+
+                if (t == EXIT) {
+                    DrawRectangleRec(dest, Fade(GREEN, 0.4f));
+                    DrawRectangleLinesEx(dest, 2, LIME);
+                }
+            }
+        }
+    }
+}
+
+void Game::drawParticles() const {
+    particles.forEachAlive([this](float x, float y, float size, float alpha, uint32_t rgba) {
+        // Fade out (se vuelven transparentes al final): solo cambia el alfa
+        const uint32_t a = (uint32_t)((float)(rgba >> 24) * alpha);
+        batch.rect(x, y, size, size, (rgba & 0x00FFFFFFu) | (a << 24));
+    });
+}
+
+void Game::drawSlash() const {
+    if (!slashActive) return;
+
+    // Calculamos el centro del jugador
+    Vector2 center = { 
+        px * (float)tileSize + tileSize / 2.0f, 
+        py * (float)tileSize + tileSize / 2.0f 
+    };
+
+    // Radio del corte (un poco más grande que el tile para que sobresalga)
+    float radiusInner = tileSize * 0.5f;
+    float radiusOuter = tileSize * 1.2f;
+
+    // Ángulos del arco (120 grados de amplitud)
+    float startAngle = slashBaseAngle - 60.0f;
+    float endAngle   = slashBaseAngle + 60.0f;
+
+    // Fade Out (Se vuelve transparente al final)
+    // 0.15f es la duración total del golpe
+    float alpha = std::clamp(slashTimer / 0.15f, 0.0f, 1.0f); 
+    Color c = Fade(unpackColor(slashColor), alpha);
+
+    // Dibujamos el arco
+    DrawRing(center, radiusInner, radiusOuter, startAngle, endAngle, 16, c);
+}
+
+// Mismas medidas que DrawTextEx con la fuente por defecto (recorte con el
+// relleno del glifo, desplazamiento y avance), calculadas una sola vez
+void Game::cacheDigitGlyphs() const {
+    const Font font = GetFontDefault();
+    const float pad = (float)font.glyphPadding;
+    const float tw = (float)font.texture.width, th = (float)font.texture.height;
+    for (int k = 0; k < DIGIT_GLYPHS; ++k) {
+        const int index = GetGlyphIndex(font, k < 10 ? '0' + k : '-');
+        const Rectangle r = font.recs[index];
+        DigitGlyph &g = digitGlyphs[k];
+        g.u0 = (r.x - pad) / tw;
+        g.v0 = (r.y - pad) / th;
+        g.u1 = (r.x + r.width + pad) / tw;
+        g.v1 = (r.y + r.height + pad) / th;
+        g.dx = font.glyphs[index].offsetX - pad;
+        g.dy = font.glyphs[index].offsetY - pad;
+        g.w = r.width + 2.0f * pad;
+        g.h = r.height + 2.0f * pad;
+        g.advance = font.glyphs[index].advanceX != 0
+                        ? (float)font.glyphs[index].advanceX
+                        : r.width;
+    }
+    digitBaseSize = (float)font.baseSize;
+    digitAtlas = font.texture.id;
+}
+
+void Game::drawFloatingTexts() const {
+    if (floatingTexts.size() == 0) return;
+    if (digitAtlas == 0) cacheDigitGlyphs();
+
+    // Todos los textos con la textura del atlas: rlgl los junta en una
+    // llamada de dibujo (o pocas, si el buffer se llena)
+    rlSetTexture(digitAtlas);
+    floatingTexts.forEach([this](float x, float y, float alpha, float pop,
+                                 const char* txt, uint32_t rgba) {
+        Color c = unpackColor(rgba);
+        c.a = (unsigned char)(c.a * alpha);
+        const Color shadow = Fade(BLACK, alpha);
+        // Recién sumado un golpe: un pelín más grande
+        const int fontSize = 10 + (int)(4.0f * pop);
+        const float scale = fontSize / digitBaseSize;
+        const float spacing = (float)(fontSize / 10); // Como DrawText
+
+        int len = 0;
+        while (txt[len]) len++;
+        rlCheckRenderBatchLimit(8 * len);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        // Borde negro debajo para que se lea bien, luego el texto
+        for (int pass = 0; pass < 2; ++pass) {
+            const Color col = pass == 0 ? shadow : c;
+            rlColor4ub(col.r, col.g, col.b, col.a);
+            float penX = (float)((int)x + 1 - pass);
+            const float penY = (float)((int)y + 1 - pass);
+            for (int i = 0; i < len; ++i) {
+                const char ch = txt[i];
+                const DigitGlyph& g = digitGlyphs[ch == '-' ? 10 : ch - '0'];
+                const float x0 = penX + g.dx * scale, y0 = penY + g.dy * scale;
+                const float x1 = x0 + g.w * scale, y1 = y0 + g.h * scale;
+                rlTexCoord2f(g.u0, g.v0); rlVertex2f(x0, y0);
+                rlTexCoord2f(g.u0, g.v1); rlVertex2f(x0, y1);
+                rlTexCoord2f(g.u1, g.v1); rlVertex2f(x1, y1);
+                rlTexCoord2f(g.u1, g.v0); rlVertex2f(x1, y0);
+                penX += g.advance * scale + spacing;
+            }
+        }
+        rlEnd();
+    });
+    rlSetTexture(0);
+}
@@ -0,0 +1,207 @@
+#include "Game.hpp"
+#include "GettextCompat.hpp"
+#include "I18n.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+// ----------------------------------------------------------------------------
+// Grabación
+// ----------------------------------------------------------------------------
+std::string Game::replayDir() {
+  const char *home = std::getenv("HOME");
+  if (!home)
+    return "replays";
+
+  return std::string(home) + "/.config/roguebot/replays";
+}
+
+// Zoom de 0.5 a 3.0 en un byte (0 = sin dato)
+std::uint8_t Game::packZoom(float zoom) {
+  const float k = (std::clamp(zoom, 0.5f, 3.0f) - 0.5f) / 2.5f;
+  return static_cast<std::uint8_t>(1 + std::lround(k * 254.0f));
+}
+
+float Game::unpackZoom(std::uint8_t z) {
+  if (z == 0)
+    return 1.0f;
+  return 0.5f + (z - 1) / 254.0f * 2.5f;
+}
+
+void Game::recordTick(const TickInput &in) {
+  if (recordingActive)
+    recording.push(in, packZoom(cameraZoom));
+}
+
+// Tras el tick: keyframe periódico, al cambiar de nivel y al terminar
+void Game::recordKeyframe() {
+  if (!recordingActive)
+    return;
+  recording.markTick(*this);
+  if (state != GameState::Playing)
+    saveRecording(); // Victoria o derrota: la partida ya no cambia
+}
+
+void Game::saveRecording() {
+  if (!recordingActive)
+    return;
+  recordingActive = false;
+  if (recording.ticks() == 0)
+    return;
+
+  const std::string dir = replayDir();
+  try {
+    std::filesystem::create_directories(dir);
+  } catch (...) {
+    // Si falla crear carpetas, save() lo dirá
+  }
+
+  const std::string path =
+      dir + "/run_" + std::to_string(recording.setup().seed) + ".rbr";
+  if (recording.save(path))
+    std::cout << _("[REPLAY] Partida grabada: ") << path << " ("
+              << recording.ticks() << " ticks, " << recording.sizeBytes()
+              << " bytes)\n";
+  else
+    std::cerr << _("[REPLAY] No se pudo guardar: ") << path << "\n";
+}
+
+// ----------------------------------------------------------------------------
+// Repetición
+// ----------------------------------------------------------------------------
+bool Game::requestReplay(const std::string &path) {
+  if (!recording.load(path))
+    return false;
+  launchReplayOnStart = true;
+  return true;
+}
+
+void Game::startReplay() {
+  seedBeforeReplay = fixedSeed;
+  replaying = true;
+  replaySpeed = 1;
+  // RunStarted rebobina el cursor (ver onSimEvent)
+  startRun(recording.setup());
+  std::cout << _("[REPLAY] Reproduciendo ") << recording.ticks()
+            << " ticks (seed " << recording.setup().seed << ")\n";
+}
+
+void Game::stopReplay() {
+  if (!replaying)
+    return;
+  replaying = false;
+  fixedSeed = seedBeforeReplay;
+  setViewport(GetScreenWidth(), GetScreenHeight());
+}
+
+void Game::seekReplay(std::uint64_t tick) {
+  tick = std::min(tick, recording.ticks());
+  // Adelantar sin ventana ni sonido; hacia atrás, desde el principio
+  SetMasterVolume(0.0f);
+  if (tick < getTick() || state != GameState::Playing)
+    startRun(recording.setup());
+  replayCheck.add(replayRecording(*this, replayCursor, recording, tick));
+  SetMasterVolume(audioVolume);
+
+  cameraZoom = unpackZoom(replayCursor.zoom());
+  camera.zoom = cameraZoom;
+  if (currentLevel != maxLevels)
+    centerCameraOnPlayer();
+  player.setGridPos(px, py);
+  stepper.reset();
+}
+
+void Game::handleReplayInput() {
+  if (IsKeyPressed(KEY_F))
+    replaySpeed = replaySpeed >= 16 ? 1 : replaySpeed * 4;
+
+  const std::uint64_t jump = 10 * FixedTimestep::TICK_HZ;
+  const std::uint64_t now = getTick();
+  if (IsKeyPressed(KEY_RIGHT))
+    seekReplay(now + jump);
+  if (IsKeyPressed(KEY_LEFT))
+    seekReplay(now > jump ? now - jump : 0);
+
+  // Keyframes: el anterior y el siguiente al tick actual
+  const auto &frames = recording.keyframes();
+  if (IsKeyPressed(KEY_PAGE_DOWN)) {
+    auto it = std::upper_bound(frames.begin(), frames.end(), now,
+                               [](std::uint64_t t, const auto &k) {
+                                 return t < k.tick;
+                               });
+    if (it != frames.end())
+      seekReplay(it->tick);
+  }
+  if (IsKeyPressed(KEY_PAGE_UP)) {
+    auto it = std::lower_bound(frames.begin(), frames.end(), now,
+                               [](const auto &k, std::uint64_t t) {
+                                 return k.tick < t;
+                               });
+    seekReplay(it == frames.begin() ? 0 : std::prev(it)->tick);
+  }
+
+  if (IsKeyPressed(KEY_C)) {
+    camera.rotation = 0.0f;
+    clampCameraToMap();
+  }
+}
+
+void Game::drawReplayOverlay() const {
+  const int fontSize = 20;
+  const int x = 10;
+  const int y = screenH - 3 * (fontSize + 6) - 10;
+  const std::uint64_t now = getTick();
+  const int secs = (int)(now / FixedTimestep::TICK_HZ);
+  const int total = (int)(recording.ticks() / FixedTimestep::TICK_HZ);
+
+  DrawText(TextFormat(_("REPETICIÓN x%d   %02d:%02d / %02d:%02d"), replaySpeed,
+                      secs / 60, secs % 60, total / 60, total % 60),
+           x, y, fontSize, GOLD);
+  DrawText(_("F: velocidad  Izq/Der: 10 s  RePág/AvPág: keyframes"), x,
+           y + fontSize + 6, fontSize - 4, RAYWHITE);
+
+  if (replayCheck.desyncs > 0)
+    DrawText(TextFormat(_("DESINCRONIZADA en el tick %d"),
+                        (int)replayCheck.firstDesync),
+             x, y + 2 * (fontSize + 6), fontSize - 4, RED);
+  else if (replayCursor.done())
+    DrawText(_("Fin de la grabación"), x, y + 2 * (fontSize + 6),
+             fontSize - 4, LIME);
+}
+
+// ----------------------------------------------------------------------------
+// Fotos del estado
+// ----------------------------------------------------------------------------
+void Game::quickSaveState() {
+  const double t0 = GetTime();
+  saveSnapshot(quickSave);
+  std::cout << _("[SNAPSHOT] Guardado rápido: ") << quickSave.size()
+            << " bytes en " << (GetTime() - t0) * 1e6 << " us\n";
+  snapshotNotice = _("Guardado rápido");
+  snapshotNoticeUntil = GetTime() + 1.5;
+}
+
+bool Game::restoreState(const SimSnapshot &snap, const char *notice) {
+  if (snap.empty())
+    return false;
+  // onSimEvent(StateRestored) recoloca cámara y grabación
+  if (!loadSnapshot(snap)) {
+    // Con fotos de esta misma sesión no debería pasar; si pasa, la partida
+    // sigue tal cual estaba
+    std::cerr << _("[SNAPSHOT] No se pudo cargar la foto\n");
+    return false;
+  }
+  snapshotNotice = notice;
+  snapshotNoticeUntil = GetTime() + 1.5;
+  return true;
+}
+
+void Game::drawSnapshotNotice() const {
+  if (!snapshotNotice || GetTime() > snapshotNoticeUntil)
+    return;
+  const int fontSize = 24;
+  const int w = MeasureText(snapshotNotice, fontSize);
+  DrawText(snapshotNotice, (screenW - w) / 2, 60, fontSize, GOLD);
+}
@@ -0,0 +1,80 @@
+#include "Game.hpp"
+#include "GettextCompat.hpp"
+#include "I18n.hpp"
+#include <cstdlib>
+#include <iostream>
+
+// ----------------------------------------------------------------------------
+// Partida guardada
+// ----------------------------------------------------------------------------
+std::string Game::runSavePath() {
+  const char *home = std::getenv("HOME");
+  if (!home)
+    return "roguebot_run.sav";
+
+  return std::string(home) + "/.config/roguebot/run.sav";
+}
+
+bool Game::runInProgress() const {
+  if (!autosaveActive)
+    return false;
+  if (state == GameState::Playing)
+    return true;
+  // Ajustes abiertos desde la pausa de una partida
+  const GameState paused =
+      state == GameState::OptionsMenu ? previousState : state;
+  return paused == GameState::Paused && pauseOrigin == GameState::Playing;
+}
+
+// Foto y encargo al hilo: microsegundos en este hilo, el disco no se nota
+void Game::autosaveRun() {
+  savedRun.capture(*this);
+  hasSavedRun = true;
+  lastAutosaveTick = getTick();
+  autosave.submit(savedRun);
+}
+
+// Tras el tick
+void Game::autosaveAfterTick() {
+  if (!autosaveActive)
+    return;
+  if (state != GameState::Playing) {
+    // Victoria o derrota: esta partida ya no se puede continuar
+    autosaveActive = false;
+    hasSavedRun = false;
+    autosave.erase();
+  } else if (getTick() - lastAutosaveTick >= AUTOSAVE_TICKS) {
+    autosaveRun();
+  }
+}
+
+void Game::continueRun() {
+  if (!hasSavedRun)
+    return;
+  saveRecording(); // La anterior, si quedó a medias
+
+  // onSimEvent(StateRestored) recoloca la cámara y reactiva el autoguardado
+  if (!loadSnapshot(savedRun.snapshot)) {
+    // RunSave::load() ya comprobó la foto; si aun así falla, el guardado
+    // no sirve (el estado no se ha tocado) y se vuelve al menú
+    std::cerr << _("[SAVE] No se pudo continuar la partida guardada\n");
+    hasSavedRun = false;
+    autosaveActive = false;
+    autosave.erase();
+    state = GameState::MainMenu;
+    mainMenuSelection = 0;
+    return;
+  }
+
+  // La foto trae la ventana de cuando se guardó; se dibuja en la de ahora
+  setViewport(GetScreenWidth(), GetScreenHeight());
+  if (currentLevel != maxLevels)
+    centerCameraOnPlayer();
+
+  // La grabación empezó en otra sesión: el resto de la partida no se graba
+  recordingActive = false;
+  quickSave.clear();
+  levelStart.clear();
+  std::cout << _("[SAVE] Continuando en el nivel ") << currentLevel
+            << " (tick " << getTick() << ")\n";
+}
@@ -45,22 +45,11 @@ void Game::renderMainMenu()
     // Texto Principal (Rojo) encima de todo
     DrawText(title, titleX, titleY, titleSize, RED);
 
-    // 2. Dimensiones de los botones
-    // Calculamos ancho (bw) y alto (bh) relativos a la pantalla, con límites (clamp)
-    // para que no se vean ni diminutos en 4k ni enormes en 800x600.
-    int bw = (int)std::round(screenW * 0.46f);
-    bw = std::clamp(bw, 360, 720);
-
-    int bh = (int)std::round(screenH * 0.12f);
-    bh = std::clamp(bh, 80, 128);
-
-    int startY = (int)std::round(screenH * 0.52f); // Empiezan un poco más abajo del centro
-    int gap = (int)std::round(screenH * 0.045f);   // Espacio vertical entre botones
-
-    // Definición de las áreas de colisión (Rectangles)
-    Rectangle playBtn = {(float)((screenW - bw) / 2), (float)startY, (float)bw, (float)bh};
-    Rectangle readBtn = {(float)((screenW - bw) / 2), (float)(startY + bh + gap), (float)bw, (float)bh};
-    Rectangle quitBtn = {(float)((screenW - bw) / 2), (float)(startY + (bh + gap) * 2), (float)bw, (float)bh};
+    // 2. Botones (los mismos rectángulos usa handleMainMenuInput)
+    Rectangle playBtn = mainMenuButtonRect(0);
+    Rectangle readBtn = mainMenuButtonRect(1);
+    Rectangle hordeBtn = mainMenuButtonRect(2);
+    Rectangle quitBtn = mainMenuButtonRect(3);
 
     Vector2 mp = GetMousePosition();
 
@@ -188,20 +177,17 @@ void Game::renderMainMenu()
     };
 
     // 4. Dibujado de elementos
+    if (hasSavedRun)
+        drawPixelButton(mainMenuButtonRect(MENU_CONTINUE),
+                        TextFormat(_("CONTINUAR (NIVEL %d)"), savedRun.level), MENU_CONTINUE);
     drawPixelButton(playBtn, _("JUGAR"), 0);
     drawPixelButton(readBtn, _("TUTORIAL"), 1);
-    drawPixelButton(quitBtn, _("SALIR"), 2);
+    drawPixelButton(hordeBtn, _("MODO HORDA"), 2);
+    drawPixelButton(quitBtn, _("SALIR"), 3);
 
     // 5. Botón de ajustes en la esquina inferior derecha
-    // Calculamos un tamaño proporcional a la altura de la pantalla con límites para no desaparecer en resoluciones grandes o pequeñas.
-    int settingsSize = (int)std::round(screenH * 0.08f);
-    if (settingsSize < 48)
-        settingsSize = 48;
-    if (settingsSize > 120)
-        settingsSize = 120;
-    Rectangle settingsRect = {(float)(screenW - settingsSize - 20), (float)(screenH - settingsSize - 20), (float)settingsSize, (float)settingsSize};
-    // Dibujamos el botón de ajustes usando el mismo estilo de botones. Como índice usamos 3 para que no interfiera con la selección de teclado.
-    drawPixelButton(settingsRect, _("AJUSTES"), 3);
+    // Usamos el índice 4 (el último) para que la selección por teclado pase por él al final.
+    drawPixelButton(mainMenuButtonRect(4), _("AJUSTES"), 4);
 
     // Si el usuario abrió la guía, dibujamos el overlay encima de todo
     if (showHelp)
@@ -210,6 +196,59 @@ void Game::renderMainMenu()
     EndDrawing();
 }
 
+// Geometría del menú principal
+// Índices 0..3: botones centrales (jugar, tutorial, horda, salir).
+// Índice 4: botón de ajustes en la esquina inferior derecha.
+// MENU_CONTINUE: encima de jugar, solo si hay partida guardada (los demás
+// bajan una fila y la columna empieza más arriba para que quepan cinco).
+Rectangle Game::mainMenuButtonRect(int index) const
+{
+    if (index == 4)
+    {
+        // Tamaño proporcional a la altura de la pantalla, con límites para no
+        // desaparecer en resoluciones grandes o pequeñas.
+        int settingsSize = (int)std::round(screenH * 0.08f);
+        settingsSize = std::clamp(settingsSize, 48, 120);
+        return {(float)(screenW - settingsSize - 20), (float)(screenH - settingsSize - 20),
+                (float)settingsSize, (float)settingsSize};
+    }
+
+    // Ancho (bw) y alto (bh) relativos a la pantalla, con límites (clamp)
+    // para que no se vean ni diminutos en 4k ni enormes en 800x600.
+    int bw = (int)std::round(screenW * 0.46f);
+    bw = std::clamp(bw, 360, 720);
+
+    int bh = (int)std::round(screenH * 0.10f);
+    bh = std::clamp(bh, 64, 110);
+
+    int startY = (int)std::round(screenH * (hasSavedRun ? 0.33f : 0.40f)); // Cuatro botones: empiezan algo más arriba
+    int gap = (int)std::round(screenH * 0.035f);   // Espacio vertical entre botones
+
+    int row = index;
+    if (hasSavedRun)
+        row = (index == MENU_CONTINUE) ? 0 : index + 1;
+
+    return {(float)((screenW - bw) / 2), (float)(startY + (bh + gap) * row), (float)bw, (float)bh};
+}
+
+// Navegación del menú principal en el orden de pantalla: continuar (si hay
+// partida guardada), jugar, tutorial, horda, salir y ajustes
+void Game::stepMainMenu(int dir)
+{
+    static constexpr int order[MAIN_MENU_ITEMS] = {MENU_CONTINUE, 0, 1, 2, 3, 4};
+    const int first = hasSavedRun ? 0 : 1;
+    const int n = MAIN_MENU_ITEMS - first;
+
+    int pos = first;
+    for (int i = first; i < MAIN_MENU_ITEMS; ++i)
+    {
+        if (order[i] == mainMenuSelection)
+            pos = i;
+    }
+    pos = first + ((pos - first + dir) % n + n) % n;
+    mainMenuSelection = order[pos];
+}
+
 // Renderizado del overlay (modal) de ayuda
 void Game::renderHelpOverlay()
 {
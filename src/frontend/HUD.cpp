@@ -294,5 +294,9 @@ void HUD::drawVictory(const Game &game) const {
 
 // Pantalla de Derrota
 void HUD::drawGameOver(const Game &game) const {
-    DrawCenteredOverlay(game, _("GAME OVER"), RED, _("Pulsa R para comenzar de nuevo"));
+    // Con foto del principio del nivel se puede reintentar sin regenerarlo
+    const char *tip = game.canRetryLevel()
+                          ? _("R: comenzar de nuevo   L: reintentar el nivel")
+                          : _("Pulsa R para comenzar de nuevo");
+    DrawCenteredOverlay(game, _("GAME OVER"), RED, tip);
 }
@@ -0,0 +1,94 @@
+#include "Game.hpp"
+#include "raylib.h"
+
+// Renderizado de Ítems
+void Game::drawItems() const {
+    // Lambda para Niebla de Guerra (FOV, "Fog of War")
+    // Evita que el jugador vea ítems a través de paredes o zonas no exploradas
+    auto isVisible = [&](int x, int y) {
+        if (map.fogEnabled()) return map.isVisible(x, y);
+        return true;
+    };
+
+    // UI adaptativa (input contextual)
+    // Detectamos qué dispositivo usó el jugador por última vez para mostrar
+    // el prompt correcto: "(A)" para mando o "E" para Teclado.
+    const char* promptText = (lastInput == InputDevice::Gamepad) ? "(A)" : "E";
+
+    for (const auto &it : items) {
+        // 1. Si está en la niebla, no se dibuja (anti-cheat visual)
+        if (!isVisible(it.tile.x, it.tile.y)) continue;
+        
+        // 2. Dibujar el sprite del objeto en el suelo
+        drawItemSprite(it);
+        
+        // 3. UI flotante (Solo si el jugador está encima)
+        // La Llave Maestra no necesita texto porque se recoge sola (Auto-Pickup).
+        if (it.tile.x == px && it.tile.y == py && it.type != ItemType::LlaveMaestra) {
+            // Centrado del texto sobre el tile
+            int txtW = MeasureText(promptText, 10);
+            int txtX = it.tile.x * tileSize + (tileSize - txtW) / 2;
+            int txtY = it.tile.y * tileSize - 12; // Flotando un poco arriba
+
+            // Renderizado con sombra simple (negro abajo derecha) para legibilidad
+            DrawText(promptText, txtX + 1, txtY + 1, 10, BLACK); 
+            DrawText(promptText, txtX, txtY, 10, YELLOW);
+        }
+    }
+}
+
+// Selección de sprites (Visuales)
+void Game::drawItemSprite(const ItemSpawn &it) const {
+    const Texture2D *tex = nullptr;
+
+    switch (it.type) {
+        case ItemType::LlaveMaestra:        tex = &itemSprites.keycard; break;
+        case ItemType::Escudo:              tex = &itemSprites.shield;  break;
+        
+        // Mismo sprite para pilas buenas/malas (Factor riesgo/sorpresa)
+        case ItemType::PilaBuena:
+        case ItemType::PilaMala:            tex = &itemSprites.pila;    break;
+        
+        case ItemType::Gafas3DBuenas:
+        case ItemType::Gafas3DMalas:        tex = &itemSprites.glasses; break;
+        case ItemType::BateriaVidaExtra:    tex = &itemSprites.battery; break;
+
+        // Visualización de Tiers de Armas
+        case ItemType::EspadaPickup: {
+            // Lógica visual inteligente:
+            // Muestra el sprite del nivel que OBTENDRÁS, no necesariamente el que es el ítem.
+            // Ej: Si tengo nivel 0 y el item es nivel 3, veo una espada de nivel 1 (azul).
+            // Esto comunica "Este objeto te subirá al siguiente nivel".
+            int displayTier = std::min(it.tierSugerido, runCtx.espadaMejorasObtenidas + 1);
+            displayTier = std::clamp(displayTier, 1, 3); // Asegurar rango válido de array/texturas
+            
+            tex = (displayTier == 1) ? &itemSprites.swordBlue
+                 : (displayTier == 2) ? &itemSprites.swordGreen
+                                      : &itemSprites.swordRed;
+            break;
+        }
+        case ItemType::PistolaPlasmaPickup: {
+            int displayTier = std::min(it.tierSugerido, runCtx.plasmaMejorasObtenidas + 1);
+            displayTier = std::clamp(displayTier, 1, 2);
+            tex = (displayTier == 1) ? &itemSprites.plasma1 : &itemSprites.plasma2;
+            break;
+        }
+    }
+
+    // Coordenadas de pantalla
+    const int pxl = it.tile.x * tileSize;
+    const int pyl = it.tile.y * tileSize;
+
+    if (tex && tex->id != 0) {
+        // Dibujado seguro con textura
+        Rectangle src{0, 0, (float)tex->width, (float)tex->height};
+        Rectangle dst{(float)pxl, (float)pyl, (float)tileSize, (float)tileSize};
+        Vector2 origin{0, 0};
+        DrawTexturePro(*tex, src, dst, origin, 0.0f, WHITE);
+    }
+    else {
+        // Fallback: Cuadrado blanco si falta la textura (Debug visual)
+        DrawRectangle(pxl, pyl, tileSize, tileSize, WHITE);
+        DrawRectangleLines(pxl, pyl, tileSize, tileSize, BLACK);
+    }
+}
@@ -1,9 +1,11 @@
 #include "Game.hpp"
 #include "GettextCompat.hpp"
+#include "InputRecording.hpp"
 #include <cstdlib>    // strtoul (String to Unsigned Long)
 #include <filesystem> // C++17: Manejo moderno de rutas y directorios
 #include <iostream>
 #include <locale.h>
+#include <string>
 
 // Helper: Verificación segura de directorios
 // Comprueba si una ruta existe y es una carpeta.
@@ -14,7 +16,41 @@ static bool dirExists(const std::filesystem::path &p) {
   return std::filesystem::exists(p, ec) && std::filesystem::is_directory(p, ec);
 }
 
+// Repetición sin ventana ni audio, tan rápido como dé la CPU: comprueba que
+// la grabación sigue dando la misma partida (keyframes) y mide la simulación.
+// Devuelve el código de salida: 0 si cuadra, 1 si no se pudo leer, 2 si se
+// desincronizó.
+static int runHeadlessReplay(const std::string &path) {
+  InputRecording rec;
+  if (!rec.load(path)) {
+    std::cerr << "[ERR] No se pudo leer la grabación: " << path << "\n";
+    return 1;
+  }
+
+  GameSim sim;
+  sim.startRun(rec.setup());
+  InputRecording::Cursor cursor(rec);
+  const ReplayStats st = replayRecording(sim, cursor, rec);
+
+  const double tps = st.ms > 0.0 ? st.ticks / (st.ms / 1000.0) : 0.0;
+  std::cout << "[REPLAY] " << st.ticks << "/" << rec.ticks() << " ticks en "
+            << st.ms << " ms (" << (long long)tps << " ticks/s), tick más lento "
+            << st.worstTickMs << " ms\n";
+  std::cout << "[REPLAY] keyframes comprobados " << st.keyframesChecked
+            << ", desincronizados " << st.desyncs << "\n";
+  if (st.desyncs > 0) {
+    std::cerr << "[REPLAY] Primera desincronización en el tick "
+              << st.firstDesync << "\n";
+    return 2;
+  }
+  return 0;
+}
+
 int main(int argc, char **argv) {
+  // Las rutas relativas de la línea de comandos (--replay) son respecto a
+  // donde se lanzó el juego, no a la carpeta de assets
+  const std::filesystem::path launchDir = std::filesystem::current_path();
+
   // 1. Configuración del directorio de trabajo (CWD)
   // Objetivo: Asegurar que cuando el juego pida cargar "sprites/player.png",
   // el sistema operativo sepa dónde buscar, independientemente de si ejecutamos
@@ -84,18 +120,56 @@ int main(int argc, char **argv) {
   // Si se ejecuta "./roguebot 12345", siempre se generará la misma mazmorra.
   // Si se ejecuta "./roguebot", será aleatoria cada vez.
 
+  // "--horde" / "--horde=N" arranca el modo horda (prueba de estrés) con N
+  // enemigos (por defecto HORDE_DEFAULT_ENEMIES). El orden da igual:
+  // "./roguebot 12345 --horde=5000" también vale.
+  // "--replay=archivo.rbr" reproduce una partida grabada (se graban solas en
+  // ~/.config/roguebot/replays); con "--headless" va sin ventana, a máxima
+  // velocidad, y solo informa.
   unsigned seed = 0;
-  if (argc > 1) {
-    // Convertir argumento de texto a número (base 10)
-    seed = static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10));
+  bool hasSeed = false;
+  bool horde = false;
+  int hordeCount = 0; // 0 = por defecto
+  std::string replayPath;
+  bool headless = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--horde" || arg.rfind("--horde=", 0) == 0) {
+      horde = true;
+      if (arg.size() > 8)
+        hordeCount = std::atoi(arg.c_str() + 8);
+    } else if (arg.rfind("--replay=", 0) == 0) {
+      fs::path p(arg.substr(9));
+      replayPath = (p.is_relative() ? launchDir / p : p).string();
+    } else if (arg == "--headless") {
+      headless = true;
+    } else {
+      // Convertir argumento de texto a número (base 10)
+      seed = static_cast<unsigned>(std::strtoul(argv[i], nullptr, 10));
+      hasSeed = true;
+    }
+  }
+  if (!replayPath.empty() && headless)
+    return runHeadlessReplay(replayPath);
+
+  if (hasSeed)
     std::cout << "[CLI] Seed fija: " << seed << "\n";
-  } else {
+  else
     std::cout << "[CLI] Sin seed -> aleatoria por ejecución\n";
-  }
 
   // 3. Inicio del juego
   // Pasamos la seed al constructor para inicializar el RNG
   Game g(seed);
+  if (!replayPath.empty()) {
+    if (g.requestReplay(replayPath))
+      std::cout << "[CLI] Repetición: " << replayPath << "\n";
+    else
+      std::cerr << "[ERR] No se pudo leer la grabación: " << replayPath
+                << "\n";
+  } else if (horde) {
+    g.requestHorde(hordeCount);
+    std::cout << "[CLI] Modo horda\n";
+  }
   g.run(); // Bucle principal (Game Loop)
 
   return 0;
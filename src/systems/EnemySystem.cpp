@@ -1,157 +1,15 @@
-#include "Game.hpp"
+#include "GameSim.hpp"
 #include "GameUtils.hpp"
-#include "raylib.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
-#include <random>
+#include <unordered_map>
 #include <vector>
 
-// Renderizado de enemigos
-void Game::drawEnemies() const {
-  // Calculamos la vida máxima para la barra según la dificultad y el nivel.
-  // En modo fácil: 60/80/100; en medio: 70/90/110; en difícil: 100/125/150.
-  int maxHPLevel;
-  switch (difficulty) {
-  case Difficulty::Easy:
-    maxHPLevel = (currentLevel == 1) ? 60 : (currentLevel == 2) ? 80 : 100;
-    break;
-  case Difficulty::Medium:
-    maxHPLevel = (currentLevel == 1) ? 70 : (currentLevel == 2) ? 90 : 110;
-    break;
-  case Difficulty::Hard:
-  default:
-    // Fórmula original: 100 + 25*(nivel-1)
-    maxHPLevel = ENEMY_BASE_HP + (currentLevel - 1) * 25;
-    break;
-  }
-  float maxHP = static_cast<float>(maxHPLevel);
-
-  auto visible = [&](int x, int y) {
-    return !map.fogEnabled() || map.isVisible(x, y);
-  };
-
-  for (size_t i = 0; i < enemies.size(); ++i) {
-    const auto &e = enemies[i];
-    if (!visible(e.getX(), e.getY()))
-      continue;
-
-    const Texture2D *tex = nullptr;
-
-    EnemyFacing face =
-        (i < enemyFacing.size()) ? enemyFacing[i] : EnemyFacing::Down;
-
-    // Alternamos frame 1 / frame 2 con el tiempo de animación del enemigo
-    // (no depende de si se mueve o no, pero te asegura que NUNCA se quedará en
-    // idle “por error de assets”)
-    bool frame2 = ((int)std::floor(e.getAnimTime() * 4.0f) % 2) == 1;
-
-    // Elegimos set según tipo
-    const bool isEnemy2 = (e.getType() == Enemy::Shooter);
-
-    if (!isEnemy2) {
-      switch (face) {
-      case EnemyFacing::Up:
-        tex = frame2 ? &itemSprites.enemy1Up2 : &itemSprites.enemy1Up1;
-        break;
-      case EnemyFacing::Down:
-        tex = frame2 ? &itemSprites.enemy1Down2 : &itemSprites.enemy1Down1;
-        break;
-      case EnemyFacing::Left:
-        tex = frame2 ? &itemSprites.enemy1Left2 : &itemSprites.enemy1Left1;
-        break;
-      case EnemyFacing::Right:
-        tex = frame2 ? &itemSprites.enemy1Right2 : &itemSprites.enemy1Right1;
-        break;
-      }
-    } else {
-      switch (face) {
-      case EnemyFacing::Up:
-        tex = frame2 ? &itemSprites.enemy2Up2 : &itemSprites.enemy2Up1;
-        break;
-      case EnemyFacing::Down:
-        tex = frame2 ? &itemSprites.enemy2Down2 : &itemSprites.enemy2Down1;
-        break;
-      case EnemyFacing::Left:
-        tex = frame2 ? &itemSprites.enemy2Left2 : &itemSprites.enemy2Left1;
-        break;
-      case EnemyFacing::Right:
-        tex = frame2 ? &itemSprites.enemy2Right2 : &itemSprites.enemy2Right1;
-        break;
-      }
-    }
-
-    const float xpx = (float)(e.getX() * tileSize);
-    const float ypx = (float)(e.getY() * tileSize);
-
-    Color tint = WHITE;
-
-    // 1. Respiración (Squash & Stretch)
-    // Usamos el seno del tiempo para calcular una escala Y que oscila entre
-    // 0.95 y 1.05
-    float breathe = 1.0f + sinf(e.getAnimTime()) * 0.05f;
-
-    // 2. Origen de rotación
-    // Queremos que roten desde sus "pies" (centro-abajo), no desde la esquina
-    // El centro del tile es (16, 16). Los pies son (16, 32).
-    Vector2 origin = {(float)tileSize / 2.0f, (float)tileSize};
-
-    // 3. Destino ajustado
-    // Como rotamos desde los pies, la posición Y de destino debe ser la base
-    // del tile
-    Rectangle dest = {
-        xpx + tileSize / 2.0f,    // Centro X
-        ypx + tileSize,           // Pies Y
-        (float)tileSize,          // Ancho
-        (float)tileSize * breathe // Alto (Respirando)
-    };
-
-    if (tex && tex->id != 0) {
-      Rectangle src{0, 0, (float)tex->width, (float)tex->height};
-      // Usamos la rotación (tilt)
-      DrawTexturePro(*tex, src, dest, origin, e.getTilt(), tint);
-    } else {
-      // Fallback a idle del tipo correspondiente
-      const Texture2D &idle = (e.getType() == Enemy::Shooter)
-                                  ? itemSprites.enemy2Idle
-                                  : itemSprites.enemy1Idle;
-      if (idle.id != 0) {
-        Rectangle src{0, 0, (float)idle.width, (float)idle.height};
-        DrawTexturePro(idle, src, dest, origin, e.getTilt(), tint);
-      } else {
-        e.draw(tileSize);
-      }
-    }
-
-    // Flash blanco
-    if (i < enemyFlashTimer.size() && enemyFlashTimer[i] > 0.0f) {
-      // Dibujamos el cuadrado simple encima porque rotar un rectángulo sin
-      // textura es complejo en Raylib simple Pero como es un flash rápido, no
-      // se nota la discrepancia
-      DrawRectangle((int)xpx, (int)ypx, tileSize, tileSize, Fade(WHITE, 0.7f));
-    }
-
-    // Barra de vida
-    // Barra de vida
-    if (i < enemyHP.size()) {
-      const int w = tileSize, h = 4;
-      const int x = static_cast<int>(xpx);
-      const int y = static_cast<int>(ypx) - (h + 2);
-
-      // Calculamos la fracción de vida usando maxHP como denominador
-      int hpw = static_cast<int>(std::lround(w * (enemyHP[i] / maxHP)));
-      hpw = std::clamp(hpw, 0, w);
-
-      DrawRectangle(x, y, w, h, Color{60, 60, 60, 200});
-      DrawRectangle(x, y, hpw, h, RED);
-      DrawRectangleLines(x, y, w, h, BLACK);
-    }
-  }
-}
-
 // Lógica de ataque enemigo
-void Game::enemyTryAttackFacing() {
-  for (size_t i = 0; i < enemies.size(); ++i) {
+void GameSim::enemyTryAttackFacing() {
+  // Solo los enemigos activos pueden estar adyacentes al jugador
+  for (size_t i : activeEnemies) {
     const int ex = enemies[i].getX();
     const int ey = enemies[i].getY();
 
@@ -174,18 +32,18 @@ void Game::enemyTryAttackFacing() {
       continue;
 
     // 3. Comprobación de Cooldowns
-    // - enemyAtkCD: El enemigo debe haber descansado de su último golpe.
-    // - damageCooldown: El jugador no debe estar en periodo de invencibilidad
+    // - enemyAtkReadyAt: El enemigo debe haber descansado de su último golpe.
+    // - invulnUntil: El jugador no debe estar en periodo de invencibilidad
     // tras un golpe.
-    if (i < enemyAtkCD.size() && enemyAtkCD[i] <= 0.0f &&
-        damageCooldown <= 0.0f) {
+    if (i < enemyAtkReadyAt.size() && simTime >= enemyAtkReadyAt[i] &&
+        !isInvulnerable()) {
       // Impacto
       takeDamage(ENEMY_CONTACT_DMG);
 
       // Reiniciar temporizadores
-      enemyAtkCD[i] = ENEMY_ATTACK_COOLDOWN;
-      damageCooldown =
-          DAMAGE_COOLDOWN; // Otorga invencibilidad breve al jugador
+      enemyAtkReadyAt[i] = simTime + ENEMY_ATTACK_COOLDOWN;
+      invulnUntil =
+          simTime + DAMAGE_COOLDOWN; // Otorga invencibilidad breve al jugador
 
       std::cout << "[EnemyAtk] Enemy at (" << ex << "," << ey
                 << ") hit Player!\n";
@@ -194,8 +52,9 @@ void Game::enemyTryAttackFacing() {
 }
 
 // Generación de enemigos (Spawning)
-void Game::spawnEnemiesForLevel() {
-  enemies.clear();
+void GameSim::spawnEnemiesForLevel() {
+  clearEnemies(); // También saca de la cola de turnos a los anteriores
+  enemyDensity = 0.0f;
   const int n = enemiesPerLevel(currentLevel); // Cantidad según dificultad
   const int minDistTiles =
       8; // Distancia de seguridad para no aparecer encima del jugador
@@ -231,8 +90,7 @@ void Game::spawnEnemiesForLevel() {
     return; // Mapa demasiado pequeño o lleno
 
   // 2. Selección aleatoria
-  std::uniform_int_distribution<int> dist(0, (int)candidates.size() - 1);
-  std::uniform_int_distribution<int> typeDist(0, 100); // Probabilidad 0-100
+  const int lastCandidate = (int)candidates.size() - 1;
 
   // Lista de posiciones ocupadas para evitar superponer enemigos entre sí o con
   // items
@@ -247,51 +105,435 @@ void Game::spawnEnemiesForLevel() {
     return false;
   };
 
+  std::vector<PopulationStreamer::Record> placed;
+  placed.reserve(n);
+
   for (int i = 0; i < n; ++i) {
     // Intentamos hasta 200 veces encontrar un hueco libre de la lista de
     // candidatos
     for (int tries = 0; tries < 200; ++tries) {
-      const auto &p = candidates[dist(rng)];
+      const auto &p = candidates[levelRng.range(0, lastCandidate)];
       if (!isUsed(p.x, p.y)) {
-        // Decidir tipo de enemigo
-        // Nivel 1: 100% Melee
-        // Nivel 2+: 30% Shooter
-        Enemy::Type t = Enemy::Melee;
-        if (currentLevel >= 2 && typeDist(rng) < 30) {
-          t = Enemy::Shooter;
-        }
-
-        enemies.emplace_back(p.x, p.y, t); // Creamos enemigo con tipo
+        const Enemy::Type t = rollEnemyType(); // Melee / Shooter
+
+        // Se apunta como registro: el streaming decide cuándo cobra vida
+        PopulationStreamer::Record r;
+        r.x = static_cast<int16_t>(p.x);
+        r.y = static_cast<int16_t>(p.y);
+        r.type = static_cast<uint8_t>(t);
+        placed.push_back(r);
         used.push_back(p);
         break;
       }
     }
   }
 
-  // 3. Escalado de dificultad (HP)
+  // 3. Mapas mayores que el de referencia (pantallas grandes): la misma
+  // densidad que en uno normal. Los n colocados no llegan; el resto sale
+  // de las cuotas por sector, repartido por el suelo libre.
+  const int area = map.width() * map.height();
+  if (area > ENEMY_REFERENCE_MAP_TILES) {
+    const float target =
+        static_cast<float>(n) * area / ENEMY_REFERENCE_MAP_TILES;
+    enemyDensity = std::max(0.0f, target - static_cast<float>(placed.size())) /
+                   static_cast<float>(candidates.size());
+  }
+
+  // 4. Población por streaming: todos quedan aparcados en su sector y los
+  // cercanos vuelven a la vida enseguida. Con enemyDensity > 0 los sectores
+  // además se rellenan al entrar en rango.
+  const int hp = enemyHpForLevel();
+  population.reset(map, levelSeed ^ 0x9E3779B9u, enemyDensity, ENEMY_LIVE_CAP);
+  for (auto &r : placed) {
+    r.hp = r.maxHp = hp;
+    population.park(r);
+  }
+  reserveEnemySlots(ENEMY_LIVE_CAP);
+  streamPopulation();
+}
+
+// Modo horda (prueba de estrés)
+int GameSim::hordeMapSide() const {
+  // Lado del mapa cuadrado que da ~HORDE_TILES_PER_ENEMY casillas por enemigo
+  const int n = hordeCount > 0 ? hordeCount : HORDE_DEFAULT_ENEMIES;
+  const int side = static_cast<int>(
+      std::ceil(std::sqrt(static_cast<double>(n) * HORDE_TILES_PER_ENEMY)));
+  return std::min(HORDE_MAX_MAP_SIDE, side);
+}
+
+void GameSim::spawnHorde() {
+  // Sin streaming: toda la horda está viva a la vez para medir de verdad
+  // IA, proyectiles y render. Solo el LOD activo/dormido reparte el coste.
+  clearEnemies();
+  const int n = hordeCount > 0 ? hordeCount : HORDE_DEFAULT_ENEMIES;
+  const int minDistTiles = 8;
+  const int W = map.width(), H = map.height();
+  auto [exitX, exitY] = map.findExitTile();
+
+  // Ocupación en rejilla: con miles de enemigos la lista de 'used' de
+  // spawnEnemiesForLevel sería cuadrática
+  std::vector<uint8_t> used(static_cast<size_t>(W) * H, 0);
+  auto mark = [&](int x, int y) {
+    if (x >= 0 && y >= 0 && x < W && y < H)
+      used[static_cast<size_t>(y) * W + x] = 1;
+  };
+  mark(px, py);
+  mark(exitX, exitY);
+  for (const auto &it : items)
+    mark(it.tile.x, it.tile.y);
+
+  reserveEnemySlots(static_cast<size_t>(n));
+  const int hp = enemyHpForLevel();
+  int placed = 0;
+  for (int tries = 0; placed < n && tries < n * 20; ++tries) {
+    const int x = levelRng.range(0, W - 1);
+    const int y = levelRng.range(0, H - 1);
+    if (!map.isWalkable(x, y) || used[static_cast<size_t>(y) * W + x])
+      continue;
+    if (std::max(std::abs(x - px), std::abs(y - py)) < minDistTiles)
+      continue;
+    const Enemy::Type t =
+        levelRng.range(0, 99) < HORDE_SHOOTER_PCT ? Enemy::Shooter : Enemy::Melee;
+    spawnEnemyAt(x, y, t, hp, hp, EnemyFacing::Down);
+    mark(x, y);
+    ++placed;
+  }
+  std::cout << "[Horde] " << placed << " enemigos en mapa " << W << "x" << H
+            << "\n";
+  refreshEnemyActivity();
+}
+
+// Escalado de dificultad (HP)
+int GameSim::enemyHpForLevel() const {
   // Ajustamos la vida base de los enemigos según la dificultad seleccionada.
-  int hpForLevel;
   switch (difficulty) {
   case Difficulty::Easy:
     // Fácil: menos enemigos y vida reducida por nivel (60, 80, 100)
-    hpForLevel = (currentLevel == 1) ? 60 : (currentLevel == 2) ? 80 : 100;
-    break;
+    return (currentLevel == 1) ? 60 : (currentLevel == 2) ? 80 : 100;
   case Difficulty::Medium:
     // Medio: vida intermedia (70, 90, 110)
-    hpForLevel = (currentLevel == 1) ? 70 : (currentLevel == 2) ? 90 : 110;
-    break;
+    return (currentLevel == 1) ? 70 : (currentLevel == 2) ? 90 : 110;
   case Difficulty::Hard:
   default:
     // Difícil: comportamiento original (100, 125, 150)
-    hpForLevel = ENEMY_BASE_HP + (currentLevel - 1) * 25;
-    break;
+    return ENEMY_BASE_HP + (currentLevel - 1) * 25;
+  }
+}
+
+Enemy::Type GameSim::rollEnemyType() {
+  // Nivel 1: 100% Melee. Nivel 2+: 30% Shooter
+  return (currentLevel >= 2 && spawnRng.range(0, 100) < 30) ? Enemy::Shooter
+                                                              : Enemy::Melee;
+}
+
+// Pool de enemigos vivos
+void GameSim::reserveEnemySlots(size_t n) {
+  // Los vectores paralelos se reservan una vez por nivel al tamaño máximo
+  // del conjunto vivo: entrar y salir del streaming nunca realoja.
+  enemies.reserve(n);
+  enemyFacing.reserve(n);
+  enemyHP.reserve(n);
+  enemyMaxHP.reserve(n);
+  enemyAtkReadyAt.reserve(n);
+  enemyShootReadyAt.reserve(n);
+  enemyFlashUntil.reserve(n);
+  enemyAwake.reserve(n);
+  enemyProvoked.reserve(n);
+  enemyActor.reserve(n);
+  enemySeesPlayer.reserve(n);
+}
+
+const SpatialGrid &GameSim::enemyOccupancy() {
+  // O(enemigos) al reconstruir; vaciar la rejilla es solo cambiar de sello
+  if (enemyGridDirty || enemyGrid.width() != map.width() ||
+      enemyGrid.height() != map.height()) {
+    enemyGrid.resize(map.width(), map.height());
+    for (size_t i = 0; i < enemies.size(); ++i)
+      enemyGrid.insert(static_cast<int>(i), enemies[i].getX(),
+                       enemies[i].getY());
+    enemyGridDirty = false;
+  }
+  return enemyGrid;
+}
+
+void GameSim::spawnEnemyAt(int x, int y, Enemy::Type t, int hp, int maxHp,
+                        EnemyFacing facing) {
+  // Añade a TODOS los vectores paralelos a la vez (sin refrescar el LOD)
+  enemies.emplace_back(x, y, t);
+  enemyFacing.push_back(facing);
+  enemyHP.push_back(hp);
+  enemyMaxHP.push_back(maxHp);
+  enemyAtkReadyAt.push_back(0.0);
+  enemyShootReadyAt.push_back(0.0); // Pueden disparar ya
+  enemyFlashUntil.push_back(0.0);
+  enemyAwake.push_back(0);
+  enemyProvoked.push_back(0);
+  enemyActor.push_back(ActorScheduler::INVALID_ACTOR);
+  enemyGridDirty = true;
+}
+
+void GameSim::streamPopulation() {
+  // Se llama en cada paso del jugador (y al cargar el nivel). Sin streaming
+  // activo (tutorial, boss) solo reparte activos/dormidos.
+  if (!population.active()) {
+    refreshEnemyActivity();
+    return;
+  }
+
+  // Los golpes pendientes apuntan a índices: se aplican antes de aparcar
+  if (!damageEvents.empty())
+    resolveDamage();
+
+  // 1. Aparcar los lejanos (los provocados siguen persiguiendo)
+  enemyDoomed.assign(enemies.size(), 0);
+  bool anyParked = false;
+  for (size_t i = 0; i < enemies.size(); ++i) {
+    const int ex = enemies[i].getX(), ey = enemies[i].getY();
+    if (enemyProvoked[i] || !population.shouldPark(px, py, ex, ey))
+      continue;
+    PopulationStreamer::Record r;
+    r.x = static_cast<int16_t>(ex);
+    r.y = static_cast<int16_t>(ey);
+    r.type = static_cast<uint8_t>(enemies[i].getType());
+    r.facing = static_cast<uint8_t>(enemyFacing[i]);
+    r.hp = enemyHP[i];
+    r.maxHp = enemyMaxHP[i];
+    population.park(r);
+    enemyDoomed[i] = 1;
+    anyParked = true;
+  }
+  if (anyParked)
+    eraseEnemySlots(enemyDoomed);
+
+  // 2. Entrar en rango: aparcados que vuelven y cuota de densidad
+  population.update(map, px, py, enemies.size(), streamRestore, streamFresh);
+
+  auto occupied = [&](int x, int y) {
+    if (x == px && y == py)
+      return true;
+    for (const auto &e : enemies)
+      if (e.getX() == x && e.getY() == y)
+        return true;
+    return false;
+  };
+
+  for (const auto &r : streamRestore) {
+    if (occupied(r.x, r.y)) {
+      population.park(r); // Ya lo intentará en otro paso
+      continue;
+    }
+    spawnEnemyAt(r.x, r.y, static_cast<Enemy::Type>(r.type), r.hp, r.maxHp,
+                 static_cast<EnemyFacing>(r.facing));
+  }
+
+  const int hp = enemyHpForLevel();
+  for (const auto &t : streamFresh) {
+    bool onItem = false;
+    for (const auto &it : items)
+      if (it.tile.x == t.first && it.tile.y == t.second)
+        onItem = true;
+    if (onItem || occupied(t.first, t.second))
+      continue;
+    spawnEnemyAt(t.first, t.second, rollEnemyType(), hp, hp,
+                 EnemyFacing::Down);
+  }
+
+  refreshEnemyActivity();
+}
+
+// Nivel de detalle de la IA (LOD)
+void GameSim::refreshEnemyActivity() {
+  // Se llama cuando el jugador cambia de casilla o cambia la población.
+  // Recorre la lista una sola vez (comparación entera, sin raíces) y
+  // reconstruye la lista de índices activos que usan los bucles por frame.
+  const int r = ENEMY_ACTIVE_RADIUS_TILES;
+  const int r2 = r * r;
+
+  enemyAwake.resize(enemies.size(), 0);
+  enemyProvoked.resize(enemies.size(), 0);
+  enemyActor.resize(enemies.size(), ActorScheduler::INVALID_ACTOR);
+  activeEnemies.clear();
+
+  for (size_t i = 0; i < enemies.size(); ++i) {
+    const int dx = enemies[i].getX() - px;
+    const int dy = enemies[i].getY() - py;
+    const bool near = (dx * dx + dy * dy) <= r2;
+
+    // Un enemigo provocado sigue activo aunque el jugador se aleje
+    enemyAwake[i] = (near || enemyProvoked[i]) ? 1 : 0;
+
+    // Solo los activos ocupan sitio en la cola de turnos
+    if (enemyAwake[i]) {
+      activeEnemies.push_back(i);
+      if (enemyActor[i] == ActorScheduler::INVALID_ACTOR)
+        enemyActor[i] = turns.add(enemySpeed(i), static_cast<uint32_t>(i));
+    } else if (enemyActor[i] != ActorScheduler::INVALID_ACTOR) {
+      turns.remove(enemyActor[i]);
+      enemyActor[i] = ActorScheduler::INVALID_ACTOR;
+    }
+  }
+}
+
+void GameSim::eraseEnemySlots(const std::vector<uint8_t> &doomed) {
+  // Compactación estable de todos los vectores paralelos a la vez: O(n)
+  // aunque mueran muchos en el mismo frame (erase uno a uno sería O(n·k)).
+  const size_t n = enemies.size();
+  auto gone = [&](size_t i) { return i < doomed.size() && doomed[i]; };
+
+  for (size_t i = 0; i < n && i < enemyActor.size(); ++i)
+    if (gone(i))
+      turns.remove(enemyActor[i]);
+
+  auto compact = [&](auto &v) {
+    size_t w = 0;
+    for (size_t r = 0; r < v.size(); ++r) {
+      if (gone(r))
+        continue;
+      if (w != r)
+        v[w] = std::move(v[r]);
+      ++w;
+    }
+    v.erase(v.begin() + w, v.end());
+  };
+
+  compact(enemies);
+  compact(enemyFacing);
+  compact(enemyHP);
+  compact(enemyMaxHP);
+  compact(enemyAtkReadyAt);
+  compact(enemyShootReadyAt);
+  compact(enemyFlashUntil);
+  compact(enemyAwake);
+  compact(enemyProvoked);
+  compact(enemyActor);
+  enemyGridDirty = true;
+
+  // Los supervivientes cambian de índice
+  for (size_t j = 0; j < enemyActor.size(); ++j)
+    turns.setTag(enemyActor[j], static_cast<uint32_t>(j));
+}
+
+void GameSim::clearEnemies() {
+  enemies.clear();
+  enemyFacing.clear();
+  enemyHP.clear();
+  enemyMaxHP.clear();
+  enemyAtkReadyAt.clear();
+  enemyShootReadyAt.clear();
+  enemyFlashUntil.clear();
+  enemyAwake.clear();
+  enemyProvoked.clear();
+  activeEnemies.clear();
+
+  for (auto id : enemyActor)
+    turns.remove(id);
+  enemyActor.clear();
+  damageEvents.clear(); // Los índices pendientes ya no valen
+  enemyGridDirty = true;
+
+  population.clear(); // Sin registros aparcados del nivel anterior
+}
+
+// Visión en lote
+void GameSim::updateEnemyVision(const std::vector<size_t> &group) {
+  // Se llama una vez por paso del jugador (por oleada), no por frame. Cada
+  // consulta es un test de bit sobre la sombra cacheada de la casilla.
+  enemySeesPlayer.resize(enemies.size(), 0);
+  const int r = enemyVision.radius();
+
+  for (size_t i : group) {
+    const int ex = enemies[i].getX();
+    const int ey = enemies[i].getY();
+    const int face = static_cast<int>(
+        i < enemyFacing.size() ? enemyFacing[i] : EnemyFacing::Down);
+
+    bool sees = enemyVision.sees(map, ex, ey, face, px, py);
+
+    // Un enemigo provocado (golpeado) sabe dónde estás: basta con el radio
+    if (!sees && i < enemyProvoked.size() && enemyProvoked[i]) {
+      const int dx = px - ex, dy = py - ey;
+      sees = dx * dx + dy * dy <= r * r;
+    }
+    enemySeesPlayer[i] = sees ? 1 : 0;
+  }
+}
+
+// Mapas de influencia
+void GameSim::updateInfluence() {
+  // Fuentes: enemigos activos (los dormidos están fuera de la ventana) y
+  // casillas que cubre el arma del jugador hacia donde mira.
+  std::vector<std::pair<int, int>> crowd;
+  crowd.reserve(activeEnemies.size());
+  for (size_t i : activeEnemies)
+    crowd.push_back({enemies[i].getX(), enemies[i].getY()});
+
+  std::vector<std::pair<int, int>> threat;
+  MeleeTiles reach;
+  computeMeleeShapeOccluded({px, py}, attack.lastDir, attack.shape,
+                            std::max(1, attack.rangeTiles), map, reach);
+  for (const auto &t : reach)
+    threat.push_back({t.x, t.y});
+
+  // Con plasma, toda la línea de tiro hasta el primer muro
+  if (plasmaTier > 0) {
+    const int range = static_cast<int>(PLASMA_RANGE_TILES);
+    for (int s = 1; s <= range; ++s) {
+      const int tx = px + attack.lastDir.x * s;
+      const int ty = py + attack.lastDir.y * s;
+      if (!map.isWalkable(tx, ty))
+        break;
+      threat.push_back({tx, ty});
+    }
+  }
+
+  influence.update(px, py, crowd, threat);
+}
+
+// Turnos
+void GameSim::resetTurns(bool withPlayer) {
+  turns.clear();
+  enemyActor.assign(enemies.size(), ActorScheduler::INVALID_ACTOR);
+  bossMoveActor = ActorScheduler::INVALID_ACTOR;
+  bossFireActor = ActorScheduler::INVALID_ACTOR;
+  playerActor = withPlayer ? turns.add(playerSpeed)
+                           : ActorScheduler::INVALID_ACTOR;
+}
+
+int GameSim::enemySpeed(size_t i) const {
+  return enemies[i].getType() == Enemy::Shooter ? ENEMY_SPEED_SHOOTER
+                                                : ENEMY_SPEED_MELEE;
+}
+
+std::vector<std::vector<size_t>> GameSim::collectEnemyTurns() {
+  std::vector<std::vector<size_t>> waves;
+
+  // Sin jugador en la cola (ej: volviendo del menú): todos los activos
+  // actúan una vez, como un turno normal.
+  if (!turns.contains(playerActor)) {
+    if (!activeEnemies.empty())
+      waves.push_back(activeEnemies);
+    return waves;
+  }
+
+  // El jugador consume su turno y el mundo corre hasta que le vuelva a tocar
+  if (turns.peek() == playerActor)
+    turns.pop();
+
+  std::unordered_map<size_t, size_t> taken; // Turnos de cada enemigo en el paso
+  while (!turns.empty() && turns.peek() != playerActor) {
+    const size_t i = turns.tagOf(turns.pop());
+    if (i >= enemies.size())
+      continue;
+
+    const size_t wave = taken[i]++;
+    if (waves.size() <= wave)
+      waves.emplace_back();
+    waves[wave].push_back(i);
   }
 
-  // Inicializamos los vectores paralelos con los datos de los nuevos enemigos
-  enemyFacing.assign(enemies.size(), EnemyFacing::Down);
-  enemyHP.assign(enemies.size(), hpForLevel);
-  enemyMaxHP.assign(enemies.size(), hpForLevel);
-  enemyAtkCD.assign(enemies.size(), 0.0f);
-  enemyShootCD.assign(enemies.size(), 0.0f); // Inicializar cooldown disparo
-  enemyFlashTimer.assign(enemies.size(), 0.0f);
+  // Dentro de una oleada mantenemos el orden por índice: con todos a
+  // velocidad normal el resultado es idéntico a un único turno de grupo.
+  for (auto &w : waves)
+    std::sort(w.begin(), w.end());
+  return waves;
 }
\ No newline at end of file
@@ -2,12 +2,12 @@
 #include <vector>
 #include <functional>
 #include <queue>
-#include <random>
 #include <limits>
 #include <algorithm>
 #include <cstdint>
 #include <optional>
 #include <cstdlib>  
+#include "RngStream.hpp"
 
 // Estructura simple para coordenadas 2D (Enteros)
 struct IVec2 { int x{}, y{}; };
@@ -76,7 +76,7 @@ public:
         IVec2 exitTile,                       // Dónde está la salida
         const std::vector<IVec2>& enemyTiles, // Dónde están los enemigos (para riesgo/recompensa)
         int nivel,                            // 1..3
-        std::mt19937& rng,                    // Generador de números aleatorios
+        RngStream& rng,                       // Flujo aleatorio del nivel (determinista)
         RunContext& run,                      // Estado persistente
         const SpawnConfig& cfg = {}           // Configuración de balanceo
     )
@@ -174,9 +174,9 @@ public:
         // 3. Utilidad de muestreo (Rejection sampling)
         // Intenta 'attempts' veces encontrar un punto al azar que cumpla 'predicate'.
         auto randomTileMatching = [&](auto&& predicate, int attempts=500)->std::optional<IVec2>{
-            std::uniform_int_distribution<int> X(0, width-1), Y(0, height-1);
             for(int i=0;i<attempts;i++){
-                IVec2 t{X(rng), Y(rng)};
+                const int x = rng.range(0, width-1);
+                IVec2 t{x, rng.range(0, height-1)};
                 if (predicate(t)) return t;
             }
             return std::nullopt; // Falló tras N intentos
@@ -251,14 +251,13 @@ public:
 
         // D) Pilas (Consumibles comunes)
         auto placePilas = [&](int n){
-            std::bernoulli_distribution good(cfg.probPilaBuena); // RNG booleano ponderado
             for(int i=0;i<n;i++){
                 auto cand = randomTileMatching([&](IVec2 t){
                     return reachable(t) && isFarFromOtherItems(t, cfg.minSepEntreItems);
                 }, 600);
                 if (!cand) break;
                 
-                bool esBuena = good(rng);
+                bool esBuena = rng.chance((float)cfg.probPilaBuena); // Booleano ponderado
                 out.push_back({esBuena ? ItemType::PilaBuena : ItemType::PilaMala,
                                *cand, nivel, 0});
                 markOccupied(*cand);
@@ -279,13 +278,12 @@ public:
 
         // F) Gafas (Visión / Ceguera)
         auto placeGafas = [&](int n){
-            std::bernoulli_distribution buenas(cfg.probGafasBuenas);
             for(int i=0;i<n;i++){
                 auto cand = randomTileMatching([&](IVec2 t){
                     return reachable(t) && isFarFromOtherItems(t, cfg.minSepEntreItems);
                 }, 600);
                 if (!cand) break;
-                bool esBuena = buenas(rng);
+                bool esBuena = rng.chance((float)cfg.probGafasBuenas);
                 out.push_back({esBuena ? ItemType::Gafas3DBuenas : ItemType::Gafas3DMalas,
                                *cand, nivel, 0});
                 markOccupied(*cand);
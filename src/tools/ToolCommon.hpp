@@ -0,0 +1,49 @@
+#ifndef TOOL_COMMON_HPP
+#define TOOL_COMMON_HPP
+
+#include "GameSim.hpp"
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+// Lo que comparten las herramientas sin ventana de src/tools
+
+// La simulación escribe su registro por std::cout; con miles de partidas en
+// paralelo solo estorba. Se tira a un búfer que no guarda nada (y por eso
+// lo pueden usar todos los hilos a la vez).
+struct NullBuffer : std::streambuf {
+  int overflow(int c) override { return c; }
+};
+
+struct MuteCout {
+  NullBuffer sink;
+  std::streambuf *old = std::cout.rdbuf(&sink);
+  ~MuteCout() { std::cout.rdbuf(old); }
+};
+
+// "easy" / "medium" / "hard", como en la línea de comandos
+inline bool parseDifficulty(const std::string &s, Difficulty &out) {
+  if (s == "easy")
+    out = Difficulty::Easy;
+  else if (s == "medium")
+    out = Difficulty::Medium;
+  else if (s == "hard")
+    out = Difficulty::Hard;
+  else
+    return false;
+  return true;
+}
+
+inline const char *difficultyName(Difficulty d) {
+  switch (d) {
+  case Difficulty::Easy:
+    return "easy";
+  case Difficulty::Medium:
+    return "medium";
+  case Difficulty::Hard:
+    return "hard";
+  }
+  return "?";
+}
+
+#endif
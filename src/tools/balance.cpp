@@ -0,0 +1,250 @@
+// Equilibrado por Monte Carlo
+// Juega muchas partidas del jugador automático en cada dificultad,
+// repartidas entre todos los núcleos, y resume en CSV cómo salen los
+// números de equilibrado (enemiesPerLevel, la vida de los enemigos por
+// nivel, SpawnConfig, las constantes de GameUtils.hpp): tasa de victoria,
+// daño recibido por nivel, tiempo hasta la llave y cuántos objetos de cada
+// tipo aparecen y se recogen. Se cambia un número, "make tools" y en unos
+// segundos hay datos nuevos.
+//
+//   roguebot_balance [partidas por dificultad] [--threads=N] [--seed=BASE]
+//                    [--difficulty=easy|medium|hard] [--csv=archivo]
+//
+// Todas las dificultades juegan las mismas semillas (BASE..BASE+N-1): las
+// mismas mazmorras, así que las diferencias entre filas son de la
+// dificultad y no del azar. Una fila por dificultad y nivel, más una fila
+// "total" por dificultad (ahí "superadas" son las victorias). El CSV va a
+// la salida estándar si no se da --csv; el resumen legible, a la de error.
+// Con la misma BASE el CSV sale idéntico con cualquier --threads y en
+// cualquier máquina, nivel del boss incluido.
+#include "BotRun.hpp"
+#include "ToolCommon.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr int ITEM_TYPES = BotLevelStats::ITEM_TYPES;
+
+// Nombres de columna, en el orden de ItemType
+const char *const ITEM_COLUMNS[ITEM_TYPES] = {
+    "pila_buena",   "pila_mala", "escudo",  "gafas_buenas", "gafas_malas",
+    "bateria_vida", "espada",    "plasma",  "llave"};
+
+// Acumulado de una fila del CSV (un nivel, o la partida entera)
+struct Row {
+  int runs = 0;     // Partidas que llegaron
+  int cleared = 0;  // Que lo superaron (en "total": victorias)
+  int defeats = 0;  // Que murieron aquí
+  int failed = 0;   // Atascadas o rotas aquí
+  std::uint64_t ticks = 0;
+  std::vector<int> damage; // Una entrada por partida (para el p90)
+  int keyLevels = 0;       // Niveles con llave
+  int keysPicked = 0;
+  std::uint64_t keyTicks = 0;
+  std::array<long, ITEM_TYPES> spawned{};
+  std::array<long, ITEM_TYPES> picked{};
+
+  void addLevel(const BotLevelStats &lv) {
+    ticks += lv.ticks;
+    const int key = static_cast<int>(ItemType::LlaveMaestra);
+    if (lv.itemsSpawned[key] > 0) {
+      keyLevels++;
+      if (lv.keyTicks >= 0) {
+        keysPicked++;
+        keyTicks += static_cast<std::uint64_t>(lv.keyTicks);
+      }
+    }
+    for (int t = 0; t < ITEM_TYPES; ++t) {
+      spawned[t] += lv.itemsSpawned[t];
+      picked[t] += lv.itemsPicked[t];
+    }
+  }
+};
+
+struct DifficultyReport {
+  Difficulty difficulty = Difficulty::Medium;
+  Row total;
+  std::vector<Row> levels; // levels[0] = nivel 1
+};
+
+double ratio(double a, double b) { return b > 0.0 ? a / b : 0.0; }
+
+double percentile(std::vector<int> v, double p) {
+  if (v.empty())
+    return 0.0;
+  const std::size_t k = static_cast<std::size_t>(p * (v.size() - 1));
+  std::nth_element(v.begin(), v.begin() + k, v.end());
+  return v[k];
+}
+
+double mean(const std::vector<int> &v) {
+  double sum = 0.0;
+  for (int x : v)
+    sum += x;
+  return ratio(sum, static_cast<double>(v.size()));
+}
+
+DifficultyReport aggregate(Difficulty d,
+                           const std::vector<BotRunResult> &results) {
+  DifficultyReport rep;
+  rep.difficulty = d;
+  using O = BotRunResult::Outcome;
+  for (const BotRunResult &r : results) {
+    if (r.setup.difficulty != d)
+      continue;
+    Row &t = rep.total;
+    t.runs++;
+    t.cleared += r.outcome == O::Victory ? 1 : 0;
+    t.defeats += r.outcome == O::Defeat ? 1 : 0;
+    t.failed += r.failed() ? 1 : 0;
+    int damage = 0;
+
+    for (std::size_t i = 0; i < r.levels.size(); ++i) {
+      if (rep.levels.size() <= i)
+        rep.levels.resize(i + 1);
+      const BotLevelStats &lv = r.levels[i];
+      const bool last = i + 1 == r.levels.size();
+      Row &row = rep.levels[i];
+      row.runs++;
+      row.cleared += (!last || r.outcome == O::Victory) ? 1 : 0;
+      row.defeats += (last && r.outcome == O::Defeat) ? 1 : 0;
+      row.failed += (last && r.failed()) ? 1 : 0;
+      row.damage.push_back(lv.damage);
+      row.addLevel(lv);
+      t.addLevel(lv);
+      damage += lv.damage;
+    }
+    t.damage.push_back(damage);
+  }
+  return rep;
+}
+
+void writeHeader(std::ostream &out) {
+  out << "dificultad,nivel,partidas,superadas,tasa_superado,muertes,"
+         "atascadas,segundos_medios,dano_medio,dano_p90,tasa_llave,"
+         "segundos_hasta_llave";
+  for (const char *item : ITEM_COLUMNS)
+    out << "," << item << "_aparecen," << item << "_recogidos";
+  out << "\n";
+}
+
+void writeRow(std::ostream &out, Difficulty d, const std::string &level,
+              const Row &r) {
+  const double hz = FixedTimestep::TICK_HZ;
+  out << difficultyName(d) << "," << level << "," << r.runs << ","
+      << r.cleared << "," << ratio(r.cleared, r.runs) << "," << r.defeats
+      << "," << r.failed << "," << ratio(r.ticks / hz, r.runs) << ","
+      << mean(r.damage) << "," << percentile(r.damage, 0.9) << ","
+      << ratio(r.keysPicked, r.keyLevels) << ",";
+  if (r.keysPicked > 0) // Vacío si nadie la cogió (o no hay llave)
+    out << r.keyTicks / hz / r.keysPicked;
+  // Objetos: cuántos aparecen de media (por nivel o por partida) y qué
+  // fracción de ellos se recoge
+  for (int t = 0; t < ITEM_TYPES; ++t)
+    out << "," << ratio(r.spawned[t], r.runs) << ","
+        << ratio(r.picked[t], r.spawned[t]);
+  out << "\n";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t runs = 500;
+  unsigned threads = 0; // Todos los núcleos
+  unsigned baseSeed = 1;
+  std::string csvPath;
+  std::vector<Difficulty> difficulties;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg.rfind("--threads=", 0) == 0) {
+      threads = static_cast<unsigned>(std::strtoul(arg.c_str() + 10, nullptr, 10));
+    } else if (arg.rfind("--seed=", 0) == 0) {
+      baseSeed = static_cast<unsigned>(std::strtoul(arg.c_str() + 7, nullptr, 10));
+    } else if (arg.rfind("--difficulty=", 0) == 0) {
+      Difficulty d;
+      if (!parseDifficulty(arg.substr(13), d)) {
+        std::cerr << "[ERR] Dificultad desconocida: " << arg.substr(13) << "\n";
+        return 2;
+      }
+      if (std::find(difficulties.begin(), difficulties.end(), d) ==
+          difficulties.end())
+        difficulties.push_back(d);
+    } else if (arg.rfind("--csv=", 0) == 0) {
+      csvPath = arg.substr(6);
+    } else if (!arg.empty() && arg[0] != '-') {
+      runs = static_cast<std::size_t>(std::strtoul(arg.c_str(), nullptr, 10));
+    } else {
+      std::cerr << "[ERR] Argumento desconocido: " << arg << "\n";
+      return 2;
+    }
+  }
+  if (difficulties.empty())
+    difficulties = {Difficulty::Easy, Difficulty::Medium, Difficulty::Hard};
+  // La semilla 0 significa "aleatoria": no sería repetible
+  if (baseSeed == 0)
+    baseSeed = 1;
+
+  // Todas las partidas de todas las dificultades en un solo reparto: los
+  // hilos no esperan a que acabe una dificultad para empezar la siguiente
+  const std::size_t total = runs * difficulties.size();
+  std::vector<BotRunResult> results(total);
+  const double t0 = FrameProfiler::clockMs();
+  {
+    MuteCout mute;
+    runParallel(total, threads, [&](std::size_t i) {
+      RunSetup setup;
+      setup.difficulty = difficulties[i / runs];
+      setup.seed = baseSeed + static_cast<unsigned>(i % runs);
+      results[i] = playBotRun(setup);
+    });
+  }
+  const double wallMs = FrameProfiler::clockMs() - t0;
+
+  std::ofstream file;
+  if (!csvPath.empty()) {
+    file.open(csvPath, std::ios::trunc);
+    if (!file) {
+      std::cerr << "[ERR] No se pudo escribir: " << csvPath << "\n";
+      return 1;
+    }
+  }
+  std::ostream &csv = csvPath.empty() ? std::cout : file;
+  writeHeader(csv);
+
+  std::cerr << "[BALANCE] " << total << " partidas (" << runs
+            << " por dificultad, semillas " << baseSeed << ".."
+            << baseSeed + runs - 1 << ") en " << (long long)wallMs << " ms\n";
+  std::cerr << std::fixed << std::setprecision(2);
+  for (Difficulty d : difficulties) {
+    const DifficultyReport rep = aggregate(d, results);
+    for (std::size_t l = 0; l < rep.levels.size(); ++l)
+      writeRow(csv, d, std::to_string(l + 1), rep.levels[l]);
+    writeRow(csv, d, "total", rep.total);
+
+    std::cerr << "[BALANCE] " << difficultyName(d) << ": victorias "
+              << 100.0 * ratio(rep.total.cleared, rep.total.runs)
+              << "%, atascadas " << rep.total.failed << "\n";
+    for (std::size_t l = 0; l < rep.levels.size(); ++l) {
+      const Row &r = rep.levels[l];
+      std::cerr << "  nivel " << l + 1 << ": llegan " << r.runs
+                << ", superan " << 100.0 * ratio(r.cleared, r.runs)
+                << "%, daño medio " << mean(r.damage) << ", "
+                << ratio(r.ticks / (double)FixedTimestep::TICK_HZ, r.runs)
+                << " s";
+      if (r.keysPicked > 0)
+        std::cerr << ", llave a los "
+                  << ratio(r.keyTicks / (double)FixedTimestep::TICK_HZ,
+                           r.keysPicked)
+                  << " s";
+      std::cerr << "\n";
+    }
+  }
+  if (!csvPath.empty())
+    std::cerr << "[BALANCE] CSV: " << csvPath << "\n";
+  return 0;
+}
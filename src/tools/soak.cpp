@@ -0,0 +1,198 @@
+// Prueba de resistencia sin ventana
+// Juega miles de partidas con el jugador automático, repartidas entre todos
+// los núcleos, y resume: cuántas se rompieron o se atascaron, cuánto dura
+// de media cada nivel y cuáles fueron los ticks más lentos (con su semilla,
+// para repetirlos). Las partidas que fallan se pueden guardar como
+// grabación (--record-failures) y verse luego con "roguebot --replay=...".
+//
+//   roguebot_soak [partidas] [--threads=N] [--seed=BASE]
+//                 [--difficulty=easy|medium|hard] [--max-ticks=N]
+//                 [--record-failures]
+//
+// Código de salida: 0 si todo bien, 1 si alguna partida se rompió, 2 si
+// los argumentos no valen.
+#include "BotRun.hpp"
+#include "ToolCommon.hpp"
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace {
+// Semilla que juega cada hilo ahora mismo: si el proceso cae (fallo de
+// memoria, abort), el manejador de la señal las escribe para repetirlas
+constexpr int MAX_SLOTS = 256;
+std::atomic<unsigned> inFlight[MAX_SLOTS];
+std::atomic<int> nextSlot{0};
+thread_local int slot = -1;
+
+#if !defined(_WIN32)
+void writeNumber(unsigned v) {
+  char buf[16];
+  int n = 0;
+  do {
+    buf[sizeof(buf) - 1 - n++] = static_cast<char>('0' + v % 10);
+    v /= 10;
+  } while (v > 0 && n < (int)sizeof(buf));
+  (void)!write(STDERR_FILENO, buf + sizeof(buf) - n, n);
+}
+
+void onFatalSignal(int sig) {
+  const char msg[] = "\n[SOAK] El proceso cae. Semillas en juego:";
+  (void)!write(STDERR_FILENO, msg, sizeof(msg) - 1);
+  const int used = std::min(nextSlot.load(), MAX_SLOTS);
+  for (int i = 0; i < used; ++i) {
+    const unsigned s = inFlight[i].load();
+    if (s != 0) {
+      (void)!write(STDERR_FILENO, " ", 1);
+      writeNumber(s);
+    }
+  }
+  (void)!write(STDERR_FILENO, "\n", 1);
+  std::signal(sig, SIG_DFL);
+  std::raise(sig);
+}
+#endif
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t runs = 1000;
+  unsigned threads = 0; // Todos los núcleos
+  unsigned baseSeed = 1;
+  bool recordFailures = false;
+  RunSetup base;
+  BotRunLimits limits;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg.rfind("--threads=", 0) == 0) {
+      threads = static_cast<unsigned>(std::strtoul(arg.c_str() + 10, nullptr, 10));
+    } else if (arg.rfind("--seed=", 0) == 0) {
+      baseSeed = static_cast<unsigned>(std::strtoul(arg.c_str() + 7, nullptr, 10));
+    } else if (arg.rfind("--difficulty=", 0) == 0) {
+      if (!parseDifficulty(arg.substr(13), base.difficulty)) {
+        std::cerr << "[ERR] Dificultad desconocida: " << arg.substr(13) << "\n";
+        return 2;
+      }
+    } else if (arg.rfind("--max-ticks=", 0) == 0) {
+      limits.maxTicks = std::strtoull(arg.c_str() + 12, nullptr, 10);
+    } else if (arg == "--record-failures") {
+      recordFailures = true;
+    } else if (!arg.empty() && arg[0] != '-') {
+      runs = static_cast<std::size_t>(std::strtoul(arg.c_str(), nullptr, 10));
+    } else {
+      std::cerr << "[ERR] Argumento desconocido: " << arg << "\n";
+      return 2;
+    }
+  }
+  // La semilla 0 significa "aleatoria": no sería repetible
+  if (baseSeed == 0)
+    baseSeed = 1;
+  limits.record = recordFailures;
+
+#if !defined(_WIN32)
+  std::signal(SIGSEGV, onFatalSignal);
+  std::signal(SIGABRT, onFatalSignal);
+  std::signal(SIGFPE, onFatalSignal);
+#endif
+
+  std::vector<BotRunResult> results(runs);
+  std::atomic<std::size_t> done{0};
+  const double t0 = FrameProfiler::clockMs();
+  {
+    MuteCout mute;
+    runParallel(runs, threads, [&](std::size_t i) {
+      RunSetup setup = base;
+      setup.seed = baseSeed + static_cast<unsigned>(i);
+      if (slot < 0)
+        slot = nextSlot++;
+      if (slot < MAX_SLOTS)
+        inFlight[slot] = setup.seed;
+
+      results[i] = playBotRun(setup, limits);
+      if (!results[i].failed())
+        results[i].recording = InputRecording{}; // No hace falta guardarla
+
+      if (slot < MAX_SLOTS)
+        inFlight[slot] = 0;
+      const std::size_t n = ++done;
+      if (n % 100 == 0 || n == runs)
+        std::cerr << "\r[SOAK] " << n << "/" << runs << std::flush;
+    });
+  }
+  const double wallMs = FrameProfiler::clockMs() - t0;
+  std::cerr << "\n";
+
+  // Resumen
+  int count[4] = {0, 0, 0, 0};
+  std::uint64_t totalTicks = 0;
+  double simMs = 0.0;
+  std::vector<std::uint64_t> levelSum;
+  std::vector<int> levelRuns;
+  for (const BotRunResult &r : results) {
+    count[static_cast<int>(r.outcome)]++;
+    totalTicks += r.ticks;
+    simMs += r.ms;
+    for (std::size_t l = 0; l < r.levels.size(); ++l) {
+      if (levelSum.size() <= l) {
+        levelSum.resize(l + 1, 0);
+        levelRuns.resize(l + 1, 0);
+      }
+      levelSum[l] += r.levels[l].ticks;
+      levelRuns[l]++;
+    }
+  }
+
+  std::cout << "[SOAK] " << runs << " partidas (semillas " << baseSeed << ".."
+            << baseSeed + runs - 1 << ") en " << (long long)wallMs << " ms, "
+            << (long long)(wallMs > 0.0 ? totalTicks / (wallMs / 1000.0) : 0.0)
+            << " ticks/s en total\n";
+  using O = BotRunResult::Outcome;
+  std::cout << "[SOAK] victorias " << count[(int)O::Victory] << ", derrotas "
+            << count[(int)O::Defeat] << ", atascadas " << count[(int)O::Stuck]
+            << ", rotas " << count[(int)O::Crash] << "\n";
+  for (std::size_t l = 0; l < levelSum.size(); ++l)
+    std::cout << "[SOAK] nivel " << l + 1 << ": " << levelRuns[l]
+              << " partidas, media "
+              << (double)levelSum[l] / levelRuns[l] / FixedTimestep::TICK_HZ
+              << " s (" << levelSum[l] / levelRuns[l] << " ticks)\n";
+
+  // Los ticks más lentos, con lo necesario para repetirlos. Se miden en
+  // tiempo de CPU del hilo: no cambian con --threads ni con la carga
+  // (salvo el ruido de la caché)
+  std::vector<const BotRunResult *> slowest;
+  for (const BotRunResult &r : results)
+    slowest.push_back(&r);
+  const std::size_t top = std::min<std::size_t>(10, slowest.size());
+  std::partial_sort(slowest.begin(), slowest.begin() + top, slowest.end(),
+                    [](const BotRunResult *a, const BotRunResult *b) {
+                      return a->worstTickMs > b->worstTickMs;
+                    });
+  std::cout << "[SOAK] ticks más lentos en CPU (media de reloj "
+            << (totalTicks > 0 ? simMs / totalTicks : 0.0) << " ms/tick):\n";
+  for (std::size_t i = 0; i < top; ++i)
+    std::cout << "  " << slowest[i]->worstTickMs << " ms  semilla "
+              << slowest[i]->setup.seed << ", tick " << slowest[i]->worstTick
+              << ", nivel " << slowest[i]->worstTickLevel << "\n";
+
+  for (const BotRunResult &r : results) {
+    if (!r.failed())
+      continue;
+    std::cout << "[SOAK] " << outcomeName(r.outcome) << ": semilla "
+              << r.setup.seed << " tras " << r.ticks << " ticks: " << r.error
+              << "\n";
+    if (recordFailures && r.recording.ticks() > 0) {
+      const std::string path =
+          "soak_" + std::to_string(r.setup.seed) + ".rbr";
+      if (r.recording.save(path))
+        std::cout << "         grabada en " << path << "\n";
+    }
+  }
+  return count[(int)O::Crash] > 0 ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+#define BOOST_TEST_MODULE test_actor_scheduler
+#include <boost/test/unit_test.hpp>
+
+#include "core/ActorScheduler.hpp"
+
+#include <vector>
+
+using Sched = ActorScheduler;
+
+BOOST_AUTO_TEST_CASE(scheduler_same_speed_round_robin_in_add_order) {
+  Sched s;
+  auto a = s.add(Sched::NORMAL_SPEED);
+  auto b = s.add(Sched::NORMAL_SPEED);
+  auto c = s.add(Sched::NORMAL_SPEED);
+
+  std::vector<Sched::ActorId> order;
+  for (int i = 0; i < 6; ++i)
+    order.push_back(s.pop());
+
+  std::vector<Sched::ActorId> expected{a, b, c, a, b, c};
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(),
+                                expected.end());
+  BOOST_CHECK_EQUAL(s.now(), 2 * Sched::TICKS_PER_ACTION);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler_fast_actor_acts_twice_as_often) {
+  Sched s;
+  auto slow = s.add(Sched::NORMAL_SPEED);
+  auto fast = s.add(2 * Sched::NORMAL_SPEED);
+
+  int slowTurns = 0, fastTurns = 0;
+  for (int i = 0; i < 300; ++i) {
+    auto id = s.pop();
+    if (id == slow)
+      ++slowTurns;
+    if (id == fast)
+      ++fastTurns;
+  }
+  BOOST_CHECK_EQUAL(slowTurns, 100);
+  BOOST_CHECK_EQUAL(fastTurns, 200);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler_fractional_speed_keeps_exact_rate) {
+  // 75 no divide al coste de una acción: la energía sobrante se conserva
+  Sched s;
+  auto id = s.add(75);
+  for (int i = 0; i < 3; ++i)
+    BOOST_CHECK_EQUAL(s.pop(), id);
+  // 4 acciones a velocidad 75 = 4 * 10000 / 75 = 533.33 -> 534 ticks
+  BOOST_CHECK_EQUAL(s.peekTime(), 534);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler_removed_actor_never_acts) {
+  Sched s;
+  auto a = s.add(Sched::NORMAL_SPEED);
+  auto b = s.add(Sched::NORMAL_SPEED);
+  s.remove(a);
+  BOOST_CHECK(!s.contains(a));
+  BOOST_CHECK_EQUAL(s.size(), 1u);
+
+  for (int i = 0; i < 5; ++i)
+    BOOST_CHECK_EQUAL(s.pop(), b);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler_first_delay_and_tags) {
+  Sched s;
+  auto late = s.add(Sched::NORMAL_SPEED, 7, 250);
+  auto early = s.add(Sched::NORMAL_SPEED, 3);
+
+  BOOST_CHECK_EQUAL(s.tagOf(late), 7u);
+  BOOST_CHECK_EQUAL(s.peek(), early);
+  BOOST_CHECK_EQUAL(s.pop(), early); // t=100
+  BOOST_CHECK_EQUAL(s.pop(), early); // t=200
+  BOOST_CHECK_EQUAL(s.pop(), late);  // t=250
+  BOOST_CHECK_EQUAL(s.now(), 250);
+}
+
+BOOST_AUTO_TEST_CASE(scheduler_many_actors_remove_and_readd) {
+  Sched s;
+  std::vector<Sched::ActorId> ids;
+  for (int i = 0; i < 5000; ++i)
+    ids.push_back(s.add(50 + (i % 4) * 50, static_cast<std::uint32_t>(i)));
+  for (int i = 0; i < 5000; i += 2)
+    s.remove(ids[i]);
+  BOOST_CHECK_EQUAL(s.size(), 2500u);
+
+  Sched::Tick last = 0;
+  for (int i = 0; i < 20000; ++i) {
+    auto id = s.pop();
+    BOOST_REQUIRE(id != Sched::INVALID_ACTOR);
+    BOOST_CHECK(s.tagOf(id) % 2 == 1);
+    BOOST_CHECK(s.now() >= last); // El reloj nunca retrocede
+    last = s.now();
+  }
+}
@@ -0,0 +1,173 @@
+#define BOOST_TEST_MODULE test_autoplayer
+#include <boost/test/unit_test.hpp>
+
+#include "core/AutoPlayer.hpp"
+#include "core/BotRun.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+namespace {
+// La simulación escribe su registro por std::cout; aquí solo estorba. El
+// búfer no guarda nada, así que varios hilos pueden escribir a la vez.
+struct NullBuffer : std::streambuf {
+  int overflow(int c) override { return c; }
+};
+
+struct MuteCout {
+  NullBuffer sink;
+  std::streambuf *old = std::cout.rdbuf(&sink);
+  ~MuteCout() { std::cout.rdbuf(old); }
+};
+
+RunSetup easy(unsigned seed) {
+  RunSetup s;
+  s.seed = seed;
+  s.difficulty = Difficulty::Easy;
+  return s;
+}
+
+// Ticks de cada nivel jugado (el 4 incluido)
+std::vector<std::uint64_t> levelTicks(const BotRunResult &r) {
+  std::vector<std::uint64_t> v;
+  for (const BotLevelStats &l : r.levels)
+    v.push_back(l.ticks);
+  return v;
+}
+
+// Lo que resume roguebot_balance, nivel a nivel
+bool sameLevelStats(const BotRunResult &a, const BotRunResult &b) {
+  if (a.levels.size() != b.levels.size())
+    return false;
+  for (std::size_t i = 0; i < a.levels.size(); ++i) {
+    const BotLevelStats &x = a.levels[i], &y = b.levels[i];
+    if (x.ticks != y.ticks || x.damage != y.damage ||
+        x.keyTicks != y.keyTicks || x.itemsSpawned != y.itemsSpawned ||
+        x.itemsPicked != y.itemsPicked)
+      return false;
+  }
+  return true;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(bot_finishes_levels_without_breaking_the_run) {
+  MuteCout mute;
+  const int runs = 24;
+  std::vector<BotRunResult> results(runs);
+  runParallel(runs, 0, [&](std::size_t i) {
+    results[i] = playBotRun(easy(100 + static_cast<unsigned>(i)));
+  });
+
+  int pastFirst = 0, victories = 0;
+  double ms = 0.0;
+  std::uint64_t ticks = 0;
+  for (const BotRunResult &r : results) {
+    BOOST_CHECK_MESSAGE(!r.failed(), "semilla " << r.setup.seed << ": "
+                                                << outcomeName(r.outcome)
+                                                << " " << r.error);
+    BOOST_CHECK_EQUAL(r.levels.size(), (std::size_t)r.levelReached);
+    std::uint64_t sum = 0;
+    for (const BotLevelStats &l : r.levels)
+      sum += l.ticks;
+    BOOST_CHECK_EQUAL(sum, r.ticks);
+    pastFirst += r.levelReached > 1 ? 1 : 0;
+    victories += r.outcome == BotRunResult::Outcome::Victory ? 1 : 0;
+    ms += r.ms;
+    ticks += r.ticks;
+  }
+  // Explora, coge la llave y encuentra la salida casi siempre; en fácil
+  // alguna partida llega a ganar al boss
+  BOOST_CHECK_GE(pastFirst, runs * 3 / 4);
+  BOOST_CHECK_GE(victories, 1);
+
+  std::cerr << "[bench] jugador automático: " << (int)(ticks / (ms / 1000.0))
+            << " ticks/s por hilo, " << victories << "/" << runs
+            << " victorias en fácil\n";
+}
+
+BOOST_AUTO_TEST_CASE(level_stats_add_up) {
+  MuteCout mute;
+  const int key = static_cast<int>(ItemType::LlaveMaestra);
+  for (Difficulty d : {Difficulty::Easy, Difficulty::Hard}) {
+    for (unsigned seed = 60; seed < 66; ++seed) {
+      RunSetup setup = easy(seed);
+      setup.difficulty = d;
+      const BotRunResult r = playBotRun(setup);
+      int damage = 0;
+      for (std::size_t i = 0; i < r.levels.size(); ++i) {
+        const BotLevelStats &lv = r.levels[i];
+        const bool cleared = i + 1 < r.levels.size();
+        for (int t = 0; t < BotLevelStats::ITEM_TYPES; ++t)
+          BOOST_CHECK_LE(lv.itemsPicked[t], lv.itemsSpawned[t]);
+        // Sin llave no se sale: cada nivel superado la cogió antes de acabar
+        if (cleared && i + 1 < 4) {
+          BOOST_CHECK_EQUAL(lv.itemsSpawned[key], 1);
+          BOOST_CHECK_EQUAL(lv.itemsPicked[key], 1);
+          BOOST_CHECK_GE(lv.keyTicks, 0);
+          BOOST_CHECK_LE(lv.keyTicks, (std::int64_t)lv.ticks);
+        }
+        damage += lv.damage;
+      }
+      // Quien muere ha perdido al menos la vida con la que empieza (10)
+      if (r.outcome == BotRunResult::Outcome::Defeat)
+        BOOST_CHECK_GE(damage, 10);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(same_seed_same_run) {
+  MuteCout mute;
+  // 109 llega al boss en fácil
+  for (unsigned seed : {7u, 109u, 4242u}) {
+    const BotRunResult a = playBotRun(easy(seed));
+    const BotRunResult b = playBotRun(easy(seed));
+    BOOST_CHECK(levelTicks(a) == levelTicks(b));
+    BOOST_CHECK(a.outcome == b.outcome);
+    BOOST_CHECK_EQUAL(a.ticks, b.ticks);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_matches_serial) {
+  MuteCout mute;
+  const std::size_t runs = 12;
+  std::vector<BotRunResult> serial(runs), parallel(runs);
+  for (std::size_t i = 0; i < runs; ++i)
+    serial[i] = playBotRun(easy(500 + static_cast<unsigned>(i)));
+
+  std::vector<std::atomic<int>> calls(runs);
+  runParallel(runs, 4, [&](std::size_t i) {
+    calls[i]++;
+    parallel[i] = playBotRun(easy(500 + static_cast<unsigned>(i)));
+  });
+
+  int bossRuns = 0;
+  for (std::size_t i = 0; i < runs; ++i) {
+    BOOST_CHECK_EQUAL(calls[i].load(), 1);
+    BOOST_CHECK(sameLevelStats(serial[i], parallel[i]));
+    BOOST_CHECK(serial[i].outcome == parallel[i].outcome);
+    bossRuns += serial[i].levelReached == 4 ? 1 : 0;
+  }
+  BOOST_CHECK_GT(bossRuns, 0); // El nivel del boss también se compara
+}
+
+BOOST_AUTO_TEST_CASE(recorded_bot_run_replays) {
+  MuteCout mute;
+  BotRunLimits limits;
+  limits.record = true;
+  const BotRunResult r = playBotRun(easy(109), limits);
+  BOOST_REQUIRE_EQUAL(r.levelReached, 4); // Con el boss
+  BOOST_REQUIRE_EQUAL(r.recording.ticks(), r.ticks);
+  BOOST_REQUIRE_GT(r.recording.keyframes().size(), 1u);
+
+  // La repetición da la misma partida de principio a fin, boss incluido
+  GameSim sim;
+  sim.startRun(r.recording.setup());
+  InputRecording::Cursor cursor(r.recording);
+  const ReplayStats st = replayRecording(sim, cursor, r.recording);
+  BOOST_CHECK_EQUAL(st.ticks, r.ticks);
+  BOOST_CHECK_GT(st.keyframesChecked, 0);
+  BOOST_CHECK_EQUAL(st.desyncs, 0);
+  BOOST_CHECK_EQUAL(sim.getCurrentLevel(), r.levelReached);
+}
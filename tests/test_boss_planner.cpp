@@ -0,0 +1,151 @@
+#define BOOST_TEST_MODULE test_boss_planner
+#include <boost/test/unit_test.hpp>
+
+#include "core/BossPlanner.hpp"
+#include "core/BulletPatterns.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+// Sala abierta de 40x40 con borde de muro; 'wall' añade muros sueltos
+template <class Wall>
+static BossPlanner::Arena arena(int bx, int by, int px, int py, int phase,
+                                Wall &&wall) {
+  BossPlanner::Arena a;
+  BossPlanner::captureWindow(
+      bx, by,
+      [&](int x, int y) {
+        return x > 0 && y > 0 && x < 39 && y < 39 && !wall(x, y);
+      },
+      a);
+  a.bossX = bx;
+  a.bossY = by;
+  a.playerX = px;
+  a.playerY = py;
+  a.phase = phase;
+  return a;
+}
+
+static BossPlanner::Arena openRoom(int bx, int by, int px, int py, int phase) {
+  return arena(bx, by, px, py, phase, [](int, int) { return false; });
+}
+
+static int cheb(int ax, int ay, int bx, int by) {
+  return std::max(std::abs(ax - bx), std::abs(ay - by));
+}
+
+BOOST_AUTO_TEST_CASE(decision_is_a_legal_step_and_attack) {
+  for (int phase = 1; phase <= 4; ++phase) {
+    const auto a = openRoom(20, 20, 26, 20, phase);
+    const auto d = BossPlanner::plan(a, BossPlanner::FULL_NODE_BUDGET);
+    BOOST_REQUIRE(d.valid);
+    BOOST_CHECK_LE(std::abs(d.dx) + std::abs(d.dy), 1);
+    BOOST_CHECK(a.isWalkable(20 + d.dx, 20 + d.dy));
+    BOOST_CHECK_EQUAL(d.phase, phase);
+    BOOST_CHECK_GE(d.attack, 0);
+    BOOST_CHECK_LT(d.attack,
+                   (int)BulletPatternEngine::bossAttacks(phase).size());
+    BOOST_CHECK_EQUAL(d.depth, BossPlanner::MAX_DEPTH);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(phase_changes_preferred_range) {
+  // Fase 4: va a por el jugador
+  auto d = BossPlanner::plan(openRoom(20, 20, 26, 20, 4), BossPlanner::FULL_NODE_BUDGET);
+  BOOST_REQUIRE(d.valid);
+  BOOST_CHECK_LT(cheb(20 + d.dx, 20 + d.dy, 26, 20), 6);
+
+  // Fase 1: mantiene la distancia si el jugador se le echa encima
+  d = BossPlanner::plan(openRoom(20, 20, 22, 20, 1), BossPlanner::FULL_NODE_BUDGET);
+  BOOST_REQUIRE(d.valid);
+  BOOST_CHECK_GE(cheb(20 + d.dx, 20 + d.dy, 22, 20), 2);
+}
+
+BOOST_AUTO_TEST_CASE(walls_block_attack_lanes) {
+  // Muro en x = 23 entre boss y jugador (con hueco lejos): ningún ataque
+  // cubre al jugador desde aquí, así que el valor cae respecto a la sala
+  // abierta
+  auto wall = [](int x, int y) { return x == 23 && y > 5; };
+  const auto blocked = BossPlanner::plan(arena(20, 20, 26, 20, 2, wall), BossPlanner::FULL_NODE_BUDGET);
+  const auto clear = BossPlanner::plan(openRoom(20, 20, 26, 20, 2), BossPlanner::FULL_NODE_BUDGET);
+  BOOST_REQUIRE(blocked.valid);
+  BOOST_REQUIRE(clear.valid);
+  BOOST_CHECK_LT(blocked.score, clear.score);
+}
+
+BOOST_AUTO_TEST_CASE(player_out_of_window_gives_no_plan) {
+  const auto d = BossPlanner::plan(openRoom(5, 5, 35, 35, 1), BossPlanner::FULL_NODE_BUDGET);
+  BOOST_CHECK(!d.valid);
+}
+
+BOOST_AUTO_TEST_CASE(budget_is_respected_and_anytime) {
+  // Presupuesto nulo: aún hay una respuesta (profundidad 1)
+  auto d = BossPlanner::plan(openRoom(20, 20, 26, 21, 4), 0);
+  BOOST_CHECK(d.valid);
+  BOOST_CHECK_GE(d.depth, 1);
+
+  // Corto: se queda en la última profundidad completa
+  d = BossPlanner::plan(openRoom(20, 20, 26, 21, 4), 500);
+  BOOST_CHECK(d.valid);
+  BOOST_CHECK_LT(d.depth, BossPlanner::MAX_DEPTH);
+  BOOST_CHECK_LE(d.nodes, 501u);
+}
+
+BOOST_AUTO_TEST_CASE(web_budget_still_plans_ahead) {
+  // En la web busca en el hilo principal con menos nodos, en todas las fases
+  for (int phase = 1; phase <= 4; ++phase) {
+    const auto d = BossPlanner::plan(openRoom(20, 20, 26, 20, phase),
+                                     BossPlanner::WEB_NODE_BUDGET);
+    BOOST_REQUIRE(d.valid);
+    BOOST_CHECK_GE(d.depth, 4);
+    BOOST_CHECK_LE(d.nodes, BossPlanner::WEB_NODE_BUDGET + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(same_arena_same_decision) {
+  // Presupuesto de nodos, no de tiempo: repetir da lo mismo siempre
+  const auto a = openRoom(20, 20, 25, 22, 3);
+  const auto first = BossPlanner::plan(a, 700);
+  for (int i = 0; i < 20; ++i) {
+    const auto d = BossPlanner::plan(a, 700);
+    BOOST_CHECK_EQUAL(d.dx, first.dx);
+    BOOST_CHECK_EQUAL(d.dy, first.dy);
+    BOOST_CHECK_EQUAL(d.attack, first.attack);
+    BOOST_CHECK_EQUAL(d.depth, first.depth);
+    BOOST_CHECK_EQUAL(d.nodes, first.nodes);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(worker_matches_inline_search) {
+  auto a = openRoom(20, 20, 26, 20, 3);
+  BossPlanner inlinePlanner;
+  BossPlanner threaded;
+  threaded.setThreaded(true);
+
+  BossPlanner::Decision d, t;
+  BOOST_CHECK(!threaded.wait(t)); // Nada encargado
+  for (int step = 0; step < 5; ++step) {
+    a.playerX = 24 + step;
+    const auto id = threaded.submit(a);
+    inlinePlanner.submit(a);
+    BOOST_REQUIRE(inlinePlanner.wait(d));
+    BOOST_REQUIRE(threaded.wait(t)); // Espera al hilo si no ha terminado
+    BOOST_CHECK_EQUAL(t.request, id);
+    BOOST_CHECK(t.valid);
+    BOOST_CHECK_EQUAL(t.dx, d.dx);
+    BOOST_CHECK_EQUAL(t.dy, d.dy);
+    BOOST_CHECK_EQUAL(t.attack, d.attack);
+    BOOST_CHECK_EQUAL(threaded.lastDecision().request, id);
+    BOOST_CHECK(!threaded.wait(t)); // Ya recogida
+  }
+
+  // Un encargo nuevo sustituye al pendiente; tras reset() no queda nada
+  threaded.submit(openRoom(20, 20, 22, 20, 1));
+  const auto id = threaded.submit(a);
+  BOOST_REQUIRE(threaded.wait(t));
+  BOOST_CHECK_EQUAL(t.request, id);
+  threaded.submit(a);
+  threaded.reset();
+  BOOST_CHECK(!threaded.pending());
+  BOOST_CHECK(!threaded.wait(t));
+}
@@ -0,0 +1,201 @@
+#define BOOST_TEST_MODULE test_bullet_patterns
+#include <boost/test/unit_test.hpp>
+
+#include "core/BulletPatterns.hpp"
+#include "core/FrameProfiler.hpp"
+#include "core/ProjectilePool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static BulletPattern make(BulletPattern::Kind kind, int bullets, int volleys,
+                          float interval, float delay = 0.0f,
+                          float spread = 0.0f, float spin = 0.0f) {
+  BulletPattern p;
+  p.kind = kind;
+  p.bullets = bullets;
+  p.volleys = volleys;
+  p.interval = interval;
+  p.delay = delay;
+  p.spread = spread;
+  p.spin = spin;
+  return p;
+}
+
+static float angleDeg(const ProjectilePool &pool, std::size_t i) {
+  return std::atan2(pool.vy(i), pool.vx(i)) * 180.0f / 3.14159265f;
+}
+
+BOOST_AUTO_TEST_CASE(ring_is_even_and_keeps_projectile_semantics) {
+  ProjectilePool pool(256);
+  BulletPatternEngine eng;
+  BulletPatternEngine::Shot shot;
+  shot.speed = 200.0f;
+  shot.range = 640.0f;
+  shot.damage = 3;
+
+  BOOST_REQUIRE(eng.trigger(make(BulletPattern::Ring, 8, 1, 0.0f), 0.0, 0, 0, shot));
+  BOOST_CHECK_EQUAL(eng.update(0.0, 100.0f, 50.0f, 0, 0, pool), 8u);
+  BOOST_CHECK_EQUAL(eng.running(), 0u);
+  BOOST_REQUIRE_EQUAL(pool.size(), 8u);
+
+  for (std::size_t i = 0; i < pool.size(); ++i) {
+    BOOST_CHECK_EQUAL(pool.x(i), 100.0f);
+    BOOST_CHECK_EQUAL(pool.y(i), 50.0f);
+    BOOST_CHECK_CLOSE(pool.speed(i), 200.0f, 1e-2);
+    BOOST_CHECK_EQUAL(pool.range(i), 640.0f);
+    BOOST_CHECK_EQUAL(pool.damage(i), 3);
+    BOOST_CHECK(pool.isEnemy(i));
+    // Múltiplos de 45°
+    const float a = angleDeg(pool, i);
+    BOOST_CHECK_SMALL(std::remainder(a, 45.0f), 1e-2f);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(spiral_fires_on_schedule_and_rotates) {
+  ProjectilePool pool(256);
+  BulletPatternEngine eng;
+  eng.trigger(make(BulletPattern::Spiral, 1, 3, 0.1f, 0.0f, 0.0f, 30.0f), 0.0,
+              0, 0, {});
+
+  eng.update(0.0, 0, 0, 0, 0, pool);
+  BOOST_CHECK_EQUAL(pool.size(), 1u);
+  eng.update(0.05, 0, 0, 0, 0, pool); // Aún no toca
+  BOOST_CHECK_EQUAL(pool.size(), 1u);
+  eng.update(0.15, 0, 0, 0, 0, pool);
+  eng.update(0.25, 0, 0, 0, 0, pool);
+  BOOST_REQUIRE_EQUAL(pool.size(), 3u);
+  BOOST_CHECK_EQUAL(eng.running(), 0u);
+
+  BOOST_CHECK_SMALL(angleDeg(pool, 0), 1e-3f);
+  BOOST_CHECK_CLOSE(angleDeg(pool, 1), 30.0f, 1e-2);
+  BOOST_CHECK_CLOSE(angleDeg(pool, 2), 60.0f, 1e-2);
+}
+
+BOOST_AUTO_TEST_CASE(aimed_fan_is_centered_on_target) {
+  ProjectilePool pool(16);
+  BulletPatternEngine eng;
+  eng.trigger(make(BulletPattern::AimedFan, 3, 1, 0.0f, 0.0f, 40.0f), 0.0, 0,
+              0, {});
+  // Jugador justo debajo del boss: 90°
+  eng.update(0.0, 0.0f, 0.0f, 0.0f, 300.0f, pool);
+  BOOST_REQUIRE_EQUAL(pool.size(), 3u);
+  BOOST_CHECK_CLOSE(angleDeg(pool, 0), 70.0f, 1e-2);
+  BOOST_CHECK_CLOSE(angleDeg(pool, 1), 90.0f, 1e-2);
+  BOOST_CHECK_CLOSE(angleDeg(pool, 2), 110.0f, 1e-2);
+}
+
+BOOST_AUTO_TEST_CASE(delayed_burst_explodes_where_the_player_was) {
+  ProjectilePool pool(64);
+  BulletPatternEngine eng;
+  eng.trigger(make(BulletPattern::DelayedBurst, 12, 1, 0.0f, 0.5f), 1.0,
+              320.0f, 160.0f, {});
+
+  int pending = 0;
+  eng.forEachPendingBurst(1.2, [&](float x, float y, float left) {
+    BOOST_CHECK_EQUAL(x, 320.0f);
+    BOOST_CHECK_EQUAL(y, 160.0f);
+    BOOST_CHECK_CLOSE(left, 0.3f, 1e-3);
+    ++pending;
+  });
+  BOOST_CHECK_EQUAL(pending, 1);
+
+  // El jugador se ha ido a (0, 0), pero estalla en el punto marcado
+  eng.update(1.2, 0, 0, 0, 0, pool);
+  BOOST_CHECK_EQUAL(pool.size(), 0u);
+  eng.update(1.5, 0, 0, 0, 0, pool);
+  BOOST_REQUIRE_EQUAL(pool.size(), 12u);
+  BOOST_CHECK_EQUAL(pool.x(0), 320.0f);
+  BOOST_CHECK_EQUAL(pool.y(0), 160.0f);
+}
+
+BOOST_AUTO_TEST_CASE(late_frames_keep_the_pattern_shape) {
+  // La descarga tocaba en 0.10 pero el frame llega en 0.11: la bala sale
+  // ya adelantada lo que habría recorrido
+  ProjectilePool pool(16);
+  BulletPatternEngine eng;
+  BulletPatternEngine::Shot shot;
+  shot.speed = 100.0f;
+  eng.trigger(make(BulletPattern::Ring, 1, 1, 0.0f, 0.1f), 0.0, 0, 0, shot);
+  eng.update(0.11, 0, 0, 0, 0, pool);
+  BOOST_REQUIRE_EQUAL(pool.size(), 1u);
+  BOOST_CHECK_CLOSE(pool.x(0), 1.0f, 1e-2);
+  BOOST_CHECK_CLOSE(pool.range(0), shot.range - 1.0f, 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(running_patterns_are_bounded) {
+  BulletPatternEngine eng;
+  const BulletPattern p = make(BulletPattern::Ring, 4, 5, 1.0f);
+  for (std::size_t i = 0; i < BulletPatternEngine::MAX_RUNNING; ++i)
+    BOOST_CHECK(eng.trigger(p, 0.0, 0, 0, {}));
+  BOOST_CHECK(!eng.trigger(p, 0.0, 0, 0, {}));
+  BOOST_CHECK_EQUAL(eng.running(), BulletPatternEngine::MAX_RUNNING);
+
+  // Pool lleno: se descartan balas, pero el motor sigue avanzando
+  ProjectilePool tiny(10);
+  eng.update(10.0, 0, 0, 0, 0, tiny);
+  BOOST_CHECK_EQUAL(tiny.size(), 10u);
+  BOOST_CHECK_EQUAL(eng.running(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(every_phase_has_valid_attacks) {
+  for (int phase = 1; phase <= 4; ++phase) {
+    const auto &attacks = BulletPatternEngine::bossAttacks(phase);
+    BOOST_REQUIRE(!attacks.empty());
+    for (const auto &attack : attacks) {
+      BOOST_CHECK(!attack.empty());
+      BOOST_CHECK_LE(attack.size(), BulletPatternEngine::MAX_RUNNING);
+      for (const auto &p : attack) {
+        BOOST_CHECK_GT(p.bullets, 0);
+        BOOST_CHECK_GT(p.volleys, 0);
+        BOOST_CHECK_GT(p.speedScale, 0.0f);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(dense_pattern_benchmark,
+                     *boost::unit_test::label("bench") *
+                         boost::unit_test::disabled()) {
+  // Escenario denso: la fase 4 encadenando ataques cada 0.1 s más una
+  // espiral de 32 brazos, 10 s a 60 FPS. Motor + integración + alcance.
+  ProjectilePool pool;
+  BulletPatternEngine eng;
+  BulletPatternEngine::Shot shot;
+  shot.speed = 450.0f;
+  shot.range = 1600.0f;
+
+  const float dt = 1.0f / 60.0f;
+  const auto &attacks = BulletPatternEngine::bossAttacks(4);
+  const BulletPattern storm =
+      make(BulletPattern::Spiral, 32, 600, 1.0f / 60.0f, 0.0f, 0.0f, 7.0f);
+  eng.trigger(storm, 0.0, 0, 0, shot);
+
+  std::size_t peak = 0, cycle = 0;
+  double nextAttack = 0.0, worst = 0.0;
+  const double t0 = FrameProfiler::clockMs();
+  for (int f = 0; f < 600; ++f) {
+    const double now = f * (double)dt;
+    const double f0 = FrameProfiler::clockMs();
+
+    if (now >= nextAttack) {
+      for (const auto &p : attacks[cycle++ % attacks.size()])
+        eng.trigger(p, now, 200.0f, 0.0f, shot);
+      nextAttack += 0.1;
+    }
+    pool.integrate(dt);
+    for (std::size_t k = pool.size(); k-- > 0;)
+      if (pool.range(k) <= 0.0f)
+        pool.kill(k);
+    eng.update(now, 0.0f, 0.0f, 200.0f, 0.0f, pool);
+
+    worst = std::max(worst, FrameProfiler::clockMs() - f0);
+    peak = std::max(peak, pool.size());
+  }
+  const double perFrame = (FrameProfiler::clockMs() - t0) / 600.0;
+  std::cout << "[bench] patrones densos: pico " << peak << " balas vivas, "
+            << perFrame << " ms/frame (peor " << worst << " ms)\n";
+
+  BOOST_CHECK_GT(peak, 3000u); // De verdad es denso
+}
@@ -0,0 +1,73 @@
+#define BOOST_TEST_MODULE rb_test_compute_melee_shapes
+#include <boost/test/unit_test.hpp>
+
+#include "GameUtils.hpp"
+#include "Map.hpp"
+#include <cstdlib>
+
+BOOST_AUTO_TEST_SUITE(compute_melee_shapes)
+
+BOOST_AUTO_TEST_CASE(cleave_is_three_wide_per_row)
+{
+  MeleeTiles got;
+  computeMeleeShape({10, 10}, {0, -1}, MeleeShape::Cleave, 2, got);
+  BOOST_REQUIRE_EQUAL(got.size(), 6);
+  for (int x = 9; x <= 11; ++x) {
+    BOOST_TEST(got.contains(x, 9));
+    BOOST_TEST(got.contains(x, 8));
+  }
+  BOOST_TEST(!got.contains(10, 10));
+}
+
+BOOST_AUTO_TEST_CASE(spin_covers_square_in_distance_order)
+{
+  MeleeTiles got;
+  computeMeleeShape({5, 5}, {1, 0}, MeleeShape::Spin, 2, got);
+  BOOST_REQUIRE_EQUAL(got.size(), 24); // 5x5 - centro
+
+  int lastDist = 0;
+  for (const IVec2 &t : got) {
+    const int d = std::abs(t.x - 5) + std::abs(t.y - 5);
+    BOOST_TEST(d >= lastDist); // Ordenadas por distancia Manhattan
+    lastDist = d;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(range_is_clamped_to_capacity)
+{
+  MeleeTiles got;
+  computeMeleeShape({20, 20}, {1, 0}, MeleeShape::Spin, 99, got);
+  BOOST_TEST(got.size() == MeleeTiles::CAPACITY);
+
+  computeMeleeShape({20, 20}, {1, 0}, MeleeShape::Line, 99, got);
+  BOOST_TEST(got.size() == MELEE_MAX_RANGE); // Lanza de alcance 3
+
+  // El envoltorio con vector recorta igual
+  BOOST_TEST(computeMeleeTiles({20, 20}, {1, 0}, 5, true).size() ==
+             (std::size_t)MELEE_MAX_RANGE);
+}
+
+BOOST_AUTO_TEST_CASE(occluded_spin_stops_at_walls)
+{
+  Map map;
+  map.generateBossArena(12, 12);
+  // Pared vertical en x = 6 (y 3..7): nada al otro lado desde (5, 5)
+  for (int y = 3; y <= 7; ++y)
+    map.setTile(6, y, WALL);
+
+  MeleeTiles got;
+  computeMeleeShapeOccluded({5, 5}, {1, 0}, MeleeShape::Spin, 2, map, got);
+  BOOST_TEST(got.contains(4, 5));
+  BOOST_TEST(got.contains(5, 7));
+  BOOST_TEST(!got.contains(6, 5)); // Muro
+  BOOST_TEST(!got.contains(7, 5)); // Detrás del muro
+  BOOST_TEST(!got.contains(7, 7));
+
+  // El tajo pasa por el hueco lateral si la casilla central está tapada
+  map.setTile(6, 7, FLOOR);
+  computeMeleeShapeOccluded({5, 6}, {1, 0}, MeleeShape::Cleave, 1, map, got);
+  BOOST_TEST(!got.contains(6, 6));
+  BOOST_TEST(!got.contains(6, 7)); // Solo se llega desde (6, 6), que es muro
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+#define BOOST_TEST_MODULE test_enemy_vision
+#include <boost/test/unit_test.hpp>
+
+#include "core/EnemyVision.hpp"
+#include "core/Map.hpp"
+
+// Arena del tutorial (50x25): sala abierta en x 37..47, y 4..20
+static Map makeArena() {
+  Map map;
+  map.generateTutorialMap(50, 25);
+  return map;
+}
+
+BOOST_AUTO_TEST_CASE(vision_sees_player_in_front) {
+  Map map = makeArena();
+  EnemyVision v(6, 60.0f);
+
+  BOOST_CHECK(v.sees(map, 42, 12, EnemyVision::Right, 45, 12));
+  BOOST_CHECK(v.sees(map, 42, 12, EnemyVision::Right, 46, 14)); // Dentro del cono
+}
+
+BOOST_AUTO_TEST_CASE(vision_does_not_see_behind_or_outside_cone) {
+  Map map = makeArena();
+  EnemyVision v(6, 60.0f);
+
+  BOOST_CHECK(!v.sees(map, 42, 12, EnemyVision::Left, 45, 12));  // Espalda
+  BOOST_CHECK(!v.sees(map, 42, 12, EnemyVision::Right, 42, 15)); // Lateral
+}
+
+BOOST_AUTO_TEST_CASE(vision_notices_adjacent_even_from_behind) {
+  Map map = makeArena();
+  EnemyVision v(6, 60.0f);
+
+  BOOST_CHECK(v.sees(map, 42, 12, EnemyVision::Left, 43, 12));
+  BOOST_CHECK(v.sees(map, 42, 12, EnemyVision::Up, 43, 13));
+}
+
+BOOST_AUTO_TEST_CASE(vision_limited_by_radius) {
+  Map map = makeArena();
+  EnemyVision v(6, 60.0f);
+
+  BOOST_CHECK(v.sees(map, 42, 8, EnemyVision::Down, 42, 14));
+  BOOST_CHECK(!v.sees(map, 42, 8, EnemyVision::Down, 42, 15));
+}
+
+BOOST_AUTO_TEST_CASE(vision_blocked_by_walls) {
+  Map map = makeArena();
+  map.setTile(44, 11, WALL);
+  map.setTile(44, 12, WALL);
+  map.setTile(44, 13, WALL);
+
+  EnemyVision v(6, 60.0f);
+  BOOST_CHECK(!v.sees(map, 42, 12, EnemyVision::Right, 46, 12));
+  BOOST_CHECK(v.sees(map, 42, 12, EnemyVision::Right, 43, 12));
+}
+
+BOOST_AUTO_TEST_CASE(vision_caches_per_tile_and_resets) {
+  Map map = makeArena();
+  EnemyVision v(6, 60.0f);
+
+  v.sees(map, 42, 12, EnemyVision::Right, 45, 12);
+  v.sees(map, 42, 12, EnemyVision::Left, 39, 12);
+  v.sees(map, 42, 12, EnemyVision::Up, 42, 9);
+  BOOST_CHECK_EQUAL(v.cachedTiles(), 1u); // Las 4 orientaciones de una vez
+
+  v.sees(map, 40, 10, EnemyVision::Up, 40, 7);
+  BOOST_CHECK_EQUAL(v.cachedTiles(), 2u);
+
+  v.reset();
+  BOOST_CHECK_EQUAL(v.cachedTiles(), 0u);
+}
@@ -0,0 +1,95 @@
+#define BOOST_TEST_MODULE test_floating_text_pool
+#include <boost/test/unit_test.hpp>
+
+#include "core/FloatingTextPool.hpp"
+
+#include <climits>
+#include <cstring>
+#include <string>
+
+static std::string fmt(int v) {
+  char buf[FloatingTextPool::TEXT_MAX];
+  const std::size_t len = FloatingTextPool::formatInt(v, buf);
+  BOOST_CHECK_EQUAL(len, std::strlen(buf));
+  return buf;
+}
+
+BOOST_AUTO_TEST_CASE(format_matches_printf) {
+  BOOST_CHECK_EQUAL(fmt(0), "0");
+  BOOST_CHECK_EQUAL(fmt(7), "7");
+  BOOST_CHECK_EQUAL(fmt(9999), "9999");
+  BOOST_CHECK_EQUAL(fmt(-35), "-35");
+  BOOST_CHECK_EQUAL(fmt(INT_MAX), "2147483647");
+  BOOST_CHECK_EQUAL(fmt(INT_MIN), "-2147483648");
+}
+
+BOOST_AUTO_TEST_CASE(hits_on_same_target_accumulate) {
+  FloatingTextPool pool(16);
+  pool.spawn(10.0f, 20.0f, 5, 0xFFu, 42);
+  pool.update(0.1f);
+  pool.spawn(10.0f, 20.0f, 7, 0xFFu, 42);
+  pool.update(0.1f);
+  pool.spawn(10.0f, 20.0f, 3, 0xFFu, 42);
+
+  BOOST_REQUIRE_EQUAL(pool.size(), 1u);
+  BOOST_CHECK_EQUAL(pool.value(0), 15);
+  BOOST_CHECK_EQUAL(std::string(pool.text(0)), "15");
+  BOOST_CHECK_EQUAL(pool.merged(), 2u);
+
+  // Al sumar vuelve a su ancla con vida completa y realce
+  pool.forEach([](float, float y, float alpha, float pop, const char *,
+                  std::uint32_t) {
+    BOOST_CHECK_EQUAL(y, 20.0f);
+    BOOST_CHECK_CLOSE(alpha, 1.0f, 1e-3);
+    BOOST_CHECK_CLOSE(pop, 1.0f, 1e-3);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(other_targets_colors_or_late_hits_do_not_merge) {
+  FloatingTextPool pool(16);
+  pool.spawn(0.0f, 0.0f, 1, 0xFFu, 1);
+  pool.spawn(0.0f, 0.0f, 1, 0xFFu, 2);   // Otro objetivo
+  pool.spawn(0.0f, 0.0f, 1, 0xFF00u, 1); // Otro color (p.ej. escudo)
+  BOOST_CHECK_EQUAL(pool.size(), 3u);
+
+  // Pasada la ventana, el siguiente golpe es un número nuevo
+  pool.update(FloatingTextPool::MERGE_WINDOW + 0.05f);
+  pool.spawn(0.0f, 0.0f, 1, 0xFFu, 1);
+  BOOST_CHECK_EQUAL(pool.size(), 4u);
+  BOOST_CHECK_EQUAL(pool.merged(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(texts_rise_fade_and_expire) {
+  FloatingTextPool pool(16);
+  pool.spawn(0.0f, 100.0f, 1, 0xFFu, 1);
+  pool.update(0.5f);
+  pool.forEach([](float, float y, float alpha, float, const char *,
+                  std::uint32_t) {
+    BOOST_CHECK_CLOSE(y, 100.0f - FloatingTextPool::RISE * 0.5f, 1e-3);
+    BOOST_CHECK_CLOSE(alpha, 0.3f / FloatingTextPool::LIFE, 1e-2);
+  });
+  pool.update(0.31f);
+  BOOST_CHECK_EQUAL(pool.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(spam_stays_within_capacity) {
+  // Ráfaga de una horda: miles de golpes a cientos de objetivos
+  FloatingTextPool pool(64);
+  for (int f = 0; f < 60; ++f) {
+    for (std::uint32_t k = 0; k < 500; ++k)
+      pool.spawn(0.0f, 0.0f, 1, 0xFFu, k);
+    pool.update(1.0f / 60.0f);
+    BOOST_CHECK_LE(pool.size(), pool.capacity());
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 64u);
+  BOOST_CHECK_GT(pool.evicted(), 0u);
+
+  // Un solo objetivo a 60 golpes por segundo: un único número
+  FloatingTextPool boss(64);
+  for (int f = 0; f < 120; ++f) {
+    boss.spawn(0.0f, 0.0f, 2, 0xFFu, 7);
+    boss.update(1.0f / 60.0f);
+  }
+  BOOST_CHECK_EQUAL(boss.size(), 1u);
+  BOOST_CHECK_EQUAL(boss.value(0), 240);
+}
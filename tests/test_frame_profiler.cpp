@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE test_frame_profiler
+#include <boost/test/unit_test.hpp>
+
+#include "core/FrameProfiler.hpp"
+
+#include <chrono>
+#include <thread>
+
+BOOST_AUTO_TEST_CASE(profiler_first_frame_sets_averages) {
+  FrameProfiler p({"ia", "render"});
+  p.beginFrame(0.0);
+  p.add(0, 2.0);
+  p.add(0, 1.0); // Una sección puede medirse varias veces por frame
+  p.add(1, 4.0);
+  p.endFrame(8.0);
+
+  BOOST_CHECK_EQUAL(p.frames(), 1u);
+  BOOST_CHECK_CLOSE(p.sectionMs(0), 3.0, 1e-9);
+  BOOST_CHECK_CLOSE(p.sectionMs(1), 4.0, 1e-9);
+  BOOST_CHECK_CLOSE(p.cpuMs(), 8.0, 1e-9);
+  BOOST_CHECK_EQUAL(p.frameMs(), 0.0); // Aún no hay intervalo entre frames
+}
+
+BOOST_AUTO_TEST_CASE(profiler_frame_time_is_start_to_start) {
+  FrameProfiler p({"ia"});
+  for (int i = 0; i < 10; ++i) {
+    p.beginFrame(i * 16.0);
+    p.endFrame(i * 16.0 + 5.0);
+  }
+  BOOST_CHECK_CLOSE(p.frameMs(), 16.0, 1e-9);
+  BOOST_CHECK_CLOSE(p.cpuMs(), 5.0, 1e-9);
+  BOOST_CHECK_CLOSE(p.fps(), 62.5, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(profiler_smooths_and_tracks_worst) {
+  FrameProfiler p({"ia"});
+  double t = 0.0;
+  for (int i = 0; i < 20; ++i) {
+    p.beginFrame(t);
+    p.add(0, 1.0);
+    p.endFrame(t + 1.0);
+    t += (i == 10) ? 50.0 : 10.0; // Un pico
+  }
+  p.beginFrame(t);
+  p.add(0, 11.0);
+  p.endFrame(t + 1.0);
+
+  BOOST_CHECK_CLOSE(p.worstFrameMs(), 50.0, 1e-9);
+  // Media exponencial: un frame de 11 ms mueve la media un 10%
+  BOOST_CHECK_CLOSE(p.sectionMs(0), 1.0 + 10.0 * FrameProfiler::SMOOTH, 1e-9);
+  BOOST_CHECK_GT(p.frameMs(), 10.0);
+  BOOST_CHECK_LT(p.frameMs(), 50.0);
+}
+
+BOOST_AUTO_TEST_CASE(profiler_scope_and_bad_ids) {
+  FrameProfiler p({"a"});
+  p.beginFrame();
+  {
+    FrameProfiler::Scope s(p, 0);
+  }
+  p.add(5, 100.0); // Ignorado
+  p.add(-1, 100.0);
+  p.endFrame();
+  BOOST_CHECK_GE(p.sectionMs(0), 0.0);
+  BOOST_CHECK_LT(p.sectionMs(0), 100.0);
+  BOOST_CHECK_EQUAL(p.sectionMs(7), 0.0);
+  BOOST_CHECK_EQUAL(p.sectionCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(thread_cpu_clock_ignores_sleep) {
+  // Dormir no gasta CPU: el reloj del hilo apenas avanza
+  const double cpu0 = FrameProfiler::threadCpuMs();
+  const double wall0 = FrameProfiler::clockMs();
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  BOOST_CHECK_GE(FrameProfiler::clockMs() - wall0, 25.0);
+  BOOST_CHECK_LT(FrameProfiler::threadCpuMs() - cpu0, 10.0);
+
+  // Y trabajar sí
+  volatile double acc = 0.0;
+  const double cpu1 = FrameProfiler::threadCpuMs();
+  while (FrameProfiler::threadCpuMs() - cpu1 < 5.0)
+    acc = acc + 1.0;
+  BOOST_CHECK_GE(FrameProfiler::threadCpuMs() - cpu1, 5.0);
+}
@@ -0,0 +1,246 @@
+#define BOOST_TEST_MODULE test_headless_sim
+#include <boost/test/unit_test.hpp>
+
+#include "core/FrameProfiler.hpp"
+#include "core/GameSim.hpp"
+#include "core/GameUtils.hpp"
+#include "core/RngStream.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+// La simulación escribe su registro por std::cout; aquí solo estorba
+struct MuteCout {
+  std::ostringstream sink;
+  std::streambuf *old = std::cout.rdbuf(sink.rdbuf());
+  ~MuteCout() { std::cout.rdbuf(old); }
+};
+
+// GameSim sin frontend que cuenta los avisos y resume el estado
+class Probe : public GameSim {
+public:
+  using GameSim::GameSim;
+  std::vector<int> events = std::vector<int>(32, 0);
+
+  // Huella del estado: si dos partidas coinciden aquí, fueron iguales
+  std::uint64_t fingerprint() const {
+    std::uint64_t h = getTick();
+    auto mix = [&h](std::uint64_t v) { h = RngStream::mix(h, v); };
+    mix((std::uint64_t)px);
+    mix((std::uint64_t)py);
+    mix((std::uint64_t)hp);
+    mix((std::uint64_t)currentLevel);
+    mix((std::uint64_t)state);
+    mix((std::uint64_t)enemies.size());
+    for (std::size_t i = 0; i < enemies.size(); ++i) {
+      mix((std::uint64_t)enemies[i].getX());
+      mix((std::uint64_t)enemies[i].getY());
+      mix((std::uint64_t)enemyHP[i]);
+    }
+    mix((std::uint64_t)projectiles.size());
+    return h;
+  }
+
+  // Salta al nivel del boss (el planificador decide sus pasos y ataques)
+  void enterBossLevel() {
+    currentLevel = maxLevels;
+    newLevel(currentLevel);
+    toggleGodMode(true); // Que el combate dure
+  }
+  int bossX() const { return boss.x; }
+  int bossY() const { return boss.y; }
+
+  // Población por streaming vista desde la simulación
+  float density() const { return enemyDensity; }
+  std::size_t liveEnemies() const { return enemies.size(); }
+  std::size_t parkedEnemies() const { return population.dormantCount(); }
+  int quotaLeft() const { return population.pendingQuota(); }
+  void teleport(int x, int y) {
+    px = x;
+    py = y;
+    streamPopulation();
+  }
+  bool allLiveNear() const {
+    for (const Enemy &e : enemies)
+      if (population.shouldPark(px, py, e.getX(), e.getY()))
+        return false;
+    return true;
+  }
+
+protected:
+  void onSimEvent(SimEvent e) override { events[(int)e]++; }
+};
+
+// Jugador de prueba: camina, ataca y da dashes al azar (con su propia
+// semilla, así que la misma semilla da la misma secuencia de entradas)
+TickInput scripted(RngStream &rng) {
+  TickInput in;
+  in.stepMode = false;
+  switch (rng.range(0, 3)) {
+  case 0: in.holdX = 1; break;
+  case 1: in.holdX = -1; break;
+  case 2: in.holdY = 1; break;
+  default: in.holdY = -1; break;
+  }
+  in.attackHands = rng.chance(0.1f);
+  in.dash = rng.chance(0.01f);
+  in.interact = rng.chance(0.05f);
+  return in;
+}
+
+std::uint64_t playRun(unsigned seed, int ticks, Probe *out = nullptr) {
+  Probe sim(seed);
+  sim.startRun();
+  RngStream input(seed, 99);
+  TickInput in;
+  for (int t = 0; t < ticks && sim.getState() == GameState::Playing; ++t) {
+    if (t % 6 == 0) // Cambia de idea cada décima de segundo
+      in = scripted(input);
+    sim.step(in);
+    in.clearEdges();
+  }
+  if (out)
+    out->events = sim.events;
+  return sim.fingerprint();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(runs_without_window_and_reports_events) {
+  MuteCout mute;
+  Probe sim(1234);
+  BOOST_CHECK(sim.getState() == GameState::MainMenu);
+  sim.step(TickInput{}); // Sin partida no avanza
+  BOOST_CHECK_EQUAL(sim.getTick(), 0u);
+
+  sim.startRun();
+  BOOST_CHECK(sim.getState() == GameState::Playing);
+  BOOST_CHECK_EQUAL(sim.events[(int)SimEvent::RunStarted], 1);
+  BOOST_CHECK_EQUAL(sim.events[(int)SimEvent::LevelStarted], 1);
+  BOOST_CHECK(sim.getMap().isWalkable(sim.getPlayerX(), sim.getPlayerY()));
+
+  TickInput right;
+  right.stepMode = false;
+  right.holdX = 1;
+  for (int t = 0; t < 120; ++t)
+    sim.step(right);
+  BOOST_CHECK_EQUAL(sim.getTick(), 120u);
+  BOOST_CHECK_GT(sim.events[(int)SimEvent::PlayerTurned], 0);
+}
+
+BOOST_AUTO_TEST_CASE(same_seed_same_run) {
+  MuteCout mute;
+  const int ticks = 60 * 60; // Un minuto de partida
+  for (unsigned seed : {7u, 42u, 20240u}) {
+    Probe a, b;
+    const std::uint64_t x = playRun(seed, ticks, &a);
+    const std::uint64_t y = playRun(seed, ticks, &b);
+    BOOST_CHECK_EQUAL(x, y);
+    BOOST_CHECK(a.events == b.events);
+  }
+  BOOST_CHECK_NE(playRun(7u, ticks), playRun(8u, ticks));
+}
+
+BOOST_AUTO_TEST_CASE(boss_level_same_seed_same_ticks) {
+  // El boss decide con BossPlanner: misma semilla y mismas entradas, mismo
+  // estado tick a tick también en el nivel 4
+  MuteCout mute;
+  auto play = [](unsigned seed, std::vector<std::pair<int, int>> &bossAt) {
+    Probe sim(seed);
+    sim.startRun();
+    sim.enterBossLevel();
+    RngStream input(seed, 99);
+    TickInput in;
+    std::vector<std::uint64_t> hashes;
+    for (int t = 0; t < 60 * 40 && sim.getState() == GameState::Playing;
+         ++t) {
+      if (t % 6 == 0)
+        in = scripted(input);
+      sim.step(in);
+      in.clearEdges();
+      hashes.push_back(sim.stateHash());
+      bossAt.emplace_back(sim.bossX(), sim.bossY());
+    }
+    return hashes;
+  };
+
+  for (unsigned seed : {5u, 77u}) {
+    std::vector<std::pair<int, int>> a, b;
+    const auto x = play(seed, a);
+    const auto y = play(seed, b);
+    BOOST_REQUIRE_EQUAL(x.size(), y.size());
+    for (std::size_t t = 0; t < x.size(); ++t)
+      BOOST_REQUIRE_MESSAGE(x[t] == y[t], "semilla " << seed
+                                                     << ": distinto en el tick "
+                                                     << t);
+    BOOST_CHECK(a == b);
+    // El boss se ha movido de verdad (no es un combate vacío)
+    BOOST_CHECK(std::count(a.begin(), a.end(), a.front()) < (long)a.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(large_map_streams_and_refills_population) {
+  // Pantalla 4K: mapa de 144x81, mucho mayor que el radio del streaming.
+  // Los lejanos se aparcan, vuelven al acercarse y las cuotas de densidad
+  // rellenan los sectores que van entrando en rango.
+  MuteCout mute;
+  RunSetup setup;
+  setup.seed = 321;
+  setup.difficulty = Difficulty::Hard;
+  setup.viewW = 3840;
+  setup.viewH = 2160;
+  Probe sim;
+  sim.startRun(setup);
+  BOOST_CHECK_GT(sim.density(), 0.0f);
+  const int quota0 = sim.quotaLeft();
+  BOOST_REQUIRE_GT(quota0, 0);
+  const std::size_t total0 = sim.liveEnemies() + sim.parkedEnemies();
+  BOOST_CHECK_GT(sim.parkedEnemies(), 0u); // Los del otro extremo del mapa
+
+  // Recorre el mapa en zigzag
+  const Map &map = sim.getMap();
+  bool parked = false, restored = false;
+  std::size_t lastParked = sim.parkedEnemies();
+  for (int y = 4; y < map.height(); y += 12) {
+    for (int i = 0; i < map.width(); i += 6) {
+      const int x = (y / 12) % 2 == 0 ? i : map.width() - 1 - i;
+      sim.teleport(x, y);
+      parked = parked || sim.parkedEnemies() > lastParked;
+      restored = restored || sim.parkedEnemies() < lastParked;
+      lastParked = sim.parkedEnemies();
+      BOOST_REQUIRE(sim.allLiveNear());
+      BOOST_REQUIRE_LE(sim.liveEnemies(), (std::size_t)ENEMY_LIVE_CAP);
+      // Nadie se pierde: lo vivo más lo aparcado es lo de antes más lo
+      // que han creado las cuotas
+      BOOST_REQUIRE_EQUAL(sim.liveEnemies() + sim.parkedEnemies(),
+                          total0 + (std::size_t)(quota0 - sim.quotaLeft()));
+    }
+  }
+  BOOST_CHECK(parked);
+  BOOST_CHECK(restored);
+  BOOST_CHECK_LT(sim.quotaLeft(), quota0 / 2); // La mayoría ya creada
+
+  // En el mapa de siempre no hay cuota: el número fijo de enemiesPerLevel
+  Probe small;
+  setup.viewW = 1280;
+  setup.viewH = 720;
+  small.startRun(setup);
+  BOOST_CHECK_EQUAL(small.density(), 0.0f);
+  BOOST_CHECK_EQUAL(small.quotaLeft(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(headless_tick_rate) {
+  MuteCout mute;
+  // Varias partidas cortas seguidas: miles de ticks por segundo sin ventana
+  const int runs = 8, ticks = 60 * 30;
+  const double t0 = FrameProfiler::clockMs();
+  for (int r = 0; r < runs; ++r)
+    playRun(100u + (unsigned)r, ticks);
+  const double ms = FrameProfiler::clockMs() - t0;
+  const double tps = runs * ticks / (ms / 1000.0);
+  std::cerr << "[bench] simulación sin ventana: " << (int)tps
+            << " ticks/s\n";
+  BOOST_CHECK_GT(tps, 2000.0);
+}
@@ -0,0 +1,78 @@
+#define BOOST_TEST_MODULE test_influence_map
+#include <boost/test/unit_test.hpp>
+
+#include "core/InfluenceMap.hpp"
+#include "core/Map.hpp"
+
+#include <utility>
+#include <vector>
+
+using Tiles = std::vector<std::pair<int, int>>;
+
+// Arena del tutorial (50x25): sala abierta en x 37..47, y 4..20
+static Map makeArena() {
+  Map map;
+  map.generateTutorialMap(50, 25);
+  return map;
+}
+
+BOOST_AUTO_TEST_CASE(influence_crowd_peaks_at_enemy_and_spreads) {
+  Map map = makeArena();
+  InfluenceMaps inf;
+  inf.reset(map);
+  inf.update(42, 12, Tiles{{40, 10}}, Tiles{});
+
+  BOOST_CHECK_GT(inf.crowd(40, 10), inf.crowd(41, 10));
+  BOOST_CHECK_GT(inf.crowd(41, 10), 0.0f);
+  BOOST_CHECK_EQUAL(inf.crowd(44, 16), 0.0f);
+  BOOST_CHECK_EQUAL(inf.crowd(36, 2), 0.0f); // Muro
+}
+
+BOOST_AUTO_TEST_CASE(influence_crowd_decays_without_sources) {
+  Map map = makeArena();
+  InfluenceMaps inf;
+  inf.reset(map);
+  inf.update(42, 12, Tiles{{40, 10}}, Tiles{});
+  const float before = inf.crowd(40, 10);
+
+  inf.update(42, 12, Tiles{}, Tiles{});
+  BOOST_CHECK_LT(inf.crowd(40, 10), before * 0.5f + 1e-6f);
+}
+
+BOOST_AUTO_TEST_CASE(influence_threat_marks_weapon_reach) {
+  Map map = makeArena();
+  InfluenceMaps inf;
+  inf.reset(map);
+  inf.update(42, 12, Tiles{}, Tiles{{43, 12}});
+
+  BOOST_CHECK_GT(inf.threat(43, 12), 0.0f);
+  BOOST_CHECK_EQUAL(inf.threat(41, 12), 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(influence_flank_prefers_free_slots) {
+  Map map = makeArena();
+  InfluenceMaps inf;
+  inf.reset(map);
+  // Un enemigo ya ocupa el hueco derecho del jugador
+  inf.update(42, 12, Tiles{{43, 12}}, Tiles{});
+
+  BOOST_CHECK_GT(inf.flank(41, 12), inf.flank(43, 12));
+  BOOST_CHECK_GT(inf.flank(42, 11), inf.flank(42, 9));
+}
+
+BOOST_AUTO_TEST_CASE(influence_best_step_avoids_crowded_axis) {
+  Map map = makeArena();
+  InfluenceMaps inf;
+  inf.reset(map);
+  auto can = [&](int x, int y) { return map.isWalkable(x, y); };
+
+  // Sin nadie alrededor: eje dominante (como el avance voraz)
+  inf.update(46, 12, Tiles{{40, 10}}, Tiles{});
+  auto step = inf.bestStep(40, 10, 46, 12, can);
+  BOOST_CHECK(step == std::make_pair(41, 10));
+
+  // Otro enemigo tapando ese eje: entra por el otro
+  inf.update(46, 12, Tiles{{40, 10}, {41, 10}}, Tiles{});
+  step = inf.bestStep(40, 10, 46, 12, can);
+  BOOST_CHECK(step == std::make_pair(40, 11));
+}
@@ -0,0 +1,215 @@
+#define BOOST_TEST_MODULE test_input_recording
+#include <boost/test/unit_test.hpp>
+
+#include "core/GameSim.hpp"
+#include "core/InputRecording.hpp"
+#include "core/RngStream.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+namespace {
+// La simulación escribe su registro por std::cout; aquí solo estorba
+struct MuteCout {
+  std::ostringstream sink;
+  std::streambuf *old = std::cout.rdbuf(sink.rdbuf());
+  ~MuteCout() { std::cout.rdbuf(old); }
+};
+
+bool sameInput(const TickInput &a, const TickInput &b) {
+  return a.holdX == b.holdX && a.holdY == b.holdY &&
+         a.stepMode == b.stepMode && a.stepX == b.stepX &&
+         a.stepY == b.stepY && a.movePressed == b.movePressed &&
+         a.dash == b.dash && a.interact == b.interact &&
+         a.attackHands == b.attackHands && a.attackSword == b.attackSword &&
+         a.attackPlasma == b.attackPlasma && a.toggleGod == b.toggleGod;
+}
+
+TickInput randomInput(RngStream &rng) {
+  TickInput in;
+  in.holdX = (std::int8_t)rng.range(-1, 1);
+  in.holdY = (std::int8_t)rng.range(-1, 1);
+  in.stepMode = rng.chance(0.5f);
+  in.stepX = (std::int8_t)rng.range(-1, 1);
+  in.stepY = (std::int8_t)rng.range(-1, 1);
+  in.movePressed = rng.chance(0.5f);
+  in.dash = rng.chance(0.5f);
+  in.interact = rng.chance(0.5f);
+  in.attackHands = rng.chance(0.5f);
+  in.attackSword = rng.chance(0.5f);
+  in.attackPlasma = rng.chance(0.5f);
+  in.toggleGod = rng.chance(0.5f);
+  return in;
+}
+
+// Juega una partida con entrada al azar y la graba como lo hace el
+// frontend: el TickInput antes del tick, el keyframe después
+InputRecording recordRun(const RunSetup &setup, int ticks) {
+  GameSim sim;
+  sim.startRun(setup);
+  InputRecording rec;
+  rec.begin(sim.getRunSetup());
+  RngStream input(setup.seed, 99);
+  TickInput in;
+  for (int t = 0; t < ticks && sim.getState() == GameState::Playing; ++t) {
+    if (t % 6 == 0) { // Cambia de idea cada décima de segundo
+      in = TickInput{};
+      in.stepMode = false;
+      in.holdX = (std::int8_t)input.range(-1, 1);
+      in.holdY = (std::int8_t)input.range(-1, 1);
+      in.attackHands = input.chance(0.1f);
+      in.dash = input.chance(0.02f);
+      in.interact = input.chance(0.05f);
+    }
+    rec.push(in, (std::uint8_t)(t / 600));
+    sim.step(in);
+    in.clearEdges();
+    rec.markTick(sim);
+  }
+  return rec;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(tick_input_packs_into_one_word) {
+  RngStream rng(5);
+  for (int i = 0; i < 5000; ++i) {
+    const TickInput in = randomInput(rng);
+    BOOST_REQUIRE(sameInput(InputRecording::unpack(InputRecording::pack(in)), in));
+  }
+  BOOST_CHECK_EQUAL(InputRecording::pack(TickInput{}) & ~(1u << 4), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(runs_are_compressed_and_seekable) {
+  InputRecording rec;
+  rec.begin(RunSetup{});
+  TickInput right;
+  right.holdX = 1;
+  TickInput dash = right;
+  dash.dash = true;
+  for (int t = 0; t < 1000; ++t)
+    rec.push(t == 500 ? dash : right);
+  BOOST_CHECK_EQUAL(rec.ticks(), 1000u);
+  BOOST_CHECK_LT(rec.sizeBytes(), 64u); // Tres rachas
+
+  InputRecording::Cursor c(rec);
+  int dashes = 0;
+  for (; !c.done(); c.next())
+    dashes += c.input().dash;
+  BOOST_CHECK_EQUAL(dashes, 1);
+
+  c.seek(500);
+  BOOST_CHECK(c.input().dash);
+  c.next();
+  BOOST_CHECK(!c.input().dash);
+  BOOST_CHECK_EQUAL(c.input().holdX, 1);
+  c.seek(5000);
+  BOOST_CHECK(c.done());
+}
+
+BOOST_AUTO_TEST_CASE(save_and_load_round_trip) {
+  MuteCout mute;
+  RunSetup setup;
+  setup.seed = 777;
+  setup.difficulty = Difficulty::Hard;
+  const InputRecording rec = recordRun(setup, 60 * 30);
+  const std::string path = "test_input_recording.rbr";
+  BOOST_REQUIRE(rec.save(path));
+
+  InputRecording back;
+  BOOST_REQUIRE(back.load(path));
+  std::remove(path.c_str());
+  BOOST_CHECK_EQUAL(back.ticks(), rec.ticks());
+  BOOST_CHECK_EQUAL(back.setup().seed, 777u);
+  BOOST_CHECK(back.setup().difficulty == Difficulty::Hard);
+  BOOST_CHECK_EQUAL(back.keyframes().size(), rec.keyframes().size());
+
+  InputRecording::Cursor a(rec), b(back);
+  for (; !a.done(); a.next(), b.next()) {
+    BOOST_REQUIRE(sameInput(a.input(), b.input()));
+    BOOST_REQUIRE_EQUAL(a.zoom(), b.zoom());
+  }
+  BOOST_CHECK(b.done());
+
+  // Un archivo que no es una grabación no se carga (ni toca la actual)
+  BOOST_CHECK(!back.load("CMakeLists.txt"));
+  BOOST_CHECK_EQUAL(back.ticks(), rec.ticks());
+}
+
+BOOST_AUTO_TEST_CASE(replay_reproduces_the_run) {
+  MuteCout mute;
+  for (unsigned seed : {11u, 2024u}) {
+    RunSetup setup;
+    setup.seed = seed;
+    const InputRecording rec = recordRun(setup, 60 * 60);
+    BOOST_REQUIRE_GT(rec.keyframes().size(), 1u);
+
+    GameSim sim;
+    sim.startRun(rec.setup());
+    InputRecording::Cursor cursor(rec);
+    const ReplayStats st = replayRecording(sim, cursor, rec);
+    BOOST_CHECK_EQUAL(st.ticks, rec.ticks());
+    BOOST_CHECK_EQUAL(st.keyframesChecked, (int)rec.keyframes().size());
+    BOOST_CHECK_EQUAL(st.desyncs, 0);
+    BOOST_CHECK_EQUAL(sim.stateHash(), rec.keyframes().back().hash);
+
+    // Por tramos (como al saltar en la ventana) da lo mismo
+    GameSim split;
+    split.startRun(rec.setup());
+    InputRecording::Cursor c2(rec);
+    ReplayStats sum = replayRecording(split, c2, rec, rec.ticks() / 3);
+    sum.add(replayRecording(split, c2, rec));
+    BOOST_CHECK_EQUAL(sum.desyncs, 0);
+    BOOST_CHECK_EQUAL(split.stateHash(), sim.stateHash());
+
+    std::cerr << "[bench] repetición sin ventana: "
+              << (int)(st.ticks / (st.ms / 1000.0)) << " ticks/s, "
+              << rec.sizeBytes() << " bytes por " << rec.ticks() << " ticks\n";
+  }
+}
+
+BOOST_AUTO_TEST_CASE(desync_is_detected) {
+  MuteCout mute;
+  RunSetup setup;
+  setup.seed = 99;
+  const InputRecording rec = recordRun(setup, 60 * 30);
+
+  // Otra dificultad: otros enemigos, la huella no cuadra
+  RunSetup wrong = rec.setup();
+  wrong.difficulty = Difficulty::Hard;
+  GameSim sim;
+  sim.startRun(wrong);
+  InputRecording::Cursor cursor(rec);
+  const ReplayStats st = replayRecording(sim, cursor, rec);
+  BOOST_CHECK_GT(st.desyncs, 0);
+  BOOST_CHECK_LE(st.firstDesync, InputRecording::KEYFRAME_TICKS);
+}
+
+BOOST_AUTO_TEST_CASE(truncate_rewinds_the_recording) {
+  MuteCout mute;
+  RunSetup setup;
+  setup.seed = 31337;
+  const InputRecording full = recordRun(setup, 60 * 40);
+  const std::uint64_t cut = full.ticks() / 2 + 7; // En mitad de una racha
+  InputRecording rec = full;
+  rec.truncate(cut);
+  BOOST_CHECK_EQUAL(rec.ticks(), cut);
+  BOOST_REQUIRE(!rec.keyframes().empty());
+  BOOST_CHECK_LE(rec.keyframes().back().tick, cut);
+  BOOST_CHECK_LT(rec.keyframes().size(), full.keyframes().size());
+
+  InputRecording::Cursor a(full), b(rec);
+  for (; !b.done(); a.next(), b.next())
+    BOOST_REQUIRE(sameInput(a.input(), b.input()));
+  BOOST_CHECK_EQUAL(b.tick(), cut);
+
+  // Lo que queda se repite igual y se sigue grabando a continuación
+  GameSim sim;
+  sim.startRun(rec.setup());
+  InputRecording::Cursor c(rec);
+  BOOST_CHECK_EQUAL(replayRecording(sim, c, rec).desyncs, 0);
+  rec.push(TickInput{});
+  BOOST_CHECK_EQUAL(rec.ticks(), cut + 1);
+  rec.truncate(cut + 100); // Más allá del final: nada que olvidar
+  BOOST_CHECK_EQUAL(rec.ticks(), cut + 1);
+}
@@ -0,0 +1,170 @@
+#define BOOST_TEST_MODULE test_nav_graph
+#include <boost/test/unit_test.hpp>
+
+#include "core/Map.hpp"
+#include "core/NavGraph.hpp"
+
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <utility>
+#include <vector>
+
+using Path = std::vector<std::pair<int, int>>;
+
+// Distancia BFS de referencia sobre todo el mapa (-1 si no hay camino)
+static int bfsDistance(const Map &map, int sx, int sy, int tx, int ty) {
+  const int w = map.width(), h = map.height();
+  std::vector<int> dist(w * h, -1);
+  std::deque<int> q;
+  dist[sy * w + sx] = 0;
+  q.push_back(sy * w + sx);
+  static const int DX[4] = {1, -1, 0, 0}, DY[4] = {0, 0, 1, -1};
+  while (!q.empty()) {
+    const int c = q.front();
+    q.pop_front();
+    if (c == ty * w + tx)
+      return dist[c];
+    for (int d = 0; d < 4; ++d) {
+      const int nx = c % w + DX[d], ny = c / w + DY[d];
+      if (!map.isWalkable(nx, ny) || dist[ny * w + nx] >= 0)
+        continue;
+      dist[ny * w + nx] = dist[c] + 1;
+      q.push_back(ny * w + nx);
+    }
+  }
+  return -1;
+}
+
+// Camino válido: pasos 4-adyacentes sobre suelo que acaban en el destino
+static bool validPath(const Map &map, int sx, int sy, int tx, int ty,
+                      const Path &path) {
+  int x = sx, y = sy;
+  for (const auto &s : path) {
+    if (std::abs(s.first - x) + std::abs(s.second - y) != 1)
+      return false;
+    if (!map.isWalkable(s.first, s.second))
+      return false;
+    x = s.first;
+    y = s.second;
+  }
+  return x == tx && y == ty;
+}
+
+BOOST_AUTO_TEST_CASE(nav_tutorial_regions_and_portals) {
+  Map map;
+  map.generateTutorialMap(50, 25);
+  const NavGraph &nav = map.nav();
+
+  // Recepción, galería y arena; dos bordes con un portal a cada lado
+  BOOST_CHECK_EQUAL(nav.regionCount(), 3);
+  BOOST_CHECK_EQUAL(nav.portalCount(), 4);
+  BOOST_CHECK_NE(nav.regionAt(4, 12), nav.regionAt(20, 12));
+  BOOST_CHECK_NE(nav.regionAt(20, 12), nav.regionAt(42, 12));
+  BOOST_CHECK_EQUAL(nav.regionAt(0, 0), -1);
+}
+
+BOOST_AUTO_TEST_CASE(nav_tutorial_long_path_is_optimal) {
+  Map map;
+  map.generateTutorialMap(50, 25);
+  Path path;
+  BOOST_REQUIRE(map.nav().findPath(3, 12, 45, 12, path));
+  BOOST_CHECK(validPath(map, 3, 12, 45, 12, path));
+  BOOST_CHECK_EQUAL((int)path.size(), bfsDistance(map, 3, 12, 45, 12));
+  BOOST_CHECK_EQUAL(map.nav().distance(3, 12, 45, 12), (int)path.size());
+}
+
+BOOST_AUTO_TEST_CASE(nav_same_region_uses_local_search) {
+  Map map;
+  map.generateTutorialMap(50, 25);
+  Path path;
+  BOOST_REQUIRE(map.nav().findPath(38, 5, 46, 19, path));
+  BOOST_CHECK(validPath(map, 38, 5, 46, 19, path));
+  BOOST_CHECK_EQUAL((int)path.size(), 8 + 14);
+}
+
+BOOST_AUTO_TEST_CASE(nav_trivial_and_invalid_queries) {
+  Map map;
+  map.generateTutorialMap(50, 25);
+  const NavGraph &nav = map.nav();
+  Path path{{1, 1}};
+
+  BOOST_CHECK(nav.findPath(40, 10, 40, 10, path));
+  BOOST_CHECK(path.empty());
+  BOOST_CHECK(!nav.findPath(40, 10, 0, 0, path)); // Destino muro
+  BOOST_CHECK(!nav.findPath(-1, 3, 40, 10, path)); // Origen fuera
+  BOOST_CHECK_EQUAL(nav.distance(40, 10, 0, 0), -1);
+
+  const auto same = nav.nextStep(40, 10, 40, 10);
+  BOOST_CHECK_EQUAL(same.first, 40);
+  BOOST_CHECK_EQUAL(same.second, 10);
+
+  const auto step = nav.nextStep(3, 12, 45, 12);
+  BOOST_CHECK_EQUAL(step.first, 4);
+  BOOST_CHECK_EQUAL(step.second, 12);
+}
+
+BOOST_AUTO_TEST_CASE(nav_generated_map_paths_are_valid_and_near_optimal) {
+  Map map;
+  map.generate(80, 45, 1234);
+  const NavGraph &nav = map.nav();
+  BOOST_REQUIRE_GT(nav.regionCount(), 1);
+
+  std::vector<std::pair<int, int>> floor;
+  for (int y = 0; y < map.height(); ++y)
+    for (int x = 0; x < map.width(); ++x)
+      if (map.isWalkable(x, y))
+        floor.push_back({x, y});
+  BOOST_REQUIRE(!floor.empty());
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<size_t> pick(0, floor.size() - 1);
+  Path path;
+  for (int k = 0; k < 200; ++k) {
+    const auto a = floor[pick(rng)], b = floor[pick(rng)];
+    const int best = bfsDistance(map, a.first, a.second, b.first, b.second);
+    const bool found = nav.findPath(a.first, a.second, b.first, b.second, path);
+
+    BOOST_CHECK_EQUAL(found, best >= 0);
+    if (!found)
+      continue;
+    BOOST_CHECK(validPath(map, a.first, a.second, b.first, b.second, path));
+    // Jerárquico: casi óptimo (los portales fijan el punto de cruce)
+    BOOST_CHECK_GE((int)path.size(), best);
+    BOOST_CHECK_LE((int)path.size(), best * 3 / 2 + 8);
+    BOOST_CHECK_EQUAL(nav.distance(a.first, a.second, b.first, b.second),
+                      (int)path.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(nav_horde_sized_map_without_all_pairs_table) {
+  // Más de mil portales: los caminos salen del A* sobre el grafo
+  Map map;
+  map.generate(500, 500, 99);
+  const NavGraph &nav = map.nav();
+  BOOST_REQUIRE_GT(nav.portalCount(), 500);
+
+  std::vector<std::pair<int, int>> floor;
+  for (int y = 0; y < map.height(); ++y)
+    for (int x = 0; x < map.width(); ++x)
+      if (map.isWalkable(x, y))
+        floor.push_back({x, y});
+
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<size_t> pick(0, floor.size() - 1);
+  Path path;
+  for (int k = 0; k < 40; ++k) {
+    const auto a = floor[pick(rng)], b = floor[pick(rng)];
+    const int best = bfsDistance(map, a.first, a.second, b.first, b.second);
+    const bool found = nav.findPath(a.first, a.second, b.first, b.second, path);
+
+    BOOST_CHECK_EQUAL(found, best >= 0);
+    if (!found)
+      continue;
+    BOOST_CHECK(validPath(map, a.first, a.second, b.first, b.second, path));
+    BOOST_CHECK_GE((int)path.size(), best);
+    BOOST_CHECK_LE((int)path.size(), best * 3 / 2 + 8);
+    BOOST_CHECK_EQUAL(nav.distance(a.first, a.second, b.first, b.second),
+                      (int)path.size());
+  }
+}
@@ -0,0 +1,96 @@
+#define BOOST_TEST_MODULE test_particle_pool
+#include <boost/test/unit_test.hpp>
+
+#include "core/FrameProfiler.hpp"
+#include "core/ParticlePool.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+BOOST_AUTO_TEST_CASE(burst_values_stay_in_range) {
+  ParticlePool pool(512, 42);
+  pool.burst(100.0f, 50.0f, 300, 0xFF0000FFu);
+  BOOST_CHECK_EQUAL(pool.size(), 300u);
+
+  int n = 0;
+  pool.forEachAlive([&](float x, float y, float size, float alpha,
+                        std::uint32_t rgba) {
+    BOOST_CHECK_EQUAL(x, 100.0f);
+    BOOST_CHECK_EQUAL(y, 50.0f);
+    BOOST_CHECK_GE(size, 2.0f);
+    BOOST_CHECK_LE(size, 5.0f);
+    BOOST_CHECK_CLOSE(alpha, 1.0f, 1e-3);
+    BOOST_CHECK_EQUAL(rgba, 0xFF0000FFu);
+    ++n;
+  });
+  BOOST_CHECK_EQUAL(n, 300);
+
+  // Tras un frame se han movido entre 50 y 150 px/s en alguna dirección
+  pool.update(0.1f);
+  pool.forEachAlive([&](float x, float y, float, float alpha, std::uint32_t) {
+    const float d = std::hypot(x - 100.0f, y - 50.0f);
+    BOOST_CHECK_GE(d, 4.9f);
+    BOOST_CHECK_LE(d, 15.1f);
+    BOOST_CHECK_LT(alpha, 1.0f);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(full_pool_evicts_oldest_first) {
+  ParticlePool pool(100, 7);
+  pool.burst(0.0f, 0.0f, 80, 1u);
+  pool.burst(0.0f, 0.0f, 50, 2u); // 30 de las viejas ceden su hueco
+  BOOST_CHECK_EQUAL(pool.size(), 100u);
+  BOOST_CHECK_EQUAL(pool.evicted(), 30u);
+
+  int oldOnes = 0, newOnes = 0;
+  bool newSeen = false, orderOk = true;
+  pool.forEachAlive([&](float, float, float, float, std::uint32_t c) {
+    if (c == 1u) {
+      ++oldOnes;
+      orderOk = orderOk && !newSeen; // Orden: viejas antes que nuevas
+    } else {
+      ++newOnes;
+      newSeen = true;
+    }
+  });
+  BOOST_CHECK_EQUAL(oldOnes, 50);
+  BOOST_CHECK_EQUAL(newOnes, 50);
+  BOOST_CHECK(orderOk);
+}
+
+BOOST_AUTO_TEST_CASE(dead_particles_are_reclaimed) {
+  ParticlePool pool(64, 3);
+  pool.burst(0.0f, 0.0f, 40, 1u);
+  pool.update(0.45f);
+  BOOST_CHECK_EQUAL(pool.size(), 40u); // Vida mínima 0.5 s
+
+  pool.update(0.6f);
+  BOOST_CHECK_EQUAL(pool.size(), 0u);
+
+  // El anillo da la vuelta sin perder partículas
+  for (int i = 0; i < 10; ++i) {
+    pool.burst(0.0f, 0.0f, 50, 1u);
+    BOOST_CHECK_EQUAL(pool.size(), 50u);
+    pool.update(1.1f);
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+  }
+  BOOST_CHECK_EQUAL(pool.evicted(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(big_explosions_are_cheap,
+                     *boost::unit_test::label("bench") *
+                         boost::unit_test::disabled()) {
+  ParticlePool pool;
+  const int frames = 120;
+  const double t0 = FrameProfiler::clockMs();
+  for (int f = 0; f < frames; ++f) {
+    pool.burst(0.0f, 0.0f, 200, 1u); // Muerte del boss cada frame
+    pool.update(1.0f / 60.0f);
+  }
+  const double perFrame = (FrameProfiler::clockMs() - t0) / frames;
+  std::cout << "[bench] burst(200) + update de " << pool.size()
+            << " particulas: " << perFrame << " ms/frame\n";
+
+  BOOST_CHECK_LE(pool.size(), pool.capacity());
+}
@@ -1,7 +1,7 @@
 #define BOOST_TEST_MODULE test_player
 #include <boost/test/unit_test.hpp>
 
-#include "core/Player.hpp"
+#include "frontend/Player.hpp"
 
 BOOST_AUTO_TEST_CASE(player_grid_position_getters) {
   Player p;
@@ -0,0 +1,133 @@
+#define BOOST_TEST_MODULE test_population_streamer
+#include <boost/test/unit_test.hpp>
+
+#include "core/Map.hpp"
+#include "core/PopulationStreamer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+using Record = PopulationStreamer::Record;
+using Tiles = std::vector<std::pair<int, int>>;
+
+static Record rec(int x, int y, int hp = 50) {
+  Record r;
+  r.x = static_cast<std::int16_t>(x);
+  r.y = static_cast<std::int16_t>(y);
+  r.hp = r.maxHp = hp;
+  return r;
+}
+
+static int cheb(int ax, int ay, int bx, int by) {
+  return std::max(std::abs(ax - bx), std::abs(ay - by));
+}
+
+BOOST_AUTO_TEST_CASE(streamer_restores_only_nearby_records) {
+  Map map;
+  map.generateBossArena(100, 40); // Sala abierta 2..97 x 2..37
+  PopulationStreamer pop;
+  pop.reset(map, 1, 0.0f, 64);
+
+  pop.park(rec(12, 10, 33)); // Cerca del jugador
+  pop.park(rec(90, 30));     // Lejos
+  BOOST_CHECK_EQUAL(pop.dormantCount(), 2u);
+
+  std::vector<Record> restore;
+  Tiles fresh;
+  pop.update(map, 10, 10, 0, restore, fresh);
+  BOOST_REQUIRE_EQUAL(restore.size(), 1u);
+  BOOST_CHECK_EQUAL(restore[0].x, 12);
+  BOOST_CHECK_EQUAL(restore[0].hp, 33); // El estado viaja en el registro
+  BOOST_CHECK(fresh.empty());
+  BOOST_CHECK_EQUAL(pop.dormantCount(), 1u);
+
+  // Al acercarse, vuelve el otro
+  pop.update(map, 85, 30, 1, restore, fresh);
+  BOOST_CHECK_EQUAL(restore.size(), 1u);
+  BOOST_CHECK_EQUAL(pop.dormantCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(streamer_respects_live_cap) {
+  Map map;
+  map.generateBossArena(60, 40);
+  PopulationStreamer pop;
+  pop.reset(map, 1, 0.0f, 5);
+  for (int i = 0; i < 20; ++i)
+    pop.park(rec(10 + i, 12));
+
+  std::vector<Record> restore;
+  Tiles fresh;
+  pop.update(map, 15, 15, 3, restore, fresh);
+  BOOST_CHECK_EQUAL(restore.size(), 2u); // 5 - 3 vivos
+  pop.update(map, 15, 15, 5, restore, fresh);
+  BOOST_CHECK(restore.empty());
+  BOOST_CHECK_EQUAL(pop.dormantCount(), 18u);
+}
+
+BOOST_AUTO_TEST_CASE(streamer_restored_records_are_not_parked_again) {
+  // Histéresis: todo lo que entra queda dentro del radio de salida
+  Map map;
+  map.generateBossArena(100, 80);
+  PopulationStreamer pop;
+  pop.reset(map, 1, 0.0f, 10000);
+  for (int y = 2; y < 78; y += 3)
+    for (int x = 2; x < 98; x += 3)
+      pop.park(rec(x, y));
+
+  std::vector<Record> restore;
+  Tiles fresh;
+  pop.update(map, 50, 40, 0, restore, fresh);
+  BOOST_REQUIRE(!restore.empty());
+  for (const auto &r : restore)
+    BOOST_CHECK(!pop.shouldPark(50, 40, r.x, r.y));
+  BOOST_CHECK(pop.shouldPark(50, 40, 50 + PopulationStreamer::STREAM_OUT_TILES + 1, 40));
+}
+
+BOOST_AUTO_TEST_CASE(streamer_density_spawns_out_of_sight_and_once) {
+  Map map;
+  map.generate(160, 90, 4321);
+  int floor = 0;
+  for (int y = 0; y < map.height(); ++y)
+    for (int x = 0; x < map.width(); ++x)
+      floor += map.isWalkable(x, y) ? 1 : 0;
+
+  PopulationStreamer pop;
+  pop.reset(map, 99, 0.02f, 100000);
+  const int total = pop.pendingQuota();
+  BOOST_CHECK_GT(total, 0);
+  BOOST_CHECK_LE(std::abs(total - floor / 50), floor / 100 + 20);
+
+  // El jugador recorre el mapa: cada casilla nueva es suelo, fuera de la
+  // vista y no se repite la cuota de un sector
+  std::vector<Record> restore;
+  Tiles fresh;
+  int spawned = 0;
+  for (int y = 4; y < map.height(); y += 16) {
+    for (int x = 4; x < map.width(); x += 8) {
+      pop.update(map, x, y, 0, restore, fresh);
+      for (const auto &t : fresh) {
+        BOOST_CHECK(map.isWalkable(t.first, t.second));
+        BOOST_CHECK_GE(cheb(t.first, t.second, x, y),
+                       PopulationStreamer::SPAWN_MIN_TILES);
+      }
+      spawned += static_cast<int>(fresh.size());
+    }
+  }
+  BOOST_CHECK_GT(spawned, 0);
+  BOOST_CHECK_EQUAL(spawned + pop.pendingQuota(), total);
+}
+
+BOOST_AUTO_TEST_CASE(streamer_clear_deactivates) {
+  Map map;
+  map.generateBossArena(40, 30);
+  PopulationStreamer pop;
+  BOOST_CHECK(!pop.active());
+  pop.reset(map, 1, 0.0f, 10);
+  BOOST_CHECK(pop.active());
+  pop.park(rec(5, 5));
+  pop.clear();
+  BOOST_CHECK(!pop.active());
+  BOOST_CHECK_EQUAL(pop.dormantCount(), 0u);
+}
@@ -0,0 +1,105 @@
+#define BOOST_TEST_MODULE test_primitive_batch
+#include <boost/test/unit_test.hpp>
+
+#include "core/FrameProfiler.hpp"
+#include "core/PrimitiveBatch.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+// Producto vectorial del triángulo k: mismo signo en todos = mismo sentido
+static float winding(const std::vector<PrimitiveBatch::Vertex> &v,
+                     std::size_t k) {
+  const auto &a = v[3 * k], &b = v[3 * k + 1], &c = v[3 * k + 2];
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+BOOST_AUTO_TEST_CASE(primitives_become_triangles) {
+  PrimitiveBatch b;
+  const std::uint32_t red = PrimitiveBatch::pack(255, 0, 0, 255);
+  BOOST_CHECK_EQUAL(red, 0xFF0000FFu);
+
+  b.rect(10, 20, 30, 4, red);
+  BOOST_CHECK_EQUAL(b.vertices().size(), 6u);
+  b.circle(0, 0, 5, red);
+  BOOST_CHECK_EQUAL(b.vertices().size(),
+                    6u + 3u * PrimitiveBatch::CIRCLE_SEGMENTS);
+  b.circle(0, 0, 2, red); // Pequeño: mitad de lados
+  BOOST_CHECK_EQUAL(b.vertices().size(),
+                    6u + 3u * (PrimitiveBatch::CIRCLE_SEGMENTS * 3 / 2));
+  b.rectLines(0, 0, 32, 4, 1, red);
+  BOOST_CHECK_EQUAL(b.vertices().size(),
+                    6u + 3u * (PrimitiveBatch::CIRCLE_SEGMENTS * 3 / 2) + 24u);
+  BOOST_CHECK_EQUAL(b.current().primitives, 7u);
+
+  // Vacíos no generan nada (barra de vida a 0)
+  b.rect(0, 0, 0, 4, red);
+  BOOST_CHECK_EQUAL(b.current().primitives, 7u);
+
+  const auto &v = b.vertices();
+  for (const auto &p : v)
+    BOOST_CHECK_EQUAL(p.rgba, red);
+  for (std::size_t k = 0; k < v.size() / 3; ++k)
+    BOOST_CHECK_LT(winding(v, k), 0.0f); // Mismo sentido que raylib
+
+  // El rectángulo cubre exactamente su caja
+  float minX = 1e9f, maxX = -1e9f, minY = 1e9f, maxY = -1e9f;
+  for (std::size_t k = 0; k < 6; ++k) {
+    minX = std::min(minX, v[k].x);
+    maxX = std::max(maxX, v[k].x);
+    minY = std::min(minY, v[k].y);
+    maxY = std::max(maxY, v[k].y);
+  }
+  BOOST_CHECK_EQUAL(minX, 10.0f);
+  BOOST_CHECK_EQUAL(maxX, 40.0f);
+  BOOST_CHECK_EQUAL(minY, 20.0f);
+  BOOST_CHECK_EQUAL(maxY, 24.0f);
+}
+
+BOOST_AUTO_TEST_CASE(stats_follow_the_frame) {
+  PrimitiveBatch b;
+  b.beginFrame();
+  b.rect(0, 0, 1, 1, 0u);
+  b.markSubmitted(1);
+  BOOST_CHECK(b.empty());
+  b.circle(0, 0, 4, 0u);
+  b.markSubmitted(2);
+
+  BOOST_CHECK_EQUAL(b.current().submits, 2u);
+  BOOST_CHECK_EQUAL(b.current().draws, 3u);
+  BOOST_CHECK_EQUAL(b.current().vertices,
+                    6u + 3u * PrimitiveBatch::CIRCLE_SEGMENTS);
+
+  b.beginFrame();
+  BOOST_CHECK_EQUAL(b.lastFrame().primitives, 2u);
+  BOOST_CHECK_EQUAL(b.current().primitives, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(effect_heavy_frame_is_cheap_to_build,
+                     *boost::unit_test::label("bench") *
+                         boost::unit_test::disabled()) {
+  // Pool de balas lleno (halo + núcleo), pool de partículas lleno y
+  // 1000 barras de vida
+  PrimitiveBatch b;
+  const int frames = 30;
+  const double t0 = FrameProfiler::clockMs();
+  for (int f = 0; f < frames; ++f) {
+    b.beginFrame();
+    for (int i = 0; i < 8192; ++i) {
+      b.circle((float)i, 0.0f, 5.0f, 1u);
+      b.circle((float)i, 0.0f, 2.0f, 2u);
+    }
+    for (int i = 0; i < 4096; ++i)
+      b.rect((float)i, 0.0f, 3.0f, 3.0f, 3u);
+    for (int i = 0; i < 1000; ++i) {
+      b.rect((float)i, 0.0f, 32.0f, 4.0f, 4u);
+      b.rect((float)i, 0.0f, 20.0f, 4.0f, 5u);
+      b.rectLines((float)i, 0.0f, 32.0f, 4.0f, 1.0f, 6u);
+    }
+    b.markSubmitted(1);
+  }
+  const double perFrame = (FrameProfiler::clockMs() - t0) / frames;
+  std::cout << "[bench] lote de " << b.current().primitives << " primitivas ("
+            << b.current().vertices << " vertices): " << perFrame
+            << " ms/frame\n";
+}
@@ -0,0 +1,84 @@
+#define BOOST_TEST_MODULE test_projectile_pool
+#include <boost/test/unit_test.hpp>
+
+#include "core/FrameProfiler.hpp"
+#include "core/ProjectilePool.hpp"
+
+#include <cmath>
+#include <iostream>
+
+BOOST_AUTO_TEST_CASE(pool_integrates_position_and_range) {
+  ProjectilePool pool(16);
+  BOOST_REQUIRE(pool.spawn(10.0f, 20.0f, 30.0f, 40.0f, 100.0f, 7,
+                           ProjectilePool::Enemy));
+  BOOST_CHECK_EQUAL(pool.size(), 1u);
+
+  pool.integrate(0.5f);
+  BOOST_CHECK_CLOSE(pool.x(0), 25.0f, 1e-4);
+  BOOST_CHECK_CLOSE(pool.y(0), 40.0f, 1e-4);
+  BOOST_CHECK_CLOSE(pool.range(0), 75.0f, 1e-4); // |v| = 50 px/s
+  BOOST_CHECK_EQUAL(pool.damage(0), 7);
+  BOOST_CHECK(pool.isEnemy(0));
+
+  pool.integrate(1.6f);
+  BOOST_CHECK_LE(pool.range(0), 0.0f); // Agotado: lo retira el juego
+}
+
+BOOST_AUTO_TEST_CASE(pool_has_fixed_capacity) {
+  ProjectilePool pool(4);
+  for (int i = 0; i < 4; ++i)
+    BOOST_CHECK(pool.spawn(0, 0, 1, 0, 10, 1, ProjectilePool::Player));
+  BOOST_CHECK(!pool.spawn(0, 0, 1, 0, 10, 1, ProjectilePool::Player));
+  BOOST_CHECK_EQUAL(pool.size(), 4u);
+  BOOST_CHECK_EQUAL(pool.capacity(), 4u); // No crece: descarta
+
+  pool.clear();
+  BOOST_CHECK(pool.empty());
+  BOOST_CHECK(pool.spawn(0, 0, 1, 0, 10, 1, ProjectilePool::Player));
+}
+
+BOOST_AUTO_TEST_CASE(pool_kill_moves_last_into_hole) {
+  ProjectilePool pool(8);
+  for (int i = 0; i < 4; ++i)
+    pool.spawn(static_cast<float>(i), 0, 0, 0, 10, i,
+               i % 2 ? ProjectilePool::Enemy : ProjectilePool::Player);
+
+  pool.kill(1);
+  BOOST_REQUIRE_EQUAL(pool.size(), 3u);
+  BOOST_CHECK_EQUAL(pool.x(1), 3.0f);
+  BOOST_CHECK_EQUAL(pool.damage(1), 3);
+  BOOST_CHECK(pool.isEnemy(1));
+
+  // Borrar de atrás hacia delante no se salta ninguno
+  for (std::size_t k = pool.size(); k-- > 0;)
+    if (pool.damage(k) != 2)
+      pool.kill(k);
+  BOOST_REQUIRE_EQUAL(pool.size(), 1u);
+  BOOST_CHECK_EQUAL(pool.damage(0), 2);
+
+  pool.kill(5); // Fuera de rango: no hace nada
+  BOOST_CHECK_EQUAL(pool.size(), 1u);
+}
+
+// Benchmark: fuera de la tanda normal (ctest -L bench); solo imprime tiempos
+BOOST_AUTO_TEST_CASE(pool_integrates_thousands_quickly,
+                     *boost::unit_test::label("bench") *
+                         boost::unit_test::disabled()) {
+  ProjectilePool pool;
+  const std::size_t n = pool.capacity();
+  for (std::size_t i = 0; i < n; ++i) {
+    const float a = static_cast<float>(i) * 0.01f;
+    pool.spawn(0, 0, std::cos(a) * 200.0f, std::sin(a) * 200.0f, 1e9f, 1,
+               ProjectilePool::Enemy);
+  }
+
+  const int frames = 200;
+  const double t0 = FrameProfiler::clockMs();
+  for (int f = 0; f < frames; ++f)
+    pool.integrate(1.0f / 60.0f);
+  const double perFrame = (FrameProfiler::clockMs() - t0) / frames;
+  std::cout << "[bench] integrate " << n << " proyectiles: " << perFrame
+            << " ms/frame\n";
+
+  BOOST_CHECK_CLOSE(pool.x(0), 200.0f * frames / 60.0f, 0.1);
+}
@@ -0,0 +1,214 @@
+#define BOOST_TEST_MODULE test_run_save
+#include <boost/test/unit_test.hpp>
+
+#include "core/AutoPlayer.hpp"
+#include "core/FrameProfiler.hpp"
+#include "core/RunSave.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+// La simulación escribe su registro por std::cout; aquí solo estorba
+struct NullBuffer : std::streambuf {
+  int overflow(int c) override { return c; }
+};
+
+struct MuteCout {
+  NullBuffer sink;
+  std::streambuf *old = std::cout.rdbuf(&sink);
+  ~MuteCout() { std::cout.rdbuf(old); }
+};
+
+RunSetup easy(unsigned seed) {
+  RunSetup s;
+  s.seed = seed;
+  s.difficulty = Difficulty::Easy;
+  return s;
+}
+
+// Juega con el bot hasta 'ticks' o hasta que acabe la partida. Devuelve la
+// huella tras cada tick.
+std::vector<std::uint64_t> play(GameSim &sim, AutoPlayer &bot, int ticks) {
+  std::vector<std::uint64_t> hashes;
+  for (int t = 0; t < ticks && sim.getState() == GameState::Playing; ++t) {
+    sim.step(bot.next(sim));
+    hashes.push_back(sim.stateHash());
+  }
+  return hashes;
+}
+
+bool exists(const std::string &path) { return std::filesystem::exists(path); }
+} // namespace
+
+BOOST_AUTO_TEST_CASE(saved_run_resumes_the_same) {
+  MuteCout mute;
+  const std::string path = "test_run_save.sav";
+  GameSim sim;
+  sim.startRun(easy(17));
+  AutoPlayer bot(17);
+  play(sim, bot, 1200);
+  BOOST_REQUIRE(sim.getState() == GameState::Playing);
+
+  RunSave save;
+  save.capture(sim);
+  BOOST_REQUIRE(save.save(path));
+  BOOST_CHECK(!exists(path + ".tmp"));
+  const AutoPlayer botAtSave = bot;
+  const std::vector<std::uint64_t> ahead = play(sim, bot, 2000);
+
+  // "Continuar" en otra sesión: otro GameSim que solo tiene el archivo
+  RunSave back;
+  BOOST_REQUIRE(back.load(path));
+  BOOST_CHECK_EQUAL(back.seed, sim.getRunSeed());
+  BOOST_CHECK(back.difficulty == Difficulty::Easy);
+  BOOST_CHECK_EQUAL(back.level, save.level);
+  BOOST_CHECK_EQUAL(back.tick, save.tick);
+  BOOST_CHECK(back.snapshot.bytes == save.snapshot.bytes);
+
+  GameSim resumed(999);
+  BOOST_REQUIRE(resumed.loadSnapshot(back.snapshot));
+  BOOST_CHECK_EQUAL(resumed.getTick(), save.tick);
+  AutoPlayer again = botAtSave;
+  BOOST_CHECK(play(resumed, again, 2000) == ahead);
+
+  BOOST_CHECK(RunSave::erase(path));
+  BOOST_CHECK(!exists(path));
+  BOOST_CHECK(!back.load(path));
+}
+
+BOOST_AUTO_TEST_CASE(saved_boss_fight_resumes_the_same) {
+  // Guardado en mitad del combate: el boss sigue decidiendo lo mismo
+  MuteCout mute;
+  const std::string path = "test_run_save_boss.sav";
+  GameSim sim;
+  sim.startRun(easy(109));
+  AutoPlayer bot(109);
+  while (sim.getState() == GameState::Playing &&
+         sim.getCurrentLevel() < sim.getMaxLevels() && sim.getTick() < 30000)
+    sim.step(bot.next(sim));
+  BOOST_REQUIRE_EQUAL(sim.getCurrentLevel(), sim.getMaxLevels());
+  play(sim, bot, 100);
+  BOOST_REQUIRE(sim.getState() == GameState::Playing);
+
+  RunSave save;
+  save.capture(sim);
+  BOOST_REQUIRE(save.save(path));
+  const AutoPlayer botAtSave = bot;
+  const std::vector<std::uint64_t> ahead = play(sim, bot, 3000);
+
+  RunSave back;
+  BOOST_REQUIRE(back.load(path));
+  GameSim resumed;
+  BOOST_REQUIRE(resumed.loadSnapshot(back.snapshot));
+  AutoPlayer again = botAtSave;
+  BOOST_CHECK(play(resumed, again, 3000) == ahead);
+  BOOST_CHECK(RunSave::erase(path));
+}
+
+BOOST_AUTO_TEST_CASE(damaged_or_foreign_files_are_rejected) {
+  MuteCout mute;
+  const std::string path = "test_run_save_bad.sav";
+  GameSim sim;
+  sim.startRun(easy(4));
+  RunSave save;
+  save.capture(sim);
+  BOOST_REQUIRE(save.save(path));
+
+  std::vector<char> good;
+  {
+    std::ifstream f(path, std::ios::binary);
+    good.assign(std::istreambuf_iterator<char>(f),
+                std::istreambuf_iterator<char>());
+  }
+  auto rewrite = [&](const std::vector<char> &bytes) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f.write(bytes.data(), (std::streamsize)bytes.size());
+  };
+
+  RunSave kept;
+  kept.level = 77; // Un load() fallido no lo toca
+
+  std::vector<char> flipped = good;
+  flipped[good.size() / 2] ^= 0x40; // Un bit de la foto: falla la suma
+  rewrite(flipped);
+  BOOST_CHECK(!kept.load(path));
+
+  std::vector<char> version = good;
+  version[4] ^= 0x01; // Versión del archivo
+  rewrite(version);
+  BOOST_CHECK(!kept.load(path));
+
+  std::vector<char> cut(good.begin(), good.end() - 9);
+  rewrite(cut);
+  BOOST_CHECK(!kept.load(path));
+  BOOST_CHECK_EQUAL(kept.level, 77);
+
+  rewrite(good);
+  BOOST_CHECK(kept.load(path));
+  std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(autosave_writes_the_latest_in_the_background) {
+  MuteCout mute;
+  const std::string path = "test_run_save_dir/autosave.sav";
+  std::filesystem::remove_all("test_run_save_dir");
+  GameSim sim;
+  sim.startRun(easy(9));
+  AutoPlayer bot(9);
+
+  const int saves = 40;
+  double captureMs = 0.0;
+  std::vector<double> submitMs;
+  RunSave save;
+  {
+    AutosaveWriter writer(path);
+    BOOST_CHECK_EQUAL(writer.path(), path);
+    for (int i = 0; i < saves; ++i) {
+      play(sim, bot, 30);
+      const double t0 = FrameProfiler::clockMs();
+      save.capture(sim);
+      const double t1 = FrameProfiler::clockMs();
+      writer.submit(save);
+      captureMs += t1 - t0;
+      submitMs.push_back(FrameProfiler::clockMs() - t1);
+    }
+    writer.flush();
+    BOOST_CHECK(writer.lastOk());
+    // Los encargos que llegan mientras escribe se funden: nunca más
+    // escrituras que encargos, y al menos la última
+    BOOST_CHECK_GE(writer.completed(), 1u);
+    BOOST_CHECK_LE(writer.completed(), (std::uint64_t)saves);
+
+    RunSave back;
+    BOOST_REQUIRE(back.load(path));
+    BOOST_CHECK_EQUAL(back.tick, sim.getTick());
+    BOOST_CHECK(back.snapshot.bytes == save.snapshot.bytes);
+
+    // Partida terminada: el guardado desaparece
+    writer.submit(save);
+    writer.erase();
+    writer.flush();
+    BOOST_CHECK(!exists(path));
+
+    // Lo pendiente al destruir el escritor se escribe igualmente
+    writer.submit(save);
+  }
+  BOOST_CHECK(exists(path));
+  BOOST_CHECK(!exists(path + ".tmp"));
+  std::filesystem::remove_all("test_run_save_dir");
+
+  // Con un solo núcleo, despertar al hilo puede cederle la CPU en mitad
+  // de submit(): por eso la mediana y no la media
+  std::sort(submitMs.begin(), submitMs.end());
+  std::cerr << "[bench] autoguardado: " << save.snapshot.size()
+            << " bytes, foto " << captureMs * 1000.0 / saves
+            << " us, encargo al hilo " << submitMs[saves / 2] * 1000.0
+            << " us (mediana)\n";
+}
@@ -0,0 +1,256 @@
+#define BOOST_TEST_MODULE test_snapshot
+#include <boost/test/unit_test.hpp>
+
+#include "core/AutoPlayer.hpp"
+#include "core/FrameProfiler.hpp"
+#include "core/GameSim.hpp"
+
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+namespace {
+// La simulación escribe su registro por std::cout; aquí solo estorba
+struct NullBuffer : std::streambuf {
+  int overflow(int c) override { return c; }
+};
+
+struct MuteCout {
+  NullBuffer sink;
+  std::streambuf *old = std::cout.rdbuf(&sink);
+  ~MuteCout() { std::cout.rdbuf(old); }
+};
+
+RunSetup easy(unsigned seed) {
+  RunSetup s;
+  s.seed = seed;
+  s.difficulty = Difficulty::Easy;
+  return s;
+}
+
+// Juega con el bot hasta 'ticks' o hasta que acabe la partida. Devuelve la
+// huella tras cada tick.
+std::vector<std::uint64_t> play(GameSim &sim, AutoPlayer &bot, int ticks) {
+  std::vector<std::uint64_t> hashes;
+  for (int t = 0; t < ticks && sim.getState() == GameState::Playing; ++t) {
+    sim.step(bot.next(sim));
+    hashes.push_back(sim.stateHash());
+  }
+  return hashes;
+}
+
+// Juega hasta el primer tick de 'level' (false si no llega)
+bool playUntilLevel(GameSim &sim, AutoPlayer &bot, int level) {
+  const std::uint64_t limit = 6ull * 60 * FixedTimestep::TICK_HZ;
+  while (sim.getCurrentLevel() < level) {
+    if (sim.getState() != GameState::Playing || sim.getTick() > limit)
+      return false;
+    sim.step(bot.next(sim));
+  }
+  return sim.getCurrentLevel() == level;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(restored_state_plays_the_same) {
+  MuteCout mute;
+  for (unsigned seed : {12u, 345u}) {
+    GameSim sim;
+    sim.startRun(easy(seed));
+    AutoPlayer bot(seed);
+    play(sim, bot, 900);
+    BOOST_REQUIRE(sim.getState() == GameState::Playing);
+
+    SimSnapshot snap;
+    sim.saveSnapshot(snap);
+    BOOST_CHECK_EQUAL(snap.tick, sim.getTick());
+    BOOST_CHECK_EQUAL(snap.level, sim.getCurrentLevel());
+    const std::uint64_t atSnap = sim.stateHash();
+    const AutoPlayer botAtSnap = bot;
+    const std::vector<std::uint64_t> ahead = play(sim, bot, 3000);
+    BOOST_REQUIRE_GT(ahead.size(), 100u);
+
+    // Vuelta atrás en la misma partida
+    BOOST_REQUIRE(sim.loadSnapshot(snap));
+    BOOST_CHECK_EQUAL(sim.getTick(), snap.tick);
+    BOOST_CHECK_EQUAL(sim.stateHash(), atSnap);
+    AutoPlayer again = botAtSnap;
+    BOOST_CHECK(play(sim, again, 3000) == ahead);
+
+    // Clon en otro GameSim (otra semilla, sin partida empezada)
+    GameSim clone(999);
+    BOOST_REQUIRE(clone.loadSnapshot(snap));
+    BOOST_CHECK_EQUAL(clone.stateHash(), atSnap);
+    BOOST_CHECK_EQUAL(clone.getRunSeed(), sim.getRunSeed());
+    AutoPlayer cloneBot = botAtSnap;
+    BOOST_CHECK(play(clone, cloneBot, 3000) == ahead);
+    BOOST_CHECK_EQUAL(clone.getShieldTime(), sim.getShieldTime());
+    BOOST_CHECK_EQUAL(clone.getGlassesTime(), sim.getGlassesTime());
+    BOOST_CHECK_EQUAL(clone.getFovRadius(), sim.getFovRadius());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(boss_fight_rolls_back_and_clones) {
+  // Con un encargo del planificador a medias: al cargar se repite y el
+  // boss decide lo mismo
+  MuteCout mute;
+  GameSim sim;
+  sim.startRun(easy(109));
+  AutoPlayer bot(109);
+  BOOST_REQUIRE(playUntilLevel(sim, bot, sim.getMaxLevels()));
+  play(sim, bot, 150);
+  BOOST_REQUIRE(sim.getState() == GameState::Playing);
+
+  SimSnapshot snap;
+  sim.saveSnapshot(snap);
+  const AutoPlayer botAtSnap = bot;
+  const std::vector<std::uint64_t> ahead = play(sim, bot, 3000);
+  BOOST_REQUIRE_GT(ahead.size(), 60u);
+
+  BOOST_REQUIRE(sim.loadSnapshot(snap));
+  AutoPlayer again = botAtSnap;
+  BOOST_CHECK(play(sim, again, 3000) == ahead);
+
+  GameSim clone(999);
+  BOOST_REQUIRE(clone.loadSnapshot(snap));
+  AutoPlayer cloneBot = botAtSnap;
+  BOOST_CHECK(play(clone, cloneBot, 3000) == ahead);
+}
+
+BOOST_AUTO_TEST_CASE(retry_level_without_regenerating) {
+  MuteCout mute;
+  GameSim sim;
+  sim.startRun(easy(7));
+  AutoPlayer bot(7);
+  BOOST_REQUIRE(playUntilLevel(sim, bot, 2));
+
+  SimSnapshot levelStart;
+  sim.saveSnapshot(levelStart);
+  const std::uint64_t atStart = sim.stateHash();
+  const int px = sim.getPlayerX(), py = sim.getPlayerY();
+  const Map mapAtStart = sim.getMap();
+
+  // Se sigue jugando (puede que hasta el nivel 3: otro mapa) y se reintenta
+  play(sim, bot, 4000);
+  BOOST_REQUIRE(sim.loadSnapshot(levelStart));
+  BOOST_CHECK_EQUAL(sim.getCurrentLevel(), 2);
+  BOOST_CHECK_EQUAL(sim.stateHash(), atStart);
+  BOOST_CHECK_EQUAL(sim.getPlayerX(), px);
+  BOOST_CHECK_EQUAL(sim.getPlayerY(), py);
+
+  const Map &map = sim.getMap();
+  BOOST_REQUIRE_EQUAL(map.width(), mapAtStart.width());
+  BOOST_REQUIRE_EQUAL(map.height(), mapAtStart.height());
+  int diffs = 0;
+  for (int y = 0; y < map.height(); ++y)
+    for (int x = 0; x < map.width(); ++x)
+      diffs += map.at(x, y) != mapAtStart.at(x, y) ||
+               map.isDiscovered(x, y) != mapAtStart.isDiscovered(x, y);
+  BOOST_CHECK_EQUAL(diffs, 0);
+  // El grafo de navegación vuelve a servir para este mapa
+  const auto exit = map.findExitTile();
+  BOOST_CHECK_GT(map.nav().distance(px, py, exit.first, exit.second), 0);
+}
+
+BOOST_AUTO_TEST_CASE(round_trip_is_exact_and_reuses_the_buffer) {
+  MuteCout mute;
+  GameSim sim;
+  sim.startRun(easy(21));
+  AutoPlayer bot(21);
+  play(sim, bot, 1500);
+
+  SimSnapshot a, b;
+  sim.saveSnapshot(a);
+  GameSim clone;
+  BOOST_REQUIRE(clone.loadSnapshot(a));
+  clone.saveSnapshot(b);
+  BOOST_CHECK(a.bytes == b.bytes);
+
+  // Otra foto en el mismo objeto no reserva memoria
+  const std::uint8_t *data = a.bytes.data();
+  const std::size_t capacity = a.bytes.capacity();
+  play(sim, bot, 10);
+  sim.saveSnapshot(a);
+  if (a.size() <= capacity)
+    BOOST_CHECK(a.bytes.data() == data);
+}
+
+BOOST_AUTO_TEST_CASE(foreign_or_damaged_snapshots_are_rejected) {
+  MuteCout mute;
+  GameSim sim;
+  sim.startRun(easy(5));
+  AutoPlayer bot(5);
+  play(sim, bot, 300);
+
+  SimSnapshot empty;
+  BOOST_CHECK(!sim.loadSnapshot(empty));
+
+  SimSnapshot snap;
+  sim.saveSnapshot(snap);
+  BOOST_CHECK(snap.compatible());
+  const AutoPlayer botAtSnap = bot;
+  const std::vector<std::uint64_t> ahead = play(sim, bot, 600);
+  SimSnapshot now;
+  sim.saveSnapshot(now);
+  const std::uint64_t before = sim.stateHash();
+
+  // Ninguna carga fallida toca la partida
+  SimSnapshot wrong = snap;
+  wrong.bytes[4] ^= 0xFF; // Versión
+  BOOST_CHECK(!wrong.compatible());
+  BOOST_CHECK(!sim.loadSnapshot(wrong));
+  BOOST_CHECK_EQUAL(sim.stateHash(), before);
+
+  SimSnapshot cut = snap;
+  cut.bytes.resize(cut.bytes.size() - 1);
+  BOOST_CHECK(!sim.loadSnapshot(cut));
+  BOOST_CHECK_EQUAL(sim.stateHash(), before);
+
+  SimSnapshot flipped = snap;
+  flipped.bytes[flipped.size() * 3 / 4] ^= 0x10; // En mitad del volcado
+  BOOST_CHECK(!sim.loadSnapshot(flipped));
+  BOOST_CHECK_EQUAL(sim.stateHash(), before);
+
+  SimSnapshot after = now;
+  sim.saveSnapshot(after);
+  BOOST_CHECK(after.bytes == now.bytes); // Ni un byte
+
+  // Y la buena sigue sirviendo
+  BOOST_REQUIRE(sim.loadSnapshot(snap));
+  AutoPlayer again = botAtSnap;
+  BOOST_CHECK(play(sim, again, 600) == ahead);
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_cost) {
+  MuteCout mute;
+  RunSetup horde = easy(3);
+  horde.horde = true;
+  horde.hordeCount = 2000;
+  for (const RunSetup &setup : {easy(3), horde}) {
+    GameSim sim;
+    sim.startRun(setup);
+    AutoPlayer bot(3);
+    for (int t = 0; t < 600 && sim.getState() == GameState::Playing; ++t)
+      sim.step(bot.next(sim));
+
+    const int reps = 500;
+    SimSnapshot snap;
+    sim.saveSnapshot(snap); // La primera reserva el búfer
+    double t0 = FrameProfiler::clockMs();
+    for (int i = 0; i < reps; ++i)
+      sim.saveSnapshot(snap);
+    const double saveUs = (FrameProfiler::clockMs() - t0) * 1000.0 / reps;
+
+    GameSim clone;
+    BOOST_REQUIRE(clone.loadSnapshot(snap)); // La primera rehace el grafo
+    t0 = FrameProfiler::clockMs();
+    for (int i = 0; i < reps; ++i)
+      BOOST_REQUIRE(clone.loadSnapshot(snap));
+    const double loadUs = (FrameProfiler::clockMs() - t0) * 1000.0 / reps;
+    BOOST_CHECK_EQUAL(clone.stateHash(), sim.stateHash());
+
+    std::cerr << "[bench] foto del estado (" << (setup.horde ? "horda" : "nivel 1")
+              << ", " << sim.getEnemies().size() << " enemigos vivos): "
+              << snap.size() << " bytes, tomar " << saveUs << " us, cargar "
+              << loadUs << " us\n";
+  }
+}
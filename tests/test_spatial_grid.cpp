@@ -0,0 +1,76 @@
+#define BOOST_TEST_MODULE test_spatial_grid
+#include <boost/test/unit_test.hpp>
+
+#include "core/SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static std::vector<int> near(const SpatialGrid &g, int x, int y, int r) {
+  std::vector<int> out;
+  g.forEachNear(x, y, r, [&](int id) { out.push_back(id); });
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+BOOST_AUTO_TEST_CASE(grid_lists_cell_and_neighbors) {
+  SpatialGrid g;
+  g.resize(10, 10);
+  g.insert(0, 5, 5);
+  g.insert(1, 6, 5);
+  g.insert(2, 5, 5); // Dos en la misma celda
+  g.insert(3, 8, 8);
+
+  BOOST_CHECK((near(g, 5, 5, 0) == std::vector<int>{0, 2}));
+  BOOST_CHECK((near(g, 5, 5, 1) == std::vector<int>{0, 1, 2}));
+  BOOST_CHECK((near(g, 7, 6, 1) == std::vector<int>{1}));
+  BOOST_CHECK((near(g, 7, 7, 1) == std::vector<int>{3}));
+  BOOST_CHECK(near(g, 0, 0, 1).empty());
+  BOOST_CHECK_EQUAL(g.first(-1, 3), SpatialGrid::NONE); // Fuera: vacío
+}
+
+BOOST_AUTO_TEST_CASE(grid_clear_and_resize_empty_it) {
+  SpatialGrid g;
+  g.resize(4, 4);
+  g.insert(0, 1, 1);
+  g.insert(7, 2, 2);
+  g.insert(1, 9, 9); // Fuera: se ignora
+  g.clear();
+  BOOST_CHECK(near(g, 1, 1, 3).empty());
+
+  g.insert(2, 1, 1);
+  BOOST_CHECK((near(g, 1, 1, 0) == std::vector<int>{2}));
+  g.resize(4, 4);
+  BOOST_CHECK(near(g, 1, 1, 0).empty());
+
+  g.resize(20, 8);
+  BOOST_CHECK_EQUAL(g.width(), 20);
+  g.insert(0, 19, 7);
+  BOOST_CHECK((near(g, 18, 6, 1) == std::vector<int>{0}));
+}
+
+BOOST_AUTO_TEST_CASE(grid_matches_brute_force) {
+  // Muchas reconstrucciones seguidas (como un frame tras otro)
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> coord(0, 63);
+  SpatialGrid g;
+  std::vector<int> xs(500), ys(500);
+  for (int frame = 0; frame < 20; ++frame) {
+    g.resize(64, 64);
+    for (int i = 0; i < 500; ++i) {
+      xs[i] = coord(rng);
+      ys[i] = coord(rng);
+      g.insert(i, xs[i], ys[i]);
+    }
+    for (int q = 0; q < 50; ++q) {
+      const int x = coord(rng), y = coord(rng);
+      std::vector<int> expect;
+      for (int i = 0; i < 500; ++i)
+        if (std::abs(xs[i] - x) <= 1 && std::abs(ys[i] - y) <= 1)
+          expect.push_back(i);
+      BOOST_CHECK(near(g, x, y, 1) == expect);
+    }
+  }
+}
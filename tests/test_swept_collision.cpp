@@ -0,0 +1,90 @@
+#define BOOST_TEST_MODULE test_swept_collision
+#include <boost/test/unit_test.hpp>
+
+#include "core/SweptCollision.hpp"
+
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+using Tiles = std::vector<std::pair<int, int>>;
+
+static Tiles visited(float x0, float y0, float x1, float y1, float tile) {
+  Tiles out;
+  rb::traverseTiles(x0, y0, x1, y1, tile, [&](int tx, int ty, float) {
+    out.push_back({tx, ty});
+    return false;
+  });
+  return out;
+}
+
+BOOST_AUTO_TEST_CASE(dda_visits_every_crossed_tile_in_order) {
+  // Horizontal: de la casilla 0 a la 3
+  BOOST_CHECK((visited(5, 5, 100, 5, 32) == Tiles{{0, 0}, {1, 0}, {2, 0}, {3, 0}}));
+  // Hacia atrás y con coordenadas negativas
+  BOOST_CHECK((visited(40, 40, -10, 40, 32) == Tiles{{1, 1}, {0, 1}, {-1, 1}}));
+  // Sin moverse: solo su casilla
+  BOOST_CHECK((visited(40, 40, 40, 40, 32) == Tiles{{1, 1}}));
+
+  // Oblicuo: casillas 4-conectadas, empieza y acaba donde toca
+  const Tiles d = visited(2, 2, 95, 60, 32);
+  BOOST_REQUIRE(!d.empty());
+  BOOST_CHECK((d.front() == std::pair<int, int>{0, 0}));
+  BOOST_CHECK((d.back() == std::pair<int, int>{2, 1}));
+  for (size_t i = 1; i < d.size(); ++i)
+    BOOST_CHECK_EQUAL(std::abs(d[i].first - d[i - 1].first) +
+                          std::abs(d[i].second - d[i - 1].second),
+                      1);
+}
+
+BOOST_AUTO_TEST_CASE(dda_exact_corner_checks_both_sides) {
+  // Diagonal perfecta por el vértice (32, 32): no se cuela en diagonal
+  const Tiles d = visited(16, 16, 48, 48, 32);
+  BOOST_CHECK((d == Tiles{{0, 0}, {1, 0}, {0, 1}, {1, 1}}));
+
+  // Un muro en (1, 0) la detiene en la esquina
+  const float t = rb::traverseTiles(16, 16, 48, 48, 32, [](int x, int y, float) {
+    return x == 1 && y == 0;
+  });
+  BOOST_CHECK_CLOSE(t, 0.5f, 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(dda_fast_step_cannot_tunnel) {
+  // Muro de una casilla en x = 3. Un salto de 10 casillas en un frame lo
+  // atraviesa si solo se mira el destino; barrido, choca al entrar.
+  auto wall = [](int x, int, float) { return x == 3; };
+  const float t = rb::traverseTiles(16, 16, 16 + 320, 16, 32, wall);
+  BOOST_REQUIRE_GE(t, 0.0f);
+  BOOST_CHECK_CLOSE(16 + 320 * t, 96.0f, 1e-3); // Borde izquierdo del muro
+}
+
+BOOST_AUTO_TEST_CASE(swept_circle_hits_first_contact) {
+  // Pasa por el centro: entra a distancia r
+  float t = rb::sweptCircle(0, 0, 100, 0, 50, 0, 10);
+  BOOST_CHECK_CLOSE(t, 0.4f, 1e-3);
+  // Ya dentro
+  BOOST_CHECK_EQUAL(rb::sweptCircle(48, 0, 100, 0, 50, 0, 10), 0.0f);
+  // Pasa de largo (a 11 del centro)
+  BOOST_CHECK_LT(rb::sweptCircle(0, 11, 100, 11, 50, 0, 10), 0.0f);
+  // Se queda corto
+  BOOST_CHECK_LT(rb::sweptCircle(0, 0, 30, 0, 50, 0, 10), 0.0f);
+  // Se aleja
+  BOOST_CHECK_LT(rb::sweptCircle(70, 0, 200, 0, 50, 0, 10), 0.0f);
+}
+
+BOOST_AUTO_TEST_CASE(hits_do_not_depend_on_frame_time) {
+  // Bala del boss a 450 px/s contra una hitbox de 0.4 casillas (12.8 px)
+  // que queda entre dos posiciones de frame a 10 fps.
+  const float speed = 450.0f, cx = 300.0f, r = 12.8f;
+  for (float dt : {1.0f / 240.0f, 1.0f / 60.0f, 1.0f / 10.0f, 0.25f}) {
+    float x = 0.0f, hitX = -1.0f;
+    for (int f = 0; f < 1000 && hitX < 0.0f; ++f) {
+      const float nx = x + speed * dt;
+      const float t = rb::sweptCircle(x, 0, nx, 0, cx, 0, r);
+      if (t >= 0.0f)
+        hitX = x + (nx - x) * t;
+      x = nx;
+    }
+    BOOST_CHECK_CLOSE(hitX, cx - r, 1e-2);
+  }
+}
@@ -0,0 +1,99 @@
+#define BOOST_TEST_MODULE test_timer_wheel
+#include <boost/test/unit_test.hpp>
+
+#include "core/TimerWheel.hpp"
+
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(timer_fires_at_expiry_not_before) {
+  TimerWheel w;
+  bool fired = false;
+  w.schedule(1.0, [&] { fired = true; });
+
+  w.advance(0.99);
+  BOOST_CHECK(!fired);
+  BOOST_CHECK_EQUAL(w.pending(), 1u);
+
+  w.advance(1.0);
+  BOOST_CHECK(fired);
+  BOOST_CHECK_EQUAL(w.pending(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(timer_cancel_prevents_callback) {
+  TimerWheel w;
+  int count = 0;
+  auto id = w.schedule(0.5, [&] { ++count; });
+  BOOST_CHECK(w.isPending(id));
+  BOOST_CHECK(w.cancel(id));
+  BOOST_CHECK(!w.cancel(id));
+
+  w.advance(2.0);
+  BOOST_CHECK_EQUAL(count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(timer_far_future_cascades_down) {
+  // 100 s = 6400 ticks: vive en el nivel 2 y debe bajar en cascada
+  TimerWheel w;
+  bool fired = false;
+  w.schedule(100.0, [&] { fired = true; });
+
+  for (int i = 1; i < 100 * 60; ++i) {
+    w.advance(i / 60.0);
+    if (fired)
+      break;
+  }
+  BOOST_CHECK(!fired); // 99.98 s
+
+  w.advance(100.0);
+  BOOST_CHECK(fired);
+}
+
+BOOST_AUTO_TEST_CASE(timer_fires_in_expiry_order_on_large_step) {
+  TimerWheel w;
+  std::vector<int> order;
+  w.schedule(3.0, [&] { order.push_back(3); });
+  w.schedule(0.2, [&] { order.push_back(1); });
+  w.schedule(1.5, [&] { order.push_back(2); });
+  w.schedule(0.2, [&] { order.push_back(10); }); // Empate: por orden de alta
+
+  w.advance(5.0);
+
+  std::vector<int> expected{1, 10, 2, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(),
+                                expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(timer_past_deadline_fires_on_next_advance) {
+  TimerWheel w;
+  w.advance(10.0);
+
+  bool fired = false;
+  w.schedule(4.0, [&] { fired = true; });
+  w.advance(10.0);
+  BOOST_CHECK(fired);
+}
+
+BOOST_AUTO_TEST_CASE(timer_callback_can_reschedule) {
+  TimerWheel w;
+  int count = 0;
+  std::function<void()> again = [&] {
+    if (++count < 3)
+      w.schedule(w.now() + 0.5, again);
+  };
+  w.schedule(0.5, again);
+
+  for (int i = 1; i <= 120; ++i)
+    w.advance(i / 60.0);
+
+  BOOST_CHECK_EQUAL(count, 3);
+}
+
+BOOST_AUTO_TEST_CASE(timer_reset_drops_pending) {
+  TimerWheel w;
+  bool fired = false;
+  w.schedule(1.0, [&] { fired = true; });
+  w.reset(0.0);
+  w.advance(5.0);
+  BOOST_CHECK(!fired);
+  BOOST_CHECK_EQUAL(w.pending(), 0u);
+}